@@ -0,0 +1,746 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+import * as FS from "fs";
+import * as OS from "os";
+import * as Path from "path";
+
+import { spawnSync } from "child_process";
+
+import * as chalk from "chalk";
+
+//End-to-end checks of the icpp command line modes -- run against a small hand written assembly (fixtures/modes.bsqir)
+
+const bosque_dir: string = Path.join(__dirname, "../../../");
+const icpppath: string = Path.join(bosque_dir, "/build/output/icpp" + (process.platform === "win32" ? ".exe" : ""));
+const fixture: string = Path.join(bosque_dir, "src/test/icpp/fixtures/modes.bsqir");
+
+type ModeTest = {
+    name: string,
+    args: string[],
+    env?: {[k: string]: string},
+    input: string | Buffer,
+    check: (stdout: Buffer, stderr: Buffer) => string | undefined
+};
+
+//A failing run still reports on stdout so the exit status is not checked
+function runIcpp(args: string[], input: string | Buffer, env?: {[k: string]: string}): {stdout: Buffer, stderr: Buffer} {
+    const res = spawnSync(icpppath, args, {input: input, env: {...process.env, ...(env || {}), ICPP_OUTPUT_MODE: "json"}, maxBuffer: 64 * 1024 * 1024, stdio: ["pipe", "pipe", "pipe"]});
+    return {stdout: res.stdout, stderr: res.stderr};
+}
+
+//Just enough CBOR to build requests and read responses -- ints, floats, strings, arrays, maps, and simple values (definite or indefinite length)
+function cborHead(major: number, n: number): Buffer {
+    if(n < 24) {
+        return Buffer.from([(major << 5) | n]);
+    }
+    else if(n < 0x100) {
+        return Buffer.from([(major << 5) | 24, n]);
+    }
+    else if(n < 0x10000) {
+        const bb = Buffer.alloc(3);
+        bb[0] = (major << 5) | 25;
+        bb.writeUInt16BE(n, 1);
+        return bb;
+    }
+    else {
+        const bb = Buffer.alloc(5);
+        bb[0] = (major << 5) | 26;
+        bb.writeUInt32BE(n, 1);
+        return bb;
+    }
+}
+
+function cborEncode(v: any): Buffer {
+    if(v === null) {
+        return Buffer.from([0xf6]);
+    }
+    else if(typeof(v) === "boolean") {
+        return Buffer.from([v ? 0xf5 : 0xf4]);
+    }
+    else if(typeof(v) === "number" && Number.isInteger(v)) {
+        return v >= 0 ? cborHead(0, v) : cborHead(1, -1 - v);
+    }
+    else if(typeof(v) === "number") {
+        const bb = Buffer.alloc(9);
+        bb[0] = 0xfb;
+        bb.writeDoubleBE(v, 1);
+        return bb;
+    }
+    else if(typeof(v) === "string") {
+        const sb = Buffer.from(v, "utf8");
+        return Buffer.concat([cborHead(3, sb.length), sb]);
+    }
+    else if(Array.isArray(v)) {
+        return Buffer.concat([cborHead(4, v.length), ...v.map((vv) => cborEncode(vv))]);
+    }
+    else {
+        const keys = Object.keys(v);
+        return Buffer.concat([cborHead(5, keys.length), ...keys.map((kk) => Buffer.concat([cborEncode(kk), cborEncode(v[kk])]))]);
+    }
+}
+
+function cborDecode(bytes: Buffer, pos: {i: number}): any {
+    const ib = bytes[pos.i++];
+    const major = ib >> 5;
+    const info = ib & 0x1f;
+
+    if(ib === 0xfb) {
+        pos.i += 8;
+        return bytes.readDoubleBE(pos.i - 8);
+    }
+    if(major === 7) {
+        return info === 20 ? false : (info === 21 ? true : null);
+    }
+
+    let n = info;
+    if(info === 24) {
+        n = bytes[pos.i];
+        pos.i += 1;
+    }
+    else if(info === 25) {
+        n = bytes.readUInt16BE(pos.i);
+        pos.i += 2;
+    }
+    else if(info === 26) {
+        n = bytes.readUInt32BE(pos.i);
+        pos.i += 4;
+    }
+    else if(info === 27) {
+        n = (bytes.readUInt32BE(pos.i) * 0x100000000) + bytes.readUInt32BE(pos.i + 4);
+        pos.i += 8;
+    }
+
+    const more = (k: number) => (info === 31 ? bytes[pos.i] !== 0xff : k < n);
+    let res: any = undefined;
+    if(major === 0) {
+        res = n;
+    }
+    else if(major === 1) {
+        res = -1 - n;
+    }
+    else if(major === 2 || major === 3) {
+        const sb = bytes.slice(pos.i, pos.i + n);
+        pos.i += n;
+        res = (major === 3) ? sb.toString("utf8") : sb;
+    }
+    else if(major === 4) {
+        res = [];
+        for(let k = 0; more(k); ++k) {
+            res.push(cborDecode(bytes, pos));
+        }
+    }
+    else {
+        res = {};
+        for(let k = 0; more(k); ++k) {
+            const kk = cborDecode(bytes, pos);
+            res[kk] = cborDecode(bytes, pos);
+        }
+    }
+
+    if(info === 31) {
+        pos.i++; //break code
+    }
+    return res;
+}
+
+//Binary serve responses are a "cbor <n>" line followed by n bytes
+function cborResponses(stdout: Buffer): any[] {
+    const resps: any[] = [];
+    let pos = 0;
+    while(pos < stdout.length) {
+        const eol = stdout.indexOf(0x0a, pos);
+        const hdr = stdout.slice(pos, eol).toString();
+        if(!hdr.startsWith("cbor ")) {
+            throw new Error(`bad response header ${hdr}`);
+        }
+
+        const size = Number.parseInt(hdr.substring(5));
+        resps.push(cborDecode(stdout.slice(eol + 1, eol + 1 + size), {i: 0}));
+        pos = eol + 1 + size;
+    }
+    return resps;
+}
+
+function cborRequest(req: any): Buffer {
+    const rb = cborEncode(req);
+    return Buffer.concat([Buffer.from(`cbor ${rb.length}\n`), rb]);
+}
+
+//Parse the same arguments inline (DOM parse) and from an @file (streaming parse) -- both must accept or reject and agree on the value
+function parityTest(name: string, main: string, args: any[], accept: boolean, fileformat?: "json" | "cbor"): ModeTest {
+    return {
+        name: `parse parity ${name}`,
+        args: ["--compact", "--main", main, fixture, JSON.stringify(args)],
+        input: "",
+        check: (stdout: Buffer) => {
+            const dom = JSON.parse(stdout.toString());
+
+            const argsfile = Path.join(OS.tmpdir(), `icpp_parity_${process.pid}.${fileformat || "json"}`);
+            FS.writeFileSync(argsfile, fileformat === "cbor" ? cborEncode(args) : JSON.stringify(args));
+            const stream = JSON.parse(runIcpp(["--compact", "--main", main, fixture, "@" + argsfile], "").stdout.toString());
+            FS.unlinkSync(argsfile);
+
+            const expected = accept ? "success" : "failure";
+            if(dom["status"] !== expected || stream["status"] !== expected) {
+                return `expected ${expected} from both parsers but got ${JSON.stringify(dom)} (inline) and ${JSON.stringify(stream)} (@file)`;
+            }
+            if(JSON.stringify(dom["value"]) !== JSON.stringify(stream["value"])) {
+                return `parsers disagree -- ${JSON.stringify(dom["value"])} (inline) vs ${JSON.stringify(stream["value"])} (@file)`;
+            }
+            return undefined;
+        }
+    };
+}
+
+function jsonLines(stdout: Buffer): any[] {
+    return stdout.toString().split("\n").filter((ll) => ll.trim() !== "").map((ll) => JSON.parse(ll));
+}
+
+function checkResponse(resp: any, id: number, status: string, value?: any, msg?: RegExp): string | undefined {
+    if(resp === undefined || resp["id"] !== id) {
+        return `expected the response for request ${id} but got ${JSON.stringify(resp)}`;
+    }
+    if(resp["status"] !== status) {
+        return `expected ${status} for request ${id} but got ${JSON.stringify(resp)}`;
+    }
+    if(value !== undefined && JSON.stringify(resp["value"]) !== JSON.stringify(value)) {
+        return `expected value ${JSON.stringify(value)} for request ${id} but got ${JSON.stringify(resp["value"])}`;
+    }
+    if(msg !== undefined && !msg.test(resp["msg"])) {
+        return `expected a message matching ${msg} for request ${id} but got ${JSON.stringify(resp["msg"])}`;
+    }
+    return undefined;
+}
+
+//Write a modified copy of the fixture to a temporary file -- the test that uses it removes it in its check
+function tempFixture(tag: string, update: (asm: any) => void): string {
+    const asm = JSON.parse(FS.readFileSync(fixture).toString());
+    update(asm);
+
+    const file = Path.join(OS.tmpdir(), `icpp_modes_${tag}_${process.pid}.bsqir`);
+    FS.writeFileSync(file, JSON.stringify(asm));
+    return file;
+}
+
+//Add count copies of Main::fold (Main::fold0, Main::fold1, ...) that each recurse into themselves
+function addFoldCopies(asm: any, count: number) {
+    const fold = asm["code"]["bytecode"]["invdecls"].find((ii: any) => ii["ikey"] === "__i__Main::fold");
+    const foldsig = asm["code"]["api"]["apisig"].find((ss: any) => ss["name"] === "__i__Main::fold");
+    for(let i = 0; i < count; ++i) {
+        const ikey = `__i__Main::fold${i}`;
+        const body = fold["body"].map((op: any) => (op["invokeId"] === fold["ikey"] ? {...op, invokeId: ikey} : op));
+
+        asm["code"]["bytecode"]["invdecls"].push({...fold, name: ikey, ikey: ikey, body: body});
+        asm["code"]["bytecode"]["invokenames"].push(ikey);
+        asm["code"]["api"]["apisig"].push({...foldsig, name: ikey});
+    }
+}
+
+//Printable ASCII (with the quote and backslash that need escapes) in a pattern that does not line up with the 256 byte string chunks
+function sampleText(size: number): string {
+    return [...Array(size).keys()].map((i) => String.fromCharCode(32 + (i % 91))).join("");
+}
+
+//Maps of count 5000 element lists (each result is hundreds of small young list nodes) with a read of the old Main::table global every 20 calls
+function youngObjectCalls(count: number): [string, any[], any][] {
+    const calls: [string, any[], any][] = [];
+    for(let i = 0; i < count; ++i) {
+        const ll = [...Array(5000).keys()].map((v) => v + i);
+        calls.push(["Main::incList", [ll], ll.map((v) => v + 1)]);
+        if(i % 20 === 0) {
+            calls.push(["Main::getTable", [], [1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0]]);
+        }
+    }
+    return calls;
+}
+
+//Make each [entrypoint, args, expected value] call in order through one serve process (with any extra flags and env) -- every call must succeed
+function serveCallsTest(name: string, calls: [string, any[], any][], flags?: string[], env?: {[k: string]: string}): ModeTest {
+    return {
+        name: name,
+        args: [...(flags || []), "--serve", fixture],
+        env: env,
+        input: calls.map((cc, id) => JSON.stringify({id: id, main: `__i__${cc[0]}`, args: cc[1]})).join("\n") + "\n",
+        check: (stdout: Buffer) => {
+            const resps = jsonLines(stdout);
+            if(resps.length !== calls.length) {
+                return `expected ${calls.length} responses but got ${resps.length} -- ${stdout.toString()}`;
+            }
+
+            for(let i = 0; i < calls.length; ++i) {
+                const err = checkResponse(resps[i], i, "success", calls[i][2]);
+                if(err !== undefined) {
+                    return err;
+                }
+            }
+            return undefined;
+        }
+    };
+}
+
+//Counters are reported on stderr as "<name>: <n>" lines -- -1 if the counter is missing
+function statValue(stderr: Buffer, name: string): number {
+    const mm = new RegExp(`^${name}: (\\d+)$`, "m").exec(stderr.toString());
+    return mm !== null ? Number.parseInt(mm[1]) : -1;
+}
+
+function checkRecord(resp: any, record: number, status: string, value?: any, msg?: RegExp): string | undefined {
+    if(resp === undefined || resp["record"] !== record) {
+        return `expected the result for record ${record} but got ${JSON.stringify(resp)}`;
+    }
+    return checkResponse({...resp, id: record}, record, status, value, msg);
+}
+
+//Echo count lists of size elements through one serve process with the given collector settings and then make a small call
+//Every echo must succeed -- or if limitabort is set at least one must fail on the heap limit -- and the small call must succeed after them
+function boundedServeTest(name: string, env: {[k: string]: string}, count: number, size: number, limitabort?: boolean): ModeTest {
+    return {
+        name: name,
+        args: ["--serve", fixture],
+        env: env,
+        input: [...Array(count).keys()].map((id) => JSON.stringify({id: id, main: "__i__Main::echoList", args: [[...Array(size).keys()]]}))
+            .concat([JSON.stringify({id: count, main: "__i__Main::main", args: [5]})]).join("\n") + "\n",
+        check: (stdout: Buffer) => {
+            const resps = jsonLines(stdout);
+            if(resps.length !== count + 1) {
+                return `expected ${count + 1} responses but got ${resps.length}`;
+            }
+
+            const echos = resps.slice(0, count);
+            if(limitabort) {
+                if(!echos.some((resp) => resp["status"] === "failure" && /Heap limit exceeded/.test(resp["msg"]))) {
+                    return `expected a request to fail on the heap limit`;
+                }
+            }
+            else {
+                const failed = echos.find((resp) => resp["status"] !== "success");
+                if(failed !== undefined) {
+                    return `expected every request to fit under the heap limit but got ${JSON.stringify(failed).substring(0, 200)}`;
+                }
+            }
+            return checkResponse(resps[count], count, "success", 6);
+        }
+    };
+}
+
+const s_mode_tests: ModeTest[] = [
+    {
+        name: "serve abort then success",
+        args: ["--serve", fixture],
+        input: [
+            JSON.stringify({id: 1, main: "__i__Main::check", args: [0]}),
+            JSON.stringify({id: 2, main: "__i__Main::main", args: [5]})
+        ].join("\n") + "\n",
+        check: (stdout: Buffer) => {
+            const resps = jsonLines(stdout);
+            if(resps.length !== 2) {
+                return `expected 2 responses but got ${resps.length} -- ${stdout.toString()}`;
+            }
+            return checkResponse(resps[0], 1, "failure", undefined, /x must be positive/) || checkResponse(resps[1], 2, "success", 6);
+        }
+    },
+    {
+        name: "serve unknown entrypoint",
+        args: ["--serve", fixture],
+        input: [
+            JSON.stringify({id: 1, main: "__i__Main::missing", args: []}),
+            JSON.stringify({id: 2, main: "__i__Main::main", args: [1]})
+        ].join("\n") + "\n",
+        check: (stdout: Buffer) => {
+            const resps = jsonLines(stdout);
+            if(resps.length !== 2) {
+                return `expected 2 responses but got ${resps.length} -- ${stdout.toString()}`;
+            }
+            return checkResponse(resps[0], 1, "failure", undefined, /Could not load given entrypoint/) || checkResponse(resps[1], 2, "success", 2);
+        }
+    },
+    {
+        name: "serve rejects a byte count over the limit",
+        args: ["--serve", fixture],
+        env: {ICPP_SERVE_MAX_REQUEST_MB: "1"},
+        input: [JSON.stringify({id: 1, main: "__i__Main::main", args: [1]}), "2000000", JSON.stringify({id: 3, main: "__i__Main::main", args: [1]})].join("\n") + "\n",
+        check: (stdout: Buffer) => {
+            //the payload cannot be skipped so the stream ends after the error
+            const resps = jsonLines(stdout);
+            if(resps.length !== 2) {
+                return `expected 2 responses but got ${resps.length} -- ${stdout.toString()}`;
+            }
+            return checkResponse(resps[0], 1, "success", 2) || checkResponse({...resps[1], id: 2}, 2, "error", undefined, /over the limit/);
+        }
+    },
+    {
+        name: "serve rejects an overflowing byte count",
+        args: ["--serve", fixture],
+        input: "99999999999999999999\n",
+        check: (stdout: Buffer) => {
+            const resps = jsonLines(stdout);
+            if(resps.length !== 1) {
+                return `expected 1 response but got ${resps.length} -- ${stdout.toString()}`;
+            }
+            return checkResponse({...resps[0], id: 1}, 1, "error", undefined, /over the limit/);
+        }
+    },
+    serveCallsTest("serve branches and returns through the threaded dispatch", [["Main::fold", [0, 7], 7], ["Main::fold", [10, 0], 55], ["Main::sum", [[3, 4]], 7], ["Main::check", [3], 3]]),
+    (() => {
+        //enough bodies that their ops fill several of the 64KB op chunks
+        const copies = 400;
+        const asmfile = tempFixture("packed", (asm: any) => addFoldCopies(asm, copies));
+        return {
+            name: "serve runs bodies packed across op chunks",
+            args: ["--serve", asmfile],
+            input: [...Array(copies).keys()].map((i) => JSON.stringify({id: i, main: `__i__Main::fold${i}`, args: [i, 0]})).join("\n") + "\n",
+            check: (stdout: Buffer) => {
+                FS.unlinkSync(asmfile);
+
+                const resps = jsonLines(stdout);
+                if(resps.length !== copies) {
+                    return `expected ${copies} responses but got ${resps.length} -- ${stdout.toString().substring(0, 200)}`;
+                }
+                for(let i = 0; i < copies; ++i) {
+                    const err = checkResponse(resps[i], i, "success", (i * (i + 1)) / 2);
+                    if(err !== undefined) {
+                        return err;
+                    }
+                }
+                return undefined;
+            }
+        };
+    })(),
+    serveCallsTest("serve virtual call cache hits and misses", [
+        ["Main::size", [{"__type_tag__": "Main::Pt", "x": 3, "y": 4}], 7],
+        ["Main::size", [{"__type_tag__": "Main::Pt", "x": 1, "y": 1}], 2],
+        ["Main::size", [{"__type_tag__": "Main::Sq", "s": 5}], 25],
+        ["Main::size", [{"__type_tag__": "Main::Pt", "x": 2, "y": 8}], 10],
+        ["Main::size", [{"__type_tag__": "Main::Sq", "s": 3}], 9]
+    ]),
+    //the marshalling plans are built once when the API module loads and each request parses and extracts through them
+    serveCallsTest("serve round trips through the marshalling plans", [
+        ["Main::echoPt", [{"x": 1, "y": -2}], {"x": 1, "y": -2}],
+        ["Main::echoPt", [["Main::Pt", {"x": 3, "y": 4}]], {"x": 3, "y": 4}],
+        ["Main::echoPtOpt", [{"__type_tag__": "Main::Pt", "x": 5, "y": 6}], {"__type_tag__": "Main::Pt", "x": 5, "y": 6}],
+        ["Main::echoPtOpt", [["None", null]], ["None", null]],
+        ["Main::echoOpt", [["Int", 7]], ["Int", 7]],
+        ["Main::echoOpt", [["None", null]], ["None", null]],
+        ["Main::echoMap", [[[5, 50], [-1, 10], [3, 30]]], [[-1, 10], [3, 30], [5, 50]]],
+        ["Main::echoList", [[...Array(40).keys()]], [...Array(40).keys()]],
+        ["Main::sum", [[-8, 2]], -6],
+        ["Main::echoPt", [{"x": 0, "y": 0}], {"x": 0, "y": 0}]
+    ]),
+    //strings of 128 bytes or more are read into a single leaf over the input bytes -- shorter ones are still copied into chunks
+    serveCallsTest("serve echoes large strings", ["", "short", sampleText(127), sampleText(200), sampleText(5000), "\u00e9\u20ac\ud83d\ude00\n".repeat(100), sampleText(4 * 1024 * 1024), sampleText(300)]
+        .map((ss): [string, any[], any] => ["Main::echoStr", [ss], ss])),
+    {
+        name: "batch single tuple parameter",
+        args: ["--batch", fixture, "Main::sum"],
+        input: "[3, 4]\n[1, 2]\n",
+        check: (stdout: Buffer) => {
+            const resps = jsonLines(stdout);
+            if(resps.length !== 2) {
+                return `expected 2 results but got ${resps.length} -- ${stdout.toString()}`;
+            }
+            return checkRecord(resps[0], 0, "success", 7) || checkRecord(resps[1], 1, "success", 3);
+        }
+    },
+    {
+        name: "batch abort record",
+        args: ["--batch", fixture, "Main::check"],
+        input: "5\n0\n2\n",
+        check: (stdout: Buffer) => {
+            const resps = jsonLines(stdout);
+            if(resps.length !== 3) {
+                return `expected 3 results but got ${resps.length} -- ${stdout.toString()}`;
+            }
+            return checkRecord(resps[0], 0, "success", 5) || checkRecord(resps[1], 1, "failure", undefined, /x must be positive/) || checkRecord(resps[2], 2, "success", 2);
+        }
+    },
+    //list reduce is a primitive whose arguments (and the lambda arguments for each element) are passed in stack spans
+    serveCallsTest("serve primitive call with a lambda", [["Main::sumList", [[7]], 7], ["Main::sumList", [[1, 2, 3, 4, 5]], 15], ["Main::sumList", [[...Array(1000).keys()]], 499500]]),
+    //incList keeps the result of its first map only in a frame slot while a second map allocates -- collections in the middle of it find that list through the stack map
+    serveCallsTest("serve frame references stay live across collections", [...Array(8).keys()].map((i): [string, any[], any] => {
+        const ll = [...Array(200000).keys()].map((v) => v + i);
+        return ["Main::incList", [ll], ll.map((v) => v + 1)];
+    }), [], {ICPP_GC_MAX_PAUSE_MS: "0.1"}),
+    {
+        name: "batch virtual call on each union member",
+        args: ["--batch", fixture, "Main::size"],
+        input: [{"__type_tag__": "Main::Sq", "s": 4}, {"__type_tag__": "Main::Pt", "x": 1, "y": 2}, {"__type_tag__": "Main::Qt", "s": 2}, {"__type_tag__": "Main::Sq", "s": 1}].map((rr) => JSON.stringify(rr)).join("\n") + "\n",
+        check: (stdout: Buffer) => {
+            //the receiver type picks the row of the dense vtable -- a tag outside the union is rejected before the call
+            const resps = jsonLines(stdout);
+            if(resps.length !== 4) {
+                return `expected 4 results but got ${resps.length} -- ${stdout.toString()}`;
+            }
+            return checkRecord(resps[0], 0, "success", 16) || checkRecord(resps[1], 1, "success", 3) || checkRecord(resps[2], 2, "failure", undefined, /argument parsing/) || checkRecord(resps[3], 3, "success", 1);
+        }
+    },
+    //the small limit keeps the nursery small so the survivors of many collections are evacuated into the typed pages
+    serveCallsTest("serve young objects keep their values across nursery collections", youngObjectCalls(200), [], {ICPP_GC_MAX_HEAP_MB: "3"}),
+    serveCallsTest("serve parallel collection keeps young objects and old globals intact", youngObjectCalls(200), [], {ICPP_GC_THREADS: "4", ICPP_GC_MAX_HEAP_MB: "3"}),
+    boundedServeTest("serve heap limit abort then success", {ICPP_GC_MAX_HEAP_MB: "2", ICPP_GC_DEC_THREAD: "1"}, 3, 400000, true),
+    boundedServeTest("serve heap stays bounded across requests", {ICPP_GC_MAX_HEAP_MB: "4"}, 30, 100000),
+    boundedServeTest("serve heap stays bounded with parallel collection and a decrement thread", {ICPP_GC_THREADS: "4", ICPP_GC_DEC_THREAD: "1", ICPP_GC_MAX_HEAP_MB: "4"}, 30, 100000),
+    boundedServeTest("serve heap stays bounded with roots kept across collections", {ICPP_GC_MAX_PAUSE_MS: "0.1", ICPP_GC_MAX_HEAP_MB: "16"}, 8, 400000),
+    {
+        name: "serve releases free pages after a large request",
+        args: ["--serve", fixture],
+        env: {ICPP_GC_MAX_PAUSE_MS: "0.1", ICPP_GC_STATS: "1"},
+        input: [...Array(40).keys()].map((id) => JSON.stringify({id: id, main: "__i__Main::echoList", args: [[...Array(id < 3 ? 400000 : 1000).keys()]]})).join("\n") + "\n",
+        check: (stdout: Buffer, stderr: Buffer) => {
+            const resps = jsonLines(stdout);
+            if(resps.length !== 40 || resps.some((resp) => resp["status"] !== "success")) {
+                return `expected 40 successful responses`;
+            }
+
+            if(statValue(stderr, "GC page releases") <= 0) {
+                return `expected the collector to return pages to the OS but got ${stderr.toString()}`;
+            }
+            //each region is a single mapping of 4096 blocks -- the heap should not map blocks one at a time
+            if(statValue(stderr, "GC regions reserved") <= 0 || statValue(stderr, "GC regions reserved") * 4096 < statValue(stderr, "GC pages")) {
+                return `expected the pages to be carved from a few regions but got ${stderr.toString()}`;
+            }
+            return undefined;
+        }
+    },
+    {
+        name: "load stats count deferred and materialized bodies",
+        args: ["--compact", "--main", "Main::main", fixture, JSON.stringify([5])],
+        env: {ICPP_LOAD_STATS: "1"},
+        input: "",
+        check: (stdout: Buffer, stderr: Buffer) => {
+            //every body is left in the assembly text at load and only the one that is called (and the constant initializers) get parsed
+            const bytecode = JSON.parse(FS.readFileSync(fixture).toString())["code"]["bytecode"];
+            const invokes = bytecode["invdecls"].filter((ii: any) => !ii["isbuiltin"]).length;
+            const materialized = 1 + bytecode["constdecls"].length;
+            if(statValue(stderr, "Bodies deferred") !== invokes || statValue(stderr, "Bodies materialized") !== materialized) {
+                return `expected ${invokes} deferred bodies and ${materialized} materialized bodies but got ${stderr.toString()}`;
+            }
+            return checkResponse({...JSON.parse(stdout.toString()), id: 0}, 0, "success", 6);
+        }
+    },
+    {
+        name: "load stats count fused superinstructions",
+        args: ["--compact", "--main", "Main::fold", fixture, JSON.stringify([10, 0])],
+        env: {ICPP_LOAD_STATS: "1"},
+        input: "",
+        check: (stdout: Buffer, stderr: Buffer) => {
+            //the n <= 0i compare and the branch on it become one compare-and-jump op
+            if(statValue(stderr, "Superinstructions fused") !== 1) {
+                return `expected 1 fused superinstruction but got ${stderr.toString()}`;
+            }
+            return checkResponse({...JSON.parse(stdout.toString()), id: 0}, 0, "success", 55);
+        }
+    },
+    {
+        name: "load stats count folded constant ops",
+        args: ["--compact", "--main", "Main::two", fixture, JSON.stringify([])],
+        env: {ICPP_LOAD_STATS: "1"},
+        input: "",
+        check: (stdout: Buffer, stderr: Buffer) => {
+            //1i + 1i has only constant arguments so it is replaced by a load of 2i when the body is materialized
+            if(statValue(stderr, "Ops folded") !== 1) {
+                return `expected 1 folded op but got ${stderr.toString()}`;
+            }
+            return checkResponse({...JSON.parse(stdout.toString()), id: 0}, 0, "success", 2);
+        }
+    },
+    {
+        name: "self tail calls run in one frame",
+        args: ["--compact", "--main", "Main::fold", fixture, JSON.stringify([1000000, 0])],
+        env: {ICPP_LOAD_STATS: "1"},
+        input: "",
+        check: (stdout: Buffer, stderr: Buffer) => {
+            //a million nested frames would not fit on the interpreter stack
+            if(statValue(stderr, "Self tail calls") !== 1) {
+                return `expected 1 self tail call but got ${stderr.toString()}`;
+            }
+            return checkResponse({...JSON.parse(stdout.toString()), id: 0}, 0, "success", 500000500000);
+        }
+    },
+    (() => {
+        //each call runs interpreted and then native (every body compiles on its first call) and a mismatch is reported as a failure
+        const base = serveCallsTest("serve native tier matches the interpreter", [
+            ["Main::fold", [10, 0], 55],
+            ["Main::size", [{"__type_tag__": "Main::Pt", "x": 3, "y": 4}], 7],
+            ["Main::size", [{"__type_tag__": "Main::Sq", "s": 5}], 25],
+            ["Main::sum", [[3, 4]], 7],
+            ["Main::sumList", [[1, 2, 3, 4, 5]], 15],
+            ["Main::check", [3], 3]
+        ], ["--jit-diff"], {ICPP_JIT_THRESHOLD: "1", ICPP_LOAD_STATS: "1"});
+        return {
+            ...base,
+            check: (stdout: Buffer, stderr: Buffer) => {
+                if(statValue(stderr, "Bodies compiled") <= 0) {
+                    return `expected bodies to be compiled but got ${stderr.toString()}`;
+                }
+                return base.check(stdout, stderr);
+            }
+        };
+    })(),
+    {
+        name: "native tier entered from a self tail call loop",
+        args: ["--jit", "--compact", "--main", "Main::fold", fixture, JSON.stringify([1000000, 0])],
+        env: {ICPP_LOAD_STATS: "1"},
+        input: "",
+        check: (stdout: Buffer, stderr: Buffer) => {
+            //fold is called once so only the back edges of the tail call loop can reach the default threshold
+            if(statValue(stderr, "Bodies compiled") !== 1) {
+                return `expected fold to be compiled but got ${stderr.toString()}`;
+            }
+            return checkResponse({...JSON.parse(stdout.toString()), id: 0}, 0, "success", 500000500000);
+        }
+    },
+    {
+        name: "native tier overflow fails like the interpreter",
+        args: ["--jit-diff", "--compact", "--main", "Main::main", fixture, "[9223372036854775807]"],
+        env: {ICPP_JIT_THRESHOLD: "1", ICPP_LOAD_STATS: "1"},
+        input: "",
+        check: (stdout: Buffer, stderr: Buffer) => {
+            //the overflow check branches from the inline add to a slow path stub that raises the same error (the constant initializers are compiled too)
+            const compiled = 1 + JSON.parse(FS.readFileSync(fixture).toString())["code"]["bytecode"]["constdecls"].length;
+            if(statValue(stderr, "Bodies compiled") !== compiled) {
+                return `expected ${compiled} compiled bodies but got ${stderr.toString()}`;
+            }
+            return checkResponse({...JSON.parse(stdout.toString()), id: 0}, 0, "failure", undefined, /Int addition overflow/);
+        }
+    },
+    (() => {
+        //the snapshot is written next to the assembly so the test runs on a copy of the fixture
+        const asmfile = tempFixture("snapshot", () => undefined);
+        const args = ["--snapshot", "--compact", "--main", "Main::getTable", asmfile, JSON.stringify([])];
+        return {
+            name: "snapshot restores initialized globals",
+            args: args,
+            env: {ICPP_LOAD_STATS: "1"},
+            input: "",
+            check: (stdout: Buffer, stderr: Buffer) => {
+                const restore = runIcpp(args, "", {ICPP_LOAD_STATS: "1"});
+                const snapshotted = FS.existsSync(asmfile + ".bsqsnap");
+                FS.unlinkSync(asmfile);
+                if(snapshotted) {
+                    FS.unlinkSync(asmfile + ".bsqsnap");
+                }
+
+                //Main::table is a tree node over two leaves -- the second run relocates them instead of running the initializer
+                const expected = [1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0];
+                if(!snapshotted || statValue(stderr, "Snapshot objects written") !== 3) {
+                    return `expected the first run to write 3 objects to the snapshot but got ${stderr.toString()}`;
+                }
+                if(statValue(restore.stderr, "Snapshot objects restored") !== 3 || statValue(restore.stderr, "Bodies materialized") !== 1) {
+                    return `expected the second run to restore 3 objects without running the initializer but got ${restore.stderr.toString()}`;
+                }
+                return checkResponse({...JSON.parse(stdout.toString()), id: 0}, 0, "success", expected) || checkResponse({...JSON.parse(restore.stdout.toString()), id: 1}, 1, "success", expected);
+            }
+        };
+    })(),
+    {
+        name: "compact output",
+        args: ["--compact", "--main", "Main::echoMap", fixture, JSON.stringify([[[2, 20], [1, 10]]])],
+        input: "",
+        check: (stdout: Buffer) => {
+            const lines = stdout.toString().split("\n").filter((ll) => ll.trim() !== "");
+            if(lines.length !== 1) {
+                return `expected the result on a single line but got ${lines.length} -- ${stdout.toString()}`;
+            }
+            if(/\[\s|\s\]|,\s/.test(lines[0].substring(lines[0].indexOf("["), lines[0].lastIndexOf("]") + 1))) {
+                return `expected the value without whitespace but got ${lines[0]}`;
+            }
+            return checkResponse({...JSON.parse(lines[0]), id: 0}, 0, "success", [[1, 10], [2, 20]]);
+        }
+    },
+    {
+        name: "large result is one JSON document",
+        args: ["--stream"],
+        input: JSON.stringify({...JSON.parse(FS.readFileSync(fixture).toString()), main: "__i__Main::echoList", args: [[...Array(100000).keys()]]}),
+        check: (stdout: Buffer) => {
+            //the value is several writer buffers long so it goes through the spill file before it is written out
+            const res = JSON.parse(stdout.toString());
+            if(res["status"] !== "success" || !Array.isArray(res["value"]) || res["value"].length !== 100000 || res["value"][99999] !== 99999) {
+                return `expected the 100000 element list back but got ${stdout.toString().substring(0, 200)}`;
+            }
+            return undefined;
+        }
+    },
+    {
+        name: "binary serve abort then success",
+        args: ["--serve", fixture],
+        input: Buffer.concat([
+            cborRequest({id: 1, main: "__i__Main::check", args: [0]}),
+            cborRequest({id: 2, main: "__i__Main::main", args: [5]})
+        ]),
+        check: (stdout: Buffer) => {
+            const resps = cborResponses(stdout);
+            if(resps.length !== 2) {
+                return `expected 2 responses but got ${resps.length}`;
+            }
+            return checkResponse(resps[0], 1, "failure", undefined, /x must be positive/) || checkResponse(resps[1], 2, "success", 6);
+        }
+    },
+    {
+        name: "cbor output",
+        args: ["--cbor", "--main", "Main::echoMap", fixture, JSON.stringify([[[2, 20], [1, 10]]])],
+        input: "",
+        check: (stdout: Buffer) => {
+            const pos = {i: 0};
+            const resp = cborDecode(stdout, pos);
+            if(pos.i !== stdout.length) {
+                return `expected a single CBOR item but got ${stdout.length - pos.i} trailing bytes`;
+            }
+            return checkResponse({...resp, id: 0}, 0, "success", [[1, 10], [2, 20]]);
+        }
+    },
+    parityTest("cbor argument file", "Main::echoList", [[1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12]], true, "cbor"),
+    parityTest("cbor argument file reject", "Main::echoPt", [{"x": 1}], false, "cbor"),
+    parityTest("list over one chunk", "Main::echoList", [[1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17]], true),
+    parityTest("list bad element", "Main::echoList", [[1, 2, 3, 4, 5, 6, 7, 8, 9, "ten"]], false),
+    parityTest("map", "Main::echoMap", [[[3, 30], [1, 10], [2, 20]]], true),
+    parityTest("map duplicate key", "Main::echoMap", [[[1, 10], [2, 20], [1, 30]]], false),
+    parityTest("union tagged object", "Main::echoPtOpt", [{"__type_tag__": "Main::Pt", "x": 1, "y": 2}], true),
+    parityTest("union tagged object unknown tag", "Main::echoPtOpt", [{"__type_tag__": "Main::Qt", "x": 1, "y": 2}], false),
+    parityTest("union untagged object", "Main::echoPtOpt", [{"x": 1, "y": 2}], false),
+    parityTest("union pair", "Main::echoOpt", [["Int", 3]], true),
+    parityTest("entity name value pair", "Main::echoPt", [["Main::Pt", {"x": 1, "y": 2}]], true),
+    parityTest("entity object", "Main::echoPt", [{"x": 1, "y": 2}], true),
+    parityTest("entity missing field", "Main::echoPt", [{"x": 1}], false),
+    parityTest("large string", "Main::echoStr", [sampleText(100000)], true)
+];
+
+function runTest(t: ModeTest): boolean {
+    const start = new Date();
+    const {stdout, stderr} = runIcpp(t.args, t.input, t.env);
+    const end = new Date();
+
+    let err: string | undefined = undefined;
+    try {
+        err = t.check(stdout, stderr);
+    }
+    catch(ex) {
+        err = `could not read the output -- ${stdout.toString()}`;
+    }
+
+    if(err !== undefined) {
+        process.stdout.write(chalk.red(`Failed ${t.name} -- ${err}\n`));
+        return false;
+    }
+
+    process.stdout.write(`${chalk.green("Passed")} ${t.name} (${(end.getTime() - start.getTime()) / 1000} seconds)\n`);
+    return true;
+}
+
+let passcount = 0;
+for(let i = 0; i < s_mode_tests.length; ++i) {
+    if(runTest(s_mode_tests[i])) {
+        passcount++;
+    }
+}
+
+if(passcount === s_mode_tests.length) {
+    process.stdout.write(chalk.green(`\nAll icpp mode tests passed!\n`));
+    process.exit(0);
+}
+else {
+    process.stdout.write(chalk.red(`\n${s_mode_tests.length - passcount} icpp mode tests failed!\n`));
+    process.exit(1);
+}
@@ -573,6 +573,17 @@ std::optional<APIISOTimeStamp> JSONParseHelper::parseToISOTimeStamp(json j)
 
 std::optional<std::vector<uint8_t>> JSONParseHelper::parseUUID4(json j)
 {
+    //binary encodings (CBOR/MessagePack) carry the raw bytes
+    if(j.is_binary())
+    {
+        if(j.get_binary().size() != 16)
+        {
+            return std::nullopt;
+        }
+
+        return std::make_optional(std::vector<uint8_t>(j.get_binary().cbegin(), j.get_binary().cend()));
+    }
+
     if(!j.is_string())
     {
         return std::nullopt;
@@ -605,6 +616,17 @@ std::optional<std::vector<uint8_t>> JSONParseHelper::parseUUID4(json j)
 
 std::optional<std::vector<uint8_t>> JSONParseHelper::parseUUID7(json j)
 {
+    //binary encodings (CBOR/MessagePack) carry the raw bytes
+    if(j.is_binary())
+    {
+        if(j.get_binary().size() != 16)
+        {
+            return std::nullopt;
+        }
+
+        return std::make_optional(std::vector<uint8_t>(j.get_binary().cbegin(), j.get_binary().cend()));
+    }
+
     if(!j.is_string())
     {
         return std::nullopt;
@@ -637,6 +659,17 @@ std::optional<std::vector<uint8_t>> JSONParseHelper::parseUUID7(json j)
 
 std::optional<std::vector<uint8_t>> JSONParseHelper::parseSHAContentHash(json j)
 {
+    //binary encodings (CBOR/MessagePack) carry the raw bytes
+    if(j.is_binary())
+    {
+        if(j.get_binary().size() != 64)
+        {
+            return std::nullopt;
+        }
+
+        return std::make_optional(std::vector<uint8_t>(j.get_binary().cbegin(), j.get_binary().cend()));
+    }
+
     if(!j.is_string())
     {
         return std::nullopt;
@@ -959,25 +992,27 @@ APIModule::~APIModule()
 
 std::vector<const IType*> APIModule::getAllTypesInUnion(const UnionType* tt) const
 {
-    std::vector<const IType*> res;
-    std::for_each(tt->opts.cbegin(), tt->opts.cend(), [this, &res](const std::string& ttname) {
-        const IType* opttt = this->typemap.find(ttname)->second;
-        assert(!opttt->isUnion());
-
-        res.push_back(opttt);
-    });
-
-    return res;
+    assert(std::none_of(tt->optrefs.cbegin(), tt->optrefs.cend(), [](const IType* opttt) { return opttt->isUnion(); }));
+    return tt->optrefs;
 }
 
 APIModule* APIModule::jparse(json j)
 {
     std::map<std::string, const IType*> typemap;
+    std::vector<IType*> alltypes;
     auto japitypes = j["apitypes"];
     for (size_t i = 0; i < japitypes.size(); ++i)
     {
         auto val = IType::jparse(japitypes[i]);
         typemap[val->name] = val;
+        alltypes.push_back(val);
+    }
+
+    //resolve all the type references up front so the parse/extract walks are just pointer chasing
+    for (size_t i = 0; i < alltypes.size(); ++i)
+    {
+        alltypes[i]->planid = i;
+        alltypes[i]->resolvePlan(typemap);
     }
 
     std::map<std::string, std::string> typedeclmap;
@@ -184,6 +184,7 @@ public:
     virtual bool parseFloatImpl(const APIModule* apimodule, const IType* itype, std::string f, ValueRepr value, State& ctx) = 0;
     virtual bool parseDecimalImpl(const APIModule* apimodule, const IType* itype, std::string d, ValueRepr value, State& ctx) = 0;
     virtual bool parseRationalImpl(const APIModule* apimodule, const IType* itype, std::string n, uint64_t d, ValueRepr value, State& ctx) = 0;
+    //The string and byte payloads are handed over -- a manager may keep (move) them as the backing store of the parsed value
     virtual bool parseStringImpl(const APIModule* apimodule, const IType* itype, std::string s, ValueRepr value, State& ctx) = 0;
     virtual bool parseByteBufferImpl(const APIModule* apimodule, const IType* itype, uint8_t compress, uint8_t format, std::vector<uint8_t>& data, ValueRepr value, State& ctx) = 0;
     virtual bool parseDateTimeImpl(const APIModule* apimodule, const IType* itype, APIDateTime t, ValueRepr value, State& ctx) = 0;
@@ -202,8 +203,9 @@ public:
     virtual ValueRepr getValueForTupleIndex(const APIModule* apimodule, const IType* itype, ValueRepr value, size_t i, State& ctx) = 0;
     virtual void completeParseTuple(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) = 0;
 
+    //pidx/fidx are positions in the props/consfields of the record/entity type
     virtual void prepareParseRecord(const APIModule* apimodule, const IType* itype, State& ctx) = 0;
-    virtual ValueRepr getValueForRecordProperty(const APIModule* apimodule, const IType* itype, ValueRepr value, std::string pname, State& ctx) = 0;
+    virtual ValueRepr getValueForRecordProperty(const APIModule* apimodule, const IType* itype, ValueRepr value, size_t pidx, State& ctx) = 0;
     virtual void completeParseRecord(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) = 0;
 
     virtual void prepareParseContainer(const APIModule* apimodule, const IType* itype, ValueRepr value, size_t count, State& ctx) = 0;
@@ -211,9 +213,16 @@ public:
     virtual std::pair<ValueRepr, ValueRepr> getValueForContainerElementParse_KV(const APIModule* apimodule, const IType* itype, ValueRepr value, size_t i, State& ctx) = 0;
     virtual void completeParseContainer(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) = 0;
 
+    //Containers where the element count is not known until the end (streaming parse) -- managers that do not support this just fail the parse
+    virtual bool prepareParseContainerIncremental(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) { return false; }
+    virtual ValueRepr getValueForContainerElementParseIncremental_T(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) { return value; }
+    virtual std::pair<ValueRepr, ValueRepr> getValueForContainerElementParseIncremental_KV(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) { return std::make_pair(value, value); }
+    virtual bool completeContainerElementParseIncremental(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) { return false; }
+    virtual bool completeParseContainerIncremental(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) { return false; }
+
     virtual void prepareParseEntity(const APIModule* apimodule, const IType* itype, State& ctx) = 0;
     virtual void prepareParseEntityMask(const APIModule* apimodule, const IType* itype, State& ctx) = 0;
-    virtual ValueRepr getValueForEntityField(const APIModule* apimodule, const IType* itype, ValueRepr value, std::pair<std::string, std::string> fnamefkey, State& ctx) = 0;
+    virtual ValueRepr getValueForEntityField(const APIModule* apimodule, const IType* itype, ValueRepr value, size_t fidx, State& ctx) = 0;
     virtual void completeParseEntity(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) = 0;
 
     virtual void setMaskFlag(const APIModule* apimodule, ValueRepr flagloc, size_t i, bool flag, State& ctx) = 0;
@@ -243,8 +252,8 @@ public:
     virtual std::optional<std::pair<float, float>> extractLatLongCoordinateImpl(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) = 0;
     
     virtual ValueRepr extractValueForTupleIndex(const APIModule* apimodule, const IType* itype, ValueRepr value, size_t i, State& ctx) = 0;
-    virtual ValueRepr extractValueForRecordProperty(const APIModule* apimodule, const IType* itype, ValueRepr value, std::string pname, State& ctx) = 0;
-    virtual ValueRepr extractValueForEntityField(const APIModule* apimodule, const IType* itype, ValueRepr value, std::pair<std::string, std::string> fnamefkey, State& ctx) = 0;
+    virtual ValueRepr extractValueForRecordProperty(const APIModule* apimodule, const IType* itype, ValueRepr value, size_t pidx, State& ctx) = 0;
+    virtual ValueRepr extractValueForEntityField(const APIModule* apimodule, const IType* itype, ValueRepr value, size_t fidx, State& ctx) = 0;
 
     virtual void prepareExtractContainer(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) = 0;
     virtual std::optional<size_t> extractLengthForContainer(const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx) = 0;
@@ -300,17 +309,49 @@ public:
     static std::optional<std::pair<std::string, std::string>> checkEnumName(json j);
 };
 
+//Field order for a streamed object -- json objects are key sorted so the output is the same as dumping the extracted DOM
+template <typename NameFn>
+std::vector<size_t> streamFieldOrder(size_t count, NameFn fname)
+{
+    std::vector<size_t> order;
+    for(size_t i = 0; i < count; ++i)
+    {
+        order.push_back(i);
+    }
+
+    std::sort(order.begin(), order.end(), [&fname](size_t a, size_t b) {
+        return fname(a) < fname(b);
+    });
+
+    return order;
+}
+
 class IType
 {
 public:
     const TypeTag tag;
     const std::string name;
 
-    IType(TypeTag tag, std::string name) : tag(tag), name(name) {;}
+    //Dense index of this type in its APIModule -- backends key their precomputed marshalling plans on it
+    size_t planid;
+
+    IType(TypeTag tag, std::string name) : tag(tag), name(name), planid(0) {;}
     virtual ~IType() {;}
 
     static IType* jparse(json j);
 
+    //Resolve the names of the component types to their decls -- called once when the APIModule is loaded so parse/extract never search the typemap
+    virtual void resolvePlan(const std::map<std::string, const IType*>& typemap)
+    {
+        ;
+    }
+
+    static const IType* resolveTypeRef(const std::map<std::string, const IType*>& typemap, const std::string& tname)
+    {
+        auto ii = typemap.find(tname);
+        return ii != typemap.cend() ? ii->second : nullptr;
+    }
+
     virtual bool isUnion() const
     {
         return false;
@@ -319,7 +360,7 @@ public:
     virtual json jfuzz(const APIModule* apimodule, RandGenerator& rnd) const = 0;
 
     template <typename ValueRepr, typename State>
-    bool tparse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const;
+    bool tparse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const;
 
     template <typename ValueRepr, typename State>
     std::optional<json> textract(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, ValueRepr value, State& ctx) const;
@@ -349,7 +390,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         if(!j.is_null())
         {
@@ -383,7 +424,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         if(!j.is_null())
         {
@@ -418,7 +459,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         if(!j.is_boolean())
         {
@@ -453,7 +494,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         std::optional<uint64_t> nval = JSONParseHelper::parseToUnsignedNumber(j);
         if(!nval.has_value())
@@ -495,7 +536,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         std::optional<int64_t> nval = JSONParseHelper::parseToSignedNumber(j);
         if(!nval.has_value())
@@ -537,7 +578,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         std::optional<std::string> nval = JSONParseHelper::parseToBigUnsignedNumber(j);
         if(!nval.has_value())
@@ -579,7 +620,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         std::optional<std::string> nval = JSONParseHelper::parseToBigSignedNumber(j);
         if(!nval.has_value())
@@ -623,7 +664,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         std::optional<std::pair<std::string, uint64_t>> nval = JSONParseHelper::parseToRationalNumber(j);
         if(!nval.has_value())
@@ -666,7 +707,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         std::optional<std::string> nval = JSONParseHelper::parseToRealNumber(j);
         if(!nval.has_value())
@@ -709,7 +750,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         std::optional<std::string> nval = JSONParseHelper::parseToRealNumber(j);
         if(!nval.has_value())
@@ -762,7 +803,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         if(!j.is_string())
         {
@@ -805,7 +846,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         if(!j.is_string())
         {
@@ -821,7 +862,7 @@ public:
             return false;
         }
         
-        return apimgr.parseStringImpl(apimodule, this, sstr, value, ctx);
+        return apimgr.parseStringImpl(apimodule, this, std::move(sstr), value, ctx);
     }
 
     template <typename ValueRepr, typename State>
@@ -837,9 +878,16 @@ public:
     const std::string oftype;
     const std::string chkinv;
 
-    DataStringType(std::string name, std::string oftype, std::string chkinv) : IGroundedType(TypeTag::DataStringTag, name), oftype(oftype), chkinv(chkinv) {;}
+    const IType* basetyperef;
+
+    DataStringType(std::string name, std::string oftype, std::string chkinv) : IGroundedType(TypeTag::DataStringTag, name), oftype(oftype), chkinv(chkinv), basetyperef(nullptr) {;}
     virtual ~DataStringType() {;}
 
+    virtual void resolvePlan(const std::map<std::string, const IType*>& typemap) override final
+    {
+        this->basetyperef = IType::resolveTypeRef(typemap, "String");
+    }
+
     static DataStringType* jparse(json j)
     {
         auto name = j["name"].get<std::string>();
@@ -855,9 +903,9 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
-        bool okparse = apimodule->typemap.find("String")->second->tparse(apimgr, apimodule, j, value, ctx);
+        bool okparse = this->basetyperef->tparse(apimgr, apimodule, j, value, ctx);
         if(!okparse)
         {
             return false;
@@ -869,7 +917,7 @@ public:
     template <typename ValueRepr, typename State>
     std::optional<json> extract(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, ValueRepr value, State& ctx) const
     {
-        return apimodule->typemap.find("String")->second->textract(apimgr, apimodule, value, ctx);
+        return this->basetyperef->textract(apimgr, apimodule, value, ctx);
     }
 };
 
@@ -902,17 +950,35 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
-        auto jdata = j["data"];
-        auto jcompress = j["compress"];
-        auto jformat = j["format"];
-        if(!jdata.is_array() || !jcompress.is_number_unsigned() || j.get<uint8_t>() >= 2 || !jformat.is_number_unsigned() || jformat.get<uint8_t>() >= 4)
+        if(!j.is_object())
+        {
+            return false;
+        }
+
+        if(!j.contains("data") || !j.contains("compress") || !j.contains("format"))
+        {
+            return false;
+        }
+
+        const json& jdata = j["data"];
+        const json& jcompress = j["compress"];
+        const json& jformat = j["format"];
+        if(!(jdata.is_array() || jdata.is_binary()) || !jcompress.is_number_unsigned() || jcompress.get<uint8_t>() >= 2 || !jformat.is_number_unsigned() || jformat.get<uint8_t>() >= 4)
         {
             return false;
         }
 
+        //binary encodings (CBOR/MessagePack) carry the raw bytes -- this is the only copy, the manager may keep the vector contents as the value
+        if(jdata.is_binary())
+        {
+            std::vector<uint8_t> bbuff(jdata.get_binary().cbegin(), jdata.get_binary().cend());
+            return apimgr.parseByteBufferImpl(apimodule, this, jcompress.get<uint8_t>(), jformat.get<uint8_t>(), bbuff, value, ctx);
+        }
+
         std::vector<uint8_t> bbuff;
+        bbuff.reserve(jdata.size());
         bool badval = false;
         std::transform(jdata.cbegin(), jdata.cend(), std::back_inserter(bbuff), [&badval](const json& vv) {
             if(!vv.is_number_unsigned() || vv.get<uint64_t>() >= 256)
@@ -958,9 +1024,16 @@ public:
     const std::string oftype;
     const std::string chkinv;
 
-    DataBufferType(std::string name, std::string oftype, std::string chkinv) : IGroundedType(TypeTag::DataBufferTag, name), oftype(oftype), chkinv(chkinv) {;}
+    const IType* basetyperef;
+
+    DataBufferType(std::string name, std::string oftype, std::string chkinv) : IGroundedType(TypeTag::DataBufferTag, name), oftype(oftype), chkinv(chkinv), basetyperef(nullptr) {;}
     virtual ~DataBufferType() {;}
 
+    virtual void resolvePlan(const std::map<std::string, const IType*>& typemap) override final
+    {
+        this->basetyperef = IType::resolveTypeRef(typemap, "ByteBuffer");
+    }
+
     static DataBufferType* jparse(json j)
     {
         auto name = j["name"].get<std::string>();
@@ -976,9 +1049,9 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
-        bool okparse = apimodule->typemap.find("ByteBuffer")->second->tparse(apimgr, apimodule, j, value, ctx);
+        bool okparse = this->basetyperef->tparse(apimgr, apimodule, j, value, ctx);
         if(!okparse)
         {
             return false;
@@ -990,7 +1063,7 @@ public:
     template <typename ValueRepr, typename State>
     std::optional<json> extract(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, ValueRepr value, State& ctx) const
     {
-        return apimodule->typemap.find("ByteBuffer")->second->textract(apimgr, apimodule, value, ctx);
+        return this->basetyperef->textract(apimgr, apimodule, value, ctx);
     }
 };
 
@@ -1018,7 +1091,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto t = JSONParseHelper::parseToDateTime(j);
         if(!t.has_value())
@@ -1066,7 +1139,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto t = JSONParseHelper::parseToUTCDateTime(j);
         if(!t.has_value())
@@ -1114,7 +1187,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto t = JSONParseHelper::parseToCalendarDate(j);
         if(!t.has_value())
@@ -1162,7 +1235,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto t = JSONParseHelper::parseToRelativeTime(j);
         if(!t.has_value())
@@ -1204,7 +1277,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto t = JSONParseHelper::parseToTickTime(j);
         if(!t.has_value())
@@ -1246,7 +1319,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto t = JSONParseHelper::parseToLogicalTime(j);
         if(!t.has_value())
@@ -1294,7 +1367,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto t = JSONParseHelper::parseToISOTimeStamp(j);
         if(!t.has_value())
@@ -1349,7 +1422,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto uuid = JSONParseHelper::parseUUID4(j);
         if(!uuid.has_value())
@@ -1404,7 +1477,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto uuid = JSONParseHelper::parseUUID7(j);
         if(!uuid.has_value())
@@ -1459,7 +1532,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto hash = JSONParseHelper::parseSHAContentHash(j);
         if(!hash.has_value())
@@ -1514,7 +1587,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto llv = JSONParseHelper::parseLatLongCoordinate(j);
         if(!llv.has_value())
@@ -1544,9 +1617,16 @@ public:
     const std::string oftype;
     const std::optional<std::string> validatefunc; 
 
-    ConstructableOfType(std::string name, std::string oftype, std::optional<std::string> validatefunc) : IGroundedType(TypeTag::ConstructableOfType, name), oftype(oftype), validatefunc(validatefunc) {;}
+    const IType* oftyperef;
+
+    ConstructableOfType(std::string name, std::string oftype, std::optional<std::string> validatefunc) : IGroundedType(TypeTag::ConstructableOfType, name), oftype(oftype), validatefunc(validatefunc), oftyperef(nullptr) {;}
     virtual ~ConstructableOfType() {;}
 
+    virtual void resolvePlan(const std::map<std::string, const IType*>& typemap) override final
+    {
+        this->oftyperef = IType::resolveTypeRef(typemap, this->oftype);
+    }
+
     static ConstructableOfType* jparse(json j)
     {
         auto name = j["name"].get<std::string>();
@@ -1562,9 +1642,9 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
-        bool okparse = apimodule->typemap.find(this->oftype)->second->tparse(apimgr, apimodule, j, value, ctx);
+        bool okparse = this->oftyperef->tparse(apimgr, apimodule, j, value, ctx);
         if(!okparse)
         {
             return false;
@@ -1576,7 +1656,7 @@ public:
     template <typename ValueRepr, typename State>
     std::optional<json> extract(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, ValueRepr value, State& ctx) const
     {
-        return apimodule->typemap.find(this->oftype)->second->textract(apimgr, apimodule, value, ctx);
+        return this->oftyperef->textract(apimgr, apimodule, value, ctx);
     }
 };
 
@@ -1585,9 +1665,18 @@ class TupleType : public IGroundedType
 public:
     const std::vector<std::string> ttypes;
 
-    TupleType(std::string name, std::vector<std::string> ttypes) : IGroundedType(TypeTag::TupleTag, name), ttypes(ttypes) {;}
+    std::vector<const IType*> ttyperefs;
+
+    TupleType(std::string name, std::vector<std::string> ttypes) : IGroundedType(TypeTag::TupleTag, name), ttypes(ttypes), ttyperefs() {;}
     virtual ~TupleType() {;}
 
+    virtual void resolvePlan(const std::map<std::string, const IType*>& typemap) override final
+    {
+        std::transform(this->ttypes.cbegin(), this->ttypes.cend(), std::back_inserter(this->ttyperefs), [&typemap](const std::string& tt) {
+            return IType::resolveTypeRef(typemap, tt);
+        });
+    }
+
     static TupleType* jparse(json j)
     {
         auto name = j["name"].get<std::string>();
@@ -1616,7 +1705,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         if(!j.is_array() || this->ttypes.size() != j.size())
         {
@@ -1626,7 +1715,7 @@ public:
         apimgr.prepareParseTuple(apimodule, this, ctx);
         for(size_t i = 0; i < this->ttypes.size(); ++i)
         {
-            auto tt = apimodule->typemap.find(this->ttypes[i])->second;
+            auto tt = this->ttyperefs[i];
 
             ValueRepr vval = apimgr.getValueForTupleIndex(apimodule, this, value, i, ctx);
             bool ok = tt->tparse(apimgr, apimodule, j[i], vval, ctx);
@@ -1646,7 +1735,7 @@ public:
         auto jres = json::array();
         for(size_t i = 0; i < this->ttypes.size(); ++i)
         {
-            auto tt = apimodule->typemap.find(this->ttypes[i])->second;
+            auto tt = this->ttyperefs[i];
 
             ValueRepr vval = apimgr.extractValueForTupleIndex(apimodule, this, value, i, ctx);
             auto rr = tt->textract(apimgr, apimodule, vval, ctx);
@@ -1668,9 +1757,21 @@ public:
     const std::vector<std::string> props;
     const std::vector<std::string> ttypes;
 
-    RecordType(std::string name, std::vector<std::string> props, std::vector<std::string> ttypes) : IGroundedType(TypeTag::RecordTag, name), props(props), ttypes(ttypes) {;}
+    std::vector<const IType*> ttyperefs;
+    std::vector<size_t> streamorder;
+
+    RecordType(std::string name, std::vector<std::string> props, std::vector<std::string> ttypes) : IGroundedType(TypeTag::RecordTag, name), props(props), ttypes(ttypes), ttyperefs(), streamorder() {;}
     virtual ~RecordType() {;}
 
+    virtual void resolvePlan(const std::map<std::string, const IType*>& typemap) override final
+    {
+        std::transform(this->ttypes.cbegin(), this->ttypes.cend(), std::back_inserter(this->ttyperefs), [&typemap](const std::string& tt) {
+            return IType::resolveTypeRef(typemap, tt);
+        });
+
+        this->streamorder = streamFieldOrder(this->props.size(), [this](size_t i) { return this->props[i]; });
+    }
+
     static RecordType* jparse(json j)
     {
         auto name = j["name"].get<std::string>();
@@ -1705,7 +1806,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         if(!j.is_object() || this->props.size() != j.size())
         {
@@ -1723,9 +1824,9 @@ public:
         apimgr.prepareParseRecord(apimodule, this, ctx);
         for(size_t i = 0; i < this->ttypes.size(); ++i)
         {
-            auto tt = apimodule->typemap.find(this->ttypes[i])->second;
+            auto tt = this->ttyperefs[i];
 
-            ValueRepr vval = apimgr.getValueForRecordProperty(apimodule, this, value, this->props[i], ctx);
+            ValueRepr vval = apimgr.getValueForRecordProperty(apimodule, this, value, i, ctx);
             bool ok = tt->tparse(apimgr, apimodule, j[this->props[i]], vval, ctx);
             if(!ok)
             {
@@ -1743,9 +1844,9 @@ public:
         auto jres = json::object();
         for(size_t i = 0; i < this->ttypes.size(); ++i)
         {
-            auto tt = apimodule->typemap.find(this->ttypes[i])->second;
+            auto tt = this->ttyperefs[i];
 
-            ValueRepr vval = apimgr.extractValueForRecordProperty(apimodule, this, value, this->props[i], ctx);
+            ValueRepr vval = apimgr.extractValueForRecordProperty(apimodule, this, value, i, ctx);
             auto rr = tt->textract(apimgr, apimodule, vval, ctx);
             if(!rr.has_value())
             {
@@ -1773,9 +1874,16 @@ public:
     const ContainerCategory category;
     const std::string elemtype;
 
-    ContainerTType(std::string name, ContainerCategory category, std::string elemtype) : IGroundedType(TypeTag::ContainerTTag, name), category(category), elemtype(elemtype) {;}
+    const IType* elemtyperef;
+
+    ContainerTType(std::string name, ContainerCategory category, std::string elemtype) : IGroundedType(TypeTag::ContainerTTag, name), category(category), elemtype(elemtype), elemtyperef(nullptr) {;}
     virtual ~ContainerTType() {;}
 
+    virtual void resolvePlan(const std::map<std::string, const IType*>& typemap) override final
+    {
+        this->elemtyperef = IType::resolveTypeRef(typemap, this->elemtype);
+    }
+
     static ContainerTType* jparse(json j)
     {
         auto name = j["name"].get<std::string>();
@@ -1801,15 +1909,31 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         if(!j.is_array())
         {
             return false;
         }
 
+        auto tt = this->elemtyperef;
+
+        //use the same element at a time construction as the streaming parser when the manager has it so both accept (and build) the same values
+        if(apimgr.prepareParseContainerIncremental(apimodule, this, value, ctx))
+        {
+            for(size_t i = 0; i < j.size(); ++i)
+            {
+                ValueRepr vval = apimgr.getValueForContainerElementParseIncremental_T(apimodule, this, value, ctx);
+                if(!tt->tparse(apimgr, apimodule, j[i], vval, ctx) || !apimgr.completeContainerElementParseIncremental(apimodule, this, value, ctx))
+                {
+                    return false;
+                }
+            }
+
+            return apimgr.completeParseContainerIncremental(apimodule, this, value, ctx);
+        }
+
         apimgr.prepareParseContainer(apimodule, this, value, j.size(), ctx);
-        auto tt = apimodule->typemap.find(this->elemtype)->second;
         for(size_t i = 0; i < j.size(); ++i)
         {
             ValueRepr vval = apimgr.getValueForContainerElementParse_T(apimodule, this, value, i, ctx);
@@ -1835,7 +1959,7 @@ public:
         }
 
         auto jres = json::array();
-        auto tt = apimodule->typemap.find(this->elemtype)->second;
+        auto tt = this->elemtyperef;
         for(size_t i = 0; i < clen.value(); ++i)
         {
             ValueRepr vval = apimgr.extractValueForContainer_T(apimodule, this, value, i, ctx);
@@ -1859,9 +1983,18 @@ public:
     const std::string ktype;
     const std::string vtype;
 
-    ContainerKVType(std::string name, std::string ktype, std::string vtype) : IGroundedType(TypeTag::ContainerKVTag, name), ktype(ktype), vtype(vtype) {;}
+    const IType* ktyperef;
+    const IType* vtyperef;
+
+    ContainerKVType(std::string name, std::string ktype, std::string vtype) : IGroundedType(TypeTag::ContainerKVTag, name), ktype(ktype), vtype(vtype), ktyperef(nullptr), vtyperef(nullptr) {;}
     virtual ~ContainerKVType() {;}
 
+    virtual void resolvePlan(const std::map<std::string, const IType*>& typemap) override final
+    {
+        this->ktyperef = IType::resolveTypeRef(typemap, this->ktype);
+        this->vtyperef = IType::resolveTypeRef(typemap, this->vtype);
+    }
+
     static ContainerKVType* jparse(json j)
     {
         auto name = j["name"].get<std::string>();
@@ -1890,16 +2023,44 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         if(!j.is_array())
         {
             return false;
         }
 
+        auto kt = this->ktyperef;
+        auto vt = this->vtyperef;
+        for(size_t i = 0; i < j.size(); ++i)
+        {
+            if(!j[i].is_array() || j[i].size() != 2)
+            {
+                return false;
+            }
+        }
+
+        //the incremental path is also where duplicate keys are rejected
+        if(apimgr.prepareParseContainerIncremental(apimodule, this, value, ctx))
+        {
+            for(size_t i = 0; i < j.size(); ++i)
+            {
+                std::pair<ValueRepr, ValueRepr> vval = apimgr.getValueForContainerElementParseIncremental_KV(apimodule, this, value, ctx);
+                if(!kt->tparse(apimgr, apimodule, j[i][0], vval.first, ctx) || !vt->tparse(apimgr, apimodule, j[i][1], vval.second, ctx))
+                {
+                    return false;
+                }
+
+                if(!apimgr.completeContainerElementParseIncremental(apimodule, this, value, ctx))
+                {
+                    return false;
+                }
+            }
+
+            return apimgr.completeParseContainerIncremental(apimodule, this, value, ctx);
+        }
+
         apimgr.prepareParseContainer(apimodule, this, value, j.size(), ctx);
-        auto kt = apimodule->typemap.find(this->ktype)->second;
-        auto vt = apimodule->typemap.find(this->vtype)->second;
         for(size_t i = 0; i < j.size(); ++i)
         {
             std::pair<ValueRepr, ValueRepr> vval = apimgr.getValueForContainerElementParse_KV(apimodule, this, value, i, ctx);
@@ -1926,8 +2087,8 @@ public:
         }
 
         auto jres = json::array();
-        auto kt = apimodule->typemap.find(this->ktype)->second;
-        auto vt = apimodule->typemap.find(this->vtype)->second;
+        auto kt = this->ktyperef;
+        auto vt = this->vtyperef;
         for(size_t i = 0; i < clen.value(); ++i)
         {
             std::pair<ValueRepr, ValueRepr> vval = apimgr.extractValueForContainer_KV(apimodule, this, value, i, ctx);
@@ -1973,7 +2134,7 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
         auto nstrinfo = JSONParseHelper::checkEnumName(j);
         if(!nstrinfo.has_value())
@@ -2021,9 +2182,27 @@ public:
     const std::optional<std::string> validatefunc; //key
     const std::optional<std::string> consfunc; //key
 
-    EntityType(std::string name, std::vector<std::pair<std::string, std::string>> consfields, std::vector<std::pair<std::string, bool>> ttypes, std::optional<std::string> validatefunc, std::optional<std::string> consfunc) : IGroundedType(TypeTag::EntityTag, name), consfields(consfields), ttypes(ttypes), validatefunc(validatefunc), consfunc(consfunc) {;}
+    std::vector<const IType*> ttyperefs;
+    std::vector<size_t> streamorder;
+    size_t firstoptidx; //index of the first optional field -- mask flags are numbered from here
+
+    EntityType(std::string name, std::vector<std::pair<std::string, std::string>> consfields, std::vector<std::pair<std::string, bool>> ttypes, std::optional<std::string> validatefunc, std::optional<std::string> consfunc) : IGroundedType(TypeTag::EntityTag, name), consfields(consfields), ttypes(ttypes), validatefunc(validatefunc), consfunc(consfunc), ttyperefs(), streamorder(), firstoptidx(0) {;}
     virtual ~EntityType() {;}
 
+    virtual void resolvePlan(const std::map<std::string, const IType*>& typemap) override final
+    {
+        std::transform(this->ttypes.cbegin(), this->ttypes.cend(), std::back_inserter(this->ttyperefs), [&typemap](const std::pair<std::string, bool>& tentry) {
+            return IType::resolveTypeRef(typemap, tentry.first);
+        });
+
+        auto firstoptpos = std::find_if(this->ttypes.cbegin(), this->ttypes.cend(), [](const std::pair<std::string, bool>& tentry) {
+            return tentry.second;
+        });
+        this->firstoptidx = (size_t)std::distance(this->ttypes.cbegin(), firstoptpos);
+
+        this->streamorder = streamFieldOrder(this->consfields.size(), [this](size_t i) { return this->consfields[i].first; });
+    }
+
     static EntityType* jparse(json j)
     {
         auto name = j["name"].get<std::string>();
@@ -2058,17 +2237,19 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& jv, ValueRepr value, State& ctx) const
     {
-        if(j.is_array() && j.size() == 2 && j[0].is_string())
+        const json* jp = &jv;
+        if(jv.is_array() && jv.size() == 2 && jv[0].is_string())
         {
-            if(j[0].get<std::string>() != this->name)
+            if(jv[0].get<std::string>() != this->name)
             {
                 return false;
             }
-            j = j[1];
+            jp = &jv[1];
         }
 
+        const json& j = *jp;
         if(!j.is_object())
         {
             return false;
@@ -2082,7 +2263,7 @@ public:
             }
 
             auto fpos = std::find_if(this->consfields.cbegin(), this->consfields.cend(), [&fkey](const std::pair<std::string, std::string>& fnamekey) {
-                return fnamekey.second == fkey;
+                return fnamekey.first == fkey;
             });
 
             if(fpos == this->consfields.cend())
@@ -2091,11 +2272,6 @@ public:
             }
         }
 
-        auto firstoptpos = std::find_if(this->ttypes.cbegin(), this->ttypes.cend(), [](const std::pair<std::string, bool>& tentry) {
-            return tentry.second;
-        });
-        auto firstoptdist = std::distance(this->ttypes.cbegin(), firstoptpos);
-
         apimgr.prepareParseEntity(apimodule, this, ctx);
         apimgr.prepareParseEntityMask(apimodule, this, ctx);
         for(size_t i = 0; i < this->consfields.size(); ++i)
@@ -2109,13 +2285,13 @@ public:
                     return false;
                 }
 
-                apimgr.setMaskFlag(apimodule, value, i - firstoptdist, false, ctx);
+                apimgr.setMaskFlag(apimodule, value, i - this->firstoptidx, false, ctx);
             }
             else
             {
-                auto tt = apimodule->typemap.find(this->ttypes[i].first)->second;
+                auto tt = this->ttyperefs[i];
 
-                ValueRepr vval = apimgr.getValueForEntityField(apimodule, this, value, this->consfields[i], ctx);
+                ValueRepr vval = apimgr.getValueForEntityField(apimodule, this, value, i, ctx);
                 bool ok = tt->tparse(apimgr, apimodule, j[fname], vval, ctx);
                 if(!ok)
                 {
@@ -2124,7 +2300,7 @@ public:
 
                 if(this->ttypes[i].second)
                 {
-                    apimgr.setMaskFlag(apimodule, value, i - firstoptdist, true, ctx);
+                    apimgr.setMaskFlag(apimodule, value, i - this->firstoptidx, true, ctx);
                 }
             }
         }
@@ -2139,9 +2315,9 @@ public:
         auto jres = json::object();
         for(size_t i = 0; i < this->ttypes.size(); ++i)
         {
-            auto tt = apimodule->typemap.find(this->ttypes[i].first)->second;
+            auto tt = this->ttyperefs[i];
 
-            ValueRepr vval = apimgr.extractValueForEntityField(apimodule, this, value, this->consfields[i], ctx);
+            ValueRepr vval = apimgr.extractValueForEntityField(apimodule, this, value, i, ctx);
             auto rr = tt->textract(apimgr, apimodule, vval, ctx);
             if(!rr.has_value())
             {
@@ -2160,9 +2336,24 @@ class UnionType : public IType
 public:
     const std::vector<std::string> opts;
 
-    UnionType(std::string name, std::vector<std::string> opts) : IType(TypeTag::UnionTag, name), opts(opts) {;}
+    std::vector<const IType*> optrefs;
+
+    UnionType(std::string name, std::vector<std::string> opts) : IType(TypeTag::UnionTag, name), opts(opts), optrefs() {;}
     virtual ~UnionType() {;}
 
+    virtual void resolvePlan(const std::map<std::string, const IType*>& typemap) override final
+    {
+        std::transform(this->opts.cbegin(), this->opts.cend(), std::back_inserter(this->optrefs), [&typemap](const std::string& tt) {
+            return IType::resolveTypeRef(typemap, tt);
+        });
+    }
+
+    //Position of the named option in opts (== opts.size() if it is not an option of this union)
+    size_t findOptionIndex(const std::string& tname) const
+    {
+        return (size_t)std::distance(this->opts.cbegin(), std::find(this->opts.cbegin(), this->opts.cend(), tname));
+    }
+
     static UnionType* jparse(json j)
     {
         auto name = j["name"].get<std::string>();
@@ -2193,75 +2384,50 @@ public:
     }
 
     template <typename ValueRepr, typename State>
-    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+    bool parse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
     {
-        auto opttypes = apimodule->getAllTypesInUnion(this);
-
+        std::string tname;
         if(j.is_object())
         {
-            auto typetagref = j["__type_tag__"];
-            if(!typetagref.is_string())
+            auto typetagref = j.find("__type_tag__");
+            if(typetagref == j.cend() || !typetagref->is_string())
             {
                 return false;
             }
 
-            auto oftyperef = apimodule->typemap.find(typetagref.get<std::string>());
-            if(oftyperef == apimodule->typemap.cend())
-            {
-                return false;
-            }
-
-            auto ofidxref = std::find_if(opttypes.cbegin(), opttypes.cend(), [oftyperef](const IType* tt) {
-                return tt->name == oftyperef->second->name;
-            });
-            if(ofidxref == opttypes.cend())
-            {
-                return false;
-            }
-
-            auto ofidx = std::distance(opttypes.cbegin(), ofidxref);
-            auto vval = apimgr.parseUnionChoice(apimodule, oftyperef->second, value, ofidx, oftyperef->second, ctx);
-            return oftyperef->second->tparse(apimgr, apimodule, j, vval, ctx);
+            tname = typetagref->get<std::string>();
         }
-        else{
+        else
+        {
             if(!j.is_array() || j.size() != 2 || !j[0].is_string())
             {
                 return false;
             }
 
-            auto oftyperef = apimodule->typemap.find(j[0].get<std::string>());
-            if(oftyperef == apimodule->typemap.cend())
-            {
-                return false;
-            }
-
-            auto ofidxref = std::find_if(opttypes.cbegin(), opttypes.cend(), [oftyperef](const IType* tt) {
-                return tt->name == oftyperef->second->name;
-            });
-            if(ofidxref == opttypes.cend())
-            {
-                return false;
-            }
-
-            auto ofidx = std::distance(opttypes.cbegin(), ofidxref);
+            tname = j[0].get<std::string>();
+        }
 
-            auto vval = apimgr.parseUnionChoice(apimodule, oftyperef->second, value, ofidx, oftyperef->second, ctx);
-            return oftyperef->second->tparse(apimgr, apimodule, j[1], vval, ctx);
+        auto ofidx = this->findOptionIndex(tname);
+        if(ofidx == this->opts.size())
+        {
+            return false;
         }
+
+        auto oftype = this->optrefs[ofidx];
+        auto vval = apimgr.parseUnionChoice(apimodule, this, value, ofidx, oftype, ctx);
+        return oftype->tparse(apimgr, apimodule, j.is_object() ? j : j[1], vval, ctx);
     } 
 
     template <typename ValueRepr, typename State>
     std::optional<json> extract(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, ValueRepr value, State& ctx) const
     {
-        auto opttypes = apimodule->getAllTypesInUnion(this);
-
-        auto nval = apimgr.extractUnionChoice(apimodule, this, opttypes, value, ctx);
+        auto nval = apimgr.extractUnionChoice(apimodule, this, this->optrefs, value, ctx);
         if(!nval.has_value())
         {
             return std::nullopt;
         }
 
-        auto choicetype = opttypes[nval.value()];
+        auto choicetype = this->optrefs[nval.value()];
         auto uvalue = apimgr.extractUnionValue(apimodule, this, value, ctx);
         auto cval = choicetype->textract(apimgr, apimodule, uvalue, ctx);
         if(!cval.has_value())
@@ -2286,78 +2452,78 @@ public:
 };
 
 template <typename ValueRepr, typename State>
-bool IType::tparse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, json j, ValueRepr value, State& ctx) const
+bool IType::tparse(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const json& j, ValueRepr value, State& ctx) const
 {
     switch(this->tag)
     {
         case TypeTag::NoneTag:
-            return dynamic_cast<const NoneType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const NoneType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::NothingTag:
-            return dynamic_cast<const NothingType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const NothingType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::BoolTag:
-            return dynamic_cast<const BoolType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const BoolType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::NatTag:
-            return dynamic_cast<const NatType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const NatType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::IntTag:
-            return dynamic_cast<const IntType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const IntType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::BigNatTag:
-            return dynamic_cast<const BigNatType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const BigNatType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::BigIntTag:
-            return dynamic_cast<const BigIntType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const BigIntType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::RationalTag:
-            return dynamic_cast<const RationalType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const RationalType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::FloatTag:
-            return dynamic_cast<const FloatType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const FloatType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::DecimalTag:
-            return dynamic_cast<const DecimalType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const DecimalType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::StringTag:
-            return dynamic_cast<const StringType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const StringType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::StringOfTag:
-            return dynamic_cast<const StringOfType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const StringOfType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::DataStringTag:
-            return dynamic_cast<const DataStringType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const DataStringType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::ByteBufferTag:
-            return dynamic_cast<const ByteBufferType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const ByteBufferType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::DataBufferTag:
-            return dynamic_cast<const DataBufferType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const DataBufferType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::DateTimeTag:
-            return dynamic_cast<const DateTimeType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const DateTimeType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::UTCDateTimeTag:
-            return dynamic_cast<const UTCDateTimeType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const UTCDateTimeType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::CalendarDateTag:
-            return dynamic_cast<const CalendarDateType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const CalendarDateType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::RelativeTimeTag:
-            return dynamic_cast<const RelativeTimeType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const RelativeTimeType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::TickTimeTag:
-            return dynamic_cast<const TickTimeType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const TickTimeType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::LogicalTimeTag:
-            return dynamic_cast<const LogicalTimeType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const LogicalTimeType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::ISOTimeStampTag:
-            return dynamic_cast<const ISOTimeStampType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const ISOTimeStampType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::UUID4Tag:
-            return dynamic_cast<const UUID4Type*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const UUID4Type*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::UUID7Tag:
-            return dynamic_cast<const UUID7Type*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const UUID7Type*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::SHAContentHashTag:
-            return dynamic_cast<const SHAContentHashType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const SHAContentHashType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::LatLongCoordinateTag:
-            return dynamic_cast<const LatLongCoordinateType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const LatLongCoordinateType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::ConstructableOfType:
-            return dynamic_cast<const ConstructableOfType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const ConstructableOfType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::TupleTag:
-            return dynamic_cast<const TupleType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const TupleType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::RecordTag:
-            return dynamic_cast<const RecordType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const RecordType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::ContainerTTag:
-            return dynamic_cast<const ContainerTType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const ContainerTType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::ContainerKVTag:
-            return dynamic_cast<const ContainerKVType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const ContainerKVType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::EnumTag:
-            return dynamic_cast<const EnumType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const EnumType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::EntityTag:
-            return dynamic_cast<const EntityType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const EntityType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         case TypeTag::UnionTag:
-            return dynamic_cast<const UnionType*>(this)->parse(apimgr, apimodule, j, value, ctx);
+            return static_cast<const UnionType*>(this)->parse(apimgr, apimodule, j, value, ctx);
         default: 
         {
             assert(false);
@@ -2372,73 +2538,73 @@ std::optional<json> IType::textract(ApiManagerJSON<ValueRepr, State>& apimgr, co
     switch(this->tag)
     {
         case TypeTag::NoneTag:
-            return dynamic_cast<const NoneType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const NoneType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::NothingTag:
-            return dynamic_cast<const NothingType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const NothingType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::BoolTag:
-            return dynamic_cast<const BoolType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const BoolType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::NatTag:
-            return dynamic_cast<const NatType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const NatType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::IntTag:
-            return dynamic_cast<const IntType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const IntType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::BigNatTag:
-            return dynamic_cast<const BigNatType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const BigNatType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::BigIntTag:
-            return dynamic_cast<const BigIntType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const BigIntType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::RationalTag:
-            return dynamic_cast<const RationalType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const RationalType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::FloatTag:
-            return dynamic_cast<const FloatType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const FloatType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::DecimalTag:
-            return dynamic_cast<const DecimalType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const DecimalType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::StringTag:
-            return dynamic_cast<const StringType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const StringType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::StringOfTag:
-            return dynamic_cast<const StringOfType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const StringOfType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::DataStringTag:
-            return dynamic_cast<const DataStringType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const DataStringType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::ByteBufferTag:
-            return dynamic_cast<const ByteBufferType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const ByteBufferType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::DataBufferTag:
-            return dynamic_cast<const DataBufferType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const DataBufferType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::DateTimeTag:
-            return dynamic_cast<const DateTimeType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const DateTimeType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::UTCDateTimeTag:
-            return dynamic_cast<const UTCDateTimeType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const UTCDateTimeType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::CalendarDateTag:
-            return dynamic_cast<const CalendarDateType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const CalendarDateType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::RelativeTimeTag:
-            return dynamic_cast<const RelativeTimeType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const RelativeTimeType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::TickTimeTag:
-            return dynamic_cast<const TickTimeType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const TickTimeType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::LogicalTimeTag:
-            return dynamic_cast<const LogicalTimeType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const LogicalTimeType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::ISOTimeStampTag:
-            return dynamic_cast<const ISOTimeStampType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const ISOTimeStampType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::UUID4Tag:
-            return dynamic_cast<const UUID4Type*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const UUID4Type*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::UUID7Tag:
-            return dynamic_cast<const UUID7Type*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const UUID7Type*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::SHAContentHashTag:
-            return dynamic_cast<const SHAContentHashType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const SHAContentHashType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::LatLongCoordinateTag:
-            return dynamic_cast<const LatLongCoordinateType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const LatLongCoordinateType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::ConstructableOfType:
-            return dynamic_cast<const ConstructableOfType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const ConstructableOfType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::TupleTag:
-            return dynamic_cast<const TupleType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const TupleType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::RecordTag:
-            return dynamic_cast<const RecordType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const RecordType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::ContainerTTag:
-            return dynamic_cast<const ContainerTType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const ContainerTType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::ContainerKVTag:
-            return dynamic_cast<const ContainerKVType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const ContainerKVType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::EnumTag:
-            return dynamic_cast<const EnumType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const EnumType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::EntityTag:
-            return dynamic_cast<const EntityType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const EntityType*>(this)->extract(apimgr, apimodule, value, ctx);
         case TypeTag::UnionTag:
-            return dynamic_cast<const UnionType*>(this)->extract(apimgr, apimodule, value, ctx);
+            return static_cast<const UnionType*>(this)->extract(apimgr, apimodule, value, ctx);
         default: 
         {
             assert(false);
@@ -2448,3 +2614,1240 @@ std::optional<json> IType::textract(ApiManagerJSON<ValueRepr, State>& apimgr, co
 }
 
 
+
+////
+//Streaming argument parsing -- SAX events from the JSON reader are written straight into the manager so no DOM is built for the argument payload
+//Each open value has a frame, scalars are parsed with the same tparse logic as the DOM path, and containers are built incrementally as their elements complete
+//Only subtrees that need lookahead to resolve (tagged union objects, [name, value] entity forms, byte buffers and other non-scalar leaves) are captured as a small DOM and handed to tparse
+
+enum class StreamParseFrameKind
+{
+    Value = 0x0,
+    Tuple,
+    Record,
+    Entity,
+    ContainerT,
+    ContainerKV,
+    ContainerKVEntry,
+    Union,
+    Capture
+};
+
+template <typename ValueRepr>
+struct StreamParseFrame
+{
+    StreamParseFrameKind kind;
+    const IType* itype; //nullptr for a capture that is skipped
+    ValueRepr value;
+
+    //Elements/fields seen so far -- and for records/entities which fields have been set
+    size_t count;
+    std::vector<bool> seen;
+
+    //Locations of the key and value for a map entry -- or the value location of the choice for a union
+    std::pair<ValueRepr, ValueRepr> kvloc;
+
+    //Validators from ConstructableOf wrappers (innermost last) that are checked once the value is complete
+    std::vector<std::string> validators;
+
+    json capture;
+    std::vector<json*> capturepath;
+    std::string capturekey;
+
+    StreamParseFrame(StreamParseFrameKind kind, const IType* itype, ValueRepr value) : kind(kind), itype(itype), value(value), count(0), seen(), kvloc(value, value), validators(), capture(), capturepath(), capturekey() {;}
+};
+
+template <typename ValueRepr, typename State>
+class APIStreamParser : public json::json_sax_t
+{
+private:
+    ApiManagerJSON<ValueRepr, State>& apimgr;
+    const APIModule* apimodule;
+    State& ctx;
+
+    const std::vector<std::pair<const IType*, ValueRepr>> targets;
+    size_t argcount;
+    bool argsopen;
+    bool argsclosed;
+
+    std::vector<StreamParseFrame<ValueRepr>> frames;
+
+    //Strip ConstructableOf wrappers off the frame type -- the validators are run when the value completes
+    const IType* resolveFrameType(StreamParseFrame<ValueRepr>& frame) const
+    {
+        while(frame.itype->tag == TypeTag::ConstructableOfType)
+        {
+            auto ctype = static_cast<const ConstructableOfType*>(frame.itype);
+            if(ctype->validatefunc.has_value())
+            {
+                frame.validators.push_back(ctype->validatefunc.value());
+            }
+            frame.itype = ctype->oftyperef;
+        }
+
+        return frame.itype;
+    }
+
+    //Make sure the top frame is the one that receives the next value -- pushing a frame for the next argument/element if needed
+    bool beginValue()
+    {
+        if(this->frames.empty())
+        {
+            if(!this->argsopen || this->argsclosed || this->argcount >= this->targets.size())
+            {
+                return false;
+            }
+
+            auto tt = this->targets[this->argcount];
+            this->frames.push_back(StreamParseFrame<ValueRepr>(StreamParseFrameKind::Value, tt.first, tt.second));
+            return true;
+        }
+
+        auto& top = this->frames.back();
+        switch(top.kind)
+        {
+            case StreamParseFrameKind::Value:
+            case StreamParseFrameKind::Capture:
+            {
+                return true;
+            }
+            case StreamParseFrameKind::Tuple:
+            {
+                auto ttype = dynamic_cast<const TupleType*>(top.itype);
+                if(top.count >= ttype->ttypes.size())
+                {
+                    return false;
+                }
+
+                ValueRepr vval = this->apimgr.getValueForTupleIndex(this->apimodule, ttype, top.value, top.count, this->ctx);
+                this->frames.push_back(StreamParseFrame<ValueRepr>(StreamParseFrameKind::Value, ttype->ttyperefs[top.count], vval));
+                return true;
+            }
+            case StreamParseFrameKind::ContainerT:
+            {
+                auto ctype = dynamic_cast<const ContainerTType*>(top.itype);
+
+                ValueRepr vval = this->apimgr.getValueForContainerElementParseIncremental_T(this->apimodule, ctype, top.value, this->ctx);
+                this->frames.push_back(StreamParseFrame<ValueRepr>(StreamParseFrameKind::Value, ctype->elemtyperef, vval));
+                return true;
+            }
+            case StreamParseFrameKind::ContainerKVEntry:
+            {
+                auto ctype = dynamic_cast<const ContainerKVType*>(top.itype);
+                if(top.count >= 2)
+                {
+                    return false;
+                }
+
+                const IType* ttype = (top.count == 0 ? ctype->ktyperef : ctype->vtyperef);
+                ValueRepr vval = (top.count == 0 ? top.kvloc.first : top.kvloc.second);
+                this->frames.push_back(StreamParseFrame<ValueRepr>(StreamParseFrameKind::Value, ttype, vval));
+                return true;
+            }
+            case StreamParseFrameKind::Union:
+            {
+                //the first element is the tag (see stringValue) and the value follows it
+                if(top.count != 1)
+                {
+                    return false;
+                }
+
+                ValueRepr vval = top.kvloc.first;
+                this->frames.push_back(StreamParseFrame<ValueRepr>(StreamParseFrameKind::Value, top.itype, vval));
+                return true;
+            }
+            default:
+            {
+                //record and entity values only follow a key
+                return false;
+            }
+        }
+    }
+
+    //The value on top of the stack is complete -- check its validators and advance the enclosing frame
+    bool completeValue()
+    {
+        StreamParseFrame<ValueRepr> frame = std::move(this->frames.back());
+        this->frames.pop_back();
+
+        for(auto vv = frame.validators.crbegin(); vv != frame.validators.crend(); ++vv)
+        {
+            if(!this->apimgr.checkInvokeOk(*vv, frame.value, this->ctx))
+            {
+                return false;
+            }
+        }
+
+        if(this->frames.empty())
+        {
+            this->argcount++;
+            return true;
+        }
+
+        auto& top = this->frames.back();
+        switch(top.kind)
+        {
+            case StreamParseFrameKind::Tuple:
+            case StreamParseFrameKind::ContainerKVEntry:
+            case StreamParseFrameKind::Union:
+            {
+                top.count++;
+                return true;
+            }
+            case StreamParseFrameKind::Record:
+            case StreamParseFrameKind::Entity:
+            {
+                return true;
+            }
+            case StreamParseFrameKind::ContainerT:
+            case StreamParseFrameKind::ContainerKV:
+            {
+                top.count++;
+                return this->apimgr.completeContainerElementParseIncremental(this->apimodule, top.itype, top.value, this->ctx);
+            }
+            default:
+            {
+                return false;
+            }
+        }
+    }
+
+    json* captureInsert(StreamParseFrame<ValueRepr>& frame, json&& jv)
+    {
+        if(frame.capturepath.empty())
+        {
+            frame.capture = std::move(jv);
+            return &frame.capture;
+        }
+
+        json* parent = frame.capturepath.back();
+        if(parent->is_array())
+        {
+            parent->push_back(std::move(jv));
+            return &parent->back();
+        }
+        else
+        {
+            json& slot = (*parent)[frame.capturekey];
+            slot = std::move(jv);
+            return &slot;
+        }
+    }
+
+    bool completeCapture()
+    {
+        auto& top = this->frames.back();
+        if(top.itype != nullptr && !top.itype->tparse(this->apimgr, this->apimodule, std::move(top.capture), top.value, this->ctx))
+        {
+            return false;
+        }
+
+        return this->completeValue();
+    }
+
+    bool scalarValue(json&& jv)
+    {
+        if(!this->beginValue())
+        {
+            return false;
+        }
+
+        auto& top = this->frames.back();
+        if(top.kind == StreamParseFrameKind::Capture)
+        {
+            this->captureInsert(top, std::move(jv));
+            return top.capturepath.empty() ? this->completeCapture() : true;
+        }
+
+        const IType* itype = this->resolveFrameType(top);
+        if(!itype->tparse(this->apimgr, this->apimodule, jv, top.value, this->ctx))
+        {
+            return false;
+        }
+
+        return this->completeValue();
+    }
+
+    bool startCapture(StreamParseFrame<ValueRepr>& frame, json&& jv)
+    {
+        frame.kind = StreamParseFrameKind::Capture;
+
+        json* jc = this->captureInsert(frame, std::move(jv));
+        frame.capturepath.push_back(jc);
+        return true;
+    }
+
+    bool endCapture(StreamParseFrame<ValueRepr>& frame)
+    {
+        frame.capturepath.pop_back();
+        return frame.capturepath.empty() ? this->completeCapture() : true;
+    }
+
+    bool unionTag(const std::string& tag)
+    {
+        auto& top = this->frames.back();
+        auto utype = static_cast<const UnionType*>(top.itype);
+
+        auto ofidx = utype->findOptionIndex(tag);
+        if(ofidx == utype->opts.size())
+        {
+            return false;
+        }
+
+        top.kvloc.first = this->apimgr.parseUnionChoice(this->apimodule, utype, top.value, ofidx, utype->optrefs[ofidx], this->ctx);
+        top.itype = utype->optrefs[ofidx];
+        top.count = 1;
+
+        return true;
+    }
+
+    bool startArray()
+    {
+        if(this->frames.empty() && !this->argsopen)
+        {
+            this->argsopen = true;
+            return true;
+        }
+
+        if(!this->frames.empty() && this->frames.back().kind == StreamParseFrameKind::ContainerKV)
+        {
+            auto& top = this->frames.back();
+
+            StreamParseFrame<ValueRepr> eframe(StreamParseFrameKind::ContainerKVEntry, top.itype, top.value);
+            eframe.kvloc = this->apimgr.getValueForContainerElementParseIncremental_KV(this->apimodule, top.itype, top.value, this->ctx);
+            this->frames.push_back(std::move(eframe));
+            return true;
+        }
+
+        if(!this->beginValue())
+        {
+            return false;
+        }
+
+        auto& top = this->frames.back();
+        if(top.kind == StreamParseFrameKind::Capture)
+        {
+            return this->startCapture(top, json::array());
+        }
+
+        const IType* itype = this->resolveFrameType(top);
+        switch(itype->tag)
+        {
+            case TypeTag::TupleTag:
+            {
+                top.kind = StreamParseFrameKind::Tuple;
+                this->apimgr.prepareParseTuple(this->apimodule, itype, this->ctx);
+                return true;
+            }
+            case TypeTag::ContainerTTag:
+            {
+                top.kind = StreamParseFrameKind::ContainerT;
+                return this->apimgr.prepareParseContainerIncremental(this->apimodule, itype, top.value, this->ctx);
+            }
+            case TypeTag::ContainerKVTag:
+            {
+                top.kind = StreamParseFrameKind::ContainerKV;
+                return this->apimgr.prepareParseContainerIncremental(this->apimodule, itype, top.value, this->ctx);
+            }
+            case TypeTag::UnionTag:
+            {
+                top.kind = StreamParseFrameKind::Union;
+                return true;
+            }
+            default:
+            {
+                return this->startCapture(top, json::array());
+            }
+        }
+    }
+
+    bool startObject()
+    {
+        if(!this->beginValue())
+        {
+            return false;
+        }
+
+        auto& top = this->frames.back();
+        if(top.kind == StreamParseFrameKind::Capture)
+        {
+            return this->startCapture(top, json::object());
+        }
+
+        const IType* itype = this->resolveFrameType(top);
+        switch(itype->tag)
+        {
+            case TypeTag::RecordTag:
+            {
+                top.kind = StreamParseFrameKind::Record;
+                top.seen.resize(dynamic_cast<const RecordType*>(itype)->props.size(), false);
+                this->apimgr.prepareParseRecord(this->apimodule, itype, this->ctx);
+                return true;
+            }
+            case TypeTag::EntityTag:
+            {
+                top.kind = StreamParseFrameKind::Entity;
+                top.seen.resize(dynamic_cast<const EntityType*>(itype)->consfields.size(), false);
+                this->apimgr.prepareParseEntity(this->apimodule, itype, this->ctx);
+                this->apimgr.prepareParseEntityMask(this->apimodule, itype, this->ctx);
+                return true;
+            }
+            default:
+            {
+                return this->startCapture(top, json::object());
+            }
+        }
+    }
+
+    bool objectKey(const std::string& k)
+    {
+        if(this->frames.empty())
+        {
+            return false;
+        }
+
+        auto& top = this->frames.back();
+        if(top.kind == StreamParseFrameKind::Capture)
+        {
+            top.capturekey = k;
+            return true;
+        }
+        else if(top.kind == StreamParseFrameKind::Record)
+        {
+            auto rtype = dynamic_cast<const RecordType*>(top.itype);
+            auto ppos = std::find(rtype->props.cbegin(), rtype->props.cend(), k);
+            if(ppos == rtype->props.cend() || top.seen[std::distance(rtype->props.cbegin(), ppos)])
+            {
+                return false;
+            }
+
+            auto pidx = std::distance(rtype->props.cbegin(), ppos);
+            top.seen[pidx] = true;
+            top.count++;
+
+            ValueRepr vval = this->apimgr.getValueForRecordProperty(this->apimodule, rtype, top.value, pidx, this->ctx);
+            this->frames.push_back(StreamParseFrame<ValueRepr>(StreamParseFrameKind::Value, rtype->ttyperefs[pidx], vval));
+            return true;
+        }
+        else if(top.kind == StreamParseFrameKind::Entity)
+        {
+            if(k == "__type_tag__")
+            {
+                this->frames.push_back(StreamParseFrame<ValueRepr>(StreamParseFrameKind::Capture, nullptr, top.value));
+                return true;
+            }
+
+            auto etype = dynamic_cast<const EntityType*>(top.itype);
+            auto fpos = std::find_if(etype->consfields.cbegin(), etype->consfields.cend(), [&k](const std::pair<std::string, std::string>& fnamekey) {
+                return fnamekey.first == k;
+            });
+            if(fpos == etype->consfields.cend() || top.seen[std::distance(etype->consfields.cbegin(), fpos)])
+            {
+                return false;
+            }
+
+            auto fidx = std::distance(etype->consfields.cbegin(), fpos);
+            top.seen[fidx] = true;
+            top.count++;
+
+            if(etype->ttypes[fidx].second)
+            {
+                this->apimgr.setMaskFlag(this->apimodule, top.value, fidx - etype->firstoptidx, true, this->ctx);
+            }
+
+            ValueRepr vval = this->apimgr.getValueForEntityField(this->apimodule, etype, top.value, fidx, this->ctx);
+            this->frames.push_back(StreamParseFrame<ValueRepr>(StreamParseFrameKind::Value, etype->ttyperefs[fidx], vval));
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool endContainer()
+    {
+        if(this->frames.empty())
+        {
+            if(!this->argsopen || this->argsclosed)
+            {
+                return false;
+            }
+
+            this->argsclosed = true;
+            return true;
+        }
+
+        auto& top = this->frames.back();
+        switch(top.kind)
+        {
+            case StreamParseFrameKind::Capture:
+            {
+                return this->endCapture(top);
+            }
+            case StreamParseFrameKind::Tuple:
+            {
+                if(top.count != dynamic_cast<const TupleType*>(top.itype)->ttypes.size())
+                {
+                    return false;
+                }
+
+                this->apimgr.completeParseTuple(this->apimodule, top.itype, top.value, this->ctx);
+                return this->completeValue();
+            }
+            case StreamParseFrameKind::Record:
+            {
+                if(top.count != dynamic_cast<const RecordType*>(top.itype)->props.size())
+                {
+                    return false;
+                }
+
+                this->apimgr.completeParseRecord(this->apimodule, top.itype, top.value, this->ctx);
+                return this->completeValue();
+            }
+            case StreamParseFrameKind::Entity:
+            {
+                auto etype = dynamic_cast<const EntityType*>(top.itype);
+                for(size_t i = 0; i < etype->consfields.size(); ++i)
+                {
+                    if(!top.seen[i])
+                    {
+                        if(!etype->ttypes[i].second)
+                        {
+                            return false;
+                        }
+
+                        this->apimgr.setMaskFlag(this->apimodule, top.value, i - etype->firstoptidx, false, this->ctx);
+                    }
+                }
+
+                this->apimgr.completeParseEntity(this->apimodule, etype, top.value, this->ctx);
+                return this->completeValue();
+            }
+            case StreamParseFrameKind::ContainerT:
+            case StreamParseFrameKind::ContainerKV:
+            {
+                if(!this->apimgr.completeParseContainerIncremental(this->apimodule, top.itype, top.value, this->ctx))
+                {
+                    return false;
+                }
+
+                return this->completeValue();
+            }
+            case StreamParseFrameKind::ContainerKVEntry:
+            case StreamParseFrameKind::Union:
+            {
+                if(top.count != 2)
+                {
+                    return false;
+                }
+
+                return this->completeValue();
+            }
+            default:
+            {
+                return false;
+            }
+        }
+    }
+
+public:
+    APIStreamParser(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, std::vector<std::pair<const IType*, ValueRepr>> targets, State& ctx) : apimgr(apimgr), apimodule(apimodule), ctx(ctx), targets(targets), argcount(0), argsopen(false), argsclosed(false), frames() {;}
+    virtual ~APIStreamParser() {;}
+
+    //True once the full argument array has been read (which may be shorter than the target list)
+    bool isComplete() const
+    {
+        return this->argsclosed && this->frames.empty();
+    }
+
+    size_t getArgCount() const
+    {
+        return this->argcount;
+    }
+
+    virtual bool null() override
+    {
+        return this->scalarValue(json(nullptr));
+    }
+
+    virtual bool boolean(bool val) override
+    {
+        return this->scalarValue(json(val));
+    }
+
+    virtual bool number_integer(json::number_integer_t val) override
+    {
+        return this->scalarValue(json(val));
+    }
+
+    virtual bool number_unsigned(json::number_unsigned_t val) override
+    {
+        return this->scalarValue(json(val));
+    }
+
+    virtual bool number_float(json::number_float_t val, const json::string_t& s) override
+    {
+        return this->scalarValue(json(val));
+    }
+
+    virtual bool string(json::string_t& val) override
+    {
+        if(!this->frames.empty() && this->frames.back().kind == StreamParseFrameKind::Union && this->frames.back().count == 0)
+        {
+            return this->unionTag(val);
+        }
+
+        return this->scalarValue(json(std::move(val)));
+    }
+
+    virtual bool binary(json::binary_t& val) override
+    {
+        return this->scalarValue(json::binary(std::move(val)));
+    }
+
+    virtual bool start_object(std::size_t elements) override
+    {
+        return this->startObject();
+    }
+
+    virtual bool key(json::string_t& val) override
+    {
+        return this->objectKey(val);
+    }
+
+    virtual bool end_object() override
+    {
+        return this->endContainer();
+    }
+
+    virtual bool start_array(std::size_t elements) override
+    {
+        return this->startArray();
+    }
+
+    virtual bool end_array() override
+    {
+        return this->endContainer();
+    }
+
+    virtual bool parse_error(std::size_t position, const std::string& last_token, const nlohmann::detail::exception& ex) override
+    {
+        return false;
+    }
+};
+
+////
+//Streaming result output -- values are written as they are extracted into a buffered sink so large results are never held as a DOM plus its dumped string
+//Text output matches json::dump (sorted object keys, same indentation) with indent < 0 for the compact form
+//CBOR output uses indefinite length arrays/maps (so nothing needs to be counted up front) and raw byte strings for binary values
+//With a null FILE* the output is only kept in the buffer (see contents)
+//Nothing reaches the FILE* until flush -- a full buffer spills to a temporary file so a failed extraction can still be discarded without leaving a partial value on the output
+
+#define JSON_STREAM_WRITER_BUFFER_BYTES 65536
+
+enum class JSONStreamFormat
+{
+    Text = 0x0,
+    CBOR
+};
+
+class JSONStreamWriter
+{
+private:
+    FILE* out;
+    std::string buff;
+    const int indent;
+    const JSONStreamFormat format;
+    FILE* spill;
+
+    //one entry per open object/array -- true until its first element is written
+    std::vector<bool> firstelem;
+    bool afterkey;
+
+    void writeRaw(const std::string& s)
+    {
+        this->buff.append(s);
+        if(this->buff.size() >= JSON_STREAM_WRITER_BUFFER_BYTES)
+        {
+            this->spillBuffer();
+        }
+    }
+
+    //if the temporary file cannot be created the output just stays in the buffer
+    void spillBuffer()
+    {
+        if(this->out == nullptr)
+        {
+            return;
+        }
+
+        if(this->spill == nullptr)
+        {
+            this->spill = tmpfile();
+            if(this->spill == nullptr)
+            {
+                return;
+            }
+        }
+
+        fwrite(this->buff.data(), 1, this->buff.size(), this->spill);
+        this->buff.clear();
+    }
+
+    void closeSpill()
+    {
+        if(this->spill != nullptr)
+        {
+            fclose(this->spill);
+            this->spill = nullptr;
+        }
+    }
+
+    void cborHeader(uint8_t major, uint64_t len)
+    {
+        uint8_t mt = (uint8_t)(major << 5);
+        if(len < 24)
+        {
+            this->buff.push_back((char)(mt | (uint8_t)len));
+            return;
+        }
+
+        size_t bytes = 0;
+        if(len <= 0xFF)
+        {
+            this->buff.push_back((char)(mt | 24));
+            bytes = 1;
+        }
+        else if(len <= 0xFFFF)
+        {
+            this->buff.push_back((char)(mt | 25));
+            bytes = 2;
+        }
+        else if(len <= 0xFFFFFFFF)
+        {
+            this->buff.push_back((char)(mt | 26));
+            bytes = 4;
+        }
+        else
+        {
+            this->buff.push_back((char)(mt | 27));
+            bytes = 8;
+        }
+
+        for(size_t i = bytes; i > 0; --i)
+        {
+            this->buff.push_back((char)((len >> ((i - 1) * 8)) & 0xFF));
+        }
+    }
+
+    void newlineIndent(size_t depth)
+    {
+        if(this->indent >= 0)
+        {
+            this->buff.push_back('\n');
+            this->buff.append(depth * (size_t)this->indent, ' ');
+        }
+    }
+
+    void beginElement()
+    {
+        if(this->format == JSONStreamFormat::CBOR)
+        {
+            this->afterkey = false;
+            return;
+        }
+
+        if(this->afterkey)
+        {
+            this->afterkey = false;
+            return;
+        }
+
+        if(this->firstelem.empty())
+        {
+            return;
+        }
+
+        if(!this->firstelem.back())
+        {
+            this->buff.push_back(',');
+        }
+        this->firstelem.back() = false;
+
+        this->newlineIndent(this->firstelem.size());
+    }
+
+    void endContainer(char cc)
+    {
+        bool isempty = this->firstelem.back();
+        this->firstelem.pop_back();
+
+        if(this->format == JSONStreamFormat::CBOR)
+        {
+            //break code for the indefinite length item
+            this->buff.push_back((char)0xFF);
+            return;
+        }
+
+        if(!isempty)
+        {
+            this->newlineIndent(this->firstelem.size());
+        }
+        this->buff.push_back(cc);
+
+        if(this->buff.size() >= JSON_STREAM_WRITER_BUFFER_BYTES)
+        {
+            this->spillBuffer();
+        }
+    }
+
+public:
+    JSONStreamWriter(FILE* out, int indent, JSONStreamFormat format) : out(out), buff(), indent(indent), format(format), spill(nullptr), firstelem(), afterkey(false)
+    {
+        this->buff.reserve(JSON_STREAM_WRITER_BUFFER_BYTES);
+    }
+
+    //anything not flushed (e.g. on an exception out of extraction) is dropped
+    ~JSONStreamWriter()
+    {
+        this->closeSpill();
+    }
+
+    bool isCompact() const
+    {
+        return this->indent < 0;
+    }
+
+    bool isBinary() const
+    {
+        return this->format == JSONStreamFormat::CBOR;
+    }
+
+    //Output so far when there is no FILE* to flush to
+    const std::string& contents() const
+    {
+        return this->buff;
+    }
+
+    //Drop everything written since the last flush and reset to the top level
+    void discard()
+    {
+        this->closeSpill();
+        this->buff.clear();
+        this->firstelem.clear();
+        this->afterkey = false;
+    }
+
+    void flush()
+    {
+        if(this->out == nullptr)
+        {
+            return;
+        }
+
+        if(this->spill != nullptr)
+        {
+            rewind(this->spill);
+
+            char cbuff[8192];
+            size_t rcount = 0;
+            while((rcount = fread(cbuff, 1, sizeof(cbuff), this->spill)) != 0)
+            {
+                fwrite(cbuff, 1, rcount, this->out);
+            }
+            this->closeSpill();
+        }
+
+        if(!this->buff.empty())
+        {
+            fwrite(this->buff.data(), 1, this->buff.size(), this->out);
+            this->buff.clear();
+        }
+        fflush(this->out);
+    }
+
+    //Text outside of any JSON value (prefixes, envelopes, newlines)
+    void raw(const std::string& s)
+    {
+        this->writeRaw(s);
+    }
+
+    void beginObject()
+    {
+        this->beginElement();
+        this->buff.push_back(this->format == JSONStreamFormat::CBOR ? (char)0xBF : '{');
+        this->firstelem.push_back(true);
+    }
+
+    void endObject()
+    {
+        this->endContainer('}');
+    }
+
+    void beginArray()
+    {
+        this->beginElement();
+        this->buff.push_back(this->format == JSONStreamFormat::CBOR ? (char)0x9F : '[');
+        this->firstelem.push_back(true);
+    }
+
+    void endArray()
+    {
+        this->endContainer(']');
+    }
+
+    void key(const std::string& k)
+    {
+        this->beginElement();
+        if(this->format == JSONStreamFormat::CBOR)
+        {
+            this->cborHeader(3, k.size());
+            this->writeRaw(k);
+            return;
+        }
+
+        this->writeRaw(json(k).dump());
+        this->buff.append(this->indent >= 0 ? ": " : ":");
+        this->afterkey = true;
+    }
+
+    //Raw bytes -- a byte string in CBOR and an array of byte values (as textract produces them) in text
+    void binary(const std::vector<uint8_t>& bytes)
+    {
+        if(this->format == JSONStreamFormat::CBOR)
+        {
+            this->beginElement();
+            this->cborHeader(2, bytes.size());
+            this->buff.append(bytes.cbegin(), bytes.cend());
+
+            if(this->buff.size() >= JSON_STREAM_WRITER_BUFFER_BYTES)
+            {
+                this->spillBuffer();
+            }
+        }
+        else
+        {
+            this->value(json(bytes));
+        }
+    }
+
+    void value(const json& j)
+    {
+        if(this->format == JSONStreamFormat::CBOR && !j.is_structured())
+        {
+            auto bytes = json::to_cbor(j);
+            this->buff.append(bytes.cbegin(), bytes.cend());
+
+            if(this->buff.size() >= JSON_STREAM_WRITER_BUFFER_BYTES)
+            {
+                this->spillBuffer();
+            }
+            return;
+        }
+
+        if(j.is_object())
+        {
+            this->beginObject();
+            for(auto iter = j.cbegin(); iter != j.cend(); ++iter)
+            {
+                this->key(iter.key());
+                this->value(iter.value());
+            }
+            this->endObject();
+        }
+        else if(j.is_array())
+        {
+            this->beginArray();
+            for(auto iter = j.cbegin(); iter != j.cend(); ++iter)
+            {
+                this->value(*iter);
+            }
+            this->endArray();
+        }
+        else
+        {
+            this->beginElement();
+            this->writeRaw(j.dump());
+        }
+    }
+};
+
+//Write the value as textract would produce it -- composite values are walked with the extract callbacks and only leaf values are built as (small) json
+//If typetag is given the value is an object in a union and gets a "__type_tag__" field
+template <typename ValueRepr, typename State>
+bool streamExtract(ApiManagerJSON<ValueRepr, State>& apimgr, const APIModule* apimodule, const IType* itype, ValueRepr value, State& ctx, JSONStreamWriter& writer, const std::string* typetag = nullptr)
+{
+    switch(itype->tag)
+    {
+        case TypeTag::ConstructableOfType:
+        {
+            auto ctype = static_cast<const ConstructableOfType*>(itype);
+            return streamExtract(apimgr, apimodule, ctype->oftyperef, value, ctx, writer, typetag);
+        }
+        case TypeTag::TupleTag:
+        {
+            auto ttype = static_cast<const TupleType*>(itype);
+
+            writer.beginArray();
+            for(size_t i = 0; i < ttype->ttypes.size(); ++i)
+            {
+                auto tt = ttype->ttyperefs[i];
+
+                ValueRepr vval = apimgr.extractValueForTupleIndex(apimodule, ttype, value, i, ctx);
+                if(!streamExtract(apimgr, apimodule, tt, vval, ctx, writer))
+                {
+                    return false;
+                }
+            }
+            writer.endArray();
+
+            return true;
+        }
+        case TypeTag::RecordTag:
+        {
+            auto rtype = static_cast<const RecordType*>(itype);
+            const std::vector<size_t>& order = rtype->streamorder;
+
+            writer.beginObject();
+            bool tagged = (typetag == nullptr);
+            for(size_t j = 0; j < order.size(); ++j)
+            {
+                auto i = order[j];
+                if(!tagged && std::string("__type_tag__") < rtype->props[i])
+                {
+                    writer.key("__type_tag__");
+                    writer.value(*typetag);
+                    tagged = true;
+                }
+
+                auto tt = rtype->ttyperefs[i];
+
+                writer.key(rtype->props[i]);
+                ValueRepr vval = apimgr.extractValueForRecordProperty(apimodule, rtype, value, i, ctx);
+                if(!streamExtract(apimgr, apimodule, tt, vval, ctx, writer))
+                {
+                    return false;
+                }
+            }
+
+            if(!tagged)
+            {
+                writer.key("__type_tag__");
+                writer.value(*typetag);
+            }
+            writer.endObject();
+
+            return true;
+        }
+        case TypeTag::EntityTag:
+        {
+            auto etype = static_cast<const EntityType*>(itype);
+            const std::vector<size_t>& order = etype->streamorder;
+
+            writer.beginObject();
+            bool tagged = (typetag == nullptr);
+            for(size_t j = 0; j < order.size(); ++j)
+            {
+                auto i = order[j];
+                if(!tagged && std::string("__type_tag__") < etype->consfields[i].first)
+                {
+                    writer.key("__type_tag__");
+                    writer.value(*typetag);
+                    tagged = true;
+                }
+
+                auto tt = etype->ttyperefs[i];
+
+                writer.key(etype->consfields[i].first);
+                ValueRepr vval = apimgr.extractValueForEntityField(apimodule, etype, value, i, ctx);
+                if(!streamExtract(apimgr, apimodule, tt, vval, ctx, writer))
+                {
+                    return false;
+                }
+            }
+
+            if(!tagged)
+            {
+                writer.key("__type_tag__");
+                writer.value(*typetag);
+            }
+            writer.endObject();
+
+            return true;
+        }
+        case TypeTag::ContainerTTag:
+        {
+            auto ctype = static_cast<const ContainerTType*>(itype);
+
+            apimgr.prepareExtractContainer(apimodule, ctype, value, ctx);
+            auto clen = apimgr.extractLengthForContainer(apimodule, ctype, value, ctx);
+            if(!clen.has_value())
+            {
+                return false;
+            }
+
+            auto tt = ctype->elemtyperef;
+
+            writer.beginArray();
+            for(size_t i = 0; i < clen.value(); ++i)
+            {
+                ValueRepr vval = apimgr.extractValueForContainer_T(apimodule, ctype, value, i, ctx);
+                if(!streamExtract(apimgr, apimodule, tt, vval, ctx, writer))
+                {
+                    return false;
+                }
+            }
+            writer.endArray();
+
+            apimgr.completeExtractContainer(apimodule, ctype, ctx);
+            return true;
+        }
+        case TypeTag::ContainerKVTag:
+        {
+            auto ctype = static_cast<const ContainerKVType*>(itype);
+
+            apimgr.prepareExtractContainer(apimodule, ctype, value, ctx);
+            auto clen = apimgr.extractLengthForContainer(apimodule, ctype, value, ctx);
+            if(!clen.has_value())
+            {
+                return false;
+            }
+
+            auto kt = ctype->ktyperef;
+            auto vt = ctype->vtyperef;
+
+            writer.beginArray();
+            for(size_t i = 0; i < clen.value(); ++i)
+            {
+                std::pair<ValueRepr, ValueRepr> vval = apimgr.extractValueForContainer_KV(apimodule, ctype, value, i, ctx);
+
+                writer.beginArray();
+                if(!streamExtract(apimgr, apimodule, kt, vval.first, ctx, writer) || !streamExtract(apimgr, apimodule, vt, vval.second, ctx, writer))
+                {
+                    return false;
+                }
+                writer.endArray();
+            }
+            writer.endArray();
+
+            apimgr.completeExtractContainer(apimodule, ctype, ctx);
+            return true;
+        }
+        case TypeTag::UnionTag:
+        {
+            auto utype = static_cast<const UnionType*>(itype);
+
+            auto nval = apimgr.extractUnionChoice(apimodule, utype, utype->optrefs, value, ctx);
+            if(!nval.has_value())
+            {
+                return false;
+            }
+
+            auto choicetype = utype->optrefs[nval.value()];
+            auto uvalue = apimgr.extractUnionValue(apimodule, utype, value, ctx);
+
+            const IType* rtype = choicetype;
+            while(rtype->tag == TypeTag::ConstructableOfType)
+            {
+                rtype = static_cast<const ConstructableOfType*>(rtype)->oftyperef;
+            }
+
+            //values that extract as objects carry the tag as a field and everything else is a [tag, value] pair
+            if(rtype->tag == TypeTag::RecordTag || rtype->tag == TypeTag::EntityTag || rtype->tag == TypeTag::ByteBufferTag || rtype->tag == TypeTag::DataBufferTag)
+            {
+                return streamExtract(apimgr, apimodule, choicetype, uvalue, ctx, writer, &choicetype->name);
+            }
+            else
+            {
+                writer.beginArray();
+                writer.value(choicetype->name);
+                if(!streamExtract(apimgr, apimodule, choicetype, uvalue, ctx, writer))
+                {
+                    return false;
+                }
+                writer.endArray();
+
+                return true;
+            }
+        }
+        case TypeTag::DataBufferTag:
+        {
+            return streamExtract(apimgr, apimodule, static_cast<const DataBufferType*>(itype)->basetyperef, value, ctx, writer, typetag);
+        }
+        case TypeTag::ByteBufferTag:
+        {
+            //the bytes go out as a byte string in binary formats (and are never built as a json array)
+            auto iiinfo = apimgr.extractByteBufferImpl(apimodule, itype, value, ctx);
+            if(!iiinfo.has_value())
+            {
+                return false;
+            }
+
+            writer.beginObject();
+            if(typetag != nullptr)
+            {
+                writer.key("__type_tag__");
+                writer.value(*typetag);
+            }
+            writer.key("compress");
+            writer.value(iiinfo->second.first);
+            writer.key("data");
+            writer.binary(iiinfo->first);
+            writer.key("format");
+            writer.value(iiinfo->second.second);
+            writer.endObject();
+
+            return true;
+        }
+        case TypeTag::UUID4Tag:
+        case TypeTag::UUID7Tag:
+        case TypeTag::SHAContentHashTag:
+        {
+            if(!writer.isBinary())
+            {
+                auto jv = itype->textract(apimgr, apimodule, value, ctx);
+                if(!jv.has_value())
+                {
+                    return false;
+                }
+
+                writer.value(jv.value());
+                return true;
+            }
+
+            std::optional<std::vector<uint8_t>> bytes = std::nullopt;
+            if(itype->tag == TypeTag::UUID4Tag)
+            {
+                bytes = apimgr.extractUUID4Impl(apimodule, itype, value, ctx);
+            }
+            else if(itype->tag == TypeTag::UUID7Tag)
+            {
+                bytes = apimgr.extractUUID7Impl(apimodule, itype, value, ctx);
+            }
+            else
+            {
+                bytes = apimgr.extractSHAContentHashImpl(apimodule, itype, value, ctx);
+            }
+
+            if(!bytes.has_value())
+            {
+                return false;
+            }
+
+            writer.binary(bytes.value());
+            return true;
+        }
+        default:
+        {
+            auto jv = itype->textract(apimgr, apimodule, value, ctx);
+            if(!jv.has_value())
+            {
+                return false;
+            }
+
+            writer.value(jv.value());
+            return true;
+        }
+    }
+}
@@ -883,12 +883,9 @@ void SMTParseJSON::prepareParseRecord(const APIModule* apimodule, const IType* i
     ;
 }
 
-z3::expr SMTParseJSON::getValueForRecordProperty(const APIModule* apimodule, const IType* itype, z3::expr value, std::string pname, z3::solver& ctx)
+z3::expr SMTParseJSON::getValueForRecordProperty(const APIModule* apimodule, const IType* itype, z3::expr value, size_t pidx, z3::solver& ctx)
 {
-    auto rtype = dynamic_cast<const RecordType*>(itype);
-    auto ppos = std::find(rtype->props.cbegin(), rtype->props.cend(), pname);
-
-    return extendContext(ctx.ctx(), value, std::distance(rtype->props.cbegin(), ppos));
+    return extendContext(ctx.ctx(), value, pidx);
 }
 
 void SMTParseJSON::completeParseRecord(const APIModule* apimodule, const IType* itype, z3::expr value, z3::solver& ctx)
@@ -931,12 +928,9 @@ void SMTParseJSON::prepareParseEntityMask(const APIModule* apimodule, const ITyp
     ;
 }
 
-z3::expr SMTParseJSON::getValueForEntityField(const APIModule* apimodule, const IType* itype, z3::expr value, std::pair<std::string, std::string> fnamefkey, z3::solver& ctx)
+z3::expr SMTParseJSON::getValueForEntityField(const APIModule* apimodule, const IType* itype, z3::expr value, size_t fidx, z3::solver& ctx)
 {
-    auto ootype = dynamic_cast<const EntityType*>(itype);
-    auto ppos = std::find(ootype->consfields.cbegin(), ootype->consfields.cend(), fnamefkey);
-
-    return extendContext(ctx.ctx(), extendContext(ctx.ctx(), value, 0), std::distance(ootype->consfields.cbegin(), ppos));
+    return extendContext(ctx.ctx(), extendContext(ctx.ctx(), value, 0), fidx);
 }
 
 void SMTParseJSON::completeParseEntity(const APIModule* apimodule, const IType* itype, z3::expr value, z3::solver& ctx)
@@ -1337,20 +1331,14 @@ z3::expr SMTParseJSON::extractValueForTupleIndex(const APIModule* apimodule, con
     return extendContext(ctx.ctx(), value, i);
 }
 
-z3::expr SMTParseJSON::extractValueForRecordProperty(const APIModule* apimodule, const IType* itype, z3::expr value, std::string pname, z3::solver& ctx)
+z3::expr SMTParseJSON::extractValueForRecordProperty(const APIModule* apimodule, const IType* itype, z3::expr value, size_t pidx, z3::solver& ctx)
 {
-    auto rtype = dynamic_cast<const RecordType*>(itype);
-    auto ppos = std::find(rtype->props.cbegin(), rtype->props.cend(), pname);
-
-    return extendContext(ctx.ctx(), value, std::distance(rtype->props.cbegin(), ppos));
+    return extendContext(ctx.ctx(), value, pidx);
 }
 
-z3::expr SMTParseJSON::extractValueForEntityField(const APIModule* apimodule, const IType* itype, z3::expr value, std::pair<std::string, std::string> fnamefkey, z3::solver& ctx)
+z3::expr SMTParseJSON::extractValueForEntityField(const APIModule* apimodule, const IType* itype, z3::expr value, size_t fidx, z3::solver& ctx)
 {
-    auto ootype = dynamic_cast<const EntityType*>(itype);
-    auto ppos = std::find(ootype->consfields.cbegin(), ootype->consfields.cend(), fnamefkey);
-
-    return extendContext(ctx.ctx(), extendContext(ctx.ctx(), value, 0), std::distance(ootype->consfields.cbegin(), ppos));
+    return extendContext(ctx.ctx(), extendContext(ctx.ctx(), value, 0), fidx);
 }
 
 void SMTParseJSON::prepareExtractContainer(const APIModule* apimodule, const IType* itype, z3::expr value, z3::solver& ctx)
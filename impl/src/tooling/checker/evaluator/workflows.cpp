@@ -133,7 +133,8 @@ json workflowTestPass(std::string smt2decl, const APIModule* apimodule, const In
     }
 }
 
-json workflowEvaluate(std::string smt2decl, const APIModule* apimodule, const InvokeSignature* apisig, json jin, unsigned timeout)
+//The output value is written to jout as it is extracted (and null is returned) -- the other outcomes are returned as a status object
+json workflowEvaluate(std::string smt2decl, const APIModule* apimodule, const InvokeSignature* apisig, json jin, unsigned timeout, JSONStreamWriter& jout)
 {
     z3::context c;
     z3::solver s(c);
@@ -194,21 +195,20 @@ json workflowEvaluate(std::string smt2decl, const APIModule* apimodule, const In
         SMTParseJSON jextract;
 
         auto rootctx = SMTParseJSON::generateInitialResultContext(c);
-        auto jarg = apisig->restype->textract(jextract, apimodule, rootctx, s);
 
-        if(!jarg.has_value())
+        jout.raw("{\"status\":\"output\",\"time\":" + std::to_string(delta_ms) + ",\"value\":");
+        if(!streamExtract(jextract, apimodule, apisig->restype, rootctx, s, jout))
         {
+            jout.discard();
+
             return {
                 {"status", "error"},
                 {"info", "Could not extract arg"}
             };
         }
+        jout.raw("}");
 
-        return {
-            {"status", "output"},
-            {"time", delta_ms},
-            {"value", jarg.value()}
-        };
+        return json(nullptr);
     }
 }
 
@@ -297,9 +297,15 @@ int main(int argc, char** argv)
             APIModule* apimodule = APIModule::jparse(payload["apimodule"]);
             const InvokeSignature* apisig = apimodule->getSigForFriendlyName(payload["mainfunc"]).value();
 
-            json result = workflowEvaluate(smt2decl, apimodule, apisig, payload["jin"], timeout);
-            
-            std::cout << result << std::endl;
+            JSONStreamWriter jout(stdout, -1, JSONStreamFormat::Text);
+            json result = workflowEvaluate(smt2decl, apimodule, apisig, payload["jin"], timeout, jout);
+            jout.flush();
+
+            if(!result.is_null())
+            {
+                std::cout << result;
+            }
+            std::cout << std::endl;
             fflush(stdout);
         }
         catch(const std::exception& e)
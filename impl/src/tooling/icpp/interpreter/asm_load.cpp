@@ -5,6 +5,23 @@
 
 #include "asm_load.h"
 
+#include <fstream>
+
+size_t AssemblyLoadInfo::g_fusedOpCount = 0;
+size_t AssemblyLoadInfo::g_tailCallCount = 0;
+size_t AssemblyLoadInfo::g_foldedOpCount = 0;
+size_t AssemblyLoadInfo::g_propagatedCopyCount = 0;
+size_t AssemblyLoadInfo::g_removedOpCount = 0;
+size_t AssemblyLoadInfo::g_deferredBodyCount = 0;
+size_t AssemblyLoadInfo::g_materializedBodyCount = 0;
+bool AssemblyLoadInfo::g_dooptimize = true;
+bool AssemblyLoadInfo::g_dofusion = true;
+std::map<uint32_t, BSQTypeID> AssemblyLoadInfo::g_literalTypes;
+std::string AssemblyLoadInfo::g_snapshotFile;
+uint64_t AssemblyLoadInfo::g_snapshotFingerprint = 0;
+bool AssemblyLoadInfo::g_snapshotRestored = false;
+size_t AssemblyLoadInfo::g_snapshotObjectCount = 0;
+
 const BSQType* jsonLoadBoxedStructType(json v)
 {
     auto tstr = v["tkey"].get<std::string>();
@@ -63,7 +80,8 @@ BSQMapTypeFlavor jsonLoadMapFlavor(json v)
     uint32_t keyoffset = sizeof(BSQMapTreeRepr);
     uint32_t valueoffset = sizeof(BSQMapTreeRepr) + keytype->allocinfo.inlinedatasize;
 
-    RefMask heapmask = internRefMask(std::string("221") + std::string(keytype->allocinfo.inlinedmask) + std::string(valuetype->allocinfo.inlinedmask));
+    //the children are null at the leaves so they are scanned like (possibly empty) collection slots
+    RefMask heapmask = internRefMask(std::string("551") + std::string(keytype->allocinfo.inlinedmask) + std::string(valuetype->allocinfo.inlinedmask));
     std::string name = "[BSQMapTree]";
 
     const BSQMapTreeType* treetype = new BSQMapTreeType(BSQ_TYPE_ID_INTERNAL, allocsize, heapmask, name, keytype->tid, keyoffset, valuetype->tid, valueoffset);
@@ -71,141 +89,1355 @@ BSQMapTypeFlavor jsonLoadMapFlavor(json v)
     return BSQMapTypeFlavor{mtype, keytype, valuetype, treetype};   
 }
 
-void initialize(size_t cbuffsize, const RefMask cmask)
+bool isArgumentForTarget(Argument arg, TargetVar trgt)
 {
-    MarshalEnvironment::g_typenameToIdMap["None"] = BSQ_TYPE_ID_NONE;
-    MarshalEnvironment::g_typenameToIdMap["Nothing"] = BSQ_TYPE_ID_NOTHING;
-    MarshalEnvironment::g_typenameToIdMap["Bool"] = BSQ_TYPE_ID_BOOL;
-    MarshalEnvironment::g_typenameToIdMap["Nat"] = BSQ_TYPE_ID_NAT;
-    MarshalEnvironment::g_typenameToIdMap["Int"] = BSQ_TYPE_ID_INT;
-    MarshalEnvironment::g_typenameToIdMap["BigNat"] = BSQ_TYPE_ID_BIGNAT;
-    MarshalEnvironment::g_typenameToIdMap["BigInt"] = BSQ_TYPE_ID_BIGINT;
-    MarshalEnvironment::g_typenameToIdMap["Float"] = BSQ_TYPE_ID_FLOAT;
-    MarshalEnvironment::g_typenameToIdMap["Decimal"] = BSQ_TYPE_ID_DECIMAL;
-    MarshalEnvironment::g_typenameToIdMap["Rational"] = BSQ_TYPE_ID_RATIONAL;
-    MarshalEnvironment::g_typenameToIdMap["String"] = BSQ_TYPE_ID_STRING;
-    MarshalEnvironment::g_typenameToIdMap["ByteBuffer"] = BSQ_TYPE_ID_BYTEBUFFER;
-    MarshalEnvironment::g_typenameToIdMap["DateTime"] = BSQ_TYPE_ID_DATETIME;
-    MarshalEnvironment::g_typenameToIdMap["UTCDateTime"] = BSQ_TYPE_ID_UTC_DATETIME;
-    MarshalEnvironment::g_typenameToIdMap["CalendarDate"] = BSQ_TYPE_ID_CALENDAR_DATE;
-    MarshalEnvironment::g_typenameToIdMap["RelativeTime"] = BSQ_TYPE_ID_RELATIVE_TIME;
-    MarshalEnvironment::g_typenameToIdMap["TickTime"] = BSQ_TYPE_ID_TICKTIME;
-    MarshalEnvironment::g_typenameToIdMap["LogicalTime"] = BSQ_TYPE_ID_LOGICALTIME;
-    MarshalEnvironment::g_typenameToIdMap["ISOTimeStamp"] = BSQ_TYPE_ID_ISO_TIMESTAMP;
-    MarshalEnvironment::g_typenameToIdMap["UUID4"] = BSQ_TYPE_ID_UUID4;
-    MarshalEnvironment::g_typenameToIdMap["UUID7"] = BSQ_TYPE_ID_UUID7;
-    MarshalEnvironment::g_typenameToIdMap["SHAContentHash"] = BSQ_TYPE_ID_SHA_CONTENT_HASH;
-    MarshalEnvironment::g_typenameToIdMap["LatLongCoordinate"] = BSQ_TYPE_ID_LAT_LONG_COORDINATE;
-    MarshalEnvironment::g_typenameToIdMap["Regex"] = BSQ_TYPE_ID_REGEX;
+    return arg.kind == ArgumentTag::StackVal && arg.location == trgt.offset;
+}
+
+template <OpCodeTag CTAG, OpCodeTag FTAG>
+InterpOp* tryFuseCompareJumpCond(const InterpOp* cop, const InterpOp* nop)
+{
+    auto bop = static_cast<const PrimitiveBinaryCompareOp<CTAG>*>(cop);
+    auto jop = static_cast<const JumpCondOp*>(nop);
+    if(!isArgumentForTarget(jop->arg, bop->trgt))
+    {
+        return nullptr;
+    }
+
+    return new PrimitiveCompareJumpCondOp<FTAG>(bop->trgt, bop->larg, bop->rarg, jop->toffset + 1, jop->foffset + 1);
+}
+
+template <OpCodeTag ATAG, OpCodeTag FTAG>
+InterpOp* tryFuseLoadConstAdd(const InterpOp* cop, const InterpOp* nop)
+{
+    auto lop = static_cast<const LoadConstOp*>(cop);
+    auto aop = static_cast<const PrimitiveBinaryOperatorOp<ATAG>*>(nop);
+
+    bool lconst = isArgumentForTarget(aop->larg, lop->trgt);
+    bool rconst = isArgumentForTarget(aop->rarg, lop->trgt);
+    if(!lconst && !rconst)
+    {
+        return nullptr;
+    }
+
+    return new LoadConstBinaryOperatorOp<FTAG>(lop->trgt, lop->arg, lop->oftype, aop->trgt, lconst ? lop->arg : aop->larg, rconst ? lop->arg : aop->rarg);
+}
+
+InterpOp* tryFuseLoadFieldAssign(const InterpOp* cop, const InterpOp* nop)
+{
+    auto lop = static_cast<const LoadEntityFieldDirectOp*>(cop);
+    auto rop = static_cast<const RegisterAssignOp*>(nop);
+    if(rop->sguard.enabled || !isArgumentForTarget(rop->arg, lop->trgt))
+    {
+        return nullptr;
+    }
+
+    return new LoadEntityFieldDirectRegisterAssignOp(lop, rop->trgt, rop->oftype);
+}
+
+InterpOp* tryFuseOpPair(const InterpOp* cop, const InterpOp* nop)
+{
+    if(nop->tag == OpCodeTag::JumpCondOp)
+    {
+        switch(cop->tag)
+        {
+        case OpCodeTag::LtNatOp:
+            return tryFuseCompareJumpCond<OpCodeTag::LtNatOp, OpCodeTag::LtNatJumpCondOp>(cop, nop);
+        case OpCodeTag::LtIntOp:
+            return tryFuseCompareJumpCond<OpCodeTag::LtIntOp, OpCodeTag::LtIntJumpCondOp>(cop, nop);
+        case OpCodeTag::LeNatOp:
+            return tryFuseCompareJumpCond<OpCodeTag::LeNatOp, OpCodeTag::LeNatJumpCondOp>(cop, nop);
+        case OpCodeTag::LeIntOp:
+            return tryFuseCompareJumpCond<OpCodeTag::LeIntOp, OpCodeTag::LeIntJumpCondOp>(cop, nop);
+        case OpCodeTag::EqNatOp:
+            return tryFuseCompareJumpCond<OpCodeTag::EqNatOp, OpCodeTag::EqNatJumpCondOp>(cop, nop);
+        case OpCodeTag::EqIntOp:
+            return tryFuseCompareJumpCond<OpCodeTag::EqIntOp, OpCodeTag::EqIntJumpCondOp>(cop, nop);
+        case OpCodeTag::NeqNatOp:
+            return tryFuseCompareJumpCond<OpCodeTag::NeqNatOp, OpCodeTag::NeqNatJumpCondOp>(cop, nop);
+        case OpCodeTag::NeqIntOp:
+            return tryFuseCompareJumpCond<OpCodeTag::NeqIntOp, OpCodeTag::NeqIntJumpCondOp>(cop, nop);
+        default:
+            return nullptr;
+        }
+    }
+    else if(cop->tag == OpCodeTag::LoadConstOp && nop->tag == OpCodeTag::AddNatOp)
+    {
+        return tryFuseLoadConstAdd<OpCodeTag::AddNatOp, OpCodeTag::LoadConstAddNatOp>(cop, nop);
+    }
+    else if(cop->tag == OpCodeTag::LoadConstOp && nop->tag == OpCodeTag::AddIntOp)
+    {
+        return tryFuseLoadConstAdd<OpCodeTag::AddIntOp, OpCodeTag::LoadConstAddIntOp>(cop, nop);
+    }
+    else if(cop->tag == OpCodeTag::LoadEntityFieldDirectOp && nop->tag == OpCodeTag::RegisterAssignOp)
+    {
+        return tryFuseLoadFieldAssign(cop, nop);
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void fuseSuperinstructions(BSQInvokeBodyDecl* invk)
+{
+    size_t i = 0;
+    while(i + 1 < invk->body.size())
+    {
+        InterpOp* fop = tryFuseOpPair(invk->body[i], invk->body[i + 1]);
+        if(fop == nullptr)
+        {
+            i++;
+        }
+        else
+        {
+            //the second op stays in place so any jump that targets it still sees the original code
+            invk->body[i] = fop;
+            AssemblyLoadInfo::g_fusedOpCount++;
+
+            i += 2;
+        }
+    }
+}
+
+////
+//Load time optimizer -- works on one body at a time and runs before tail call detection and fusion
+
+struct OptSlotInfo
+{
+    std::optional<Argument> copyof; //slot holds the same value as this (already resolved) argument
+    bool hasconst;
+    uint64_t cval;
+    BSQTypeID ctid;
+};
+
+typedef std::map<uint32_t, OptSlotInfo> OptSlotMap;
+typedef std::map<uint32_t, BSQTypeID> OptLiteralMap;
+
+bool optIsDebugOnlyOp(const InterpOp* op)
+{
+    return op->tag == OpCodeTag::VarLifetimeStartOp || op->tag == OpCodeTag::VarLifetimeEndOp || op->tag == OpCodeTag::VarHomeLocationValueUpdate;
+}
+
+bool optSameArgument(Argument a1, Argument a2)
+{
+    return a1.kind == a2.kind && a1.location == a2.location;
+}
+
+Argument optResolveArgument(const OptSlotMap& slots, Argument arg)
+{
+    if(arg.kind == ArgumentTag::StackVal)
+    {
+        auto iter = slots.find(arg.location);
+        if(iter != slots.cend() && iter->second.copyof.has_value())
+        {
+            return iter->second.copyof.value();
+        }
+    }
+
+    return arg;
+}
+
+bool optKnownScalar(const OptSlotMap& slots, const OptLiteralMap& literals, Argument arg, BSQTypeID tid, uint64_t& val)
+{
+    if(arg.kind == ArgumentTag::Const)
+    {
+        auto liter = literals.find(arg.location);
+        if(liter == literals.cend() || liter->second != tid)
+        {
+            return false;
+        }
+
+        StorageLocationPtr sl = Evaluator::g_constantbuffer + arg.location;
+        val = (tid == BSQ_TYPE_ID_BOOL) ? (uint64_t)SLPTR_LOAD_CONTENTS_AS(BSQBool, sl) : SLPTR_LOAD_CONTENTS_AS(uint64_t, sl);
+        return true;
+    }
+    else
+    {
+        auto iter = slots.find(arg.location);
+        if(iter == slots.cend() || !iter->second.hasconst || iter->second.ctid != tid)
+        {
+            return false;
+        }
+
+        val = iter->second.cval;
+        return true;
+    }
+}
+
+void optInvalidateSlot(OptSlotMap& slots, uint32_t offset)
+{
+    slots.erase(offset);
+
+    auto iter = slots.begin();
+    while(iter != slots.end())
+    {
+        const std::optional<Argument>& cpy = iter->second.copyof;
+        if(cpy.has_value() && cpy.value().kind == ArgumentTag::StackVal && cpy.value().location == offset)
+        {
+            iter = slots.erase(iter);
+        }
+        else
+        {
+            iter++;
+        }
+    }
+}
+
+void optRecordSlot(OptSlotMap& slots, uint32_t offset, std::optional<Argument> copyof, bool hasconst, uint64_t cval, BSQTypeID ctid)
+{
+    optInvalidateSlot(slots, offset);
+
+    if(copyof.has_value() && copyof.value().kind == ArgumentTag::StackVal && copyof.value().location == offset)
+    {
+        copyof = std::nullopt;
+    }
+
+    if(copyof.has_value() || hasconst)
+    {
+        slots[offset] = OptSlotInfo{copyof, hasconst, cval, ctid};
+    }
+}
+
+template <OpCodeTag TAG>
+bool optFoldBinary(uint64_t lval, uint64_t rval, uint64_t& res, BSQTypeID& rtid)
+{
+    BSQNat ln = (BSQNat)lval;
+    BSQNat rn = (BSQNat)rval;
+    BSQInt li = (BSQInt)lval;
+    BSQInt ri = (BSQInt)rval;
+
+    //overflowing ops are left alone so the error is still raised at runtime
+    if constexpr(TAG == OpCodeTag::AddNatOp || TAG == OpCodeTag::SubNatOp || TAG == OpCodeTag::MultNatOp)
+    {
+        rtid = BSQ_TYPE_ID_NAT;
+
+        BSQNat rr = 0;
+        bool err = (TAG == OpCodeTag::AddNatOp) ? __builtin_add_overflow(ln, rn, &rr) : ((TAG == OpCodeTag::SubNatOp) ? __builtin_sub_overflow(ln, rn, &rr) : __builtin_mul_overflow(ln, rn, &rr));
+        res = (uint64_t)rr;
+        return !err;
+    }
+    else if constexpr(TAG == OpCodeTag::AddIntOp || TAG == OpCodeTag::SubIntOp || TAG == OpCodeTag::MultIntOp)
+    {
+        rtid = BSQ_TYPE_ID_INT;
+
+        BSQInt rr = 0;
+        bool err = (TAG == OpCodeTag::AddIntOp) ? __builtin_add_overflow(li, ri, &rr) : ((TAG == OpCodeTag::SubIntOp) ? __builtin_sub_overflow(li, ri, &rr) : __builtin_mul_overflow(li, ri, &rr));
+        res = (uint64_t)rr;
+        return !err;
+    }
+    else
+    {
+        rtid = BSQ_TYPE_ID_BOOL;
+
+        if constexpr(TAG == OpCodeTag::EqNatOp) { res = (ln == rn); }
+        else if constexpr(TAG == OpCodeTag::NeqNatOp) { res = (ln != rn); }
+        else if constexpr(TAG == OpCodeTag::LtNatOp) { res = (ln < rn); }
+        else if constexpr(TAG == OpCodeTag::LeNatOp) { res = (ln <= rn); }
+        else if constexpr(TAG == OpCodeTag::EqIntOp) { res = (li == ri); }
+        else if constexpr(TAG == OpCodeTag::NeqIntOp) { res = (li != ri); }
+        else if constexpr(TAG == OpCodeTag::LtIntOp) { res = (li < ri); }
+        else { res = (li <= ri); }
+
+        return true;
+    }
+}
+
+template <OpCodeTag TAG, typename OPTYPE>
+InterpOp* optPropagateBinaryOp(const InterpOp* op, OptSlotMap& slots, const OptLiteralMap& literals, BSQTypeID argtid)
+{
+    auto bop = static_cast<const OPTYPE*>(op);
+    Argument larg = optResolveArgument(slots, bop->larg);
+    Argument rarg = optResolveArgument(slots, bop->rarg);
+
+    uint64_t lval = 0;
+    uint64_t rval = 0;
+    uint64_t res = 0;
+    BSQTypeID rtid = BSQ_TYPE_ID_NONE;
+    if(optKnownScalar(slots, literals, larg, argtid, lval) && optKnownScalar(slots, literals, rarg, argtid, rval) && optFoldBinary<TAG>(lval, rval, res, rtid))
+    {
+        optRecordSlot(slots, bop->trgt.offset, std::nullopt, true, res, rtid);
+
+        AssemblyLoadInfo::g_foldedOpCount++;
+        return new LoadFoldedConstOp(bop->trgt, BSQType::g_typetable[rtid], res);
+    }
+
+    optInvalidateSlot(slots, bop->trgt.offset);
+    if(optSameArgument(larg, bop->larg) && optSameArgument(rarg, bop->rarg))
+    {
+        return nullptr;
+    }
+
+    return new OPTYPE(bop->trgt, bop->oftype, larg, rarg);
+}
+
+//Returns the replacement for op (or nullptr if it is unchanged) and updates the known slot values -- anything we don't model clears them
+InterpOp* optPropagateOp(const InterpOp* op, OptSlotMap& slots, const OptLiteralMap& literals)
+{
+    switch(op->tag)
+    {
+    case OpCodeTag::LoadConstOp:
+    {
+        auto lop = static_cast<const LoadConstOp*>(op);
+
+        uint64_t cval = 0;
+        BSQTypeID ctid = lop->oftype->tid;
+        bool hasconst = optKnownScalar(slots, literals, lop->arg, ctid, cval);
+        optRecordSlot(slots, lop->trgt.offset, std::make_optional(lop->arg), hasconst, cval, ctid);
+        return nullptr;
+    }
+    case OpCodeTag::DirectAssignOp:
+    case OpCodeTag::RegisterAssignOp:
+    {
+        bool isdirect = (op->tag == OpCodeTag::DirectAssignOp);
+        auto daop = static_cast<const DirectAssignOp*>(op);
+        auto raop = static_cast<const RegisterAssignOp*>(op);
+        if(isdirect ? daop->sguard.enabled : raop->sguard.enabled)
+        {
+            slots.clear();
+            return nullptr;
+        }
+
+        TargetVar trgt = isdirect ? daop->trgt : raop->trgt;
+        Argument oarg = isdirect ? daop->arg : raop->arg;
+        const BSQType* atype = isdirect ? daop->intotype : raop->oftype;
+
+        Argument arg = optResolveArgument(slots, oarg);
+        uint64_t cval = 0;
+        bool hasconst = optKnownScalar(slots, literals, arg, atype->tid, cval);
+        optRecordSlot(slots, trgt.offset, std::make_optional(arg), hasconst, cval, atype->tid);
+
+        if(optSameArgument(arg, oarg))
+        {
+            return nullptr;
+        }
+
+        AssemblyLoadInfo::g_propagatedCopyCount++;
+        if(isdirect)
+        {
+            return new DirectAssignOp(trgt, atype, arg, daop->sguard);
+        }
+        else
+        {
+            return new RegisterAssignOp(trgt, arg, atype, raop->sguard);
+        }
+    }
+    case OpCodeTag::ReturnAssignOp:
+    {
+        auto rop = static_cast<const ReturnAssignOp*>(op);
+        Argument arg = optResolveArgument(slots, rop->arg);
+        optInvalidateSlot(slots, rop->trgt.offset);
+
+        if(optSameArgument(arg, rop->arg))
+        {
+            return nullptr;
+        }
+
+        AssemblyLoadInfo::g_propagatedCopyCount++;
+        return new ReturnAssignOp(rop->trgt, arg, rop->oftype);
+    }
+    case OpCodeTag::PrefixNotOp:
+    {
+        auto nop = static_cast<const PrefixNotOp*>(op);
+        Argument arg = optResolveArgument(slots, nop->arg);
+
+        uint64_t bval = 0;
+        if(optKnownScalar(slots, literals, arg, BSQ_TYPE_ID_BOOL, bval))
+        {
+            optRecordSlot(slots, nop->trgt.offset, std::nullopt, true, (uint64_t)!bval, BSQ_TYPE_ID_BOOL);
+
+            AssemblyLoadInfo::g_foldedOpCount++;
+            return new LoadFoldedConstOp(nop->trgt, BSQWellKnownType::g_typeBool, (uint64_t)!bval);
+        }
+
+        optInvalidateSlot(slots, nop->trgt.offset);
+        return optSameArgument(arg, nop->arg) ? nullptr : new PrefixNotOp(nop->trgt, arg);
+    }
+    case OpCodeTag::AddNatOp:
+        return optPropagateBinaryOp<OpCodeTag::AddNatOp, PrimitiveBinaryOperatorOp<OpCodeTag::AddNatOp>>(op, slots, literals, BSQ_TYPE_ID_NAT);
+    case OpCodeTag::SubNatOp:
+        return optPropagateBinaryOp<OpCodeTag::SubNatOp, PrimitiveBinaryOperatorOp<OpCodeTag::SubNatOp>>(op, slots, literals, BSQ_TYPE_ID_NAT);
+    case OpCodeTag::MultNatOp:
+        return optPropagateBinaryOp<OpCodeTag::MultNatOp, PrimitiveBinaryOperatorOp<OpCodeTag::MultNatOp>>(op, slots, literals, BSQ_TYPE_ID_NAT);
+    case OpCodeTag::AddIntOp:
+        return optPropagateBinaryOp<OpCodeTag::AddIntOp, PrimitiveBinaryOperatorOp<OpCodeTag::AddIntOp>>(op, slots, literals, BSQ_TYPE_ID_INT);
+    case OpCodeTag::SubIntOp:
+        return optPropagateBinaryOp<OpCodeTag::SubIntOp, PrimitiveBinaryOperatorOp<OpCodeTag::SubIntOp>>(op, slots, literals, BSQ_TYPE_ID_INT);
+    case OpCodeTag::MultIntOp:
+        return optPropagateBinaryOp<OpCodeTag::MultIntOp, PrimitiveBinaryOperatorOp<OpCodeTag::MultIntOp>>(op, slots, literals, BSQ_TYPE_ID_INT);
+    case OpCodeTag::EqNatOp:
+        return optPropagateBinaryOp<OpCodeTag::EqNatOp, PrimitiveBinaryCompareOp<OpCodeTag::EqNatOp>>(op, slots, literals, BSQ_TYPE_ID_NAT);
+    case OpCodeTag::NeqNatOp:
+        return optPropagateBinaryOp<OpCodeTag::NeqNatOp, PrimitiveBinaryCompareOp<OpCodeTag::NeqNatOp>>(op, slots, literals, BSQ_TYPE_ID_NAT);
+    case OpCodeTag::LtNatOp:
+        return optPropagateBinaryOp<OpCodeTag::LtNatOp, PrimitiveBinaryCompareOp<OpCodeTag::LtNatOp>>(op, slots, literals, BSQ_TYPE_ID_NAT);
+    case OpCodeTag::LeNatOp:
+        return optPropagateBinaryOp<OpCodeTag::LeNatOp, PrimitiveBinaryCompareOp<OpCodeTag::LeNatOp>>(op, slots, literals, BSQ_TYPE_ID_NAT);
+    case OpCodeTag::EqIntOp:
+        return optPropagateBinaryOp<OpCodeTag::EqIntOp, PrimitiveBinaryCompareOp<OpCodeTag::EqIntOp>>(op, slots, literals, BSQ_TYPE_ID_INT);
+    case OpCodeTag::NeqIntOp:
+        return optPropagateBinaryOp<OpCodeTag::NeqIntOp, PrimitiveBinaryCompareOp<OpCodeTag::NeqIntOp>>(op, slots, literals, BSQ_TYPE_ID_INT);
+    case OpCodeTag::LtIntOp:
+        return optPropagateBinaryOp<OpCodeTag::LtIntOp, PrimitiveBinaryCompareOp<OpCodeTag::LtIntOp>>(op, slots, literals, BSQ_TYPE_ID_INT);
+    case OpCodeTag::LeIntOp:
+        return optPropagateBinaryOp<OpCodeTag::LeIntOp, PrimitiveBinaryCompareOp<OpCodeTag::LeIntOp>>(op, slots, literals, BSQ_TYPE_ID_INT);
+    case OpCodeTag::JumpCondOp:
+    {
+        //end of a block either way
+        auto jop = static_cast<const JumpCondOp*>(op);
+        Argument arg = optResolveArgument(slots, jop->arg);
+
+        uint64_t bval = 0;
+        bool known = optKnownScalar(slots, literals, arg, BSQ_TYPE_ID_BOOL, bval);
+        slots.clear();
+
+        if(known)
+        {
+            AssemblyLoadInfo::g_foldedOpCount++;
+            return bval ? new JumpOp(jop->toffset, jop->tlabel) : new JumpOp(jop->foffset, jop->flabel);
+        }
+
+        return optSameArgument(arg, jop->arg) ? nullptr : new JumpCondOp(arg, jop->toffset, jop->foffset, jop->tlabel, jop->flabel);
+    }
+    default:
+    {
+        slots.clear();
+        return nullptr;
+    }
+    }
+}
+
+bool optIsJumpOp(const InterpOp* op)
+{
+    return op->tag == OpCodeTag::JumpOp || op->tag == OpCodeTag::JumpCondOp || op->tag == OpCodeTag::JumpNoneOp;
+}
+
+template <typename FN>
+void optForEachJumpTarget(const InterpOp* op, size_t pos, FN fn)
+{
+    if(op->tag == OpCodeTag::JumpOp)
+    {
+        fn(pos + static_cast<const JumpOp*>(op)->offset);
+    }
+    else if(op->tag == OpCodeTag::JumpCondOp)
+    {
+        fn(pos + static_cast<const JumpCondOp*>(op)->toffset);
+        fn(pos + static_cast<const JumpCondOp*>(op)->foffset);
+    }
+    else
+    {
+        fn(pos + static_cast<const JumpNoneOp*>(op)->noffset);
+        fn(pos + static_cast<const JumpNoneOp*>(op)->soffset);
+    }
+}
+
+//Rebuild a jump at (old) position pos that is moving to newpos with each (old) target mapped through mapfn
+template <typename MAPFN>
+InterpOp* optRetargetJump(const InterpOp* op, size_t pos, size_t newpos, MAPFN mapfn)
+{
+    if(op->tag == OpCodeTag::JumpOp)
+    {
+        auto jop = static_cast<const JumpOp*>(op);
+        return new JumpOp((uint32_t)(mapfn(pos + jop->offset) - newpos), jop->label);
+    }
+    else if(op->tag == OpCodeTag::JumpCondOp)
+    {
+        auto jop = static_cast<const JumpCondOp*>(op);
+        return new JumpCondOp(jop->arg, (uint32_t)(mapfn(pos + jop->toffset) - newpos), (uint32_t)(mapfn(pos + jop->foffset) - newpos), jop->tlabel, jop->flabel);
+    }
+    else
+    {
+        auto jop = static_cast<const JumpNoneOp*>(op);
+        return new JumpNoneOp(jop->arg, jop->arglayout, (uint32_t)(mapfn(pos + jop->noffset) - newpos), (uint32_t)(mapfn(pos + jop->soffset) - newpos), jop->nlabel, jop->slabel);
+    }
+}
+
+//Follow removed ops and unconditional jumps from trgt to the op that will actually execute
+size_t optFinalJumpTarget(const std::vector<InterpOp*>& body, const std::vector<bool>& removed, size_t trgt)
+{
+    while(trgt < body.size())
+    {
+        if(removed[trgt])
+        {
+            trgt++;
+        }
+        else if(body[trgt]->tag == OpCodeTag::JumpOp && static_cast<const JumpOp*>(body[trgt])->offset != 0)
+        {
+            trgt += static_cast<const JumpOp*>(body[trgt])->offset;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return trgt;
+}
+
+void optimizeBody(BSQInvokeBodyDecl* invk, const OptLiteralMap& literals)
+{
+    size_t opcount = invk->body.size();
+    std::vector<bool> removed(opcount, false);
+    std::vector<bool> jtargets(opcount + 1, false);
+    for(size_t i = 0; i < opcount; ++i)
+    {
+        const InterpOp* op = invk->body[i];
+        removed[i] = optIsDebugOnlyOp(op);
+
+        if(optIsJumpOp(op))
+        {
+            optForEachJumpTarget(op, i, [&jtargets](size_t trgt) {
+                jtargets[trgt] = true;
+            });
+        }
+    }
+
+    //values are only tracked within a block so clear everything at each jump target
+    OptSlotMap slots;
+    for(size_t i = 0; i < opcount; ++i)
+    {
+        if(jtargets[i])
+        {
+            slots.clear();
+        }
+
+        if(!removed[i])
+        {
+            InterpOp* rop = optPropagateOp(invk->body[i], slots, literals);
+            if(rop != nullptr)
+            {
+                invk->body[i] = rop;
+            }
+        }
+    }
+
+    //all jumps are forward so a single pass finds the ops that are no longer reachable after branch folding
+    std::vector<bool> reachable(opcount + 1, false);
+    reachable[0] = true;
+    for(size_t i = 0; i < opcount; ++i)
+    {
+        if(!reachable[i])
+        {
+            removed[i] = true;
+            continue;
+        }
+
+        if(optIsJumpOp(invk->body[i]))
+        {
+            optForEachJumpTarget(invk->body[i], i, [&reachable](size_t trgt) {
+                reachable[trgt] = true;
+            });
+        }
+        else
+        {
+            reachable[i + 1] = true;
+        }
+    }
+
+    //jumps to jumps go straight to the final target and a jump to the next live op is dropped
+    for(size_t i = 0; i < opcount; ++i)
+    {
+        if(!removed[i] && optIsJumpOp(invk->body[i]))
+        {
+            invk->body[i] = optRetargetJump(invk->body[i], i, i, [&](size_t trgt) {
+                return optFinalJumpTarget(invk->body, removed, trgt);
+            });
+
+            if(invk->body[i]->tag == OpCodeTag::JumpOp)
+            {
+                size_t trgt = i + static_cast<const JumpOp*>(invk->body[i])->offset;
+                removed[i] = (trgt == optFinalJumpTarget(invk->body, removed, i + 1));
+            }
+        }
+    }
+
+    std::vector<size_t> newidx(opcount + 1, 0);
+    size_t livecount = 0;
+    for(size_t i = 0; i < opcount; ++i)
+    {
+        newidx[i] = livecount;
+        livecount += removed[i] ? 0 : 1;
+    }
+    newidx[opcount] = livecount;
+
+    if(livecount == opcount)
+    {
+        return;
+    }
+
+    std::vector<InterpOp*> nbody;
+    std::vector<InterpOpSourceEntry> nsrcinfo;
+    for(size_t i = 0; i < opcount; ++i)
+    {
+        if(removed[i])
+        {
+            AssemblyLoadInfo::g_removedOpCount++;
+            continue;
+        }
+
+        InterpOp* op = invk->body[i];
+        if(optIsJumpOp(op))
+        {
+            op = optRetargetJump(op, i, newidx[i], [&newidx](size_t trgt) {
+                return newidx[trgt];
+            });
+        }
+
+        nbody.push_back(op);
+        nsrcinfo.push_back(invk->bodysrcinfo[i]);
+    }
+
+    invk->body = std::move(nbody);
+    invk->bodysrcinfo = std::move(nsrcinfo);
+}
+
+InterpOp* tryMakeSelfTailCall(const BSQInvokeBodyDecl* invk, size_t i)
+{
+    const InterpOp* cop = invk->body[i];
+    const InterpOp* nop = invk->body[i + 1];
+    if(cop->tag != OpCodeTag::InvokeFixedFunctionOp || nop->tag != OpCodeTag::ReturnAssignOp)
+    {
+        return nullptr;
+    }
+
+    auto iop = static_cast<const InvokeFixedFunctionOp*>(cop);
+    auto rop = static_cast<const ReturnAssignOp*>(nop);
+    if(iop->invokeId != invk->ikey || iop->sguard.enabled || iop->optmaskoffset != -1)
+    {
+        return nullptr;
+    }
+
+    if(!isArgumentForTarget(rop->arg, iop->trgt) || rop->oftype != iop->trgttype)
+    {
+        return nullptr;
+    }
+
+    //the return must end the body -- either directly or via the jump to the (empty) exit block
+    size_t rpos = i + 2;
+    if(rpos != invk->body.size())
+    {
+        const InterpOp* jop = invk->body[rpos];
+        if(jop->tag != OpCodeTag::JumpOp || rpos + static_cast<const JumpOp*>(jop)->offset != invk->body.size())
+        {
+            return nullptr;
+        }
+    }
+
+    size_t argbytes = 0;
+    for(size_t j = 0; j < invk->params.size(); ++j)
+    {
+        argbytes += invk->params[j].ptype->allocinfo.inlinedatasize;
+    }
+
+    return new InvokeSelfTailCallOp(iop, argbytes);
+}
+
+void eliminateSelfTailCalls(BSQInvokeBodyDecl* invk)
+{
+    if(!invk->recursive)
+    {
+        return;
+    }
+
+    for(size_t i = 0; i + 1 < invk->body.size(); ++i)
+    {
+        InterpOp* top = tryMakeSelfTailCall(invk, i);
+        if(top != nullptr)
+        {
+            //the ReturnAssignOp stays in place (it is just never reached from the tail call)
+            invk->body[i] = top;
+            AssemblyLoadInfo::g_tailCallCount++;
+        }
+    }
+}
+
+void buildTypeDispatchTables()
+{
+    size_t vcount = MarshalEnvironment::g_vinvokeToIdMap.size();
+    size_t bitwords = (BSQType::g_typeTableSize + 63) / 64;
+
+    for(size_t i = 0; i < BSQType::g_typeTableSize; ++i)
+    {
+        BSQType* tt = const_cast<BSQType*>(BSQType::g_typetable[i]);
+        if(tt == nullptr)
+        {
+            continue;
+        }
+
+        if(!tt->vtable.empty())
+        {
+            tt->vdispatch = (BSQInvokeID*)xalloc(vcount * sizeof(BSQInvokeID));
+            std::fill(tt->vdispatch, tt->vdispatch + vcount, UINT32_MAX);
+
+            std::for_each(tt->vtable.cbegin(), tt->vtable.cend(), [tt](const std::pair<BSQVirtualInvokeID, BSQInvokeID>& ventry) {
+                tt->vdispatch[ventry.first] = ventry.second;
+            });
+        }
+
+        if(tt->isUnion())
+        {
+            BSQUnionType* ut = static_cast<BSQUnionType*>(tt);
+            ut->subtypebits = (uint64_t*)zxalloc(bitwords * sizeof(uint64_t));
+
+            std::for_each(ut->subtypes.cbegin(), ut->subtypes.cend(), [ut](BSQTypeID stid) {
+                ut->subtypebits[stid / 64] |= (0x1ul << (stid % 64));
+            });
+        }
+    }
+}
+
+void initialize(size_t cbuffsize, const RefMask cmask)
+{
+    MarshalEnvironment::g_typenameToIdMap["None"] = BSQ_TYPE_ID_NONE;
+    MarshalEnvironment::g_typenameToIdMap["Nothing"] = BSQ_TYPE_ID_NOTHING;
+    MarshalEnvironment::g_typenameToIdMap["Bool"] = BSQ_TYPE_ID_BOOL;
+    MarshalEnvironment::g_typenameToIdMap["Nat"] = BSQ_TYPE_ID_NAT;
+    MarshalEnvironment::g_typenameToIdMap["Int"] = BSQ_TYPE_ID_INT;
+    MarshalEnvironment::g_typenameToIdMap["BigNat"] = BSQ_TYPE_ID_BIGNAT;
+    MarshalEnvironment::g_typenameToIdMap["BigInt"] = BSQ_TYPE_ID_BIGINT;
+    MarshalEnvironment::g_typenameToIdMap["Float"] = BSQ_TYPE_ID_FLOAT;
+    MarshalEnvironment::g_typenameToIdMap["Decimal"] = BSQ_TYPE_ID_DECIMAL;
+    MarshalEnvironment::g_typenameToIdMap["Rational"] = BSQ_TYPE_ID_RATIONAL;
+    MarshalEnvironment::g_typenameToIdMap["String"] = BSQ_TYPE_ID_STRING;
+    MarshalEnvironment::g_typenameToIdMap["ByteBuffer"] = BSQ_TYPE_ID_BYTEBUFFER;
+    MarshalEnvironment::g_typenameToIdMap["DateTime"] = BSQ_TYPE_ID_DATETIME;
+    MarshalEnvironment::g_typenameToIdMap["UTCDateTime"] = BSQ_TYPE_ID_UTC_DATETIME;
+    MarshalEnvironment::g_typenameToIdMap["CalendarDate"] = BSQ_TYPE_ID_CALENDAR_DATE;
+    MarshalEnvironment::g_typenameToIdMap["RelativeTime"] = BSQ_TYPE_ID_RELATIVE_TIME;
+    MarshalEnvironment::g_typenameToIdMap["TickTime"] = BSQ_TYPE_ID_TICKTIME;
+    MarshalEnvironment::g_typenameToIdMap["LogicalTime"] = BSQ_TYPE_ID_LOGICALTIME;
+    MarshalEnvironment::g_typenameToIdMap["ISOTimeStamp"] = BSQ_TYPE_ID_ISO_TIMESTAMP;
+    MarshalEnvironment::g_typenameToIdMap["UUID4"] = BSQ_TYPE_ID_UUID4;
+    MarshalEnvironment::g_typenameToIdMap["UUID7"] = BSQ_TYPE_ID_UUID7;
+    MarshalEnvironment::g_typenameToIdMap["SHAContentHash"] = BSQ_TYPE_ID_SHA_CONTENT_HASH;
+    MarshalEnvironment::g_typenameToIdMap["LatLongCoordinate"] = BSQ_TYPE_ID_LAT_LONG_COORDINATE;
+    MarshalEnvironment::g_typenameToIdMap["Regex"] = BSQ_TYPE_ID_REGEX;
+
+    std::string globalname = "[GlobalObject]";
+    const BSQType* globaltype = new BSQGlobalObjectType(cbuffsize, cmask, globalname);
+
+    Allocator::GlobalAllocator.setGlobalsMemory(globaltype);
+
+    Evaluator::g_constantbuffer = (uint8_t*)GCStack::global_memory->data;
+}
+
+void completeLoad()
+{
+    Allocator::GlobalAllocator.completeGlobalInitialization();
+}
+
+void initializeLiteral(size_t storageOffset, const BSQType* gtype, std::string& lval)
+{
+    StorageLocationPtr sl = Evaluator::g_constantbuffer + storageOffset;
+    switch (gtype->tid)
+    {
+    case BSQ_TYPE_ID_NONE: {
+        break;
+    }
+    case BSQ_TYPE_ID_NOTHING: {
+        break;
+    }
+    case BSQ_TYPE_ID_BOOL: {
+        dynamic_cast<const BSQRegisterType<BSQBool>*>(BSQWellKnownType::g_typeBool)->storeValueDirect(sl, (BSQBool)(lval == "true"));
+        break;
+    }
+    case BSQ_TYPE_ID_NAT: {
+        dynamic_cast<const BSQRegisterType<BSQNat>*>(BSQWellKnownType::g_typeNat)->storeValueDirect(sl, std::stoull(lval.substr(0, lval.size() - 1)));
+        break;
+    }
+    case BSQ_TYPE_ID_INT: {
+        dynamic_cast<const BSQRegisterType<BSQInt>*>(BSQWellKnownType::g_typeInt)->storeValueDirect(sl, std::stoll(lval.substr(0, lval.size() - 1)));
+        break;
+    }
+    case BSQ_TYPE_ID_BIGNAT: {
+        dynamic_cast<const BSQBigNumType<BSQBigNat>*>(BSQWellKnownType::g_typeBigNat)->storeValueDirect(sl, std::stoull(lval.substr(0, lval.size() - 1)));
+        break;
+    }
+    case BSQ_TYPE_ID_BIGINT: {
+        dynamic_cast<const BSQBigNumType<BSQBigInt>*>(BSQWellKnownType::g_typeBigInt)->storeValueDirect(sl, std::stoll(lval.substr(0, lval.size() - 1)));
+        break;
+    }
+    case BSQ_TYPE_ID_FLOAT: {
+        dynamic_cast<const BSQRegisterType<BSQFloat>*>(BSQWellKnownType::g_typeFloat)->storeValueDirect(sl, std::stod(lval.substr(0, lval.size() - 1)));
+        break;
+    }
+    case BSQ_TYPE_ID_DECIMAL: {
+        dynamic_cast<const BSQRegisterType<BSQDecimal>*>(BSQWellKnownType::g_typeDecimal)->storeValueDirect(sl, std::stod(lval.substr(0, lval.size() - 1)));
+        break;
+    }
+    case BSQ_TYPE_ID_RATIONAL: {
+        assert(false);
+        break;
+    }
+    case BSQ_TYPE_ID_STRING: {
+        std::string sstr = lval.substr(1, lval.size() - 2);
+        //
+        //TODO: need to string unescape here
+        //
+
+        BSQString s = g_emptyString;
+        if(sstr.size() == 0)
+        {
+            //already empty
+        }
+        else if(sstr.size() < 16) 
+        {
+            s.u_inlineString = BSQInlineString::create((const uint8_t*)sstr.c_str(), sstr.size());
+        }
+        else if(sstr.size() <= 128)
+        {
+            auto stp = BSQStringKReprTypeAbstract::selectKReprForSize(sstr.size());
+
+            s.u_data = Allocator::GlobalAllocator.allocateDynamic(stp);
+            BSQ_MEM_COPY(s.u_data, sstr.c_str(), sstr.size());
+        }
+        else
+        {
+            //
+            //TODO: split the string into multiple parts
+            //
+            assert(false);
+        }
+
+        dynamic_cast<const BSQStringImplType*>(BSQWellKnownType::g_typeString)->storeValueDirect(sl, s);
+        break;
+    }
+    case BSQ_TYPE_ID_REGEX: {
+        auto reptr = Evaluator::g_regexs.at(lval);
+        dynamic_cast<const BSQRegisterType<void*>*>(BSQWellKnownType::g_typeRegex)->storeValueDirect(sl, (void*)reptr);
+        break;
+    }
+    default:
+        assert(false);
+        break;
+    }
+}
+
+void initializeConst(Evaluator& runner, size_t storageOffset, BSQInvokeID ikey, const BSQType* gtype)
+{
+    auto ccall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[ikey]);
+
+    runner.invokeGlobalCons(ccall, Evaluator::g_constantbuffer + storageOffset, gtype, ccall->resultArg);
+}
+
+void prepareBody(BSQInvokeBodyDecl* bdecl, Evaluator& ee)
+{
+    if(AssemblyLoadInfo::g_dooptimize)
+    {
+        optimizeBody(bdecl, AssemblyLoadInfo::g_literalTypes);
+    }
+
+    if(AssemblyLoadInfo::g_dofusion)
+    {
+        eliminateSelfTailCalls(bdecl);
+        fuseSuperinstructions(bdecl);
+    }
+
+    ee.resolveDispatchTable(bdecl);
+}
+
+void materializeBody(const BSQInvokeBodyDecl* invk, Evaluator& ee)
+{
+    BSQInvokeBodyDecl* bdecl = const_cast<BSQInvokeBodyDecl*>(invk);
+
+    bdecl->materializeOps();
+    prepareBody(bdecl, ee);
+
+    AssemblyLoadInfo::g_materializedBodyCount++;
+}
+
+//Every type an object in the global heap can have -- snapshots refer to types by their position here so the order must only depend on the assembly
+std::vector<const BSQType*> snapshotTypeUniverse()
+{
+    std::vector<const BSQType*> tuniv(BSQType::g_typetable, BSQType::g_typetable + BSQType::g_typeTableSize);
+
+    tuniv.push_back(BSQWellKnownType::g_typeStringKRepr16);
+    tuniv.push_back(BSQWellKnownType::g_typeStringKRepr32);
+    tuniv.push_back(BSQWellKnownType::g_typeStringKRepr64);
+    tuniv.push_back(BSQWellKnownType::g_typeStringKRepr96);
+    tuniv.push_back(BSQWellKnownType::g_typeStringKRepr128);
+    tuniv.push_back(BSQWellKnownType::g_typeStringTreeRepr);
+    tuniv.push_back(BSQWellKnownType::g_typeByteBufferLeaf);
+    tuniv.push_back(BSQWellKnownType::g_typeByteBufferNode);
+
+    for(auto iter = BSQListOps::g_flavormap.cbegin(); iter != BSQListOps::g_flavormap.cend(); ++iter)
+    {
+        tuniv.push_back(iter->second.pv4type);
+        tuniv.push_back(iter->second.pv8type);
+        tuniv.push_back(iter->second.treetype);
+    }
+
+    for(auto iter = BSQMapOps::g_flavormap.cbegin(); iter != BSQMapOps::g_flavormap.cend(); ++iter)
+    {
+        tuniv.push_back(iter->second.treetype);
+    }
+
+    return tuniv;
+}
+
+//Regex values are pointers into the (per process) regex table stored under a no-ref mask so we cannot relocate them -- unions are checked when they are written
+bool snapshotLayoutsHaveRegex()
+{
+    for(size_t i = 0; i < BSQType::g_typeTableSize; ++i)
+    {
+        const BSQType* tt = BSQType::g_typetable[i];
+        if(tt == nullptr)
+        {
+            continue;
+        }
+
+        std::vector<BSQTypeID> ctypes;
+        if(dynamic_cast<const BSQTupleInfo*>(tt) != nullptr)
+        {
+            ctypes = dynamic_cast<const BSQTupleInfo*>(tt)->ttypes;
+        }
+        else if(dynamic_cast<const BSQRecordInfo*>(tt) != nullptr)
+        {
+            ctypes = dynamic_cast<const BSQRecordInfo*>(tt)->rtypes;
+        }
+        else if(dynamic_cast<const BSQEntityInfo*>(tt) != nullptr)
+        {
+            ctypes = dynamic_cast<const BSQEntityInfo*>(tt)->ftypes;
+        }
+
+        if(std::find(ctypes.cbegin(), ctypes.cend(), BSQ_TYPE_ID_REGEX) != ctypes.cend())
+        {
+            return true;
+        }
+    }
+
+    auto lregex = std::find_if(BSQListOps::g_flavormap.cbegin(), BSQListOps::g_flavormap.cend(), [](const auto& lf) {
+        return lf.second.entrytype->tid == BSQ_TYPE_ID_REGEX;
+    });
+
+    auto mregex = std::find_if(BSQMapOps::g_flavormap.cbegin(), BSQMapOps::g_flavormap.cend(), [](const auto& mf) {
+        return mf.second.keytype->tid == BSQ_TYPE_ID_REGEX || mf.second.valuetype->tid == BSQ_TYPE_ID_REGEX;
+    });
+
+    return lregex != BSQListOps::g_flavormap.cend() || mregex != BSQMapOps::g_flavormap.cend();
+}
+
+uint64_t snapshotHash(const char* bytes, size_t count, uint64_t h)
+{
+    for(size_t i = 0; i < count; ++i)
+    {
+        h = (h ^ (uint8_t)bytes[i]) * 0x100000001b3ull;
+    }
+
+    return h;
+}
+
+//Snapshots from a different build of the interpreter are never trusted -- the object representations are compiled in
+uint64_t snapshotBuildId()
+{
+    const char* buildstr = __DATE__ " " __TIME__;
+    return snapshotHash(buildstr, strlen(buildstr), 0xcbf29ce484222325ull);
+}
+
+GlobalSnapshotTypeLayout snapshotTypeLayout(const BSQType* tt)
+{
+    GlobalSnapshotTypeLayout ll = {0, 0, 0};
+    if(tt != nullptr)
+    {
+        ll.heapsize = tt->allocinfo.heapsize;
+        ll.inlinedatasize = tt->allocinfo.inlinedatasize;
+
+        uint64_t h = 0xcbf29ce484222325ull;
+        if(tt->allocinfo.heapmask != nullptr)
+        {
+            h = snapshotHash(tt->allocinfo.heapmask, strlen(tt->allocinfo.heapmask), h);
+        }
+        h = snapshotHash("|", 1, h);
+        if(tt->allocinfo.inlinedmask != nullptr)
+        {
+            h = snapshotHash(tt->allocinfo.inlinedmask, strlen(tt->allocinfo.inlinedmask), h);
+        }
+        ll.maskhash = h;
+    }
+
+    return ll;
+}
+
+//Walk the reference slots of a value with the same mask semantics as the collector -- fref is called on each (non-inline) reference slot and ftype on each union type word (returning the real type or nullptr to stop)
+template <typename FRef, typename FType>
+bool snapshotVisitSlots(void** slots, RefMask mask, FRef fref, FType ftype)
+{
+    void** cslot = slots;
+    for(RefMask cmaskop = mask; *cmaskop; ++cmaskop, ++cslot)
+    {
+        bool ok = true;
+        switch(*cmaskop)
+        {
+            case PTR_FIELD_MASK_NOP:
+            case PTR_FIELD_MASK_BIGNUM:
+                break;
+            case PTR_FIELD_MASK_PTR:
+                ok = fref(cslot);
+                break;
+            case PTR_FIELD_MASK_STRING:
+                ok = IS_INLINE_STRING(cslot) || fref(cslot);
+                break;
+            case PTR_FIELD_MASK_COLLECTION:
+                ok = IS_EMPTY_COLLECTION(*cslot) || fref(cslot);
+                break;
+            default: {
+                const BSQType* umeta = ftype(cslot);
+                if(umeta == nullptr)
+                {
+                    return false;
+                }
+
+                auto visitfp = umeta->gcops.fpProcessObjVisit;
+                if(visitfp == gcProcessHeapOperator_inlineImpl)
+                {
+                    ok = snapshotVisitSlots(cslot + 1, umeta->allocinfo.inlinedmask, fref, ftype);
+                }
+                else if(visitfp == gcProcessHeapOperator_refImpl)
+                {
+                    ok = fref(cslot + 1);
+                }
+                else if(visitfp == gcProcessHeapOperator_stringImpl)
+                {
+                    ok = IS_INLINE_STRING(cslot + 1) || fref(cslot + 1);
+                }
+                else if(visitfp == gcProcessHeapOperator_collectionImpl)
+                {
+                    ok = IS_EMPTY_COLLECTION(*(cslot + 1)) || fref(cslot + 1);
+                }
+                else
+                {
+                    ok = (visitfp == gcProcessHeapOperator_nopImpl || visitfp == gcProcessHeapOperator_bignumImpl);
+                }
+                break;
+            }
+        }
+
+        if(!ok)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+struct GlobalSnapshotWriter
+{
+    std::map<const BSQType*, uint64_t> typeidx;
+    std::map<void*, uint64_t> objidx;
+
+    std::vector<uint8_t> objbytes;
+    uint64_t objcount;
+
+    bool encodeSlots(uint8_t* data, RefMask mask)
+    {
+        auto fref = [this](void** slot) {
+            uint64_t idx = 0;
+            if(*slot != nullptr && !this->encodeObject(*slot, idx))
+            {
+                return false;
+            }
+
+            *slot = (void*)idx;
+            return true;
+        };
+
+        auto ftype = [this](void** slot) -> const BSQType* {
+            const BSQType* umeta = (const BSQType*)(*slot);
+            auto tii = this->typeidx.find(umeta);
+            if(umeta == nullptr || umeta->tid == BSQ_TYPE_ID_REGEX || tii == this->typeidx.cend())
+            {
+                return nullptr;
+            }
+
+            *slot = (void*)(tii->second + 1);
+            return umeta;
+        };
+
+        return snapshotVisitSlots((void**)data, mask, fref, ftype);
+    }
+
+    //Objects are written after everything they point to so the reader can patch each one as soon as it is allocated
+    //Uses an explicit worklist (not recursion) since deep lists and trees in the globals would otherwise overflow the native stack
+    bool encodeObject(void* root, uint64_t& idx)
+    {
+        std::vector<std::pair<void*, bool>> worklist = {std::make_pair(root, false)};
+        std::set<void*> pending;
+
+        while(!worklist.empty())
+        {
+            void* obj = worklist.back().first;
+            if(this->objidx.find(obj) != this->objidx.cend())
+            {
+                worklist.pop_back();
+                continue;
+            }
+
+            const BSQType* otype = PAGE_MASK_EXTRACT_ADDR(obj)->btype;
+            auto tii = this->typeidx.find(otype);
+            if(tii == this->typeidx.cend())
+            {
+                return false;
+            }
+
+            std::vector<uint8_t> obytes((uint8_t*)obj, (uint8_t*)obj + otype->allocinfo.heapsize);
+            if(!worklist.back().second)
+            {
+                //first visit -- queue the children that are not written yet and come back once they are
+                if(!pending.insert(obj).second)
+                {
+                    return false;
+                }
+                worklist.back().second = true;
+
+                if(!otype->isLeaf())
+                {
+                    auto fchild = [this, &worklist](void** slot) {
+                        if(*slot != nullptr && this->objidx.find(*slot) == this->objidx.cend())
+                        {
+                            worklist.push_back(std::make_pair(*slot, false));
+                        }
+                        return true;
+                    };
+
+                    auto ftype = [this](void** slot) -> const BSQType* {
+                        const BSQType* umeta = (const BSQType*)(*slot);
+                        if(umeta == nullptr || umeta->tid == BSQ_TYPE_ID_REGEX || this->typeidx.find(umeta) == this->typeidx.cend())
+                        {
+                            return nullptr;
+                        }
+                        return umeta;
+                    };
+
+                    if(!snapshotVisitSlots((void**)obytes.data(), otype->allocinfo.heapmask, fchild, ftype))
+                    {
+                        return false;
+                    }
+                }
+                continue;
+            }
+
+            worklist.pop_back();
+            pending.erase(obj);
+
+            //every child has an index by now so this only rewrites the slots
+            if(!otype->isLeaf() && !this->encodeSlots(obytes.data(), otype->allocinfo.heapmask))
+            {
+                return false;
+            }
+
+            uint64_t ohdr[2] = {tii->second, obytes.size()};
+            this->objbytes.insert(this->objbytes.end(), (uint8_t*)ohdr, (uint8_t*)ohdr + sizeof(ohdr));
+            this->objbytes.insert(this->objbytes.end(), obytes.cbegin(), obytes.cend());
+
+            this->objidx[obj] = ++this->objcount;
+        }
+
+        idx = this->objidx.at(root);
+        return true;
+    }
+};
+
+bool writeGlobalSnapshot(const std::vector<std::pair<size_t, const BSQType*>>& consts, const std::string& into, uint64_t fingerprint)
+{
+    if(snapshotLayoutsHaveRegex())
+    {
+        return false;
+    }
 
-    std::string globalname = "[GlobalObject]";
-    const BSQType* globaltype = new BSQGlobalObjectType(cbuffsize, cmask, globalname);
+    auto tuniv = snapshotTypeUniverse();
 
-    Allocator::GlobalAllocator.setGlobalsMemory(globaltype);
+    GlobalSnapshotWriter writer;
+    writer.objcount = 0;
+    for(size_t i = 0; i < tuniv.size(); ++i)
+    {
+        if(tuniv[i] != nullptr)
+        {
+            writer.typeidx.emplace(tuniv[i], (uint64_t)i);
+        }
+    }
 
-    Evaluator::g_constantbuffer = (uint8_t*)GCStack::global_memory->data;
+    std::vector<uint8_t> cbytes;
+    for(size_t i = 0; i < consts.size(); ++i)
+    {
+        const BSQType* gtype = consts[i].second;
+        if(gtype->tid == BSQ_TYPE_ID_REGEX)
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> vbytes(Evaluator::g_constantbuffer + consts[i].first, Evaluator::g_constantbuffer + consts[i].first + gtype->allocinfo.inlinedatasize);
+        if(!writer.encodeSlots(vbytes.data(), gtype->allocinfo.inlinedmask))
+        {
+            return false;
+        }
+
+        cbytes.insert(cbytes.end(), vbytes.cbegin(), vbytes.cend());
+    }
+
+    std::vector<GlobalSnapshotTypeLayout> layouts;
+    std::transform(tuniv.cbegin(), tuniv.cend(), std::back_inserter(layouts), [](const BSQType* tt) {
+        return snapshotTypeLayout(tt);
+    });
+
+    GlobalSnapshotHeader hdr;
+    GC_MEM_ZERO(&hdr, sizeof(GlobalSnapshotHeader));
+    GC_MEM_COPY(hdr.magic, BSQ_GLOBAL_SNAPSHOT_MAGIC, sizeof(hdr.magic));
+    hdr.version = BSQ_GLOBAL_SNAPSHOT_VERSION;
+    hdr.fingerprint = fingerprint;
+    hdr.buildid = snapshotBuildId();
+    hdr.typecount = tuniv.size();
+    hdr.constcount = consts.size();
+    hdr.objcount = writer.objcount;
+    hdr.payloadbytes = (layouts.size() * sizeof(GlobalSnapshotTypeLayout)) + writer.objbytes.size() + cbytes.size();
+
+    std::ofstream outfile(into, std::ios::binary | std::ios::trunc);
+    outfile.write((const char*)&hdr, sizeof(GlobalSnapshotHeader));
+    outfile.write((const char*)layouts.data(), layouts.size() * sizeof(GlobalSnapshotTypeLayout));
+    outfile.write((const char*)writer.objbytes.data(), writer.objbytes.size());
+    outfile.write((const char*)cbytes.data(), cbytes.size());
+
+    AssemblyLoadInfo::g_snapshotObjectCount = writer.objcount;
+    return outfile.good();
 }
 
-void completeLoad()
+bool decodeSnapshotSlots(uint8_t* data, RefMask mask, const std::vector<const BSQType*>& tuniv, const std::vector<void*>& objs)
 {
-    Allocator::GlobalAllocator.completeGlobalInitialization();
+    auto fref = [&objs](void** slot) {
+        uint64_t idx = (uint64_t)(*slot);
+        if(idx > objs.size())
+        {
+            return false;
+        }
+
+        *slot = (idx != 0) ? objs[idx - 1] : nullptr;
+        return true;
+    };
+
+    auto ftype = [&tuniv](void** slot) -> const BSQType* {
+        uint64_t idx = (uint64_t)(*slot);
+        if(idx == 0 || idx > tuniv.size())
+        {
+            return nullptr;
+        }
+
+        *slot = (void*)tuniv[idx - 1];
+        return tuniv[idx - 1];
+    };
+
+    return snapshotVisitSlots((void**)data, mask, fref, ftype);
 }
 
-void initializeLiteral(size_t storageOffset, const BSQType* gtype, std::string& lval)
+//Rebuild the global heap from a snapshot -- nothing is written into the constant buffer unless the whole snapshot matches this assembly
+bool restoreGlobalSnapshot(const std::vector<std::pair<size_t, const BSQType*>>& consts, const std::string& from, uint64_t fingerprint)
 {
-    StorageLocationPtr sl = Evaluator::g_constantbuffer + storageOffset;
-    switch (gtype->tid)
+    std::ifstream infile(from, std::ios::binary);
+    std::vector<uint8_t> contents((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+    if(contents.size() < sizeof(GlobalSnapshotHeader))
     {
-    case BSQ_TYPE_ID_NONE: {
-        break;
-    }
-    case BSQ_TYPE_ID_NOTHING: {
-        break;
-    }
-    case BSQ_TYPE_ID_BOOL: {
-        dynamic_cast<const BSQRegisterType<BSQBool>*>(BSQWellKnownType::g_typeBool)->storeValueDirect(sl, (BSQBool)(lval == "true"));
-        break;
-    }
-    case BSQ_TYPE_ID_NAT: {
-        dynamic_cast<const BSQRegisterType<BSQNat>*>(BSQWellKnownType::g_typeNat)->storeValueDirect(sl, std::stoull(lval.substr(0, lval.size() - 1)));
-        break;
-    }
-    case BSQ_TYPE_ID_INT: {
-        dynamic_cast<const BSQRegisterType<BSQInt>*>(BSQWellKnownType::g_typeInt)->storeValueDirect(sl, std::stoll(lval.substr(0, lval.size() - 1)));
-        break;
-    }
-    case BSQ_TYPE_ID_BIGNAT: {
-        dynamic_cast<const BSQBigNumType<BSQBigNat>*>(BSQWellKnownType::g_typeBigNat)->storeValueDirect(sl, std::stoull(lval.substr(0, lval.size() - 1)));
-        break;
-    }
-    case BSQ_TYPE_ID_BIGINT: {
-        dynamic_cast<const BSQBigNumType<BSQBigInt>*>(BSQWellKnownType::g_typeBigInt)->storeValueDirect(sl, std::stoll(lval.substr(0, lval.size() - 1)));
-        break;
+        return false;
     }
-    case BSQ_TYPE_ID_FLOAT: {
-        dynamic_cast<const BSQRegisterType<BSQFloat>*>(BSQWellKnownType::g_typeFloat)->storeValueDirect(sl, std::stod(lval.substr(0, lval.size() - 1)));
-        break;
+
+    auto tuniv = snapshotTypeUniverse();
+
+    GlobalSnapshotHeader hdr;
+    GC_MEM_COPY(&hdr, contents.data(), sizeof(GlobalSnapshotHeader));
+    if(memcmp(hdr.magic, BSQ_GLOBAL_SNAPSHOT_MAGIC, sizeof(hdr.magic)) != 0 || hdr.version != BSQ_GLOBAL_SNAPSHOT_VERSION || hdr.fingerprint != fingerprint || hdr.buildid != snapshotBuildId())
+    {
+        return false;
     }
-    case BSQ_TYPE_ID_DECIMAL: {
-        dynamic_cast<const BSQRegisterType<BSQDecimal>*>(BSQWellKnownType::g_typeDecimal)->storeValueDirect(sl, std::stod(lval.substr(0, lval.size() - 1)));
-        break;
+
+    if(hdr.typecount != tuniv.size() || hdr.constcount != consts.size() || hdr.payloadbytes != contents.size() - sizeof(GlobalSnapshotHeader))
+    {
+        return false;
     }
-    case BSQ_TYPE_ID_RATIONAL: {
-        assert(false);
-        break;
+
+    size_t pos = sizeof(GlobalSnapshotHeader);
+    if(contents.size() - pos < tuniv.size() * sizeof(GlobalSnapshotTypeLayout))
+    {
+        return false;
     }
-    case BSQ_TYPE_ID_STRING: {
-        std::string sstr = lval.substr(1, lval.size() - 2);
-        //
-        //TODO: need to string unescape here
-        //
 
-        BSQString s = g_emptyString;
-        if(sstr.size() == 0)
+    for(size_t i = 0; i < tuniv.size(); ++i)
+    {
+        GlobalSnapshotTypeLayout ll;
+        GC_MEM_COPY(&ll, contents.data() + pos, sizeof(GlobalSnapshotTypeLayout));
+        pos += sizeof(GlobalSnapshotTypeLayout);
+
+        auto cl = snapshotTypeLayout(tuniv[i]);
+        if(ll.heapsize != cl.heapsize || ll.inlinedatasize != cl.inlinedatasize || ll.maskhash != cl.maskhash)
         {
-            //already empty
+            return false;
         }
-        else if(sstr.size() < 16) 
+    }
+
+    //allocating can collect so each object is rooted until the constants that reach it are in place
+    std::vector<void*> objs;
+    objs.reserve(hdr.objcount);
+
+    bool ok = true;
+    while(ok && objs.size() < hdr.objcount)
+    {
+        uint64_t ohdr[2];
+        if(contents.size() - pos < sizeof(ohdr))
         {
-            s.u_inlineString = BSQInlineString::create((const uint8_t*)sstr.c_str(), sstr.size());
+            ok = false;
+            break;
         }
-        else if(sstr.size() <= 128)
+        GC_MEM_COPY(ohdr, contents.data() + pos, sizeof(ohdr));
+        pos += sizeof(ohdr);
+
+        const BSQType* otype = (ohdr[0] < tuniv.size()) ? tuniv[ohdr[0]] : nullptr;
+        if(otype == nullptr || otype->allocinfo.heapsize != ohdr[1] || contents.size() - pos < ohdr[1])
         {
-            auto stp = BSQStringKReprTypeAbstract::selectKReprForSize(sstr.size());
+            ok = false;
+            break;
+        }
 
-            s.u_data = Allocator::GlobalAllocator.allocateDynamic(stp);
-            BSQ_MEM_COPY(s.u_data, sstr.c_str(), sstr.size());
+        uint8_t* obj = Allocator::GlobalAllocator.allocateDynamic(otype);
+        GC_MEM_COPY(obj, contents.data() + pos, ohdr[1]);
+        pos += ohdr[1];
+
+        ok = otype->isLeaf() || decodeSnapshotSlots(obj, otype->allocinfo.heapmask, tuniv, objs);
+        if(ok)
+        {
+            Allocator::GlobalAllocator.insertLoadRoot(obj);
+            objs.push_back(obj);
         }
-        else
+    }
+
+    std::vector<std::vector<uint8_t>> cvals;
+    for(size_t i = 0; ok && i < consts.size(); ++i)
+    {
+        size_t csize = consts[i].second->allocinfo.inlinedatasize;
+        if(contents.size() - pos < csize)
         {
-            //
-            //TODO: split the string into multiple parts
-            //
-            assert(false);
+            ok = false;
+            break;
         }
 
-        dynamic_cast<const BSQStringImplType*>(BSQWellKnownType::g_typeString)->storeValueDirect(sl, s);
-        break;
-    }
-    case BSQ_TYPE_ID_REGEX: {
-        auto reptr = Evaluator::g_regexs.at(lval);
-        dynamic_cast<const BSQRegisterType<void*>*>(BSQWellKnownType::g_typeRegex)->storeValueDirect(sl, (void*)reptr);
-        break;
-    }
-    default:
-        assert(false);
-        break;
+        std::vector<uint8_t> vbytes(contents.data() + pos, contents.data() + pos + csize);
+        pos += csize;
+
+        ok = decodeSnapshotSlots(vbytes.data(), consts[i].second->allocinfo.inlinedmask, tuniv, objs);
+        cvals.push_back(std::move(vbytes));
     }
-}
 
-void initializeConst(Evaluator& runner, size_t storageOffset, BSQInvokeID ikey, const BSQType* gtype)
-{
-    auto ccall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[ikey]);
+    if(ok)
+    {
+        for(size_t i = 0; i < consts.size(); ++i)
+        {
+            GC_MEM_COPY(Evaluator::g_constantbuffer + consts[i].first, cvals[i].data(), cvals[i].size());
+        }
 
-    runner.invokeGlobalCons(ccall, Evaluator::g_constantbuffer + storageOffset, gtype, ccall->resultArg);
+        AssemblyLoadInfo::g_snapshotObjectCount = objs.size();
+    }
+
+    Allocator::GlobalAllocator.clearLoadRoots();
+    return ok;
 }
 
-void loadAssembly(json j, Evaluator& ee)
+void loadAssembly(json& j, Evaluator& ee)
 {
     ////
     //Load the application sources if they are provided
@@ -324,8 +1556,25 @@ void loadAssembly(json j, Evaluator& ee)
         BSQMapOps::g_flavormap.emplace(std::make_pair(mflavor.keytype->tid, mflavor.valuetype->tid), mflavor);
     });
 
+    buildTypeDispatchTables();
+
     ////
     //Load Functions
+
+    //Superinstructions and tail calls only have handlers in the threaded loop and we want to see the original ops (and frames) when debugging
+    //The debugger also looks up ops by source line across every body so nothing is deferred when it is attached
+    AssemblyLoadInfo::g_dofusion = true;
+    AssemblyLoadInfo::g_dooptimize = true;
+    BSQInvokeBodyDecl::g_lazyload = true;
+#ifndef BSQ_THREADED_DISPATCH
+    AssemblyLoadInfo::g_dofusion = false;
+#endif
+#ifdef BSQ_DEBUG_BUILD
+    AssemblyLoadInfo::g_dofusion &= !ee.debuggerattached;
+    AssemblyLoadInfo::g_dooptimize = !ee.debuggerattached;
+    BSQInvokeBodyDecl::g_lazyload = !ee.debuggerattached;
+#endif
+
     BSQInvokeDecl::g_invokes.resize(MarshalEnvironment::g_invokeToIdMap.size());
     auto idlist = j["invdecls"];
     std::for_each(idlist.cbegin(), idlist.cend(), [](json idecl) {
@@ -342,6 +1591,28 @@ void loadAssembly(json j, Evaluator& ee)
 
         jsonLoadBSQLiteralDecl(ldecl, storageOffset, gtype, lval);
         initializeLiteral(storageOffset, gtype, lval);
+
+        if(gtype->tid == BSQ_TYPE_ID_BOOL || gtype->tid == BSQ_TYPE_ID_NAT || gtype->tid == BSQ_TYPE_ID_INT)
+        {
+            AssemblyLoadInfo::g_literalTypes[(uint32_t)storageOffset] = gtype->tid;
+        }
+    });
+
+    ////
+    //Optimize the bodies -- this needs the literal values but must run before any constant initializers are executed (deferred bodies get the same passes on their first call)
+    std::for_each(BSQInvokeDecl::g_invokes.cbegin(), BSQInvokeDecl::g_invokes.cend(), [&ee](const BSQInvokeDecl* idecl) {
+        if(idecl != nullptr && !idecl->isPrimitive())
+        {
+            BSQInvokeBodyDecl* bdecl = const_cast<BSQInvokeBodyDecl*>(static_cast<const BSQInvokeBodyDecl*>(idecl));
+            if(bdecl->isMaterialized())
+            {
+                prepareBody(bdecl, ee);
+            }
+            else
+            {
+                AssemblyLoadInfo::g_deferredBodyCount++;
+            }
+        }
     });
 
     ////
@@ -360,16 +1631,263 @@ void loadAssembly(json j, Evaluator& ee)
     });
 
     ////
-    //Load Constants
+    //Load Constants -- from the snapshot of a previous run if there is a matching one and otherwise by running their initializers
+    std::vector<std::pair<size_t, const BSQType*>> consts;
+    std::vector<BSQInvokeID> cinvokes;
+
     auto cdlist = j["constdecls"];
-    std::for_each(cdlist.cbegin(), cdlist.cend(), [&ee](json ldecl) {
+    std::for_each(cdlist.cbegin(), cdlist.cend(), [&consts, &cinvokes](json ldecl) {
         size_t storageOffset;
         BSQInvokeID ikey;
         const BSQType* gtype; 
         
         jsonLoadBSQConstantDecl(ldecl, storageOffset, ikey, gtype);
-        initializeConst(ee, storageOffset, ikey, gtype);
+        consts.push_back(std::make_pair(storageOffset, gtype));
+        cinvokes.push_back(ikey);
     });
 
+    const std::string& snapfile = AssemblyLoadInfo::g_snapshotFile;
+    AssemblyLoadInfo::g_snapshotRestored = !snapfile.empty() && restoreGlobalSnapshot(consts, snapfile, AssemblyLoadInfo::g_snapshotFingerprint);
+
+    if(!AssemblyLoadInfo::g_snapshotRestored)
+    {
+        for(size_t i = 0; i < consts.size(); ++i)
+        {
+            initializeConst(ee, consts[i].first, cinvokes[i], consts[i].second);
+        }
+
+        if(!snapfile.empty())
+        {
+            writeGlobalSnapshot(consts, snapfile, AssemblyLoadInfo::g_snapshotFingerprint);
+        }
+    }
+
     completeLoad();
 }
+
+//Byte iterator over the assembly source that publishes how far the parser has read -- the SAX events below use it to find where a body starts and ends
+class AssemblySourceCursor
+{
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = char;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const char*;
+    using reference = const char&;
+
+    const char* pos;
+    const char** reached;
+
+    AssemblySourceCursor(const char* pos, const char** reached) : pos(pos), reached(reached) {;}
+
+    inline reference operator*() const
+    {
+        return *this->pos;
+    }
+
+    inline AssemblySourceCursor& operator++()
+    {
+        this->pos++;
+        *this->reached = this->pos;
+        return *this;
+    }
+
+    inline bool operator==(const AssemblySourceCursor& other) const
+    {
+        return this->pos == other.pos;
+    }
+
+    inline bool operator!=(const AssemblySourceCursor& other) const
+    {
+        return this->pos != other.pos;
+    }
+};
+
+//Builds the assembly DOM but skips over the "body" array of each entry in "invdecls" -- the DOM gets {srcoffset, srcbytes} for it instead
+class AssemblyDeferringSAX
+{
+private:
+    nlohmann::detail::json_sax_dom_parser<json> dom;
+    const char* base;
+    const char* const* reached;
+
+    //object (true) or array (false) and the last key seen in it
+    std::vector<std::pair<bool, std::string>> frames;
+
+    size_t skipdepth;
+    const char* skipstart;
+
+    inline bool atInvokeBody() const
+    {
+        size_t fc = this->frames.size();
+        return fc >= 3 && this->frames[fc - 1].first && this->frames[fc - 1].second == "body" && !this->frames[fc - 2].first && this->frames[fc - 3].first && this->frames[fc - 3].second == "invdecls";
+    }
+
+    bool pushFrame(bool isobj, size_t elements)
+    {
+        if(this->skipdepth != 0)
+        {
+            this->skipdepth++;
+            return true;
+        }
+
+        if(!isobj && this->atInvokeBody())
+        {
+            //the range starts at the '[' just read
+            this->skipstart = *this->reached - 1;
+            this->skipdepth = 1;
+            return true;
+        }
+
+        this->frames.push_back(std::make_pair(isobj, std::string()));
+        return isobj ? this->dom.start_object(elements) : this->dom.start_array(elements);
+    }
+
+    bool popFrame(bool isobj)
+    {
+        if(this->skipdepth != 0)
+        {
+            this->skipdepth--;
+            if(this->skipdepth != 0)
+            {
+                return true;
+            }
+
+            std::string kofs("srcoffset");
+            std::string kbytes("srcbytes");
+            this->dom.start_object(2);
+            this->dom.key(kofs);
+            this->dom.number_unsigned((json::number_unsigned_t)(this->skipstart - this->base));
+            this->dom.key(kbytes);
+            this->dom.number_unsigned((json::number_unsigned_t)(*this->reached - this->skipstart));
+            return this->dom.end_object();
+        }
+
+        this->frames.pop_back();
+        return isobj ? this->dom.end_object() : this->dom.end_array();
+    }
+
+public:
+    AssemblyDeferringSAX(json& into, const char* base, const char* const* reached) : dom(into, false), base(base), reached(reached), frames(), skipdepth(0), skipstart(nullptr) {;}
+
+    bool null()
+    {
+        return this->skipdepth != 0 || this->dom.null();
+    }
+
+    bool boolean(bool val)
+    {
+        return this->skipdepth != 0 || this->dom.boolean(val);
+    }
+
+    bool number_integer(json::number_integer_t val)
+    {
+        return this->skipdepth != 0 || this->dom.number_integer(val);
+    }
+
+    bool number_unsigned(json::number_unsigned_t val)
+    {
+        return this->skipdepth != 0 || this->dom.number_unsigned(val);
+    }
+
+    bool number_float(json::number_float_t val, const json::string_t& s)
+    {
+        return this->skipdepth != 0 || this->dom.number_float(val, s);
+    }
+
+    bool string(json::string_t& val)
+    {
+        return this->skipdepth != 0 || this->dom.string(val);
+    }
+
+    bool binary(json::binary_t& val)
+    {
+        return this->skipdepth != 0 || this->dom.binary(val);
+    }
+
+    bool start_object(std::size_t elements)
+    {
+        return this->pushFrame(true, elements);
+    }
+
+    bool key(json::string_t& val)
+    {
+        if(this->skipdepth != 0)
+        {
+            return true;
+        }
+
+        this->frames.back().second = val;
+        return this->dom.key(val);
+    }
+
+    bool end_object()
+    {
+        return this->popFrame(true);
+    }
+
+    bool start_array(std::size_t elements)
+    {
+        return this->pushFrame(false, elements);
+    }
+
+    bool end_array()
+    {
+        return this->popFrame(false);
+    }
+
+    bool parse_error(std::size_t position, const std::string& last_token, const nlohmann::detail::exception& ex)
+    {
+        return false;
+    }
+};
+
+std::optional<json> parseAssemblyPayload(const char* data, size_t size, bool deferbodies)
+{
+    json j;
+    if(!deferbodies)
+    {
+        j = json::parse(data, data + size, nullptr, false);
+        if(j.is_discarded())
+        {
+            return std::nullopt;
+        }
+
+        return std::make_optional(std::move(j));
+    }
+
+    const char* reached = data;
+    AssemblyDeferringSAX sax(j, data, &reached);
+    if(!json::sax_parse(AssemblySourceCursor(data, &reached), AssemblySourceCursor(data + size, &reached), &sax))
+    {
+        return std::nullopt;
+    }
+
+    BSQInvokeBodyDecl::g_lazysource = data;
+
+    return std::make_optional(std::move(j));
+}
+
+std::optional<json> loadTextAssembly(const std::string& file, bool deferbodies)
+{
+    std::ifstream infile(file, std::ios::binary);
+    if(!infile.good())
+    {
+        return std::nullopt;
+    }
+
+    std::string contents((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+    if(!deferbodies)
+    {
+        return parseAssemblyPayload(contents.data(), contents.size(), false);
+    }
+
+    //deferred bodies are parsed out of the text later so it is never freed
+    std::string* retained = new std::string(std::move(contents));
+    auto res = parseAssemblyPayload(retained->data(), retained->size(), true);
+    if(!res.has_value())
+    {
+        delete retained;
+    }
+    return res;
+}
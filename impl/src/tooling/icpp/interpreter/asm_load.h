@@ -7,4 +7,71 @@
 
 #include "op_eval.h"
 
-void loadAssembly(json j, Evaluator& ee);
+class AssemblyLoadInfo
+{
+public:
+    //Number of superinstructions created by the fusion pass
+    static size_t g_fusedOpCount;
+
+    //Number of self-recursive calls converted to frame reuse + jump
+    static size_t g_tailCallCount;
+
+    //Load time optimizer -- ops replaced by a folded constant (or jump), uses rewritten to an earlier copy, and ops removed from bodies
+    static size_t g_foldedOpCount;
+    static size_t g_propagatedCopyCount;
+    static size_t g_removedOpCount;
+
+    //Bodies left in the assembly source at load time and bodies parsed since (on their first call)
+    static size_t g_deferredBodyCount;
+    static size_t g_materializedBodyCount;
+
+    //Load time pass configuration and the literal types the optimizer may read -- kept for bodies that are materialized later
+    static bool g_dooptimize;
+    static bool g_dofusion;
+    static std::map<uint32_t, BSQTypeID> g_literalTypes;
+
+    //Snapshot of the initialized globals to restore from (or write after running the initializers) -- empty if disabled
+    static std::string g_snapshotFile;
+    static uint64_t g_snapshotFingerprint;
+
+    //Heap objects restored from (or written to) the snapshot
+    static bool g_snapshotRestored;
+    static size_t g_snapshotObjectCount;
+};
+
+//With deferbodies the op list of each invoke is not built into the DOM -- it is replaced by its byte range in the source ({srcoffset, srcbytes}) and parsed on the first call
+//The source text is then kept for the life of the process
+std::optional<json> parseAssemblyPayload(const char* data, size_t size, bool deferbodies);
+
+std::optional<json> loadTextAssembly(const std::string& file, bool deferbodies);
+
+//Global snapshot files are a fixed header, the layout of every type in the snapshot type universe, the heap objects reachable from the constants (children first) and then the constant values
+//Pointers are stored as 1 + the index of the object they refer to and types as 1 + their index in the snapshot type universe
+#define BSQ_GLOBAL_SNAPSHOT_MAGIC "BSQSNAP"
+#define BSQ_GLOBAL_SNAPSHOT_VERSION 2
+
+struct GlobalSnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t fingerprint;
+    uint64_t buildid;
+    uint64_t typecount;
+    uint64_t constcount;
+    uint64_t objcount;
+    uint64_t payloadbytes;
+};
+
+//A restore is refused unless every type has the same sizes and reference masks as when the snapshot was written
+struct GlobalSnapshotTypeLayout
+{
+    uint64_t heapsize;
+    uint64_t inlinedatasize;
+    uint64_t maskhash;
+};
+
+void loadAssembly(json& j, Evaluator& ee);
+
+//Parse and run the load time passes on a deferred body -- called on the first invoke
+void materializeBody(const BSQInvokeBodyDecl* invk, Evaluator& ee);
@@ -419,7 +419,7 @@ BSQInt BSQListOps::s_find_value_last_ne(void* t, const BSQListReprType* ttype, S
     return (BSQInt)(found ? idx : -1);
 }
 
-BSQInt BSQListOps::s_find_pred_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params)
+BSQInt BSQListOps::s_find_pred_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params)
 {
     BSQBool found = BSQFALSE;
     int64_t idx = 0;
@@ -432,10 +432,7 @@ BSQInt BSQListOps::s_find_pred_ne(LambdaEvalThunk ee, void* t, const BSQListRepr
 
     {
         uint8_t* tmpl = GCStack::allocFrame(lentrytype->allocinfo.inlinedatasize);
-        std::vector<StorageLocationPtr> lparams = {tmpl};
-        std::transform(pred->cargpos.cbegin(), pred->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (1 + pred->cargpos.size())), {tmpl}, pred, params);
 
         while(iter.valid())
         {
@@ -458,7 +455,7 @@ BSQInt BSQListOps::s_find_pred_ne(LambdaEvalThunk ee, void* t, const BSQListRepr
     return (BSQInt)(found ? idx : -1);
 }
 
-BSQInt BSQListOps::s_find_pred_idx_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params)
+BSQInt BSQListOps::s_find_pred_idx_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params)
 {
     BSQBool found = BSQFALSE;
     int64_t idx = 0;
@@ -471,10 +468,7 @@ BSQInt BSQListOps::s_find_pred_idx_ne(LambdaEvalThunk ee, void* t, const BSQList
 
     {
         uint8_t* tmpl = GCStack::allocFrame(lentrytype->allocinfo.inlinedatasize);
-        std::vector<StorageLocationPtr> lparams = {tmpl, &idx};
-        std::transform(pred->cargpos.cbegin(), pred->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (2 + pred->cargpos.size())), {tmpl, &idx}, pred, params);
 
         while(iter.valid())
         {
@@ -497,7 +491,7 @@ BSQInt BSQListOps::s_find_pred_idx_ne(LambdaEvalThunk ee, void* t, const BSQList
     return (BSQInt)(found ? idx : -1);
 }
 
-BSQInt BSQListOps::s_find_pred_last_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params)
+BSQInt BSQListOps::s_find_pred_last_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params)
 {
     BSQBool found = BSQFALSE;
     int64_t icount = ttype->getCount(t);
@@ -511,10 +505,7 @@ BSQInt BSQListOps::s_find_pred_last_ne(LambdaEvalThunk ee, void* t, const BSQLis
 
     {
         uint8_t* tmpl = GCStack::allocFrame(lentrytype->allocinfo.inlinedatasize);
-        std::vector<StorageLocationPtr> lparams = {tmpl};
-        std::transform(pred->cargpos.cbegin(), pred->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (1 + pred->cargpos.size())), {tmpl}, pred, params);
 
         while(iter.valid())
         {
@@ -537,7 +528,7 @@ BSQInt BSQListOps::s_find_pred_last_ne(LambdaEvalThunk ee, void* t, const BSQLis
     return (BSQInt)idx;
 }
 
-BSQInt BSQListOps::s_find_pred_last_idx_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params)
+BSQInt BSQListOps::s_find_pred_last_idx_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params)
 {
     int64_t icount = ttype->getCount(t);
     int64_t idx = icount - 1;
@@ -551,10 +542,7 @@ BSQInt BSQListOps::s_find_pred_last_idx_ne(LambdaEvalThunk ee, void* t, const BS
     {
         BSQNat idx = icount - 1;
         uint8_t* tmpl = GCStack::allocFrame(lentrytype->allocinfo.inlinedatasize);
-        std::vector<StorageLocationPtr> lparams = {tmpl, &idx};
-        std::transform(pred->cargpos.cbegin(), pred->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (2 + pred->cargpos.size())), {tmpl, &idx}, pred, params);
 
         BSQBool found = BSQFALSE;
         while(iter.valid())
@@ -578,7 +566,7 @@ BSQInt BSQListOps::s_find_pred_last_idx_ne(LambdaEvalThunk ee, void* t, const BS
     return (BSQInt)idx;
 }
 
-void* BSQListOps::s_filter_pred_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params)
+void* BSQListOps::s_filter_pred_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params)
 {
     const BSQInvokeBodyDecl* icall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[pred->code]);
 
@@ -588,10 +576,7 @@ void* BSQListOps::s_filter_pred_ne(const BSQListTypeFlavor& lflavor, LambdaEvalT
         uint8_t* esl = ((uint8_t*)tmpl + (sizeof(void*) * 2));
         tmpl[0] = t;
 
-        std::vector<StorageLocationPtr> lparams = {esl};
-        std::transform(pred->cargpos.cbegin(), pred->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (1 + pred->cargpos.size())), {esl}, pred, params);
     
         rres = BSQListOps::list_tree_transform(lflavor, tmpl[0], [&](void* vv, const BSQPartialVectorType* reprtype) {
             tmpl[1] = vv;
@@ -627,7 +612,7 @@ void* BSQListOps::s_filter_pred_ne(const BSQListTypeFlavor& lflavor, LambdaEvalT
     return rres;
 }
 
-void* BSQListOps::s_filter_pred_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params)
+void* BSQListOps::s_filter_pred_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params)
 {
     const BSQInvokeBodyDecl* icall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[pred->code]);
 
@@ -638,10 +623,7 @@ void* BSQListOps::s_filter_pred_idx_ne(const BSQListTypeFlavor& lflavor, LambdaE
         tmpl[0] = t;
 
         uint64_t idxarg = 0;
-        std::vector<StorageLocationPtr> lparams = {esl, &idxarg};
-        std::transform(pred->cargpos.cbegin(), pred->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (2 + pred->cargpos.size())), {esl, &idxarg}, pred, params);
 
         rres = BSQListOps::list_tree_transform_idx(lflavor, tmpl[0], 0, [&](void* vv, const BSQPartialVectorType* reprtype, uint64_t idx) {
             idxarg = idx;
@@ -680,7 +662,7 @@ void* BSQListOps::s_filter_pred_idx_ne(const BSQListTypeFlavor& lflavor, LambdaE
     return rres;
 }
     
-void* BSQListOps::s_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, const std::vector<StorageLocationPtr>& params, const BSQListTypeFlavor& resflavor)
+void* BSQListOps::s_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, StorageLocationSpan params, const BSQListTypeFlavor& resflavor)
 {
     const BSQInvokeBodyDecl* icall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[fn->code]);
 
@@ -691,10 +673,7 @@ void* BSQListOps::s_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee,
         uint8_t* pv8l = ((uint8_t*)tmpl + (sizeof(void*) * 2) + lflavor.entrytype->allocinfo.inlinedatasize);
         tmpl[0] = t;
 
-        std::vector<StorageLocationPtr> lparams = {esl};
-        std::transform(fn->cargpos.cbegin(), fn->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (1 + fn->cargpos.size())), {esl}, fn, params);
 
         rres = BSQListOps::list_tree_transform(lflavor, tmpl[0], [&](void* vv, const BSQPartialVectorType* reprtype) {
             tmpl[1] = vv;
@@ -722,7 +701,7 @@ void* BSQListOps::s_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee,
     return rres;
 }
 
-void* BSQListOps::s_map_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, const std::vector<StorageLocationPtr>& params, const BSQListTypeFlavor& resflavor)
+void* BSQListOps::s_map_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, StorageLocationSpan params, const BSQListTypeFlavor& resflavor)
 {
     const BSQInvokeBodyDecl* icall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[fn->code]);
 
@@ -734,10 +713,7 @@ void* BSQListOps::s_map_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk
         tmpl[0] = t;
 
         uint64_t idxarg = 0;
-        std::vector<StorageLocationPtr> lparams = {esl, &idxarg};
-        std::transform(fn->cargpos.cbegin(), fn->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (2 + fn->cargpos.size())), {esl, &idxarg}, fn, params);
 
         rres = BSQListOps::list_tree_transform_idx(lflavor, tmpl[0], 0, [&](void* vv, const BSQPartialVectorType* reprtype, uint64_t idx) {
             idxarg = idx;
@@ -768,7 +744,7 @@ void* BSQListOps::s_map_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk
     return rres;
 }
 
-void* s_map_sync_list_rec(const BSQListTypeFlavor& lflavor1, const BSQListTypeFlavor& lflavor2, LambdaEvalThunk ee, uint64_t count, BSQListForwardIterator& iter1, BSQListForwardIterator& iter2, const BSQPCode* fn, const BSQInvokeBodyDecl* icall, const std::vector<StorageLocationPtr>& params, const BSQListTypeFlavor& resflavor)
+void* s_map_sync_list_rec(const BSQListTypeFlavor& lflavor1, const BSQListTypeFlavor& lflavor2, LambdaEvalThunk ee, uint64_t count, BSQListForwardIterator& iter1, BSQListForwardIterator& iter2, const BSQPCode* fn, const BSQInvokeBodyDecl* icall, StorageLocationSpan params, const BSQListTypeFlavor& resflavor)
 {
     void** tmpl = (void**)GCStack::allocFrame((sizeof(void*) * 2) + lflavor1.entrytype->allocinfo.inlinedatasize + lflavor2.entrytype->allocinfo.inlinedatasize + resflavor.pv8type->allocinfo.heapsize);
     
@@ -779,10 +755,7 @@ void* s_map_sync_list_rec(const BSQListTypeFlavor& lflavor1, const BSQListTypeFl
         uint8_t* esl2 = ((uint8_t*)tmpl + (sizeof(void*) * 2) + lflavor1.entrytype->allocinfo.inlinedatasize);
         uint8_t* pv8l = ((uint8_t*)tmpl + (sizeof(void*) * 2) + lflavor1.entrytype->allocinfo.inlinedatasize + lflavor2.entrytype->allocinfo.inlinedatasize);
 
-        std::vector<StorageLocationPtr> lparams = {esl1, esl2};
-        std::transform(fn->cargpos.cbegin(), fn->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (2 + fn->cargpos.size())), {esl1, esl2}, fn, params);
 
         for(uint64_t i = 0; i < count; ++i)
         {
@@ -816,7 +789,7 @@ void* s_map_sync_list_rec(const BSQListTypeFlavor& lflavor1, const BSQListTypeFl
     return res;
 }
 
-void* BSQListOps::s_map_sync_ne(const BSQListTypeFlavor& lflavor1, const BSQListTypeFlavor& lflavor2, LambdaEvalThunk ee, uint64_t count, void* t1, const BSQListReprType* ttype1, void* t2, const BSQListReprType* ttype2, const BSQPCode* fn, const std::vector<StorageLocationPtr>& params, const BSQListTypeFlavor& resflavor)
+void* BSQListOps::s_map_sync_ne(const BSQListTypeFlavor& lflavor1, const BSQListTypeFlavor& lflavor2, LambdaEvalThunk ee, uint64_t count, void* t1, const BSQListReprType* ttype1, void* t2, const BSQListReprType* ttype2, const BSQPCode* fn, StorageLocationSpan params, const BSQListTypeFlavor& resflavor)
 {
     BSQListForwardIterator iter1(ttype1, t1);
     Allocator::GlobalAllocator.insertCollectionIter(&iter1);
@@ -834,7 +807,7 @@ void* BSQListOps::s_map_sync_ne(const BSQListTypeFlavor& lflavor1, const BSQList
     return res;
 }
 
-void* BSQListOps::s_filter_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, const BSQPCode* p, const std::vector<StorageLocationPtr>& params, const BSQListTypeFlavor& resflavor)
+void* BSQListOps::s_filter_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, const BSQPCode* p, StorageLocationSpan params, const BSQListTypeFlavor& resflavor)
 {
     const BSQInvokeBodyDecl* icall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[fn->code]);
     const BSQInvokeBodyDecl* pcall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[p->code]);
@@ -846,15 +819,9 @@ void* BSQListOps::s_filter_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalTh
         uint8_t* pv8l = ((uint8_t*)tmpl + (sizeof(void*) * 2) + lflavor.entrytype->allocinfo.inlinedatasize);
         tmpl[0] = t;
 
-        std::vector<StorageLocationPtr> plparams = {esl};
-        std::transform(p->cargpos.cbegin(), p->cargpos.cend(), std::back_inserter(plparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan plparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (1 + p->cargpos.size())), {esl}, p, params);
 
-        std::vector<StorageLocationPtr> ilparams = {esl};
-        std::transform(fn->cargpos.cbegin(), fn->cargpos.cend(), std::back_inserter(ilparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan ilparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (1 + fn->cargpos.size())), {esl}, fn, params);
 
         rres = BSQListOps::list_tree_transform(lflavor, tmpl[0], [&](void* vv, const BSQPartialVectorType* reprtype) {
             tmpl[1] = vv;
@@ -894,7 +861,7 @@ void* BSQListOps::s_filter_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalTh
     return rres;
 }
 
-void BSQListOps::s_reduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* f, const std::vector<StorageLocationPtr>& params, StorageLocationPtr res)
+void BSQListOps::s_reduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* f, StorageLocationSpan params, StorageLocationPtr res)
 {
     BSQListForwardIterator iter(ttype, t);
     Allocator::GlobalAllocator.insertCollectionIter(&iter);
@@ -904,10 +871,7 @@ void BSQListOps::s_reduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk e
     {
         uint8_t* tmpl = (uint8_t*)GCStack::allocFrame(lflavor.entrytype->allocinfo.inlinedatasize + icall->resultType->allocinfo.inlinedatasize);
         uint8_t* resl = (tmpl + lflavor.entrytype->allocinfo.inlinedatasize);
-        std::vector<StorageLocationPtr> lparams = {resl, tmpl};
-        std::transform(f->cargpos.cbegin(), f->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        }); 
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (2 + f->cargpos.size())), {resl, tmpl}, f, params); 
 
         while(iter.valid())
         {
@@ -924,7 +888,7 @@ void BSQListOps::s_reduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk e
     Allocator::GlobalAllocator.removeCollectionIter(&iter);
 }
 
-void BSQListOps::s_reduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* f, const std::vector<StorageLocationPtr>& params, StorageLocationPtr res)
+void BSQListOps::s_reduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* f, StorageLocationSpan params, StorageLocationPtr res)
 {
     BSQListForwardIterator iter(ttype, t);
     Allocator::GlobalAllocator.insertCollectionIter(&iter);
@@ -935,10 +899,7 @@ void BSQListOps::s_reduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThu
         uint64_t idxarg = 0;
         uint8_t* tmpl = (uint8_t*)GCStack::allocFrame(lflavor.entrytype->allocinfo.inlinedatasize + icall->resultType->allocinfo.inlinedatasize);
         uint8_t* resl = (tmpl + lflavor.entrytype->allocinfo.inlinedatasize);
-        std::vector<StorageLocationPtr> lparams = {resl, tmpl, &idxarg};
-        std::transform(f->cargpos.cbegin(), f->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        }); 
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (3 + f->cargpos.size())), {resl, tmpl, &idxarg}, f, params); 
 
         while(iter.valid())
         {
@@ -956,7 +917,7 @@ void BSQListOps::s_reduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThu
     Allocator::GlobalAllocator.removeCollectionIter(&iter);
 }
 
-void BSQListOps::s_transduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQListTypeFlavor& uflavor, const BSQType* envtype, const BSQPCode* f, const std::vector<StorageLocationPtr>& params, const BSQEphemeralListType* rrtype, StorageLocationPtr eres)
+void BSQListOps::s_transduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQListTypeFlavor& uflavor, const BSQType* envtype, const BSQPCode* f, StorageLocationSpan params, const BSQEphemeralListType* rrtype, StorageLocationPtr eres)
 {
     const BSQInvokeBodyDecl* icall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[f->code]);
     const BSQEphemeralListType* pcrtype = dynamic_cast<const BSQEphemeralListType*>(icall->resultType);
@@ -970,10 +931,7 @@ void BSQListOps::s_transduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThun
         uint8_t* pv8l = ((uint8_t*)tmpl + (sizeof(void*) * 2) + lflavor.entrytype->allocinfo.inlinedatasize + envtype->allocinfo.inlinedatasize + icall->resultType->allocinfo.inlinedatasize);
         tmpl[0] = t;
 
-        std::vector<StorageLocationPtr> lparams = {esl, envsl};
-        std::transform(f->cargpos.cbegin(), f->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (2 + f->cargpos.size())), {esl, envsl}, f, params);
         envtype->storeValue(envsl, params[1]);
 
         rres = BSQListOps::list_tree_transform(lflavor, tmpl[0], [&](void* vv, const BSQPartialVectorType* reprtype) {
@@ -1007,7 +965,7 @@ void BSQListOps::s_transduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThun
     }
 }
 
-void BSQListOps::s_transduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQListTypeFlavor& uflavor, const BSQType* envtype, const BSQPCode* f, const std::vector<StorageLocationPtr>& params, const BSQEphemeralListType* rrtype, StorageLocationPtr eres)
+void BSQListOps::s_transduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQListTypeFlavor& uflavor, const BSQType* envtype, const BSQPCode* f, StorageLocationSpan params, const BSQEphemeralListType* rrtype, StorageLocationPtr eres)
 {
     const BSQInvokeBodyDecl* icall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[f->code]);
     const BSQEphemeralListType* pcrtype = dynamic_cast<const BSQEphemeralListType*>(icall->resultType);
@@ -1022,10 +980,7 @@ void BSQListOps::s_transduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEval
         tmpl[0] = t;
 
         uint64_t idxarg = 0;
-        std::vector<StorageLocationPtr> lparams = {esl, envsl, &idxarg};
-        std::transform(f->cargpos.cbegin(), f->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (3 + f->cargpos.size())), {esl, envsl, &idxarg}, f, params);
         envtype->storeValue(envsl, params[1]);
 
         rres = BSQListOps::list_tree_transform_idx(lflavor, tmpl[0], 0, [&](void* vv, const BSQPartialVectorType* reprtype, uint64_t idx) {
@@ -1062,14 +1017,14 @@ void BSQListOps::s_transduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEval
     }
 }
 
-void* BSQListOps::s_sort_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* lt, const std::vector<StorageLocationPtr>& params)
+void* BSQListOps::s_sort_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* lt, StorageLocationSpan params)
 {
     //TODO: implement
     assert(false);
     return nullptr;
 }
 
-void* BSQListOps::s_unique_from_sorted_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* eq, const std::vector<StorageLocationPtr>& params)
+void* BSQListOps::s_unique_from_sorted_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* eq, StorageLocationSpan params)
 {
     //TODO: implement
     assert(false);
@@ -1290,7 +1245,7 @@ void* BSQMapOps::s_fast_union_ne(const BSQMapTypeFlavor& mflavor, void* t1, cons
     return res;
 }
 
-void* BSQMapOps::s_submap_ne(const BSQMapTypeFlavor& mflavor, LambdaEvalThunk ee, void* t, const BSQMapTreeType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params)
+void* BSQMapOps::s_submap_ne(const BSQMapTypeFlavor& mflavor, LambdaEvalThunk ee, void* t, const BSQMapTreeType* ttype, const BSQPCode* pred, StorageLocationSpan params)
 {
     BSQMapSpineIterator iter(ttype, t);
     Allocator::GlobalAllocator.insertCollectionIter(&iter);
@@ -1303,10 +1258,7 @@ void* BSQMapOps::s_submap_ne(const BSQMapTypeFlavor& mflavor, LambdaEvalThunk ee
         uint8_t* ksl = (uint8_t*)tmpl;
         uint8_t* vsl = (uint8_t*)tmpl + mflavor.keytype->allocinfo.inlinedatasize;
 
-        std::vector<StorageLocationPtr> lparams = {ksl, vsl};
-        std::transform(pred->cargpos.cbegin(), pred->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        }); 
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (2 + pred->cargpos.size())), {ksl, vsl}, pred, params); 
 
         res = BSQMapOps::map_tree_flatten(mflavor, iter, [&](StorageLocationPtr lk, StorageLocationPtr lv) { 
             mflavor.keytype->storeValue(ksl, lk);
@@ -1392,7 +1344,7 @@ void* BSQMapOps::s_entries_ne(const BSQMapTypeFlavor& mflavor, void* t, const BS
     return res;
 }
 
-void* BSQMapOps::s_remap_ne(const BSQMapTypeFlavor& mflavor, LambdaEvalThunk ee, void* t, const BSQMapTreeType* ttype, const BSQPCode* fn, const std::vector<StorageLocationPtr>& params, const BSQMapTypeFlavor& resflavor)
+void* BSQMapOps::s_remap_ne(const BSQMapTypeFlavor& mflavor, LambdaEvalThunk ee, void* t, const BSQMapTreeType* ttype, const BSQPCode* fn, StorageLocationSpan params, const BSQMapTypeFlavor& resflavor)
 {
     const BSQInvokeBodyDecl* icall = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[fn->code]);
 
@@ -1404,10 +1356,7 @@ void* BSQMapOps::s_remap_ne(const BSQMapTypeFlavor& mflavor, LambdaEvalThunk ee,
         uint8_t* resl = ((uint8_t*)tmpl + sizeof(void*) * 4 + mflavor.keytype->allocinfo.inlinedatasize + mflavor.valuetype->allocinfo.heapsize);
         tmpl[0] = t;
 
-        std::vector<StorageLocationPtr> lparams = {ksl, vsl};
-        std::transform(fn->cargpos.cbegin(), fn->cargpos.cend(), std::back_inserter(lparams), [&params](uint32_t pos) {
-            return params[pos];
-        });
+        StorageLocationSpan lparams = loadLambdaArgs((StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * (2 + fn->cargpos.size())), {ksl, vsl}, fn, params);
 
         rres = BSQMapOps::map_tree_transform(mflavor, tmpl[0], [&](void* vv, void* ll, void* rr) {
             tmpl[1] = vv;
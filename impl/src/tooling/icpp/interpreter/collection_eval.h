@@ -16,12 +16,23 @@
 //Forward Decl
 class Evaluator;
 
+//Lambda args are the fixed slots (element, index, accumulator, ...) followed by the captured values -- written into caller provided stack space
+inline StorageLocationSpan loadLambdaArgs(StorageLocationPtr* into, std::initializer_list<StorageLocationPtr> fixed, const BSQPCode* pc, StorageLocationSpan params)
+{
+    auto cpos = std::copy(fixed.begin(), fixed.end(), into);
+    std::transform(pc->cargpos.cbegin(), pc->cargpos.cend(), cpos, [&params](uint32_t pos) {
+        return params[pos];
+    });
+
+    return StorageLocationSpan(into, fixed.size() + pc->cargpos.size());
+}
+
 class BSQListOps
 {
 public:
     static std::map<BSQTypeID, BSQListTypeFlavor> g_flavormap; //map from entry type to the flavors of the repr
 
-    inline static void* list_consk(const BSQListTypeFlavor& lflavor, const std::vector<StorageLocationPtr>& params)
+    inline static void* list_consk(const BSQListTypeFlavor& lflavor, StorageLocationSpan params)
     {
         auto res = Allocator::GlobalAllocator.allocateDynamic((params.size() <= 4) ? lflavor.pv4type : lflavor.pv8type);
         BSQPartialVectorType::initializePVData(res, params, lflavor.entrytype);
@@ -29,12 +40,11 @@ public:
         return res;
     }
 
-    static void* list_cons_rec(const BSQListTypeFlavor& lflavor, const std::vector<StorageLocationPtr>& params, size_t idx, size_t count)
+    static void* list_cons_rec(const BSQListTypeFlavor& lflavor, StorageLocationSpan params, size_t idx, size_t count)
     {
         if(count <= 8)
         {
-            std::vector<StorageLocationPtr> psub(&params[idx], &params[idx + count]);
-            return list_consk(lflavor, psub);
+            return list_consk(lflavor, params.subspan(idx, count));
         }
         else
         {
@@ -55,7 +65,7 @@ public:
             return res;
         }
     }
-    static void* list_cons(const BSQListTypeFlavor& lflavor, const std::vector<StorageLocationPtr>& params)
+    static void* list_cons(const BSQListTypeFlavor& lflavor, StorageLocationSpan params)
     {
         if(params.size() <= 8)
         {
@@ -454,28 +464,28 @@ public:
     static BSQInt s_find_value_ne(void* t, const BSQListReprType* ttype, StorageLocationPtr v);
     static BSQInt s_find_value_last_ne(void* t, const BSQListReprType* ttype, StorageLocationPtr v);
 
-    static BSQInt s_find_pred_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params);
-    static BSQInt s_find_pred_idx_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params);
-    static BSQInt s_find_pred_last_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params);
-    static BSQInt s_find_pred_last_idx_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params);
+    static BSQInt s_find_pred_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params);
+    static BSQInt s_find_pred_idx_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params);
+    static BSQInt s_find_pred_last_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params);
+    static BSQInt s_find_pred_last_idx_ne(LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params);
 
-    static void* s_filter_pred_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params);
-    static void* s_filter_pred_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params);
+    static void* s_filter_pred_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params);
+    static void* s_filter_pred_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* pred, StorageLocationSpan params);
 
-    static void* s_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, const std::vector<StorageLocationPtr>& params, const BSQListTypeFlavor& resflavor);
-    static void* s_map_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, const std::vector<StorageLocationPtr>& params, const BSQListTypeFlavor& resflavor);
-    static void* s_map_sync_ne(const BSQListTypeFlavor& lflavor1, const BSQListTypeFlavor& lflavor2, LambdaEvalThunk ee, uint64_t count, void* t1, const BSQListReprType* ttype1, void* t2, const BSQListReprType* ttype2, const BSQPCode* fn, const std::vector<StorageLocationPtr>& params, const BSQListTypeFlavor& resflavor);
+    static void* s_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, StorageLocationSpan params, const BSQListTypeFlavor& resflavor);
+    static void* s_map_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, StorageLocationSpan params, const BSQListTypeFlavor& resflavor);
+    static void* s_map_sync_ne(const BSQListTypeFlavor& lflavor1, const BSQListTypeFlavor& lflavor2, LambdaEvalThunk ee, uint64_t count, void* t1, const BSQListReprType* ttype1, void* t2, const BSQListReprType* ttype2, const BSQPCode* fn, StorageLocationSpan params, const BSQListTypeFlavor& resflavor);
 
-    static void* s_filter_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, const BSQPCode* p, const std::vector<StorageLocationPtr>& params, const BSQListTypeFlavor& resflavor);
+    static void* s_filter_map_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* fn, const BSQPCode* p, StorageLocationSpan params, const BSQListTypeFlavor& resflavor);
 
-    static void s_reduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* f, const std::vector<StorageLocationPtr>& params, StorageLocationPtr res);
-    static void s_reduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* f, const std::vector<StorageLocationPtr>& params, StorageLocationPtr res);
+    static void s_reduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* f, StorageLocationSpan params, StorageLocationPtr res);
+    static void s_reduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* f, StorageLocationSpan params, StorageLocationPtr res);
 
-    static void s_transduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQListTypeFlavor& uflavor, const BSQType* envtype, const BSQPCode* f, const std::vector<StorageLocationPtr>& params, const BSQEphemeralListType* rrtype, StorageLocationPtr eres);
-    static void s_transduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQListTypeFlavor& uflavor, const BSQType* envtype, const BSQPCode* f, const std::vector<StorageLocationPtr>& params, const BSQEphemeralListType* rrtype, StorageLocationPtr eres);
+    static void s_transduce_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQListTypeFlavor& uflavor, const BSQType* envtype, const BSQPCode* f, StorageLocationSpan params, const BSQEphemeralListType* rrtype, StorageLocationPtr eres);
+    static void s_transduce_idx_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQListTypeFlavor& uflavor, const BSQType* envtype, const BSQPCode* f, StorageLocationSpan params, const BSQEphemeralListType* rrtype, StorageLocationPtr eres);
 
-    static void* s_sort_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* lt, const std::vector<StorageLocationPtr>& params);
-    static void* s_unique_from_sorted_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* eq, const std::vector<StorageLocationPtr>& params);
+    static void* s_sort_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* lt, StorageLocationSpan params);
+    static void* s_unique_from_sorted_ne(const BSQListTypeFlavor& lflavor, LambdaEvalThunk ee, void* t, const BSQListReprType* ttype, const BSQPCode* eq, StorageLocationSpan params);
 };
 
 class BSQMapOps
@@ -483,7 +493,7 @@ class BSQMapOps
 public:
     static std::map<std::pair<BSQTypeID, BSQTypeID>, BSQMapTypeFlavor> g_flavormap; //map from entry type to the flavors of the repr
 
-    static void* map_cons_one_element(const BSQMapTypeFlavor& mflavor, const BSQType* tupletype, const std::vector<StorageLocationPtr>& params)
+    static void* map_cons_one_element(const BSQMapTypeFlavor& mflavor, const BSQType* tupletype, StorageLocationSpan params)
     {
         void* repr = Allocator::GlobalAllocator.allocateDynamic(mflavor.treetype);
         const BSQTupleInfo* tupinfo = dynamic_cast<const BSQTupleInfo*>(tupletype);
@@ -627,6 +637,6 @@ public:
     
     static void* s_fast_union_ne(const BSQMapTypeFlavor& mflavor, void* t1, const BSQMapTreeType* ttype1, void* t2, const BSQMapTreeType* ttype2);
     
-    static void* s_submap_ne(const BSQMapTypeFlavor& mflavor, LambdaEvalThunk ee, void* t, const BSQMapTreeType* ttype, const BSQPCode* pred, const std::vector<StorageLocationPtr>& params);
-    static void* s_remap_ne(const BSQMapTypeFlavor& mflavor, LambdaEvalThunk ee, void* t, const BSQMapTreeType* ttype, const BSQPCode* fn, const std::vector<StorageLocationPtr>& params, const BSQMapTypeFlavor& resflavor);
+    static void* s_submap_ne(const BSQMapTypeFlavor& mflavor, LambdaEvalThunk ee, void* t, const BSQMapTreeType* ttype, const BSQPCode* pred, StorageLocationSpan params);
+    static void* s_remap_ne(const BSQMapTypeFlavor& mflavor, LambdaEvalThunk ee, void* t, const BSQMapTreeType* ttype, const BSQPCode* fn, StorageLocationSpan params, const BSQMapTypeFlavor& resflavor);
 };
@@ -16,10 +16,12 @@
 #include <string>
 
 #include <vector>
+#include <span>
 #include <queue>
 #include <list>
 #include <map>
 
+#include <atomic>
 #include <chrono>
 
 #include "../../api_parse/decls.h"
@@ -50,15 +52,32 @@ class BSQType;
 //Various sizes
 #define BSQ_MAX_STACK 65536
 
+////////////////////////////////
+//Interpreter dispatch
+
+//Use threaded (computed goto) dispatch over pre-resolved per-body handler tables when the compiler supports labels as values
+#if defined(__GNUC__) || defined(__clang__)
+#define BSQ_THREADED_DISPATCH
+#endif
+
+//Optional native tier (opt in at runtime) that stitches per-op stencils into executable memory -- only x86-64 SysV hosts are supported
+#if defined(__x86_64__) && defined(__linux__)
+#define BSQ_JIT_AVAILABLE
+#endif
+
+//Default number of calls before a body is compiled by the native tier
+#define BSQ_JIT_CALL_THRESHOLD 32
+
 ////////////////////////////////
 //Asserts
 
 #define BSQ_INTERNAL_ASSERT(C) if(!(C)) { assert(false); }
 
+//The message is kept for whoever catches the longjmp to report with the failure -- stdout may be a serve/batch response stream so nothing is printed here
 #ifdef BSQ_DEBUG_BUILD
-#define HANDLE_BSQ_ABORT(MSG, F, L, C) { printf("\"%s\" in %s on line %i\n", MSG, F, (int)L); fflush(stdout); longjmp(Evaluator::g_entrybuff, C); }
+#define HANDLE_BSQ_ABORT(MSG, F, L, C) { snprintf(Evaluator::g_abortmsg, sizeof(Evaluator::g_abortmsg), "\"%s\" in %s on line %i", MSG, F, (int)L); longjmp(Evaluator::g_entrybuff, C); }
 #else
-#define HANDLE_BSQ_ABORT() { printf("ABORT\n"); longjmp(Evaluator::g_entrybuff, 5); }
+#define HANDLE_BSQ_ABORT() { snprintf(Evaluator::g_abortmsg, sizeof(Evaluator::g_abortmsg), "ABORT"); longjmp(Evaluator::g_entrybuff, 5); }
 #endif
 
 #ifdef BSQ_DEBUG_BUILD
@@ -104,9 +123,19 @@ class BSQType;
 //Block allocation size
 #define BSQ_BLOCK_ALLOCATION_SIZE 8192ul
 
-//Collection threshold
-//TODO: we probably want allow this to adjust dynamically on demand, say from 2MB to 16MB or something
+//Blocks are carved from regions of this size -- aligned so that they can be backed by (transparent) huge pages
+#define BSQ_REGION_ALLOCATION_SIZE 33554432ul
+#define BSQ_REGION_ALIGNMENT 2097152ul
+
+//Initial collection threshold -- the heap sizing policy grows or shrinks it (within the min/max) after each collection
 #define BSQ_COLLECT_THRESHOLD 8388608ul
+#define BSQ_COLLECT_THRESHOLD_MIN 2097152ul
+#define BSQ_COLLECT_THRESHOLD_MAX 536870912ul
+
+//Young objects are bump allocated in a nursery of this many blocks -- a collection is run when it is full
+#define BSQ_NURSERY_BLOCK_COUNT (BSQ_COLLECT_THRESHOLD / BSQ_BLOCK_ALLOCATION_SIZE)
+#define BSQ_NURSERY_MIN_BLOCK_COUNT (BSQ_COLLECT_THRESHOLD_MIN / BSQ_BLOCK_ALLOCATION_SIZE)
+#define BSQ_NURSERY_MAX_BLOCK_COUNT (BSQ_COLLECT_THRESHOLD_MAX / BSQ_BLOCK_ALLOCATION_SIZE)
 
 //Make sure any allocated page is addressable by us -- larger than 2^31 and less than 2^42
 #define MIN_ALLOCATED_ADDRESS 2147483648ul
@@ -165,6 +194,8 @@ struct PageInfo
 
 #define GC_LOAD_META_DATA_WORD(ADDR) (*ADDR)
 #define GC_STORE_META_DATA_WORD(ADDR, W) (*ADDR = W)
+//The parallel collector updates meta data words that other workers may be reading or updating with atomic operations
+#define GC_ATOMIC_META_DATA_WORD(ADDR) (reinterpret_cast<std::atomic<GC_META_DATA_WORD>*>(ADDR))
 
 #define GC_IS_DEC_PENDING(W) ((W & GC_DEC_PENDING_BIT) != 0x0ul)
 #define GC_IS_FWD_PTR(W) ((W & GC_IS_FWD_PTR_BIT) != 0x0ul)
@@ -217,6 +248,9 @@ struct PageInfo
 //Generic pointer to a storage location that holds a value
 typedef void* StorageLocationPtr;
 
+//Non-owning view of an argument list -- callers back it with a stack array (or existing vector) so calls do not touch the heap
+typedef std::span<const StorageLocationPtr> StorageLocationSpan;
+
 #define IS_INLINE_STRING(S) ((*(((uint8_t*)(S)) + 15) != 0) | (*((void**)S) == nullptr))
 #define IS_INLINE_BIGNUM(N) true
 #define IS_EMPTY_COLLECTION(C) (C == nullptr)
@@ -0,0 +1,257 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+#include "jit.h"
+
+#ifdef BSQ_JIT_AVAILABLE
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <string.h>
+
+#define BSQ_JIT_POOL_CHUNK_SIZE (256 * 1024)
+#define BSQ_JIT_POOL_ALIGN 16
+
+std::vector<BSQJitCodePool::Chunk> BSQJitCodePool::g_chunks;
+
+bool BSQJitCodePool::allocateChunk(size_t minsize)
+{
+    size_t pagesize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t allocsize = std::max((size_t)BSQ_JIT_POOL_CHUNK_SIZE, ((minsize + pagesize - 1) / pagesize) * pagesize);
+
+    int fd = memfd_create("icpp-jit", MFD_CLOEXEC);
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    if(ftruncate(fd, (off_t)allocsize) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* wmem = mmap(nullptr, allocsize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void* xmem = mmap(nullptr, allocsize, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if(wmem == MAP_FAILED || xmem == MAP_FAILED)
+    {
+        if(wmem != MAP_FAILED)
+        {
+            munmap(wmem, allocsize);
+        }
+        if(xmem != MAP_FAILED)
+        {
+            munmap(xmem, allocsize);
+        }
+        return false;
+    }
+
+    BSQJitCodePool::g_chunks.push_back({(uint8_t*)wmem, (uint8_t*)xmem, allocsize, 0});
+    return true;
+}
+
+void* BSQJitCodePool::install(const uint8_t* code, size_t size)
+{
+    size_t asize = ((size + BSQ_JIT_POOL_ALIGN - 1) / BSQ_JIT_POOL_ALIGN) * BSQ_JIT_POOL_ALIGN;
+
+    if(BSQJitCodePool::g_chunks.empty() || BSQJitCodePool::g_chunks.back().size - BSQJitCodePool::g_chunks.back().used < asize)
+    {
+        if(!BSQJitCodePool::allocateChunk(asize))
+        {
+            return nullptr;
+        }
+    }
+
+    Chunk& chunk = BSQJitCodePool::g_chunks.back();
+    memcpy(chunk.wview + chunk.used, code, size);
+
+    void* entry = chunk.xview + chunk.used;
+    chunk.used += asize;
+
+    return entry;
+}
+
+void BSQJitEmitter::emitHandlerCall(const void* fn, const void* op)
+{
+    this->emitBytes({0x48, 0x89, 0xdf}); //mov rdi, rbx
+    this->emitBytes({0x48, 0xbe}); //movabs rsi, op
+    this->emitImm64((uint64_t)op);
+    this->emitBytes({0x48, 0xb8}); //movabs rax, fn
+    this->emitImm64((uint64_t)fn);
+    this->emitBytes({0xff, 0xd0}); //call rax
+}
+
+void BSQJitEmitter::emitPrologue(BSQJitFrameFP framefn)
+{
+    //rbx holds ctx and r12 the frame pointer for the whole body -- the pushes and pad keep 16 byte stack alignment for the handler calls
+    this->emitByte(0x53); //push rbx
+    this->emitBytes({0x41, 0x54}); //push r12
+    this->emitBytes({0x48, 0x83, 0xec, 0x08}); //sub rsp, 8
+    this->emitBytes({0x48, 0x89, 0xfb}); //mov rbx, rdi
+
+    this->emitBytes({0x48, 0xb8}); //movabs rax, framefn
+    this->emitImm64((uint64_t)framefn);
+    this->emitBytes({0xff, 0xd0}); //call rax
+    this->emitBytes({0x49, 0x89, 0xc4}); //mov r12, rax
+}
+
+void BSQJitEmitter::emitEpilogue()
+{
+    this->emitBytes({0x48, 0x83, 0xc4, 0x08}); //add rsp, 8
+    this->emitBytes({0x41, 0x5c}); //pop r12
+    this->emitByte(0x5b); //pop rbx
+    this->emitByte(0xc3); //ret
+}
+
+void BSQJitEmitter::emitCall(BSQJitStepFP fn, const void* op)
+{
+    this->emitHandlerCall((const void*)fn, op);
+}
+
+void BSQJitEmitter::emitCond(BSQJitCondFP fn, const void* op, size_t tlabel, size_t flabel)
+{
+    this->emitHandlerCall((const void*)fn, op);
+
+    this->emitTestByte();
+    this->emitBranch(BSQJitCond::NotEqual, tlabel, flabel);
+}
+
+void BSQJitEmitter::emitGoto(size_t label)
+{
+    this->emitByte(0xe9); //jmp rel32
+    this->emitRel32Fixup(label);
+}
+
+void BSQJitEmitter::emitLoadFrame(BSQJitReg reg, uint32_t offset, size_t bytes)
+{
+    assert(bytes == 1 || bytes == 8);
+
+    if(bytes == 8)
+    {
+        this->emitBytes({0x49, 0x8b}); //mov reg, [r12 + offset]
+    }
+    else
+    {
+        this->emitBytes({0x41, 0x0f, 0xb6}); //movzx reg32, byte [r12 + offset]
+    }
+    this->emitFrameOperand(reg, offset);
+}
+
+void BSQJitEmitter::emitLoadAbsolute(BSQJitReg reg, const void* addr, size_t bytes)
+{
+    assert(bytes == 1 || bytes == 8);
+
+    this->emitLoadImmediate(reg, (uint64_t)addr);
+
+    uint8_t modrm = (uint8_t)(((uint8_t)reg << 3) | (uint8_t)reg);
+    if(bytes == 8)
+    {
+        this->emitBytes({0x48, 0x8b, modrm}); //mov reg, [reg]
+    }
+    else
+    {
+        this->emitBytes({0x0f, 0xb6, modrm}); //movzx reg32, byte [reg]
+    }
+}
+
+void BSQJitEmitter::emitLoadImmediate(BSQJitReg reg, uint64_t v)
+{
+    this->emitBytes({0x48, (uint8_t)(0xb8 + (uint8_t)reg)}); //movabs reg, v
+    this->emitImm64(v);
+}
+
+void BSQJitEmitter::emitStoreFrame(uint32_t offset, BSQJitReg reg, size_t bytes)
+{
+    assert(bytes == 1 || bytes == 8);
+
+    if(bytes == 8)
+    {
+        this->emitBytes({0x49, 0x89}); //mov [r12 + offset], reg
+    }
+    else
+    {
+        this->emitBytes({0x41, 0x88}); //mov byte [r12 + offset], reg8
+    }
+    this->emitFrameOperand(reg, offset);
+}
+
+void BSQJitEmitter::emitArith(BSQJitArith aop)
+{
+    switch(aop)
+    {
+    case BSQJitArith::Add:
+        this->emitBytes({0x48, 0x01, 0xc8}); //add rax, rcx
+        break;
+    case BSQJitArith::Sub:
+        this->emitBytes({0x48, 0x29, 0xc8}); //sub rax, rcx
+        break;
+    case BSQJitArith::SignedMult:
+        this->emitBytes({0x48, 0x0f, 0xaf, 0xc1}); //imul rax, rcx
+        break;
+    default:
+        this->emitBytes({0x48, 0xf7, 0xe1}); //mul rcx (rdx gets the high half and OF is set if it is not 0)
+        break;
+    }
+}
+
+void BSQJitEmitter::emitCompare()
+{
+    this->emitBytes({0x48, 0x39, 0xc8}); //cmp rax, rcx
+}
+
+void BSQJitEmitter::emitSetCond(BSQJitCond cc)
+{
+    this->emitBytes({0x0f, (uint8_t)(0x90 | (uint8_t)cc), 0xc0}); //setcc al
+}
+
+void BSQJitEmitter::emitTestByte()
+{
+    this->emitBytes({0x84, 0xc0}); //test al, al
+}
+
+void BSQJitEmitter::emitBranch(BSQJitCond cc, size_t tlabel, size_t flabel)
+{
+    this->emitBytes({0x0f, (uint8_t)(0x80 | (uint8_t)cc)}); //jcc rel32
+    this->emitRel32Fixup(tlabel);
+    this->emitGoto(flabel);
+}
+
+void BSQJitEmitter::emitSlowPath(BSQJitCond cc, BSQJitStepFP fn, const void* op, size_t resumelabel)
+{
+    size_t slabel = this->labels.size();
+    this->labels.push_back(SIZE_MAX);
+    this->slowpaths.push_back({slabel, fn, op, resumelabel});
+
+    this->emitBytes({0x0f, (uint8_t)(0x80 | (uint8_t)cc)}); //jcc rel32
+    this->emitRel32Fixup(slabel);
+}
+
+BSQJitEntryFP BSQJitEmitter::finalize()
+{
+    //the slow paths go after the epilogue so the inline code falls straight through
+    for(size_t i = 0; i < this->slowpaths.size(); ++i)
+    {
+        this->markLabel(this->slowpaths[i].label);
+        this->emitHandlerCall((const void*)this->slowpaths[i].fn, this->slowpaths[i].op);
+        this->emitGoto(this->slowpaths[i].resumelabel);
+    }
+
+    for(size_t i = 0; i < this->fixups.size(); ++i)
+    {
+        size_t pos = this->fixups[i].first;
+        size_t trgt = this->labels[this->fixups[i].second];
+        assert(trgt != SIZE_MAX);
+
+        //rel32 is relative to the end of the branch instruction (which is the end of the immediate)
+        int32_t rel = (int32_t)((int64_t)trgt - (int64_t)(pos + 4));
+        memcpy(this->code.data() + pos, &rel, sizeof(int32_t));
+    }
+
+    return (BSQJitEntryFP)BSQJitCodePool::install(this->code.data(), this->code.size());
+}
+
+#endif
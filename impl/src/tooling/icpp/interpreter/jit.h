@@ -0,0 +1,181 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "common.h"
+
+#ifdef BSQ_JIT_AVAILABLE
+
+//A compiled body -- called with the evaluator that owns the (already pushed) frame
+typedef void (*BSQJitEntryFP)(void* ctx);
+
+//Complex ops are calls into precompiled C++ handlers with the signature (ctx, op) -- ctx is kept in a callee saved register for the whole body
+typedef void (*BSQJitStepFP)(void* ctx, const void* op);
+typedef uint8_t (*BSQJitCondFP)(void* ctx, const void* op); //returns a BSQBool
+
+//Largest struct value a stencil copies inline (word by word) -- bigger values go through the type storeValue
+#define BSQ_JIT_MAX_INLINE_COPY_BYTES 32
+
+//Returns the frame pointer of the body being entered -- it is kept in a callee saved register for the whole body
+typedef uint8_t* (*BSQJitFrameFP)(void* ctx);
+
+//Scratch registers for the inline stencils (caller saved so the handler calls are free to clobber them)
+enum class BSQJitReg : uint8_t
+{
+    RAX = 0x0,
+    RCX = 0x1
+};
+
+//x86 condition codes (the low nibble of jcc/setcc) -- Carry is also unsigned below
+enum class BSQJitCond : uint8_t
+{
+    Overflow = 0x0,
+    Carry = 0x2,
+    Equal = 0x4,
+    NotEqual = 0x5,
+    BelowEqual = 0x6,
+    Less = 0xC,
+    LessEqual = 0xE
+};
+
+//rax = rax op rcx with the flags set for the overflow check
+enum class BSQJitArith : uint8_t
+{
+    Add = 0x0,
+    Sub,
+    SignedMult,
+    UnsignedMult
+};
+
+//
+//Copy-and-patch style emitter for x86-64 (SysV). Each op of a body gets a label and a stencil:
+//  inline -- loads/stores of frame slots (off the frame pointer) and constants (absolute addresses) with integer arithmetic, compares, and branches
+//  call   -- call handler(ctx, op) and fall through to the next op
+//  cond   -- call handler(ctx, op) and branch to one of two op labels on the (BSQBool) result
+//  goto   -- unconditional branch to an op label
+//A failing check in an inline stencil branches to an out of line stub that calls the op handler (which reports the error).
+//The label one past the last op is the body epilogue. Branch targets are patched once all op labels are known.
+//
+class BSQJitEmitter
+{
+private:
+    struct SlowPath
+    {
+        size_t label;
+        BSQJitStepFP fn;
+        const void* op;
+        size_t resumelabel;
+    };
+
+    std::vector<uint8_t> code;
+    std::vector<size_t> labels;
+    std::vector<std::pair<size_t, size_t>> fixups; //(position of rel32, target label)
+    std::vector<SlowPath> slowpaths;
+
+    void emitByte(uint8_t b)
+    {
+        this->code.push_back(b);
+    }
+
+    void emitBytes(std::initializer_list<uint8_t> bs)
+    {
+        this->code.insert(this->code.end(), bs.begin(), bs.end());
+    }
+
+    void emitImm64(uint64_t v)
+    {
+        for(size_t i = 0; i < 8; ++i)
+        {
+            this->emitByte((uint8_t)(v >> (i * 8)));
+        }
+    }
+
+    void emitImm32(uint32_t v)
+    {
+        for(size_t i = 0; i < 4; ++i)
+        {
+            this->emitByte((uint8_t)(v >> (i * 8)));
+        }
+    }
+
+    void emitRel32Fixup(size_t trgtlabel)
+    {
+        this->fixups.push_back(std::make_pair(this->code.size(), trgtlabel));
+        this->emitBytes({0x0, 0x0, 0x0, 0x0});
+    }
+
+    void emitHandlerCall(const void* fn, const void* op);
+
+    //[r12 + offset] operand for reg
+    void emitFrameOperand(BSQJitReg reg, uint32_t offset)
+    {
+        this->emitByte((uint8_t)(0x84 | ((uint8_t)reg << 3))); //mod=10 rm=SIB
+        this->emitByte(0x24); //base=r12 no index
+        this->emitImm32(offset);
+    }
+
+public:
+    BSQJitEmitter(size_t opcount) : code(), labels(opcount + 1, SIZE_MAX), fixups(), slowpaths() {;}
+    ~BSQJitEmitter() {;}
+
+    void emitPrologue(BSQJitFrameFP framefn);
+    void emitEpilogue();
+
+    void markLabel(size_t idx)
+    {
+        this->labels[idx] = this->code.size();
+    }
+
+    void emitCall(BSQJitStepFP fn, const void* op);
+    void emitCond(BSQJitCondFP fn, const void* op, size_t tlabel, size_t flabel);
+    void emitGoto(size_t label);
+
+    //Inline stencil parts -- values are 1 or 8 bytes wide and 1 byte loads are zero extended
+    void emitLoadFrame(BSQJitReg reg, uint32_t offset, size_t bytes);
+    void emitLoadAbsolute(BSQJitReg reg, const void* addr, size_t bytes);
+    void emitLoadImmediate(BSQJitReg reg, uint64_t v);
+    void emitStoreFrame(uint32_t offset, BSQJitReg reg, size_t bytes);
+
+    void emitArith(BSQJitArith aop);
+    void emitCompare(); //flags for rax - rcx
+    void emitSetCond(BSQJitCond cc); //al = cc
+    void emitTestByte(); //flags for al
+
+    void emitBranch(BSQJitCond cc, size_t tlabel, size_t flabel);
+
+    //If cc holds call fn(ctx, op) out of line (it is expected to abort) and otherwise fall through
+    void emitSlowPath(BSQJitCond cc, BSQJitStepFP fn, const void* op, size_t resumelabel);
+
+    //Patch the branches and copy into the shared code pool -- returns nullptr if no memory could be mapped
+    BSQJitEntryFP finalize();
+};
+
+//
+//Bump allocated executable memory shared by all compiled bodies. Each chunk is one memfd mapped twice, a writable view that
+//the emitter copies into and an executable view that is handed out, so code in a chunk keeps running while later bodies are
+//appended to it (no view is ever both writable and executable). Chunks live until the process exits.
+//
+class BSQJitCodePool
+{
+private:
+    struct Chunk
+    {
+        uint8_t* wview;
+        uint8_t* xview;
+        size_t size;
+        size_t used;
+    };
+
+    static std::vector<Chunk> g_chunks;
+
+    static bool allocateChunk(size_t minsize);
+
+public:
+    //Copy the code into the pool and return the executable address -- nullptr if no memory could be mapped
+    static void* install(const uint8_t* code, size_t size);
+};
+
+#endif
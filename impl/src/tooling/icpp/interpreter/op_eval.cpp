@@ -4,6 +4,7 @@
 //-------------------------------------------------------------------------------------------------------
 
 #include "op_eval.h"
+#include "asm_load.h"
 
 //
 //TODO: win32 add checked arith
@@ -69,12 +70,23 @@ BSQ_LANGUAGE_ASSERT((!ISINFINITE(rarg) | !ISINFINITE(larg)) || ((rarg <= 0) & (0
 SLPTR_STORE_CONTENTS_AS(BSQBool, THIS->evalTargetVar(bop->trgt), larg OPERATOR rarg);
 
 jmp_buf Evaluator::g_entrybuff;
+char Evaluator::g_abortmsg[512] = {0};
 EvaluatorFrame Evaluator::g_callstack[BSQ_MAX_STACK];
 uint8_t* Evaluator::g_constantbuffer = nullptr;
 
 std::map<std::string, const BSQRegex*> Evaluator::g_validators;
 std::map<std::string, const BSQRegex*> Evaluator::g_regexs;
 
+#ifdef BSQ_THREADED_DISPATCH
+const void* const* Evaluator::g_dispatchlabels = nullptr;
+#endif
+
+#ifdef BSQ_JIT_AVAILABLE
+bool Evaluator::g_jitenabled = false;
+uint32_t Evaluator::g_jitthreshold = BSQ_JIT_CALL_THRESHOLD;
+size_t Evaluator::g_jitCompiledCount = 0;
+#endif
+
 void Evaluator::evalDeadFlowOp()
 {
     //This should be unreachable
@@ -122,8 +134,9 @@ void Evaluator::evalDebugOp(const DebugOp* op)
 
         auto dval = oftype->fpDisplay(oftype, SLPTR_LOAD_UNION_INLINE_DATAPTR(sl), DisplayMode::Standard);
 
-        printf("%s\n", dval.c_str());
-        fflush(stdout);
+        //stdout may be a serve/batch response stream so debug output goes to stderr
+        fprintf(stderr, "%s\n", dval.c_str());
+        fflush(stderr);
     }
 }
 
@@ -198,16 +211,58 @@ void Evaluator::processTupleDirectLoadAndStore(StorageLocationPtr src, const BSQ
     dsttype->storeValue(this->evalTargetVar(dst), srctype->indexStorageLocationOffset(src, slotoffset));
 }
 
-void Evaluator::processTupleVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQTupleIndex idx, TargetVar dst, const BSQType* dsttype)
+size_t Evaluator::resolveTupleIndexOffset(const BSQType* ttype, BSQTupleIndex idx, BSQInlineCache<size_t>& icache)
+{
+    size_t voffset = 0;
+    if(!icache.tryLookup(ttype->tid, voffset))
+    {
+        auto tinfo = dynamic_cast<const BSQTupleInfo*>(ttype);
+        voffset = idx < tinfo->maxIndex ? tinfo->idxoffsets[idx] : BSQ_INLINE_CACHE_ABSENT;
+
+        icache.tryInsert(ttype->tid, voffset);
+    }
+
+    return voffset;
+}
+
+size_t Evaluator::resolveRecordPropertyOffset(const BSQType* rtype, BSQRecordPropertyID propId, BSQInlineCache<size_t>& icache)
+{
+    size_t voffset = 0;
+    if(!icache.tryLookup(rtype->tid, voffset))
+    {
+        auto rinfo = dynamic_cast<const BSQRecordInfo*>(rtype);
+        auto proppos = std::find(rinfo->properties.cbegin(), rinfo->properties.cend(), propId);
+        voffset = proppos != rinfo->properties.cend() ? rinfo->propertyoffsets[(size_t)std::distance(rinfo->properties.cbegin(), proppos)] : BSQ_INLINE_CACHE_ABSENT;
+
+        icache.tryInsert(rtype->tid, voffset);
+    }
+
+    return voffset;
+}
+
+size_t Evaluator::resolveEntityFieldOffset(const BSQType* etype, BSQFieldID fldId, BSQInlineCache<size_t>& icache)
+{
+    size_t voffset = 0;
+    if(!icache.tryLookup(etype->tid, voffset))
+    {
+        auto einfo = dynamic_cast<const BSQEntityInfo*>(etype);
+        auto fldpos = std::find(einfo->fields.cbegin(), einfo->fields.cend(), fldId);
+        assert(fldpos != einfo->fields.cend());
+
+        voffset = einfo->fieldoffsets[(size_t)std::distance(einfo->fields.cbegin(), fldpos)];
+        icache.tryInsert(etype->tid, voffset);
+    }
+
+    return voffset;
+}
+
+void Evaluator::processTupleVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQTupleIndex idx, BSQInlineCache<size_t>& icache, TargetVar dst, const BSQType* dsttype)
 {
     const BSQType* ttype = srctype->getVType(src);
     StorageLocationPtr pp = srctype->getVData_StorageLocation(src);
 
-    //
-    //TODO: this is where it might be nice to do some mono/polymorphic inline caching vtable goodness
-    //
-    auto tinfo = dynamic_cast<const BSQTupleInfo*>(ttype);
-    auto voffset = tinfo->idxoffsets[idx];
+    auto voffset = this->resolveTupleIndexOffset(ttype, idx, icache);
+    assert(voffset != BSQ_INLINE_CACHE_ABSENT);
 
     this->processTupleDirectLoadAndStore(pp, ttype, voffset, dst, dsttype);
 }
@@ -217,20 +272,13 @@ void Evaluator::processRecordDirectLoadAndStore(StorageLocationPtr src, const BS
     dsttype->storeValue(this->evalTargetVar(dst), srctype->indexStorageLocationOffset(src, slotoffset));
 }
 
-void Evaluator::processRecordVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQRecordPropertyID propId, TargetVar dst, const BSQType* dsttype)
+void Evaluator::processRecordVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQRecordPropertyID propId, BSQInlineCache<size_t>& icache, TargetVar dst, const BSQType* dsttype)
 {
     const BSQType* rtype = srctype->getVType(src);
     StorageLocationPtr pp = srctype->getVData_StorageLocation(src);
 
-    //
-    //TODO: this is where it might be nice to do some mono/polymorphic inline caching vtable goodness
-    //
-    auto rinfo = dynamic_cast<const BSQRecordInfo*>(rtype);
-    auto proppos = std::find(rinfo->properties.cbegin(), rinfo->properties.cend(), propId);
-    assert(proppos != rinfo->properties.cend());
-
-    auto propidx = (size_t)std::distance(rinfo->properties.cbegin(), proppos);
-    auto voffset = rinfo->propertyoffsets[propidx];
+    auto voffset = this->resolveRecordPropertyOffset(rtype, propId, icache);
+    assert(voffset != BSQ_INLINE_CACHE_ABSENT);
 
     this->processRecordDirectLoadAndStore(pp, rtype, voffset, dst, dsttype);
 }
@@ -240,21 +288,12 @@ void Evaluator::processEntityDirectLoadAndStore(StorageLocationPtr src, const BS
     dsttype->storeValue(this->evalTargetVar(dst), srctype->indexStorageLocationOffset(src, slotoffset));
 }
 
-void Evaluator::processEntityVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQFieldID fldId, TargetVar dst, const BSQType* dsttype)
+void Evaluator::processEntityVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQFieldID fldId, BSQInlineCache<size_t>& icache, TargetVar dst, const BSQType* dsttype)
 {
     const BSQType* etype = srctype->getVType(src);
     StorageLocationPtr pp = srctype->getVData_StorageLocation(src);
 
-    //
-    //TODO: this is where it might be nice to do some mono/polymorphic inline caching vtable goodness
-    //
-    auto einfo = dynamic_cast<const BSQEntityInfo*>(etype);
-    auto fldpos = std::find(einfo->fields.cbegin(), einfo->fields.cend(), fldId);
-    assert(fldpos != einfo->fields.cend());
-
-    auto fldidx = (size_t)std::distance(einfo->fields.cbegin(), fldpos);
-    auto voffset = einfo->fieldoffsets[fldidx];
-
+    auto voffset = this->resolveEntityFieldOffset(etype, fldId, icache);
     this->processEntityDirectLoadAndStore(pp, etype, voffset, dst, dsttype);
 }
 
@@ -301,7 +340,7 @@ void Evaluator::evalLoadTupleIndexDirectOp(const LoadTupleIndexDirectOp* op)
 void Evaluator::evalLoadTupleIndexVirtualOp(const LoadTupleIndexVirtualOp* op)
 {
     auto sl = this->evalArgument(op->arg);
-    this->processTupleVirtualLoadAndStore(sl, op->layouttype, op->idx, op->trgt, op->trgttype);
+    this->processTupleVirtualLoadAndStore(sl, op->layouttype, op->idx, op->icache, op->trgt, op->trgttype);
 }
 
 void Evaluator::evalLoadTupleIndexSetGuardDirectOp(const LoadTupleIndexSetGuardDirectOp* op)
@@ -317,16 +356,11 @@ void Evaluator::evalLoadTupleIndexSetGuardVirtualOp(const LoadTupleIndexSetGuard
     const BSQType* ttype = op->layouttype->getVType(sl);
     StorageLocationPtr pp = op->layouttype->getVData_StorageLocation(sl);
 
-    //
-    //TODO: this is where it might be nice to do some mono/polymorphic inline caching vtable goodness
-    //
-
-    auto tinfo = dynamic_cast<const BSQTupleInfo*>(ttype);
-    BSQBool loadsafe = op->idx < tinfo->maxIndex;
+    auto voffset = this->resolveTupleIndexOffset(ttype, op->idx, op->icache);
+    BSQBool loadsafe = voffset != BSQ_INLINE_CACHE_ABSENT;
     if(loadsafe)
     {
-        this->processTupleVirtualLoadAndStore(pp, op->layouttype, op->idx, op->trgt, op->trgttype);
-
+        this->processTupleDirectLoadAndStore(pp, ttype, voffset, op->trgt, op->trgttype);
     }
     this->processGuardVarStore(op->guard, loadsafe);
 }
@@ -339,7 +373,7 @@ void Evaluator::evalLoadRecordPropertyDirectOp(const LoadRecordPropertyDirectOp*
 void Evaluator::evalLoadRecordPropertyVirtualOp(const LoadRecordPropertyVirtualOp* op)
 {
     auto sl = this->evalArgument(op->arg);
-    this->processRecordVirtualLoadAndStore(sl, op->layouttype, op->propId, op->trgt, op->trgttype);
+    this->processRecordVirtualLoadAndStore(sl, op->layouttype, op->propId, op->icache, op->trgt, op->trgttype);
 }
 
 void Evaluator::evalLoadRecordPropertySetGuardDirectOp(const LoadRecordPropertySetGuardDirectOp* op)
@@ -355,15 +389,11 @@ void Evaluator::evalLoadRecordPropertySetGuardVirtualOp(const LoadRecordProperty
     const BSQType* rtype = op->layouttype->getVType(sl);
     StorageLocationPtr pp = op->layouttype->getVData_StorageLocation(sl);
 
-    //
-    //TODO: this is where it might be nice to do some mono/polymorphic inline caching vtable goodness
-    //
-
-    auto rinfo = dynamic_cast<const BSQRecordInfo*>(rtype);
-    BSQBool loadsafe = std::find(rinfo->properties.cbegin(), rinfo->properties.cend(), op->propId) != rinfo->properties.cend();
+    auto voffset = this->resolveRecordPropertyOffset(rtype, op->propId, op->icache);
+    BSQBool loadsafe = voffset != BSQ_INLINE_CACHE_ABSENT;
     if(loadsafe)
     {
-        this->processRecordVirtualLoadAndStore(pp, op->layouttype, op->propId, op->trgt, op->trgttype);
+        this->processRecordDirectLoadAndStore(pp, rtype, voffset, op->trgt, op->trgttype);
     }
     this->processGuardVarStore(op->guard, loadsafe);
 }
@@ -376,7 +406,7 @@ void Evaluator::evalLoadDirectFieldOp(const LoadEntityFieldDirectOp* op)
 void Evaluator::evalLoadVirtualFieldOp(const LoadEntityFieldVirtualOp* op)
 {
     auto sl = this->evalArgument(op->arg);
-    this->processEntityVirtualLoadAndStore(sl, op->layouttype, op->fieldId, op->trgt, op->trgttype);
+    this->processEntityVirtualLoadAndStore(sl, op->layouttype, op->fieldId, op->icache, op->trgt, op->trgttype);
 }
 
 void Evaluator::evalProjectTupleOp(const ProjectTupleOp* op)
@@ -627,8 +657,15 @@ void Evaluator::evalInvokeVirtualFunctionOp(const InvokeVirtualFunctionOp* op)
     const BSQType* etype = op->rcvrlayouttype->getVType(sl);
     StorageLocationPtr rcvrloc = op->rcvrlayouttype->getVData_StorageLocation(sl);
 
+    BSQInvokeID vcall = 0;
+    if(!op->icache.tryLookup(etype->tid, vcall))
+    {
+        vcall = etype->resolveVirtualInvoke(op->invokeId);
+        op->icache.tryInsert(etype->tid, vcall);
+    }
+
     StorageLocationPtr resl = this->evalTargetVar(op->trgt);
-    this->vinvoke(dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[etype->vtable.at(op->invokeId)]), rcvrloc, op->args, resl, op->optmaskoffset != -1 ? this->cframe->masksbase + op->optmaskoffset : nullptr);
+    this->vinvoke(static_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[vcall]), rcvrloc, op->args, resl, op->optmaskoffset != -1 ? this->cframe->masksbase + op->optmaskoffset : nullptr);
 }
 
 void Evaluator::evalInvokeVirtualOperatorOp(const InvokeVirtualOperatorOp* op)
@@ -1003,7 +1040,7 @@ void Evaluator::evalTypeTagSubtypeOfOp<true>(const TypeTagSubtypeOfOp* op)
     if(this->tryProcessGuardStmt(op->trgt, BSQWellKnownType::g_typeBool, op->sguard))
     {
         auto rtid = getTypeIDForTypeOf(op->arglayout, this->evalArgument(op->arg));
-        auto subtype = std::find(op->oftype->subtypes.cbegin(), op->oftype->subtypes.cend(), rtid) != op->oftype->subtypes.cend();
+        auto subtype = op->oftype->isSubtype(rtid);
 
         SLPTR_STORE_CONTENTS_AS(BSQBool, this->evalTargetVar(op->trgt), subtype);
     }
@@ -1013,7 +1050,7 @@ template <>
 void Evaluator::evalTypeTagSubtypeOfOp<false>(const TypeTagSubtypeOfOp* op)
 {
     auto rtid = getTypeIDForTypeOf(op->arglayout, this->evalArgument(op->arg));
-    auto subtype = std::find(op->oftype->subtypes.cbegin(), op->oftype->subtypes.cend(), rtid) != op->oftype->subtypes.cend();
+    auto subtype = op->oftype->isSubtype(rtid);
 
     SLPTR_STORE_CONTENTS_AS(BSQBool, this->evalTargetVar(op->trgt), subtype);
 }
@@ -1115,6 +1152,108 @@ void Evaluator::evalVarHomeLocationValueUpdate(const VarHomeLocationValueUpdate*
 #endif    
 } 
 
+template <OpCodeTag TAG, typename REPRTYPE>
+BSQBool Evaluator::evalPrimitiveCompareJumpCondOp(const PrimitiveCompareJumpCondOp<TAG>* op)
+{
+    REPRTYPE larg = SLPTR_LOAD_CONTENTS_AS(REPRTYPE, this->evalArgument(op->larg));
+    REPRTYPE rarg = SLPTR_LOAD_CONTENTS_AS(REPRTYPE, this->evalArgument(op->rarg));
+
+    BSQBool res = BSQFALSE;
+    if constexpr(TAG == OpCodeTag::LtNatJumpCondOp || TAG == OpCodeTag::LtIntJumpCondOp)
+    {
+        res = larg < rarg;
+    }
+    else if constexpr(TAG == OpCodeTag::LeNatJumpCondOp || TAG == OpCodeTag::LeIntJumpCondOp)
+    {
+        res = larg <= rarg;
+    }
+    else if constexpr(TAG == OpCodeTag::EqNatJumpCondOp || TAG == OpCodeTag::EqIntJumpCondOp)
+    {
+        res = larg == rarg;
+    }
+    else
+    {
+        res = larg != rarg;
+    }
+
+    //the compare result may still be used after the branch so we always store it
+    SLPTR_STORE_CONTENTS_AS(BSQBool, this->evalTargetVar(op->trgt), res);
+    return res;
+}
+
+template <OpCodeTag TAG, typename REPRTYPE>
+void Evaluator::evalLoadConstAddOp(const LoadConstBinaryOperatorOp<TAG>* op)
+{
+    op->ctype->storeValue(this->evalTargetVar(op->ctrgt), this->evalArgument(op->carg));
+
+#ifdef _WIN32
+    REPRTYPE res = SLPTR_LOAD_CONTENTS_AS(REPRTYPE, this->evalArgument(op->larg)) + SLPTR_LOAD_CONTENTS_AS(REPRTYPE, this->evalArgument(op->rarg));
+#else
+    REPRTYPE res;
+    bool err = __builtin_add_overflow(SLPTR_LOAD_CONTENTS_AS(REPRTYPE, this->evalArgument(op->larg)), SLPTR_LOAD_CONTENTS_AS(REPRTYPE, this->evalArgument(op->rarg)), &res);
+    BSQ_LANGUAGE_ASSERT(!err, &(this->cframe->invoke->srcFile), this->cframe->dbg_currentline, (TAG == OpCodeTag::LoadConstAddNatOp ? "Nat addition overflow" : "Int addition overflow/underflow"));
+#endif
+
+    SLPTR_STORE_CONTENTS_AS(REPRTYPE, this->evalTargetVar(op->trgt), res);
+}
+
+void Evaluator::evalLoadEntityFieldDirectRegisterAssignOp(const LoadEntityFieldDirectRegisterAssignOp* op)
+{
+    this->evalLoadDirectFieldOp(op->lop);
+    op->atype->storeValue(this->evalTargetVar(op->atrgt), this->evalTargetVar(op->lop->trgt));
+}
+
+void Evaluator::evalInvokeSelfTailCallOp(const InvokeSelfTailCallOp* op)
+{
+    const BSQInvokeBodyDecl* idecl = static_cast<const BSQInvokeBodyDecl*>(this->cframe->invoke);
+    const std::vector<Argument>& args = op->iop->args;
+
+    //args may read the current parameters so stage all of them before any are overwritten
+    uint8_t* tmps = GCStack::allocFrame(op->argbytes);
+    uint8_t* tcurr = tmps;
+    for(size_t i = 0; i < args.size(); ++i)
+    {
+        const BSQType* ptype = idecl->params[i].ptype;
+        ptype->storeValue(tcurr, this->evalArgument(args[i]));
+        tcurr += ptype->allocinfo.inlinedatasize;
+    }
+
+    //same state a fresh invoke would see -- zeroed reference slots and masks with no incoming arg mask
+    if(idecl->stackmap != nullptr)
+    {
+        idecl->stackmap->zeroRefSlots(this->cframe->frameptr);
+    }
+    else
+    {
+        GC_MEM_ZERO(this->cframe->frameptr, idecl->stackBytes);
+    }
+    GC_MEM_ZERO(this->cframe->masksbase, idecl->maskSlots * sizeof(BSQBool));
+    this->cframe->argmask = nullptr;
+
+    tcurr = tmps;
+    for(size_t i = 0; i < args.size(); ++i)
+    {
+        const BSQType* ptype = idecl->params[i].ptype;
+        ptype->storeValue(Evaluator::evalParameterInfo(idecl->paraminfo[i], this->cframe->frameptr), tcurr);
+        tcurr += ptype->allocinfo.inlinedatasize;
+    }
+    GCStack::popFrame(op->argbytes);
+
+#ifdef BSQ_DEBUG_BUILD
+    this->call_count++;
+#endif
+
+    this->cframe->cpos = this->cframe->ops->cbegin();
+#ifdef BSQ_THREADED_DISPATCH
+    this->cframe->dpos = idecl->dispatch.data();
+#endif
+}
+
+void Evaluator::evalLoadFoldedConstOp(const LoadFoldedConstOp* op)
+{
+    op->oftype->storeValue(this->evalTargetVar(op->trgt), (StorageLocationPtr)&op->value);
+}
+
 void Evaluator::evaluateOpCode(const InterpOp* op)
 {    
     switch(op->tag)
@@ -1823,34 +1962,857 @@ void Evaluator::evaluateOpCode(const InterpOp* op)
     }
     case OpCodeTag::LeBigIntOp:
     {
-        PrimitiveBinaryComparatorMacroSafe(this, op, OpCodeTag::LeBigIntOp, BSQBigInt, <=)
-        break;
+        PrimitiveBinaryComparatorMacroSafe(this, op, OpCodeTag::LeBigIntOp, BSQBigInt, <=)
+        break;
+    }
+    case OpCodeTag::LeRationalOp:
+    {
+        assert(false);
+        break;
+    }
+    case OpCodeTag::LeFloatOp:
+    {
+        PrimitiveBinaryComparatorMacroFP(this, op, OpCodeTag::LeFloatOp, BSQFloat, std::isnan, std::isinf, <=)
+        break;
+    }
+    case OpCodeTag::LeDecimalOp:
+    {
+        PrimitiveBinaryComparatorMacroFP(this, op, OpCodeTag::LeDecimalOp, BSQDecimal, std::isnan, std::isinf, <=)
+        break;
+    }
+    case OpCodeTag::LoadFoldedConstOp:
+    {
+        this->evalLoadFoldedConstOp(static_cast<const LoadFoldedConstOp*>(op));
+        break;
+    }
+    default:
+    {
+        assert(false);
+        break;
+    }
+    }
+}
+
+#ifdef BSQ_THREADED_DISPATCH
+#define BSQ_OPCODE_TAG_COUNT ((size_t)OpCodeTag::LoadFoldedConstOp + 1)
+
+#define THREADED_DISPATCH_CURRENT() op = *frame->cpos;
+#define THREADED_DISPATCH_NEXT() { ++frame->cpos; ++frame->dpos; goto *(*frame->dpos); }
+#define THREADED_DISPATCH_JUMP(OFFSET) { frame->cpos += (OFFSET); frame->dpos += (OFFSET); goto *(*frame->dpos); }
+
+void Evaluator::evaluateOpCodeBlocksThreaded(const void* const** exportlabels)
+{
+    if(exportlabels != nullptr)
+    {
+        //Everything not listed here goes through the generic evaluateOpCode switch
+        static const void* s_labels[BSQ_OPCODE_TAG_COUNT + 1];
+        std::fill(s_labels, s_labels + BSQ_OPCODE_TAG_COUNT, &&L_Generic);
+        s_labels[BSQ_OPCODE_TAG_COUNT] = &&L_Done;
+
+        s_labels[(size_t)OpCodeTag::DirectAssignOp] = &&L_DirectAssignOp;
+        s_labels[(size_t)OpCodeTag::LoadConstOp] = &&L_LoadConstOp;
+        s_labels[(size_t)OpCodeTag::LoadEntityFieldDirectOp] = &&L_LoadEntityFieldDirectOp;
+        s_labels[(size_t)OpCodeTag::InvokeFixedFunctionOp] = &&L_InvokeFixedFunctionOp;
+        s_labels[(size_t)OpCodeTag::PrefixNotOp] = &&L_PrefixNotOp;
+        s_labels[(size_t)OpCodeTag::JumpOp] = &&L_JumpOp;
+        s_labels[(size_t)OpCodeTag::JumpCondOp] = &&L_JumpCondOp;
+        s_labels[(size_t)OpCodeTag::JumpNoneOp] = &&L_JumpNoneOp;
+        s_labels[(size_t)OpCodeTag::RegisterAssignOp] = &&L_RegisterAssignOp;
+        s_labels[(size_t)OpCodeTag::ReturnAssignOp] = &&L_ReturnAssignOp;
+        s_labels[(size_t)OpCodeTag::AddNatOp] = &&L_AddNatOp;
+        s_labels[(size_t)OpCodeTag::AddIntOp] = &&L_AddIntOp;
+        s_labels[(size_t)OpCodeTag::AddFloatOp] = &&L_AddFloatOp;
+        s_labels[(size_t)OpCodeTag::SubNatOp] = &&L_SubNatOp;
+        s_labels[(size_t)OpCodeTag::SubIntOp] = &&L_SubIntOp;
+        s_labels[(size_t)OpCodeTag::SubFloatOp] = &&L_SubFloatOp;
+        s_labels[(size_t)OpCodeTag::MultNatOp] = &&L_MultNatOp;
+        s_labels[(size_t)OpCodeTag::MultIntOp] = &&L_MultIntOp;
+        s_labels[(size_t)OpCodeTag::MultFloatOp] = &&L_MultFloatOp;
+        s_labels[(size_t)OpCodeTag::EqNatOp] = &&L_EqNatOp;
+        s_labels[(size_t)OpCodeTag::EqIntOp] = &&L_EqIntOp;
+        s_labels[(size_t)OpCodeTag::NeqNatOp] = &&L_NeqNatOp;
+        s_labels[(size_t)OpCodeTag::NeqIntOp] = &&L_NeqIntOp;
+        s_labels[(size_t)OpCodeTag::LtNatOp] = &&L_LtNatOp;
+        s_labels[(size_t)OpCodeTag::LtIntOp] = &&L_LtIntOp;
+        s_labels[(size_t)OpCodeTag::LeNatOp] = &&L_LeNatOp;
+        s_labels[(size_t)OpCodeTag::LeIntOp] = &&L_LeIntOp;
+
+        s_labels[(size_t)OpCodeTag::LtNatJumpCondOp] = &&L_LtNatJumpCondOp;
+        s_labels[(size_t)OpCodeTag::LtIntJumpCondOp] = &&L_LtIntJumpCondOp;
+        s_labels[(size_t)OpCodeTag::LeNatJumpCondOp] = &&L_LeNatJumpCondOp;
+        s_labels[(size_t)OpCodeTag::LeIntJumpCondOp] = &&L_LeIntJumpCondOp;
+        s_labels[(size_t)OpCodeTag::EqNatJumpCondOp] = &&L_EqNatJumpCondOp;
+        s_labels[(size_t)OpCodeTag::EqIntJumpCondOp] = &&L_EqIntJumpCondOp;
+        s_labels[(size_t)OpCodeTag::NeqNatJumpCondOp] = &&L_NeqNatJumpCondOp;
+        s_labels[(size_t)OpCodeTag::NeqIntJumpCondOp] = &&L_NeqIntJumpCondOp;
+        s_labels[(size_t)OpCodeTag::LoadConstAddNatOp] = &&L_LoadConstAddNatOp;
+        s_labels[(size_t)OpCodeTag::LoadConstAddIntOp] = &&L_LoadConstAddIntOp;
+        s_labels[(size_t)OpCodeTag::LoadEntityFieldDirectRegisterAssignOp] = &&L_LoadEntityFieldDirectRegisterAssignOp;
+        s_labels[(size_t)OpCodeTag::InvokeSelfTailCallOp] = &&L_InvokeSelfTailCallOp;
+        s_labels[(size_t)OpCodeTag::LoadFoldedConstOp] = &&L_LoadFoldedConstOp;
+
+        *exportlabels = s_labels;
+        return;
+    }
+
+    //g_callstack is a static array so the frame pointer is stable across any nested calls
+    EvaluatorFrame* frame = this->cframe;
+    const InterpOp* op = nullptr;
+
+    goto *(*frame->dpos);
+
+L_Generic:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evaluateOpCode(op);
+        THREADED_DISPATCH_NEXT()
+    }
+L_DirectAssignOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalDirectAssignOp<false>(static_cast<const DirectAssignOp*>(op));
+        THREADED_DISPATCH_NEXT()
+    }
+L_LoadConstOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalLoadConstOp(static_cast<const LoadConstOp*>(op));
+        THREADED_DISPATCH_NEXT()
+    }
+L_LoadEntityFieldDirectOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalLoadDirectFieldOp(static_cast<const LoadEntityFieldDirectOp*>(op));
+        THREADED_DISPATCH_NEXT()
+    }
+L_InvokeFixedFunctionOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalInvokeFixedFunctionOp<false>(static_cast<const InvokeFixedFunctionOp*>(op));
+        THREADED_DISPATCH_NEXT()
+    }
+L_PrefixNotOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalPrefixNotOp(static_cast<const PrefixNotOp*>(op));
+        THREADED_DISPATCH_NEXT()
+    }
+L_JumpOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        THREADED_DISPATCH_JUMP(static_cast<const JumpOp*>(op)->offset)
+    }
+L_JumpCondOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        auto jop = static_cast<const JumpCondOp*>(op);
+        BSQBool jc = SLPTR_LOAD_CONTENTS_AS(BSQBool, this->evalArgument(jop->arg));
+        THREADED_DISPATCH_JUMP(jc ? jop->toffset : jop->foffset)
+    }
+L_JumpNoneOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        auto jop = static_cast<const JumpNoneOp*>(op);
+        BSQBool isnone = isNoneTest(jop->arglayout, this->evalArgument(jop->arg));
+        THREADED_DISPATCH_JUMP(isnone ? jop->noffset : jop->soffset)
+    }
+L_RegisterAssignOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalRegisterAssignOp<false>(static_cast<const RegisterAssignOp*>(op));
+        THREADED_DISPATCH_NEXT()
+    }
+L_ReturnAssignOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalReturnAssignOp(static_cast<const ReturnAssignOp*>(op));
+        THREADED_DISPATCH_NEXT()
+    }
+L_AddNatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryOperatorMacroChecked(this, op, OpCodeTag::AddNatOp, BSQNat, +, __builtin_add_overflow, "Nat addition overflow")
+        THREADED_DISPATCH_NEXT()
+    }
+L_AddIntOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryOperatorMacroChecked(this, op, OpCodeTag::AddIntOp, BSQInt, +, __builtin_add_overflow, "Int addition overflow/underflow")
+        THREADED_DISPATCH_NEXT()
+    }
+L_AddFloatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryOperatorMacroSafe(this, op, OpCodeTag::AddFloatOp, BSQFloat, +)
+        THREADED_DISPATCH_NEXT()
+    }
+L_SubNatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryOperatorMacroChecked(this, op, OpCodeTag::SubNatOp, BSQNat, -, __builtin_sub_overflow, "Nat subtraction overflow")
+        THREADED_DISPATCH_NEXT()
+    }
+L_SubIntOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryOperatorMacroChecked(this, op, OpCodeTag::SubIntOp, BSQInt, -, __builtin_sub_overflow, "Int subtraction overflow/underflow")
+        THREADED_DISPATCH_NEXT()
+    }
+L_SubFloatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryOperatorMacroSafe(this, op, OpCodeTag::SubFloatOp, BSQFloat, -)
+        THREADED_DISPATCH_NEXT()
+    }
+L_MultNatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryOperatorMacroChecked(this, op, OpCodeTag::MultNatOp, BSQNat, *, __builtin_mul_overflow, "Nat multiplication overflow")
+        THREADED_DISPATCH_NEXT()
+    }
+L_MultIntOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryOperatorMacroChecked(this, op, OpCodeTag::MultIntOp, BSQInt, *, __builtin_mul_overflow, "Int multiplication underflow/overflow")
+        THREADED_DISPATCH_NEXT()
+    }
+L_MultFloatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryOperatorMacroSafe(this, op, OpCodeTag::MultFloatOp, BSQFloat, *)
+        THREADED_DISPATCH_NEXT()
+    }
+L_EqNatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryComparatorMacroSafe(this, op, OpCodeTag::EqNatOp, BSQNat, ==)
+        THREADED_DISPATCH_NEXT()
+    }
+L_EqIntOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryComparatorMacroSafe(this, op, OpCodeTag::EqIntOp, BSQInt, ==)
+        THREADED_DISPATCH_NEXT()
+    }
+L_NeqNatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryComparatorMacroSafe(this, op, OpCodeTag::NeqNatOp, BSQNat, !=)
+        THREADED_DISPATCH_NEXT()
+    }
+L_NeqIntOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryComparatorMacroSafe(this, op, OpCodeTag::NeqIntOp, BSQInt, !=)
+        THREADED_DISPATCH_NEXT()
+    }
+L_LtNatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryComparatorMacroSafe(this, op, OpCodeTag::LtNatOp, BSQNat, <)
+        THREADED_DISPATCH_NEXT()
+    }
+L_LtIntOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryComparatorMacroSafe(this, op, OpCodeTag::LtIntOp, BSQInt, <)
+        THREADED_DISPATCH_NEXT()
+    }
+L_LeNatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryComparatorMacroSafe(this, op, OpCodeTag::LeNatOp, BSQNat, <=)
+        THREADED_DISPATCH_NEXT()
+    }
+L_LeIntOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        PrimitiveBinaryComparatorMacroSafe(this, op, OpCodeTag::LeIntOp, BSQInt, <=)
+        THREADED_DISPATCH_NEXT()
+    }
+L_LtNatJumpCondOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        auto cjop = static_cast<const PrimitiveCompareJumpCondOp<OpCodeTag::LtNatJumpCondOp>*>(op);
+        BSQBool jc = this->evalPrimitiveCompareJumpCondOp<OpCodeTag::LtNatJumpCondOp, BSQNat>(cjop);
+        THREADED_DISPATCH_JUMP(jc ? cjop->toffset : cjop->foffset)
+    }
+L_LtIntJumpCondOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        auto cjop = static_cast<const PrimitiveCompareJumpCondOp<OpCodeTag::LtIntJumpCondOp>*>(op);
+        BSQBool jc = this->evalPrimitiveCompareJumpCondOp<OpCodeTag::LtIntJumpCondOp, BSQInt>(cjop);
+        THREADED_DISPATCH_JUMP(jc ? cjop->toffset : cjop->foffset)
+    }
+L_LeNatJumpCondOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        auto cjop = static_cast<const PrimitiveCompareJumpCondOp<OpCodeTag::LeNatJumpCondOp>*>(op);
+        BSQBool jc = this->evalPrimitiveCompareJumpCondOp<OpCodeTag::LeNatJumpCondOp, BSQNat>(cjop);
+        THREADED_DISPATCH_JUMP(jc ? cjop->toffset : cjop->foffset)
+    }
+L_LeIntJumpCondOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        auto cjop = static_cast<const PrimitiveCompareJumpCondOp<OpCodeTag::LeIntJumpCondOp>*>(op);
+        BSQBool jc = this->evalPrimitiveCompareJumpCondOp<OpCodeTag::LeIntJumpCondOp, BSQInt>(cjop);
+        THREADED_DISPATCH_JUMP(jc ? cjop->toffset : cjop->foffset)
+    }
+L_EqNatJumpCondOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        auto cjop = static_cast<const PrimitiveCompareJumpCondOp<OpCodeTag::EqNatJumpCondOp>*>(op);
+        BSQBool jc = this->evalPrimitiveCompareJumpCondOp<OpCodeTag::EqNatJumpCondOp, BSQNat>(cjop);
+        THREADED_DISPATCH_JUMP(jc ? cjop->toffset : cjop->foffset)
+    }
+L_EqIntJumpCondOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        auto cjop = static_cast<const PrimitiveCompareJumpCondOp<OpCodeTag::EqIntJumpCondOp>*>(op);
+        BSQBool jc = this->evalPrimitiveCompareJumpCondOp<OpCodeTag::EqIntJumpCondOp, BSQInt>(cjop);
+        THREADED_DISPATCH_JUMP(jc ? cjop->toffset : cjop->foffset)
+    }
+L_NeqNatJumpCondOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        auto cjop = static_cast<const PrimitiveCompareJumpCondOp<OpCodeTag::NeqNatJumpCondOp>*>(op);
+        BSQBool jc = this->evalPrimitiveCompareJumpCondOp<OpCodeTag::NeqNatJumpCondOp, BSQNat>(cjop);
+        THREADED_DISPATCH_JUMP(jc ? cjop->toffset : cjop->foffset)
+    }
+L_NeqIntJumpCondOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        auto cjop = static_cast<const PrimitiveCompareJumpCondOp<OpCodeTag::NeqIntJumpCondOp>*>(op);
+        BSQBool jc = this->evalPrimitiveCompareJumpCondOp<OpCodeTag::NeqIntJumpCondOp, BSQInt>(cjop);
+        THREADED_DISPATCH_JUMP(jc ? cjop->toffset : cjop->foffset)
+    }
+L_LoadConstAddNatOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalLoadConstAddOp<OpCodeTag::LoadConstAddNatOp, BSQNat>(static_cast<const LoadConstBinaryOperatorOp<OpCodeTag::LoadConstAddNatOp>*>(op));
+        THREADED_DISPATCH_JUMP(2)
+    }
+L_LoadConstAddIntOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalLoadConstAddOp<OpCodeTag::LoadConstAddIntOp, BSQInt>(static_cast<const LoadConstBinaryOperatorOp<OpCodeTag::LoadConstAddIntOp>*>(op));
+        THREADED_DISPATCH_JUMP(2)
+    }
+L_LoadEntityFieldDirectRegisterAssignOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalLoadEntityFieldDirectRegisterAssignOp(static_cast<const LoadEntityFieldDirectRegisterAssignOp*>(op));
+        THREADED_DISPATCH_JUMP(2)
+    }
+L_InvokeSelfTailCallOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalInvokeSelfTailCallOp(static_cast<const InvokeSelfTailCallOp*>(op));
+#ifdef BSQ_JIT_AVAILABLE
+        //a self tail call is a back edge -- it counts toward the threshold like a call and the body is entered at its start once compiled
+        if(Evaluator::g_jitenabled && this->tryEnterJitCode(static_cast<const BSQInvokeBodyDecl*>(frame->invoke)))
+        {
+            return;
+        }
+#endif
+        goto *(*frame->dpos);
+    }
+L_LoadFoldedConstOp:
+    {
+        THREADED_DISPATCH_CURRENT()
+        this->evalLoadFoldedConstOp(static_cast<const LoadFoldedConstOp*>(op));
+        THREADED_DISPATCH_NEXT()
+    }
+L_Done:
+    return;
+}
+#endif
+
+void Evaluator::resolveDispatchTable(BSQInvokeBodyDecl* invk)
+{
+#ifdef BSQ_THREADED_DISPATCH
+    if(Evaluator::g_dispatchlabels == nullptr)
+    {
+        this->evaluateOpCodeBlocksThreaded(&Evaluator::g_dispatchlabels);
+    }
+
+    const void* generic = Evaluator::g_dispatchlabels[(size_t)OpCodeTag::Invalid];
+
+    invk->dispatch.clear();
+    invk->dispatch.reserve(invk->body.size() + 1);
+    for(size_t i = 0; i < invk->body.size(); ++i)
+    {
+        const InterpOp* op = invk->body[i];
+        const void* lbl = Evaluator::g_dispatchlabels[(size_t)op->tag];
+
+        //The specialized handlers are the unguarded variants -- guarded ops stay on the generic path
+        if(op->tag == OpCodeTag::DirectAssignOp && static_cast<const DirectAssignOp*>(op)->sguard.enabled)
+        {
+            lbl = generic;
+        }
+        else if(op->tag == OpCodeTag::RegisterAssignOp && static_cast<const RegisterAssignOp*>(op)->sguard.enabled)
+        {
+            lbl = generic;
+        }
+        else if(op->tag == OpCodeTag::InvokeFixedFunctionOp && static_cast<const InvokeFixedFunctionOp*>(op)->sguard.enabled)
+        {
+            lbl = generic;
+        }
+        else
+        {
+            ;
+        }
+
+        invk->dispatch.push_back(lbl);
+    }
+    invk->dispatch.push_back(Evaluator::g_dispatchlabels[BSQ_OPCODE_TAG_COUNT]);
+#endif
+}
+
+#ifdef BSQ_JIT_AVAILABLE
+void Evaluator::jitStepGeneric(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evaluateOpCode(static_cast<const InterpOp*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::DirectAssignOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalDirectAssignOp<false>(static_cast<const DirectAssignOp*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::LoadConstOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalLoadConstOp(static_cast<const LoadConstOp*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::LoadEntityFieldDirectOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalLoadDirectFieldOp(static_cast<const LoadEntityFieldDirectOp*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::InvokeFixedFunctionOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalInvokeFixedFunctionOp<false>(static_cast<const InvokeFixedFunctionOp*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::PrefixNotOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalPrefixNotOp(static_cast<const PrefixNotOp*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::RegisterAssignOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalRegisterAssignOp<false>(static_cast<const RegisterAssignOp*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::ReturnAssignOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalReturnAssignOp(static_cast<const ReturnAssignOp*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::AddNatOp>(void* ctx, const void* op)
+{
+    Evaluator* ee = static_cast<Evaluator*>(ctx);
+    PrimitiveBinaryOperatorMacroChecked(ee, op, OpCodeTag::AddNatOp, BSQNat, +, __builtin_add_overflow, "Nat addition overflow")
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::AddIntOp>(void* ctx, const void* op)
+{
+    Evaluator* ee = static_cast<Evaluator*>(ctx);
+    PrimitiveBinaryOperatorMacroChecked(ee, op, OpCodeTag::AddIntOp, BSQInt, +, __builtin_add_overflow, "Int addition overflow/underflow")
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::SubNatOp>(void* ctx, const void* op)
+{
+    Evaluator* ee = static_cast<Evaluator*>(ctx);
+    PrimitiveBinaryOperatorMacroChecked(ee, op, OpCodeTag::SubNatOp, BSQNat, -, __builtin_sub_overflow, "Nat subtraction overflow")
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::SubIntOp>(void* ctx, const void* op)
+{
+    Evaluator* ee = static_cast<Evaluator*>(ctx);
+    PrimitiveBinaryOperatorMacroChecked(ee, op, OpCodeTag::SubIntOp, BSQInt, -, __builtin_sub_overflow, "Int subtraction overflow/underflow")
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::MultNatOp>(void* ctx, const void* op)
+{
+    Evaluator* ee = static_cast<Evaluator*>(ctx);
+    PrimitiveBinaryOperatorMacroChecked(ee, op, OpCodeTag::MultNatOp, BSQNat, *, __builtin_mul_overflow, "Nat multiplication overflow")
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::MultIntOp>(void* ctx, const void* op)
+{
+    Evaluator* ee = static_cast<Evaluator*>(ctx);
+    PrimitiveBinaryOperatorMacroChecked(ee, op, OpCodeTag::MultIntOp, BSQInt, *, __builtin_mul_overflow, "Int multiplication underflow/overflow")
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::LoadConstAddNatOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalLoadConstAddOp<OpCodeTag::LoadConstAddNatOp, BSQNat>(static_cast<const LoadConstBinaryOperatorOp<OpCodeTag::LoadConstAddNatOp>*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::LoadConstAddIntOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalLoadConstAddOp<OpCodeTag::LoadConstAddIntOp, BSQInt>(static_cast<const LoadConstBinaryOperatorOp<OpCodeTag::LoadConstAddIntOp>*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::LoadEntityFieldDirectRegisterAssignOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalLoadEntityFieldDirectRegisterAssignOp(static_cast<const LoadEntityFieldDirectRegisterAssignOp*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::InvokeSelfTailCallOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalInvokeSelfTailCallOp(static_cast<const InvokeSelfTailCallOp*>(op));
+}
+
+template <>
+void Evaluator::jitStep<OpCodeTag::LoadFoldedConstOp>(void* ctx, const void* op)
+{
+    static_cast<Evaluator*>(ctx)->evalLoadFoldedConstOp(static_cast<const LoadFoldedConstOp*>(op));
+}
+
+template <>
+uint8_t Evaluator::jitCond<OpCodeTag::JumpNoneOp>(void* ctx, const void* op)
+{
+    Evaluator* ee = static_cast<Evaluator*>(ctx);
+    auto jop = static_cast<const JumpNoneOp*>(op);
+    return isNoneTest(jop->arglayout, ee->evalArgument(jop->arg));
+}
+
+//Bytes storeValue moves for the type when it is a plain copy that a stencil can do inline -- 0 if the store has to go through the type
+static size_t jitPlainCopyBytes(const BSQType* tt)
+{
+    if(tt == BSQWellKnownType::g_typeBool)
+    {
+        return sizeof(BSQBool);
+    }
+    else if(tt == BSQWellKnownType::g_typeNat || tt == BSQWellKnownType::g_typeInt)
+    {
+        return sizeof(uint64_t);
+    }
+    else if(dynamic_cast<const BSQRefType*>(tt) != nullptr || dynamic_cast<const BSQBoxedStructType*>(tt) != nullptr)
+    {
+        return sizeof(void*);
+    }
+    else if(dynamic_cast<const BSQStructType*>(tt) != nullptr && tt->allocinfo.assigndatasize % sizeof(uint64_t) == 0 && tt->allocinfo.assigndatasize <= BSQ_JIT_MAX_INLINE_COPY_BYTES)
+    {
+        return tt->allocinfo.assigndatasize;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+//Frame slots are addressed off the frame pointer register and constants by their (fixed) address in the constant buffer
+static void jitEmitLoadArgument(BSQJitEmitter& emitter, BSQJitReg reg, Argument arg, uint32_t offset, size_t bytes)
+{
+    if(arg.kind == ArgumentTag::StackVal)
+    {
+        emitter.emitLoadFrame(reg, arg.location + offset, bytes);
+    }
+    else
+    {
+        emitter.emitLoadAbsolute(reg, Evaluator::g_constantbuffer + arg.location + offset, bytes);
+    }
+}
+
+//Inline stencil for trgt = arg -- false if the type needs its own store
+static bool jitEmitMove(BSQJitEmitter& emitter, TargetVar trgt, Argument arg, const BSQType* tt)
+{
+    size_t bytes = jitPlainCopyBytes(tt);
+    if(bytes == 0)
+    {
+        return false;
+    }
+
+    size_t wbytes = std::min(bytes, sizeof(uint64_t));
+    for(uint32_t i = 0; i < (uint32_t)bytes; i += (uint32_t)wbytes)
+    {
+        jitEmitLoadArgument(emitter, BSQJitReg::RAX, arg, i, wbytes);
+        emitter.emitStoreFrame(trgt.offset + i, BSQJitReg::RAX, wbytes);
+    }
+    return true;
+}
+
+//Inline stencil for trgt = larg op rarg on Int/Nat values -- a failed overflow check goes to the op handler which raises the error
+static void jitEmitArith(BSQJitEmitter& emitter, BSQJitStepFP handler, const InterpOp* op, TargetVar trgt, Argument larg, Argument rarg, BSQJitArith aop, BSQJitCond overflow, size_t resumelabel)
+{
+    jitEmitLoadArgument(emitter, BSQJitReg::RAX, larg, 0, sizeof(uint64_t));
+    jitEmitLoadArgument(emitter, BSQJitReg::RCX, rarg, 0, sizeof(uint64_t));
+    emitter.emitArith(aop);
+    emitter.emitSlowPath(overflow, handler, op, resumelabel);
+    emitter.emitStoreFrame(trgt.offset, BSQJitReg::RAX, sizeof(uint64_t));
+}
+
+//Inline stencil for trgt = larg cmp rarg on Int/Nat values -- leaves the compare in the flags for a following branch
+static void jitEmitCompare(BSQJitEmitter& emitter, TargetVar trgt, Argument larg, Argument rarg, BSQJitCond cc)
+{
+    jitEmitLoadArgument(emitter, BSQJitReg::RAX, larg, 0, sizeof(uint64_t));
+    jitEmitLoadArgument(emitter, BSQJitReg::RCX, rarg, 0, sizeof(uint64_t));
+    emitter.emitCompare();
+    emitter.emitSetCond(cc);
+    emitter.emitStoreFrame(trgt.offset, BSQJitReg::RAX, sizeof(BSQBool));
+}
+
+#define JIT_ARITH_CASE(TAG, ARITH, OVERFLOW) case TAG: \
+{ \
+    auto bop = static_cast<const PrimitiveBinaryOperatorOp<TAG>*>(op); \
+    jitEmitArith(emitter, &Evaluator::jitStep<TAG>, op, bop->trgt, bop->larg, bop->rarg, ARITH, OVERFLOW, i + 1); \
+    break; \
+}
+
+#define JIT_COMPARE_CASE(TAG, CC) case TAG: \
+{ \
+    auto bop = static_cast<const PrimitiveBinaryOperatorOp<TAG>*>(op); \
+    jitEmitCompare(emitter, bop->trgt, bop->larg, bop->rarg, CC); \
+    break; \
+}
+
+//the interpreter stores the compare result as well as branching on it (it may be read after the branch)
+#define JIT_COMPARE_JUMP_CASE(TAG, CC) case TAG: \
+{ \
+    auto cjop = static_cast<const PrimitiveCompareJumpCondOp<TAG>*>(op); \
+    jitEmitCompare(emitter, cjop->trgt, cjop->larg, cjop->rarg, CC); \
+    emitter.emitBranch(CC, i + cjop->toffset, i + cjop->foffset); \
+    break; \
+}
+
+#define JIT_LOAD_CONST_ADD_CASE(TAG, OVERFLOW) case TAG: \
+{ \
+    auto lcop = static_cast<const LoadConstBinaryOperatorOp<TAG>*>(op); \
+    if(!jitEmitMove(emitter, lcop->ctrgt, lcop->carg, lcop->ctype)) \
+    { \
+        emitter.emitCall(&Evaluator::jitStep<TAG>, op); \
+    } \
+    else \
+    { \
+        jitEmitArith(emitter, &Evaluator::jitStep<TAG>, op, lcop->trgt, lcop->larg, lcop->rarg, BSQJitArith::Add, OVERFLOW, i + 2); \
+    } \
+    emitter.emitGoto(i + 2); \
+    break; \
+}
+
+#define JIT_MOVE_CASE(TAG, OPTYPE, TYPEFIELD) case TAG: \
+{ \
+    auto mop = static_cast<const OPTYPE*>(op); \
+    if(!jitEmitMove(emitter, mop->trgt, mop->arg, mop->TYPEFIELD)) \
+    { \
+        emitter.emitCall(&Evaluator::jitStep<TAG>, op); \
+    } \
+    break; \
+}
+
+#define JIT_STEP_CASE(TAG) case TAG: \
+{ \
+    emitter.emitCall(&Evaluator::jitStep<TAG>, op); \
+    break; \
+}
+
+uint8_t* Evaluator::jitFramePtr(void* ctx)
+{
+    return static_cast<Evaluator*>(ctx)->cframe->frameptr;
+}
+
+BSQJitEntryFP Evaluator::jitCompileBody(const BSQInvokeBodyDecl* invk)
+{
+    BSQJitEmitter emitter(invk->body.size());
+    emitter.emitPrologue(&Evaluator::jitFramePtr);
+
+    for(size_t i = 0; i < invk->body.size(); ++i)
+    {
+        const InterpOp* op = invk->body[i];
+        emitter.markLabel(i);
+
+        switch(op->tag)
+        {
+        case OpCodeTag::JumpOp:
+        {
+            emitter.emitGoto(i + static_cast<const JumpOp*>(op)->offset);
+            break;
+        }
+        case OpCodeTag::JumpCondOp:
+        {
+            auto jop = static_cast<const JumpCondOp*>(op);
+            jitEmitLoadArgument(emitter, BSQJitReg::RAX, jop->arg, 0, sizeof(BSQBool));
+            emitter.emitTestByte();
+            emitter.emitBranch(BSQJitCond::NotEqual, i + jop->toffset, i + jop->foffset);
+            break;
+        }
+        case OpCodeTag::JumpNoneOp:
+        {
+            auto jop = static_cast<const JumpNoneOp*>(op);
+            emitter.emitCond(&Evaluator::jitCond<OpCodeTag::JumpNoneOp>, op, i + jop->noffset, i + jop->soffset);
+            break;
+        }
+        JIT_COMPARE_JUMP_CASE(OpCodeTag::LtNatJumpCondOp, BSQJitCond::Carry)
+        JIT_COMPARE_JUMP_CASE(OpCodeTag::LtIntJumpCondOp, BSQJitCond::Less)
+        JIT_COMPARE_JUMP_CASE(OpCodeTag::LeNatJumpCondOp, BSQJitCond::BelowEqual)
+        JIT_COMPARE_JUMP_CASE(OpCodeTag::LeIntJumpCondOp, BSQJitCond::LessEqual)
+        JIT_COMPARE_JUMP_CASE(OpCodeTag::EqNatJumpCondOp, BSQJitCond::Equal)
+        JIT_COMPARE_JUMP_CASE(OpCodeTag::EqIntJumpCondOp, BSQJitCond::Equal)
+        JIT_COMPARE_JUMP_CASE(OpCodeTag::NeqNatJumpCondOp, BSQJitCond::NotEqual)
+        JIT_COMPARE_JUMP_CASE(OpCodeTag::NeqIntJumpCondOp, BSQJitCond::NotEqual)
+        JIT_LOAD_CONST_ADD_CASE(OpCodeTag::LoadConstAddNatOp, BSQJitCond::Carry)
+        JIT_LOAD_CONST_ADD_CASE(OpCodeTag::LoadConstAddIntOp, BSQJitCond::Overflow)
+        case OpCodeTag::LoadEntityFieldDirectRegisterAssignOp:
+        {
+            emitter.emitCall(&Evaluator::jitStep<OpCodeTag::LoadEntityFieldDirectRegisterAssignOp>, op);
+            emitter.emitGoto(i + 2);
+            break;
+        }
+        case OpCodeTag::InvokeSelfTailCallOp:
+        {
+            //the handler has already reset the frame (in place so the frame pointer is unchanged) so just restart the body
+            emitter.emitCall(&Evaluator::jitStep<OpCodeTag::InvokeSelfTailCallOp>, op);
+            emitter.emitGoto(0);
+            break;
+        }
+        case OpCodeTag::DirectAssignOp:
+        {
+            auto aop = static_cast<const DirectAssignOp*>(op);
+            if(aop->sguard.enabled)
+            {
+                emitter.emitCall(&Evaluator::jitStepGeneric, op);
+            }
+            else if(!jitEmitMove(emitter, aop->trgt, aop->arg, aop->intotype))
+            {
+                emitter.emitCall(&Evaluator::jitStep<OpCodeTag::DirectAssignOp>, op);
+            }
+            break;
+        }
+        case OpCodeTag::RegisterAssignOp:
+        {
+            auto aop = static_cast<const RegisterAssignOp*>(op);
+            if(aop->sguard.enabled)
+            {
+                emitter.emitCall(&Evaluator::jitStepGeneric, op);
+            }
+            else if(!jitEmitMove(emitter, aop->trgt, aop->arg, aop->oftype))
+            {
+                emitter.emitCall(&Evaluator::jitStep<OpCodeTag::RegisterAssignOp>, op);
+            }
+            break;
+        }
+        case OpCodeTag::InvokeFixedFunctionOp:
+        {
+            bool guarded = static_cast<const InvokeFixedFunctionOp*>(op)->sguard.enabled;
+            emitter.emitCall(guarded ? &Evaluator::jitStepGeneric : &Evaluator::jitStep<OpCodeTag::InvokeFixedFunctionOp>, op);
+            break;
+        }
+        case OpCodeTag::LoadFoldedConstOp:
+        {
+            //the folded value is patched into the stencil as an immediate
+            auto fop = static_cast<const LoadFoldedConstOp*>(op);
+            size_t bytes = jitPlainCopyBytes(fop->oftype);
+            if(bytes == sizeof(BSQBool) || bytes == sizeof(uint64_t))
+            {
+                emitter.emitLoadImmediate(BSQJitReg::RAX, fop->value);
+                emitter.emitStoreFrame(fop->trgt.offset, BSQJitReg::RAX, bytes);
+            }
+            else
+            {
+                emitter.emitCall(&Evaluator::jitStep<OpCodeTag::LoadFoldedConstOp>, op);
+            }
+            break;
+        }
+        JIT_MOVE_CASE(OpCodeTag::LoadConstOp, LoadConstOp, oftype)
+        JIT_MOVE_CASE(OpCodeTag::ReturnAssignOp, ReturnAssignOp, oftype)
+        JIT_ARITH_CASE(OpCodeTag::AddNatOp, BSQJitArith::Add, BSQJitCond::Carry)
+        JIT_ARITH_CASE(OpCodeTag::AddIntOp, BSQJitArith::Add, BSQJitCond::Overflow)
+        JIT_ARITH_CASE(OpCodeTag::SubNatOp, BSQJitArith::Sub, BSQJitCond::Carry)
+        JIT_ARITH_CASE(OpCodeTag::SubIntOp, BSQJitArith::Sub, BSQJitCond::Overflow)
+        JIT_ARITH_CASE(OpCodeTag::MultNatOp, BSQJitArith::UnsignedMult, BSQJitCond::Overflow)
+        JIT_ARITH_CASE(OpCodeTag::MultIntOp, BSQJitArith::SignedMult, BSQJitCond::Overflow)
+        JIT_COMPARE_CASE(OpCodeTag::EqNatOp, BSQJitCond::Equal)
+        JIT_COMPARE_CASE(OpCodeTag::EqIntOp, BSQJitCond::Equal)
+        JIT_COMPARE_CASE(OpCodeTag::NeqNatOp, BSQJitCond::NotEqual)
+        JIT_COMPARE_CASE(OpCodeTag::NeqIntOp, BSQJitCond::NotEqual)
+        JIT_COMPARE_CASE(OpCodeTag::LtNatOp, BSQJitCond::Carry)
+        JIT_COMPARE_CASE(OpCodeTag::LtIntOp, BSQJitCond::Less)
+        JIT_COMPARE_CASE(OpCodeTag::LeNatOp, BSQJitCond::BelowEqual)
+        JIT_COMPARE_CASE(OpCodeTag::LeIntOp, BSQJitCond::LessEqual)
+        JIT_STEP_CASE(OpCodeTag::LoadEntityFieldDirectOp)
+        JIT_STEP_CASE(OpCodeTag::PrefixNotOp)
+        default:
+        {
+            //collections, strings, allocation, etc. all call back into the generic interpreter handler
+            emitter.emitCall(&Evaluator::jitStepGeneric, op);
+            break;
+        }
+        }
     }
-    case OpCodeTag::LeRationalOp:
+
+    emitter.markLabel(invk->body.size());
+    emitter.emitEpilogue();
+
+    return emitter.finalize();
+}
+
+bool Evaluator::tryEnterJitCode(const BSQInvokeBodyDecl* invk)
+{
+    if(invk->jitcode == nullptr && !invk->jitrejected && ++invk->jitcalls >= Evaluator::g_jitthreshold)
     {
-        assert(false);
-        break;
+        invk->jitcode = (void*)this->jitCompileBody(invk);
+        invk->jitrejected = (invk->jitcode == nullptr);
+        Evaluator::g_jitCompiledCount += (invk->jitcode != nullptr) ? 1 : 0;
     }
-    case OpCodeTag::LeFloatOp:
+
+    if(invk->jitcode == nullptr)
     {
-        PrimitiveBinaryComparatorMacroFP(this, op, OpCodeTag::LeFloatOp, BSQFloat, std::isnan, std::isinf, <=)
-        break;
+        return false;
     }
-    case OpCodeTag::LeDecimalOp:
+
+    ((BSQJitEntryFP)invk->jitcode)(this);
+    return true;
+}
+#endif
+
+void Evaluator::evaluateOpCodeBlocks()
+{
+#ifdef BSQ_JIT_AVAILABLE
+    //Guard -- the native tier is only used when enabled, with no debugger, and if the body compiled (otherwise we stay in the interpreter)
+    bool usejit = Evaluator::g_jitenabled;
+#ifdef BSQ_DEBUG_BUILD
+    usejit &= !this->debuggerattached;
+#endif
+    if(usejit)
     {
-        PrimitiveBinaryComparatorMacroFP(this, op, OpCodeTag::LeDecimalOp, BSQDecimal, std::isnan, std::isinf, <=)
-        break;
+        if(this->tryEnterJitCode(static_cast<const BSQInvokeBodyDecl*>(this->cframe->invoke)))
+        {
+            return;
+        }
     }
-    default:
+#endif
+
+#ifdef BSQ_THREADED_DISPATCH
+#ifdef BSQ_DEBUG_BUILD
+    if(!this->debuggerattached)
+#endif
     {
-        assert(false);
-        break;
-    }
+        this->evaluateOpCodeBlocksThreaded(nullptr);
+        return;
     }
-}
+#endif
 
-void Evaluator::evaluateOpCodeBlocks()
-{
     InterpOp* op = this->getCurrentOp();
     do
     {
@@ -1901,19 +2863,20 @@ void Evaluator::invoke(const BSQInvokeDecl* call, const std::vector<Argument>& a
 {
     if(call->isPrimitive())
     {
-        std::vector<StorageLocationPtr> pv(args.size(), (StorageLocationPtr)nullptr);
-        std::transform(args.cbegin(), args.cend(), pv.begin(), [this](const Argument& arg) {
-            return this->evalArgument(arg);
-        });
+        StorageLocationPtr* pv = (StorageLocationPtr*)BSQ_STACK_ALLOC(sizeof(StorageLocationPtr) * args.size());
+        for(size_t i = 0; i < args.size(); ++i)
+        {
+            pv[i] = this->evalArgument(args[i]);
+        }
 
-        this->evaluatePrimitiveBody((const BSQInvokePrimitiveDecl*)call, pv, resultsl, call->resultType);
+        this->evaluatePrimitiveBody((const BSQInvokePrimitiveDecl*)call, StorageLocationSpan(pv, args.size()), resultsl, call->resultType);
     }
     else
     {
         const BSQInvokeBodyDecl* idecl = (const BSQInvokeBodyDecl*)call;
 
         size_t cssize = idecl->stackBytes;
-        uint8_t* cstack = GCStack::allocFrame(cssize);
+        uint8_t* cstack = GCStack::allocMappedFrame(cssize, idecl->stackmap);
 
         for(size_t i = 0; i < args.size(); ++i)
         {
@@ -1931,15 +2894,14 @@ void Evaluator::invoke(const BSQInvokeDecl* call, const std::vector<Argument>& a
         this->evaluateBody(resultsl, idecl->resultType, idecl->resultArg);
         this->invokePostlude();
 
-        GCStack::popFrame(cssize);
+        GCStack::popMappedFrame(cssize, idecl->stackmap);
     }
 }
 
 void Evaluator::vinvoke(const BSQInvokeBodyDecl* idecl, StorageLocationPtr rcvr, const std::vector<Argument>& args, StorageLocationPtr resultsl, BSQBool* optmask)
 {
     size_t cssize = idecl->stackBytes;
-    uint8_t* cstack = GCStack::allocFrame(cssize);
-    GC_MEM_ZERO(cstack, cssize);
+    uint8_t* cstack = GCStack::allocMappedFrame(cssize, idecl->stackmap);
 
     StorageLocationPtr pv = Evaluator::evalParameterInfo(idecl->paraminfo[0], cstack);
     idecl->params[0].ptype->storeValue(pv, rcvr);
@@ -1960,11 +2922,16 @@ void Evaluator::vinvoke(const BSQInvokeBodyDecl* idecl, StorageLocationPtr rcvr,
     this->evaluateBody(resultsl, idecl->resultType, idecl->resultArg);
     this->invokePostlude();
 
-    GCStack::popFrame(cssize);
+    GCStack::popMappedFrame(cssize, idecl->stackmap);
 }
 
 void Evaluator::invokePrelude(const BSQInvokeBodyDecl* invk, uint8_t* cstack, uint8_t* maskslots, BSQBool* optmask)
 {
+    if(!invk->isMaterialized())
+    {
+        materializeBody(invk, *this);
+    }
+
 #ifdef BSQ_DEBUG_BUILD
     this->pushFrame(this->computeCallIntoStepMode(), this->computeCurrentBreakpoint(), invk, cstack, optmask, maskslots, &invk->body);
 #else
@@ -1977,7 +2944,7 @@ void Evaluator::invokePostlude()
     this->popFrame();
 }
 
-void Evaluator::evaluatePrimitiveBody(const BSQInvokePrimitiveDecl* invk, const std::vector<StorageLocationPtr>& params, StorageLocationPtr resultsl, const BSQType* restype)
+void Evaluator::evaluatePrimitiveBody(const BSQInvokePrimitiveDecl* invk, StorageLocationSpan params, StorageLocationPtr resultsl, const BSQType* restype)
 {
     LambdaEvalThunk eethunk(this);
 
@@ -2645,8 +3612,7 @@ void Evaluator::evaluatePrimitiveBody(const BSQInvokePrimitiveDecl* invk, const
 void Evaluator::invokeGlobalCons(const BSQInvokeBodyDecl* invk, StorageLocationPtr resultsl, const BSQType* restype, Argument resarg)
 {
     size_t cssize = invk->stackBytes;
-    uint8_t* cstack = (uint8_t*)GCStack::allocFrame(cssize);
-    GC_MEM_ZERO(cstack, cssize);
+    uint8_t* cstack = GCStack::allocMappedFrame(cssize, invk->stackmap);
 
     size_t maskslotbytes = invk->maskSlots * sizeof(BSQBool);
     BSQBool* maskslots = (BSQBool*)BSQ_STACK_ALLOC(maskslotbytes);
@@ -2657,13 +3623,13 @@ void Evaluator::invokeGlobalCons(const BSQInvokeBodyDecl* invk, StorageLocationP
     this->evaluateBody(resultsl, restype, resarg);
     this->invokePostlude();
 
-    GCStack::popFrame(cssize);
+    GCStack::popMappedFrame(cssize, invk->stackmap);
 }
 
 void Evaluator::invokeMain(const BSQInvokeBodyDecl* invk, uint8_t* istack, StorageLocationPtr resultsl, const BSQType* restype, Argument resarg)
 {
     size_t cssize = invk->stackBytes;
-    uint8_t* cstack = (uint8_t*)GCStack::allocFrame(cssize);
+    uint8_t* cstack = GCStack::allocMappedFrame(cssize, invk->stackmap);
     GC_MEM_COPY(cstack, istack, cssize);
 
     size_t maskslotbytes = invk->maskSlots * sizeof(BSQBool);
@@ -2674,14 +3640,13 @@ void Evaluator::invokeMain(const BSQInvokeBodyDecl* invk, uint8_t* istack, Stora
     this->evaluateBody(resultsl, restype, resarg);
     this->invokePostlude();
 
-    GCStack::popFrame(cssize);
+    GCStack::popMappedFrame(cssize, invk->stackmap);
 }
 
-void Evaluator::linvoke(const BSQInvokeBodyDecl* call, const std::vector<StorageLocationPtr>& args, StorageLocationPtr resultsl)
+void Evaluator::linvoke(const BSQInvokeBodyDecl* call, StorageLocationSpan args, StorageLocationPtr resultsl)
 {
     size_t cssize = call->stackBytes;
-    uint8_t* cstack = (uint8_t*)GCStack::allocFrame(cssize);
-    GC_MEM_ZERO(cstack, cssize);
+    uint8_t* cstack = GCStack::allocMappedFrame(cssize, call->stackmap);
 
     for(size_t i = 0; i < args.size(); ++i)
     {
@@ -2697,14 +3662,13 @@ void Evaluator::linvoke(const BSQInvokeBodyDecl* call, const std::vector<Storage
     this->evaluateBody(resultsl, call->resultType, call->resultArg);
     this->invokePostlude();
 
-    GCStack::popFrame(cssize);
+    GCStack::popMappedFrame(cssize, call->stackmap);
 }
 
-bool Evaluator::iinvoke(const BSQInvokeBodyDecl* call, const std::vector<StorageLocationPtr>& args, BSQBool* optmask)
+bool Evaluator::iinvoke(const BSQInvokeBodyDecl* call, StorageLocationSpan args, BSQBool* optmask)
 {
     size_t cssize = call->stackBytes;
-    uint8_t* cstack = (uint8_t*)GCStack::allocFrame(cssize);
-    GC_MEM_ZERO(cstack, cssize);
+    uint8_t* cstack = GCStack::allocMappedFrame(cssize, call->stackmap);
 
     for(size_t i = 0; i < args.size(); ++i)
     {
@@ -2721,15 +3685,14 @@ bool Evaluator::iinvoke(const BSQInvokeBodyDecl* call, const std::vector<Storage
     this->evaluateBody(&ok, call->resultType, call->resultArg);
     this->invokePostlude();
 
-    GCStack::popFrame(cssize);
+    GCStack::popMappedFrame(cssize, call->stackmap);
     return (bool)ok;
 }
 
-void Evaluator::cinvoke(const BSQInvokeBodyDecl* call, const std::vector<StorageLocationPtr>& args, BSQBool* optmask, StorageLocationPtr resultsl)
+void Evaluator::cinvoke(const BSQInvokeBodyDecl* call, StorageLocationSpan args, BSQBool* optmask, StorageLocationPtr resultsl)
 {
     size_t cssize = call->stackBytes;
-    uint8_t* cstack = (uint8_t*)GCStack::allocFrame(cssize);
-    GC_MEM_ZERO(cstack, cssize);
+    uint8_t* cstack = GCStack::allocMappedFrame(cssize, call->stackmap);
 
     for(size_t i = 0; i < args.size(); ++i)
     {
@@ -2745,20 +3708,100 @@ void Evaluator::cinvoke(const BSQInvokeBodyDecl* call, const std::vector<Storage
     this->evaluateBody(resultsl, call->resultType, call->resultArg);
     this->invokePostlude();
 
-    GCStack::popFrame(cssize);
+    GCStack::popMappedFrame(cssize, call->stackmap);
 }
 
-void LambdaEvalThunk::invoke(const BSQInvokeBodyDecl* call, const std::vector<StorageLocationPtr>& args, StorageLocationPtr resultsl)
+void LambdaEvalThunk::invoke(const BSQInvokeBodyDecl* call, StorageLocationSpan args, StorageLocationPtr resultsl)
 {
     static_cast<Evaluator*>(this->ctx)->linvoke(call, args, resultsl);
 }
 
+std::vector<ICPPMarshalPlan> ICPPParseJSON::g_marshalplans;
+std::list<std::string> ICPPParseJSON::g_inputstrings;
+std::list<std::vector<uint8_t>> ICPPParseJSON::g_inputbuffers;
+
+void ICPPParseJSON::releaseInputPayloads()
+{
+    ICPPParseJSON::g_inputstrings.clear();
+    ICPPParseJSON::g_inputbuffers.clear();
+}
+
+void ICPPParseJSON::buildMarshalPlans(const APIModule* apimodule)
+{
+    size_t plancount = 0;
+    for(auto iter = apimodule->typemap.cbegin(); iter != apimodule->typemap.cend(); ++iter)
+    {
+        plancount = std::max(plancount, iter->second->planid + 1);
+    }
+
+    ICPPParseJSON::g_marshalplans.clear();
+    ICPPParseJSON::g_marshalplans.resize(plancount, {nullptr, {}, {}, 0});
+
+    for(auto iter = apimodule->typemap.cbegin(); iter != apimodule->typemap.cend(); ++iter)
+    {
+        const IType* itype = iter->second;
+        auto tidii = MarshalEnvironment::g_typenameToIdMap.find(itype->name);
+        if(tidii == MarshalEnvironment::g_typenameToIdMap.cend())
+        {
+            continue;
+        }
+
+        ICPPMarshalPlan& plan = ICPPParseJSON::g_marshalplans[itype->planid];
+        plan.btype = BSQType::g_typetable[tidii->second];
+
+        if(itype->tag == TypeTag::TupleTag)
+        {
+            auto tupinfo = dynamic_cast<const BSQTupleInfo*>(plan.btype);
+            plan.offsets = tupinfo->idxoffsets;
+        }
+        else if(itype->tag == TypeTag::RecordTag)
+        {
+            auto rtype = static_cast<const RecordType*>(itype);
+            auto recinfo = dynamic_cast<const BSQRecordInfo*>(plan.btype);
+
+            std::transform(rtype->props.cbegin(), rtype->props.cend(), std::back_inserter(plan.offsets), [recinfo](const std::string& pname) {
+                BSQRecordPropertyID pid = MarshalEnvironment::g_propertyToIdMap.at(pname);
+                auto piter = std::find(recinfo->properties.cbegin(), recinfo->properties.cend(), pid);
+                return recinfo->propertyoffsets[std::distance(recinfo->properties.cbegin(), piter)];
+            });
+        }
+        else if(itype->tag == TypeTag::EntityTag)
+        {
+            auto etype = static_cast<const EntityType*>(itype);
+            auto ooinfo = dynamic_cast<const BSQEntityInfo*>(plan.btype);
+
+            std::transform(etype->consfields.cbegin(), etype->consfields.cend(), std::back_inserter(plan.offsets), [ooinfo](const std::pair<std::string, std::string>& fnamefkey) {
+                BSQFieldID fid = MarshalEnvironment::g_fieldToIdMap.at(fnamefkey.second);
+                auto fiter = std::find(ooinfo->fields.cbegin(), ooinfo->fields.cend(), fid);
+                return ooinfo->fieldoffsets[std::distance(ooinfo->fields.cbegin(), fiter)];
+            });
+
+            plan.maskcount = (size_t)std::count_if(ooinfo->fields.cbegin(), ooinfo->fields.cend(), [](BSQFieldID fid) {
+                return BSQField::g_fieldtable[fid]->isOptional;
+            });
+        }
+        else if(itype->tag == TypeTag::UnionTag)
+        {
+            auto utype = static_cast<const UnionType*>(itype);
+
+            std::transform(utype->opts.cbegin(), utype->opts.cend(), std::back_inserter(plan.opttypes), [](const std::string& oname) {
+                auto oidii = MarshalEnvironment::g_typenameToIdMap.find(oname);
+                return oidii != MarshalEnvironment::g_typenameToIdMap.cend() ? BSQType::g_typetable[oidii->second] : nullptr;
+            });
+        }
+        else
+        {
+            ;
+        }
+    }
+}
+
 bool ICPPParseJSON::checkInvokeOk(const std::string& checkinvoke, StorageLocationPtr value, Evaluator& ctx)
 {
     auto invkid = MarshalEnvironment::g_invokeToIdMap.at(checkinvoke);
     auto invk = dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[invkid]);
 
-    std::vector<StorageLocationPtr> args = {value};
+    StorageLocationPtr args[] = {value};
     BSQBool bb = BSQFALSE;
     ctx.linvoke(invk, args, &bb);
 
@@ -2882,19 +3925,24 @@ bool ICPPParseJSON::parseStringImpl(const APIModule* apimodule, const IType* ity
     {
         rstr.u_inlineString = BSQInlineString::create((const uint8_t*)s.c_str(), s.size());
     }
-    else if(s.size() <= 128)
+    else if(s.size() < 128)
     {
         auto stp = BSQStringKReprTypeAbstract::selectKReprForSize(s.size());
 
         rstr.u_data = Allocator::GlobalAllocator.allocateDynamic(stp);
-        BSQ_MEM_COPY(rstr.u_data, s.c_str(), s.size());
+        *((uint8_t*)rstr.u_data) = (uint8_t)s.size();
+        BSQ_MEM_COPY(BSQStringKReprTypeAbstract::getUTF8Bytes(rstr.u_data), s.c_str(), s.size());
     }
     else
     {
-        //
-        //TODO: split the string into multiple parts
-        //
-         assert(false);
+        //keep the input bytes and reference them from a single flat leaf
+        ICPPParseJSON::g_inputstrings.push_back(std::move(s));
+        const std::string& istr = ICPPParseJSON::g_inputstrings.back();
+
+        auto frepr = (BSQStringFlatRepr*)Allocator::GlobalAllocator.allocateDynamic(BSQWellKnownType::g_typeStringFlatRepr);
+        *frepr = {(const uint8_t*)istr.c_str(), (uint64_t)istr.size()};
+
+        rstr.u_data = frepr;
     }
     
     SLPTR_STORE_CONTENTS_AS(BSQString, value, rstr);
@@ -2903,58 +3951,42 @@ bool ICPPParseJSON::parseStringImpl(const APIModule* apimodule, const IType* ity
 
 bool ICPPParseJSON::parseByteBufferImpl(const APIModule* apimodule, const IType* itype, uint8_t compress, uint8_t format, std::vector<uint8_t>& data, StorageLocationPtr value, Evaluator& ctx)
 {
-    assert(false);
-    return false;
-
-    /*
-    Allocator::GlobalAllocator.ensureSpace(BSQWellKnownType::g_typeByteBufferLeaf->allocinfo.heapsize + BSQWellKnownType::g_typeByteBufferNode->allocinfo.heapsize + (2 * sizeof(GC_META_DATA_WORD)));
-    BSQByteBufferNode* cnode = (BSQByteBufferNode*)Allocator::GlobalAllocator.allocateSafe(BSQWellKnownType::g_typeByteBufferNode);
-    cnode->bytecount = std::min((uint64_t)data.size(), (uint64_t)256);
-    cnode->bytes = (BSQByteBufferLeaf*)Allocator::GlobalAllocator.allocateSafe(BSQWellKnownType::g_typeByteBufferLeaf);
-    cnode->next = nullptr;
-
-    void* croot = cnode;
-    GCStack::pushFrame(&croot, "2");
+    void** stck = (void**)GCStack::allocFrame(sizeof(void*) * 2);
+    GC_MEM_ZERO(stck, sizeof(void*) * 2);
 
-    size_t i = 0;
-    while(i < data.size())
+    if(!data.empty())
     {
-        std::copy(data.cbegin() + i, data.cbegin() + i + cnode->bytecount, cnode->bytes->bytes);
-        i += cnode->bytecount;
-
-        if(i < data.size())
+        //a buffer that fits in a leaf is copied into it and a larger one is kept as is and referenced from a single flat node
+        BSQByteBufferNode* cnode = nullptr;
+        if(data.size() <= sizeof(BSQByteBufferLeaf))
         {
-            Allocator::GlobalAllocator.ensureSpace(BSQWellKnownType::g_typeByteBufferLeaf->allocinfo.heapsize + BSQWellKnownType::g_typeByteBufferNode->allocinfo.heapsize + (2 * sizeof(GC_META_DATA_WORD)));
-            BSQByteBufferNode* cnode = (BSQByteBufferNode*)Allocator::GlobalAllocator.allocateSafe(BSQWellKnownType::g_typeByteBufferNode);
-            cnode->bytecount = std::min((uint64_t)data.size(), (uint64_t)256);
-            cnode->bytes = (BSQByteBufferLeaf*)Allocator::GlobalAllocator.allocateSafe(BSQWellKnownType::g_typeByteBufferLeaf);
-            cnode->next = (BSQByteBufferNode*)croot;
+            stck[0] = Allocator::GlobalAllocator.allocateDynamic(BSQWellKnownType::g_typeByteBufferLeaf);
+            GC_MEM_COPY(((BSQByteBufferLeaf*)stck[0])->bytes, data.data(), data.size());
 
-            croot = cnode;
+            cnode = (BSQByteBufferNode*)Allocator::GlobalAllocator.allocateDynamic(BSQWellKnownType::g_typeByteBufferNode);
+            *cnode = {nullptr, (BSQByteBufferLeaf*)stck[0], (uint64_t)data.size()};
         }
-    }
+        else
+        {
+            ICPPParseJSON::g_inputbuffers.push_back(std::move(data));
+            const std::vector<uint8_t>& ibuff = ICPPParseJSON::g_inputbuffers.back();
 
-    BSQByteBufferNode* nnode = (BSQByteBufferNode*)croot;
+            cnode = (BSQByteBufferNode*)Allocator::GlobalAllocator.allocateDynamic(BSQWellKnownType::g_typeByteBufferFlatNode);
+            *cnode = {nullptr, (BSQByteBufferLeaf*)ibuff.data(), (uint64_t)ibuff.size()};
+        }
 
-    while(nnode->next != nullptr)
-    {
-        auto nn = nnode->next;
-        nnode->next = nnode;
-        nnode = nn;
+        stck[1] = cnode;
     }
 
-    Allocator::GlobalAllocator.ensureSpace(BSQWellKnownType::g_typeByteBuffer->allocinfo.heapsize + sizeof(GC_META_DATA_WORD));
-    BSQByteBuffer* buff = (BSQByteBuffer*)Allocator::GlobalAllocator.allocateSafe(BSQWellKnownType::g_typeByteBufferNode);
-    buff->bytecount = data.size();
-    buff->bytes = nnode;
-    buff->compression = (BufferCompression)compress;
-    buff->format = (BufferFormat)format;
+    auto bytecount = (stck[1] != nullptr) ? ((BSQByteBufferNode*)stck[1])->bytecount : 0;
+
+    BSQByteBuffer* buff = (BSQByteBuffer*)Allocator::GlobalAllocator.allocateDynamic(BSQWellKnownType::g_typeByteBuffer);
+    *buff = {(BSQByteBufferNode*)stck[1], bytecount, (BufferFormat)format, (BufferCompression)compress};
 
     SLPTR_STORE_CONTENTS_AS_GENERIC_HEAPOBJ(value, buff);
 
-    GCStack::popFrame();
+    GCStack::popFrame(sizeof(void*) * 2);
     return true;
-    */
 }
 
 bool ICPPParseJSON::parseDateTimeImpl(const APIModule* apimodule, const IType* itype, APIDateTime t, StorageLocationPtr value, Evaluator& ctx)
@@ -3072,8 +4104,7 @@ bool ICPPParseJSON::parseLatLongCoordinateImpl(const APIModule* apimodule, const
 
 void ICPPParseJSON::prepareParseTuple(const APIModule* apimodule, const IType* itype, Evaluator& ctx)
 {
-    BSQTypeID tupid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    const BSQType* tuptype = BSQType::g_typetable[tupid];
+    const BSQType* tuptype = ICPPParseJSON::planFor(itype).btype;
 
     void* tupmem = nullptr;
     if(tuptype->tkind == BSQTypeLayoutKind::Struct)
@@ -3092,9 +4123,8 @@ void ICPPParseJSON::prepareParseTuple(const APIModule* apimodule, const IType* i
 StorageLocationPtr ICPPParseJSON::getValueForTupleIndex(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t i, Evaluator& ctx)
 {
     void* tupmem = this->tuplestack.back().first;
-    const BSQType* tuptype = this->tuplestack.back().second;
 
-    return SLPTR_INDEX_DATAPTR(tupmem, dynamic_cast<const BSQTupleInfo*>(tuptype)->idxoffsets[i]);
+    return SLPTR_INDEX_DATAPTR(tupmem, ICPPParseJSON::planFor(itype).offsets[i]);
 }
 
 void ICPPParseJSON::completeParseTuple(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
@@ -3125,8 +4155,7 @@ void ICPPParseJSON::completeParseTuple(const APIModule* apimodule, const IType*
 
 void ICPPParseJSON::prepareParseRecord(const APIModule* apimodule, const IType* itype, Evaluator& ctx)
 {
-    BSQTypeID recid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    const BSQType* rectype = BSQType::g_typetable[recid];
+    const BSQType* rectype = ICPPParseJSON::planFor(itype).btype;
 
     void* recmem = nullptr;
     if(rectype->tkind == BSQTypeLayoutKind::Struct)
@@ -3141,13 +4170,11 @@ void ICPPParseJSON::prepareParseRecord(const APIModule* apimodule, const IType*
     this->recordstack.push_back(std::make_pair(recmem, rectype));
 }
 
-StorageLocationPtr ICPPParseJSON::getValueForRecordProperty(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, std::string pname, Evaluator& ctx)
+StorageLocationPtr ICPPParseJSON::getValueForRecordProperty(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t pidx, Evaluator& ctx)
 {
     void* recmem = this->recordstack.back().first;
-    const BSQType* rectype = this->recordstack.back().second;
 
-    BSQRecordPropertyID pid = MarshalEnvironment::g_propertyToIdMap.at(pname);
-    return SLPTR_INDEX_DATAPTR(recmem, dynamic_cast<const BSQRecordInfo*>(rectype)->propertyoffsets[pid]);
+    return SLPTR_INDEX_DATAPTR(recmem, ICPPParseJSON::planFor(itype).offsets[pidx]);
 }
 
 void ICPPParseJSON::completeParseRecord(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
@@ -3173,13 +4200,12 @@ void ICPPParseJSON::completeParseRecord(const APIModule* apimodule, const IType*
     GC_MEM_COPY(trgt, recmem, bytes);
 
     GCStack::popFrame(bytes);
-    this->tuplestack.pop_back();
+    this->recordstack.pop_back();
 }
 
 void ICPPParseJSON::prepareParseContainer(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t count, Evaluator& ctx)
 {
-    BSQTypeID containertypeid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    const BSQType* collectiontype = BSQType::g_typetable[containertypeid];
+    const BSQType* collectiontype = ICPPParseJSON::planFor(itype).btype;
 
     //TODO: right now we just assume we can stack alloc this space -- later we want to add special heap allocated frame support (like for global the object)
     uint8_t* recmem = nullptr;
@@ -3291,10 +4317,10 @@ void ICPPParseJSON::completeParseContainer(const APIModule* apimodule, const ITy
                     rres = nullptr;
                 }
 
-                LIST_STORE_RESULT_REPR(&rres, value);
+                LIST_STORE_RESULT_REPR(rres, value);
             }
 
-            GCStack::allocFrame(this->containerstack.back().second.second * lflavor.entrytype->allocinfo.inlinedatasize);
+            GCStack::popFrame(this->containerstack.back().second.second * lflavor.entrytype->allocinfo.inlinedatasize);
         }
         else if(ctype->category == ContainerCategory::Stack)
         {
@@ -3321,7 +4347,8 @@ void ICPPParseJSON::completeParseContainer(const APIModule* apimodule, const ITy
         else if(this->containerstack.back().second.second == 1)
         {
             BSQMapTreeRepr* mtr = (BSQMapTreeRepr*)Allocator::GlobalAllocator.allocateDynamic(mflavor.treetype);
-            mflavor.treetype->initializeLeaf(mtr, mflavor.treetype->getKeyLocation(mtr), mflavor.keytype, mflavor.treetype->getValueLocation(mtr), mflavor.valuetype);
+            uint8_t* recmem = this->containerstack.back().second.first;
+            mflavor.treetype->initializeLeaf(mtr, recmem, mflavor.keytype, recmem + mflavor.keytype->allocinfo.inlinedatasize, mflavor.valuetype);
 
             MAP_STORE_RESULT_REPR(mtr, value);
         }
@@ -3330,16 +4357,183 @@ void ICPPParseJSON::completeParseContainer(const APIModule* apimodule, const ITy
             assert(false);
         }
 
-        GCStack::allocFrame(this->containerstack.back().second.second * (mflavor.keytype->allocinfo.inlinedatasize + mflavor.keytype->allocinfo.inlinedatasize));
+        GCStack::popFrame(this->containerstack.back().second.second * (mflavor.keytype->allocinfo.inlinedatasize + mflavor.valuetype->allocinfo.inlinedatasize));
     }
     
     this->containerstack.pop_back();
 }
 
+bool ICPPParseJSON::prepareParseContainerIncremental(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
+{
+    const BSQType* collectiontype = ICPPParseJSON::planFor(itype).btype;
+
+    ICPPIncrementalContainer cc = {collectiontype, nullptr, 0, nullptr, 0, {}};
+    if(itype->tag == TypeTag::ContainerTTag)
+    {
+        if(dynamic_cast<const ContainerTType*>(itype)->category != ContainerCategory::List)
+        {
+            return false;
+        }
+
+        const BSQListTypeFlavor& lflavor = BSQListOps::g_flavormap.at(dynamic_cast<const BSQListType*>(collectiontype)->etype);
+
+        size_t treebytes = ICPP_INCREMENTAL_LIST_LEVELS * sizeof(void*);
+        cc.framebytes = treebytes + (ICPP_INCREMENTAL_LIST_CHUNK * lflavor.entrytype->allocinfo.inlinedatasize);
+        cc.frame = GCStack::allocFrame(cc.framebytes);
+        cc.staging = cc.frame + treebytes;
+    }
+    else
+    {
+        const BSQMapType* maptype = dynamic_cast<const BSQMapType*>(collectiontype);
+        const BSQMapTypeFlavor& mflavor = BSQMapOps::g_flavormap.at(std::make_pair(maptype->ktype, maptype->vtype));
+
+        cc.framebytes = sizeof(void*) + mflavor.keytype->allocinfo.inlinedatasize + mflavor.valuetype->allocinfo.inlinedatasize;
+        cc.frame = GCStack::allocFrame(cc.framebytes);
+        cc.staging = cc.frame + sizeof(void*);
+    }
+
+    this->incrcontainerstack.push_back(cc);
+    return true;
+}
+
+StorageLocationPtr ICPPParseJSON::getValueForContainerElementParseIncremental_T(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
+{
+    const ICPPIncrementalContainer& cc = this->incrcontainerstack.back();
+    const BSQListTypeFlavor& lflavor = BSQListOps::g_flavormap.at(dynamic_cast<const BSQListType*>(cc.ctype)->etype);
+
+    return (StorageLocationPtr)(cc.staging + (cc.staged * lflavor.entrytype->allocinfo.inlinedatasize));
+}
+
+std::pair<StorageLocationPtr, StorageLocationPtr> ICPPParseJSON::getValueForContainerElementParseIncremental_KV(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
+{
+    const ICPPIncrementalContainer& cc = this->incrcontainerstack.back();
+    const BSQMapType* maptype = dynamic_cast<const BSQMapType*>(cc.ctype);
+    const BSQMapTypeFlavor& mflavor = BSQMapOps::g_flavormap.at(std::make_pair(maptype->ktype, maptype->vtype));
+
+    return std::make_pair((StorageLocationPtr)cc.staging, (StorageLocationPtr)(cc.staging + mflavor.keytype->allocinfo.inlinedatasize));
+}
+
+void ICPPParseJSON::flushIncrementalListChunk(const BSQListTypeFlavor& lflavor, ICPPIncrementalContainer& cc)
+{
+    void** trees = (void**)cc.frame;
+    BSQ_INTERNAL_ASSERT(cc.levels.size() < ICPP_INCREMENTAL_LIST_LEVELS);
+
+    std::vector<StorageLocationPtr> params;
+    for(size_t i = 0; i < cc.staged; ++i)
+    {
+        params.push_back(cc.staging + (i * lflavor.entrytype->allocinfo.inlinedatasize));
+    }
+
+    trees[cc.levels.size()] = BSQListOps::list_consk(lflavor, params);
+    cc.levels.push_back(cc.staged);
+
+    GC_MEM_ZERO(cc.staging, cc.staged * lflavor.entrytype->allocinfo.inlinedatasize);
+    cc.staged = 0;
+
+    //merge equal sized neighbors (like a binary counter) so the final list is balanced
+    while(cc.levels.size() >= 2 && cc.levels[cc.levels.size() - 2] == cc.levels[cc.levels.size() - 1])
+    {
+        size_t ll = cc.levels.size();
+
+        trees[ll - 2] = BSQListOps::list_append(lflavor, trees[ll - 2], trees[ll - 1]);
+        trees[ll - 1] = nullptr;
+
+        cc.levels[ll - 2] += cc.levels[ll - 1];
+        cc.levels.pop_back();
+    }
+}
+
+bool ICPPParseJSON::completeContainerElementParseIncremental(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
+{
+    ICPPIncrementalContainer& cc = this->incrcontainerstack.back();
+
+    if(itype->tag == TypeTag::ContainerTTag)
+    {
+        const BSQListTypeFlavor& lflavor = BSQListOps::g_flavormap.at(dynamic_cast<const BSQListType*>(cc.ctype)->etype);
+
+        cc.staged++;
+        if(cc.staged == ICPP_INCREMENTAL_LIST_CHUNK)
+        {
+            this->flushIncrementalListChunk(lflavor, cc);
+        }
+    }
+    else
+    {
+        const BSQMapType* maptype = dynamic_cast<const BSQMapType*>(cc.ctype);
+        const BSQMapTypeFlavor& mflavor = BSQMapOps::g_flavormap.at(std::make_pair(maptype->ktype, maptype->vtype));
+
+        void** mtree = (void**)cc.frame;
+        StorageLocationPtr kl = cc.staging;
+        StorageLocationPtr vl = cc.staging + mflavor.keytype->allocinfo.inlinedatasize;
+
+        if(BSQMapOps::s_lookup_ne(*mtree, mflavor.treetype, kl, mflavor.keytype) != nullptr)
+        {
+            return false;
+        }
+
+        *mtree = BSQMapOps::s_add_ne(mflavor, *mtree, mflavor.treetype, kl, vl);
+        GC_MEM_ZERO(cc.staging, mflavor.keytype->allocinfo.inlinedatasize + mflavor.valuetype->allocinfo.inlinedatasize);
+    }
+
+    return true;
+}
+
+bool ICPPParseJSON::completeParseContainerIncremental(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
+{
+    ICPPIncrementalContainer& cc = this->incrcontainerstack.back();
+
+    if(itype->tag == TypeTag::ContainerTTag)
+    {
+        const BSQListTypeFlavor& lflavor = BSQListOps::g_flavormap.at(dynamic_cast<const BSQListType*>(cc.ctype)->etype);
+        void** trees = (void**)cc.frame;
+
+        if(cc.staged != 0)
+        {
+            this->flushIncrementalListChunk(lflavor, cc);
+        }
+
+        while(cc.levels.size() >= 2)
+        {
+            size_t ll = cc.levels.size();
+
+            trees[ll - 2] = BSQListOps::list_append(lflavor, trees[ll - 2], trees[ll - 1]);
+            trees[ll - 1] = nullptr;
+
+            cc.levels[ll - 2] += cc.levels[ll - 1];
+            cc.levels.pop_back();
+        }
+
+        if(cc.levels.empty())
+        {
+            LIST_STORE_RESULT_EMPTY(value);
+        }
+        else
+        {
+            LIST_STORE_RESULT_REPR(trees[0], value);
+        }
+    }
+    else
+    {
+        void* mtree = *((void**)cc.frame);
+        if(mtree == nullptr)
+        {
+            MAP_STORE_RESULT_EMPTY(value);
+        }
+        else
+        {
+            MAP_STORE_RESULT_REPR(mtree, value);
+        }
+    }
+
+    GCStack::popFrame(cc.framebytes);
+    this->incrcontainerstack.pop_back();
+
+    return true;
+}
+
 void ICPPParseJSON::prepareParseEntity(const APIModule* apimodule, const IType* itype, Evaluator& ctx)
 {
-    BSQTypeID ooid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    const BSQType* ootype = BSQType::g_typetable[ooid];
+    const BSQType* ootype = ICPPParseJSON::planFor(itype).btype;
 
     void* oomem = nullptr;
     if(ootype->tkind == BSQTypeLayoutKind::Struct)
@@ -3356,25 +4550,15 @@ void ICPPParseJSON::prepareParseEntity(const APIModule* apimodule, const IType*
 
 void ICPPParseJSON::prepareParseEntityMask(const APIModule* apimodule, const IType* itype, Evaluator& ctx)
 {
-    BSQTypeID ooid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    const BSQEntityInfo* ootype = dynamic_cast<const BSQEntityInfo*>(BSQType::g_typetable[ooid]);
-
-    auto mcount = std::count_if(ootype->fields.cbegin(), ootype->fields.cend(), [](BSQFieldID fid) {
-        auto fdecl = BSQField::g_fieldtable[fid];
-        return fdecl->isOptional;
-    });
-
-    BSQBool* mask = (BSQBool*)zxalloc(mcount * sizeof(BSQBool));
+    BSQBool* mask = (BSQBool*)zxalloc(ICPPParseJSON::planFor(itype).maskcount * sizeof(BSQBool));
     this->entitymaskstack.push_back(mask);
 }
 
-StorageLocationPtr ICPPParseJSON::getValueForEntityField(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, std::pair<std::string, std::string> fnamefkey, Evaluator& ctx)
+StorageLocationPtr ICPPParseJSON::getValueForEntityField(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t fidx, Evaluator& ctx)
 {
     void* oomem = this->entitystack.back().first;
-    const BSQType* ootype = this->entitystack.back().second;
 
-    BSQFieldID fid = MarshalEnvironment::g_fieldToIdMap.at(fnamefkey.second);
-    return SLPTR_INDEX_DATAPTR(oomem, dynamic_cast<const BSQEntityInfo*>(ootype)->fieldoffsets[fid]);
+    return SLPTR_INDEX_DATAPTR(oomem, ICPPParseJSON::planFor(itype).offsets[fidx]);
 }
 
 void ICPPParseJSON::completeParseEntity(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
@@ -3384,10 +4568,11 @@ void ICPPParseJSON::completeParseEntity(const APIModule* apimodule, const IType*
     void* oomem = this->entitystack.back().first;
     const BSQType* ootype = this->entitystack.back().second;
 
+    const std::vector<size_t>& offsets = ICPPParseJSON::planFor(itype).offsets;
+
     std::vector<StorageLocationPtr> cargs;
-    std::transform(etype->consfields.cbegin(), etype->consfields.cend(), std::back_inserter(cargs), [&](const std::pair<std::string, std::string>& fnamefkey) {
-        BSQFieldID fid = MarshalEnvironment::g_fieldToIdMap.at(fnamefkey.second);
-        return SLPTR_INDEX_DATAPTR(oomem, dynamic_cast<const BSQEntityInfo*>(ootype)->fieldoffsets[fid]);
+    std::transform(offsets.cbegin(), offsets.cend(), std::back_inserter(cargs), [oomem](size_t offset) {
+        return SLPTR_INDEX_DATAPTR(oomem, offset);
     });
 
     BSQBool* mask = this->entitymaskstack.back();
@@ -3442,7 +4627,8 @@ void ICPPParseJSON::completeParseEntity(const APIModule* apimodule, const IType*
 
     xfree(mask);
     GCStack::popFrame(bytes);
-    this->tuplestack.pop_back();
+    this->entitystack.pop_back();
+    this->entitymaskstack.pop_back();
 }
 
 void ICPPParseJSON::setMaskFlag(const APIModule* apimodule, StorageLocationPtr flagloc, size_t i, bool flag, Evaluator& ctx)
@@ -3452,16 +4638,14 @@ void ICPPParseJSON::setMaskFlag(const APIModule* apimodule, StorageLocationPtr f
 
 StorageLocationPtr ICPPParseJSON::parseUnionChoice(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t pick, const IType* picktype, Evaluator& ctx)
 {
-    auto bsqutypeid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    auto bsqutype = dynamic_cast<const BSQUnionType*>(BSQType::g_typetable[bsqutypeid]);
-    if(bsqutype->tkind == BSQTypeLayoutKind::UnionRef)
+    const ICPPMarshalPlan& plan = ICPPParseJSON::planFor(itype);
+    if(plan.btype->tkind == BSQTypeLayoutKind::UnionRef)
     {
         return value;
     }
     else
     {
-        auto ttypeid = MarshalEnvironment::g_typenameToIdMap.at(picktype->name);
-        auto ttype = BSQType::g_typetable[ttypeid];
+        auto ttype = plan.opttypes[pick];
 
         SLPTR_STORE_UNION_INLINE_TYPE(ttype, value);
         return SLPTR_LOAD_UNION_INLINE_DATAPTR(value);
@@ -3522,6 +4706,11 @@ std::optional<std::pair<std::string, uint64_t>> ICPPParseJSON::extractRationalIm
 std::optional<std::string> ICPPParseJSON::extractStringImpl(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
 {
     auto val = SLPTR_LOAD_CONTENTS_AS(BSQString, value);
+    if(!IS_INLINE_STRING(&val) && GET_TYPE_META_DATA_AS(BSQStringReprType, val.u_data)->isFlatReprNode())
+    {
+        auto frepr = (BSQStringFlatRepr*)val.u_data;
+        return std::make_optional(std::string((const char*)frepr->bytes, (size_t)frepr->size));
+    }
 
     std::string rstr;
     BSQStringForwardIterator iter(&val, 0);
@@ -3672,42 +4861,28 @@ std::optional<std::pair<float, float>> ICPPParseJSON::extractLatLongCoordinateIm
 
 StorageLocationPtr ICPPParseJSON::extractValueForTupleIndex(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t i, Evaluator& ctx)
 {
-    BSQTypeID tupid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    const BSQType* tuptype = BSQType::g_typetable[tupid];
+    const ICPPMarshalPlan& plan = ICPPParseJSON::planFor(itype);
 
-    return tuptype->indexStorageLocationOffset(value, dynamic_cast<const BSQTupleInfo*>(tuptype)->idxoffsets[i]);
+    return plan.btype->indexStorageLocationOffset(value, plan.offsets[i]);
 }
 
-StorageLocationPtr ICPPParseJSON::extractValueForRecordProperty(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, std::string pname, Evaluator& ctx)
+StorageLocationPtr ICPPParseJSON::extractValueForRecordProperty(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t pidx, Evaluator& ctx)
 {
-    BSQTypeID recid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    const BSQType* rectype = BSQType::g_typetable[recid];
-    auto recinfo = dynamic_cast<const BSQRecordInfo*>(rectype);
-
-    BSQRecordPropertyID pid = MarshalEnvironment::g_propertyToIdMap.at(itype->name);
-    auto piter = std::find(recinfo->properties.cbegin(), recinfo->properties.cend(), pid);
-    auto pidx = std::distance(recinfo->properties.cbegin(), piter);
+    const ICPPMarshalPlan& plan = ICPPParseJSON::planFor(itype);
 
-    return rectype->indexStorageLocationOffset(value, recinfo->propertyoffsets[pidx]);
+    return plan.btype->indexStorageLocationOffset(value, plan.offsets[pidx]);
 }
 
-StorageLocationPtr ICPPParseJSON::extractValueForEntityField(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, std::pair<std::string, std::string> fnamefkey, Evaluator& ctx)
+StorageLocationPtr ICPPParseJSON::extractValueForEntityField(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t fidx, Evaluator& ctx)
 {
-    BSQTypeID ooid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    const BSQType* ootype = BSQType::g_typetable[ooid];
-    auto ooinfo = dynamic_cast<const BSQEntityInfo*>(ootype);
+    const ICPPMarshalPlan& plan = ICPPParseJSON::planFor(itype);
 
-    BSQFieldID fid = MarshalEnvironment::g_fieldToIdMap.at(fnamefkey.second);
-    auto fiter = std::find(ooinfo->fields.cbegin(), ooinfo->fields.cend(), fid);
-    auto fidx = std::distance(ooinfo->fields.cbegin(), fiter);
-
-    return ootype->indexStorageLocationOffset(value, ooinfo->fieldoffsets[fidx]);
+    return plan.btype->indexStorageLocationOffset(value, plan.offsets[fidx]);
 }
 
 void ICPPParseJSON::prepareExtractContainer(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
 {
-    BSQTypeID containertypeid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    const BSQType* collectiontype = BSQType::g_typetable[containertypeid];
+    const BSQType* collectiontype = ICPPParseJSON::planFor(itype).btype;
 
     this->parsecontainerstack.push_back({});
 
@@ -3741,7 +4916,7 @@ void ICPPParseJSON::prepareExtractContainer(const APIModule* apimodule, const IT
     {
         if(MAP_LOAD_DATA(value) != nullptr)
         {
-            const BSQMapType* maptype = dynamic_cast<const BSQMapType*>(this->containerstack.back().first);
+            const BSQMapType* maptype = dynamic_cast<const BSQMapType*>(collectiontype);
             const BSQMapTypeFlavor& mflavor = BSQMapOps::g_flavormap.at(std::make_pair(maptype->ktype, maptype->vtype));
 
             BSQMapOps::s_enumerate_for_extract(mflavor, MAP_LOAD_DATA(value), this->parsecontainerstack.back());
@@ -3825,34 +5000,29 @@ void ICPPParseJSON::completeExtractContainer(const APIModule* apimodule, const I
 
 std::optional<size_t> ICPPParseJSON::extractUnionChoice(const APIModule* apimodule, const IType* itype, const std::vector<const IType*>& opttypes, StorageLocationPtr value, Evaluator& ctx)
 {
-    auto bsqutypeid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    auto bsqutype = dynamic_cast<const BSQUnionType*>(BSQType::g_typetable[bsqutypeid]);
+    const ICPPMarshalPlan& plan = ICPPParseJSON::planFor(itype);
 
-    BSQTypeID uid;
-    if(bsqutype->tkind == BSQTypeLayoutKind::UnionRef)
+    const BSQType* utype = nullptr;
+    if(plan.btype->tkind == BSQTypeLayoutKind::UnionRef)
     {
-        uid = SLPTR_LOAD_HEAP_TYPE(value)->tid;
+        utype = SLPTR_LOAD_HEAP_TYPE(value);
     }
     else
     {
-        uid = SLPTR_LOAD_UNION_INLINE_TYPE(value)->tid;
+        utype = SLPTR_LOAD_UNION_INLINE_TYPE(value);
     }
 
-    auto ppos = std::find_if(opttypes.cbegin(), opttypes.cend(), [uid](const IType* ttopt) {
-        auto bsqoptid = MarshalEnvironment::g_typenameToIdMap.at(ttopt->name);
-        return bsqoptid == uid;
+    auto ppos = std::find_if(plan.opttypes.cbegin(), plan.opttypes.cend(), [utype](const BSQType* opttype) {
+        return opttype != nullptr && opttype->tid == utype->tid;
     });
 
-    auto tidx = std::distance(opttypes.cbegin(), ppos);
+    auto tidx = std::distance(plan.opttypes.cbegin(), ppos);
     return std::make_optional(tidx);
 }
 
 StorageLocationPtr ICPPParseJSON::extractUnionValue(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx)
 {
-    auto bsqutypeid = MarshalEnvironment::g_typenameToIdMap.at(itype->name);
-    auto bsqutype = dynamic_cast<const BSQUnionType*>(BSQType::g_typetable[bsqutypeid]);
-
-    if(bsqutype->tkind == BSQTypeLayoutKind::UnionRef)
+    if(ICPPParseJSON::planFor(itype).btype->tkind == BSQTypeLayoutKind::UnionRef)
     {
         return value;
     }
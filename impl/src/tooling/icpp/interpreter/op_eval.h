@@ -13,6 +13,7 @@
 #include "runtime/bsqlist.h"
 
 #include "collection_eval.h"
+#include "jit.h"
 
 class Evaluator;
 typedef void (*DebuggerActionFP)(Evaluator* vv);
@@ -115,18 +116,35 @@ public:
     const std::vector<InterpOp*>* ops;
     std::vector<InterpOp*>::const_iterator cpos;
     std::vector<InterpOp*>::const_iterator epos;
+
+#ifdef BSQ_THREADED_DISPATCH
+    const void* const* dpos;
+#endif
 };
 
 class Evaluator
 {
 public:
     static jmp_buf g_entrybuff;
+    static char g_abortmsg[512];
     static EvaluatorFrame g_callstack[BSQ_MAX_STACK];
     static uint8_t* g_constantbuffer;
 
     static std::map<std::string, const BSQRegex*> g_validators;
     static std::map<std::string, const BSQRegex*> g_regexs;
 
+#ifdef BSQ_THREADED_DISPATCH
+    //Label table indexed by OpCodeTag with the end of body sentinel in the final slot
+    static const void* const* g_dispatchlabels;
+#endif
+
+#ifdef BSQ_JIT_AVAILABLE
+    //Native tier is opt in -- bodies are compiled after g_jitthreshold calls
+    static bool g_jitenabled;
+    static uint32_t g_jitthreshold;
+    static size_t g_jitCompiledCount;
+#endif
+
 private:
     EvaluatorFrame* cframe = nullptr;
     int32_t cpos = -1;
@@ -202,7 +220,7 @@ private:
         {
             this->cframe->dbg_prevbp = this->cframe->dbg_currentbp;
         }
-        this->cframe->dbg_currentline = (*this->cframe->cpos)->sinfo.line;
+        this->cframe->dbg_currentline = static_cast<const BSQInvokeBodyDecl*>(this->cframe->invoke)->getOpSourceInfo(this->cframe->cpos).line;
         this->cframe->dbg_currentbp = {-1, this->call_count, this->cframe->invoke, op, this->cframe->dbg_currentline};
 
         if(this->cframe->dbg_step_mode == StepMode::Step || this->cframe->dbg_step_mode == StepMode::StepInto)
@@ -323,6 +341,10 @@ private:
         cf->cpos = cf->ops->cbegin();
         cf->epos = cf->ops->cend();
 
+#ifdef BSQ_THREADED_DISPATCH
+        cf->dpos = static_cast<const BSQInvokeBodyDecl*>(invk)->dispatch.data();
+#endif
+
         this->cframe = Evaluator::g_callstack + this->cpos;
     }
 #else
@@ -341,6 +363,10 @@ private:
         {
             cf->cpos = cf->ops->cbegin();
             cf->epos = cf->ops->cend();
+
+#ifdef BSQ_THREADED_DISPATCH
+            cf->dpos = static_cast<const BSQInvokeBodyDecl*>(invk)->dispatch.data();
+#endif
         }
 
         this->cframe = Evaluator::g_callstack + this->cpos;
@@ -460,12 +486,16 @@ private:
 
     void evalLoadConstOp(const LoadConstOp* op);
 
+    size_t resolveTupleIndexOffset(const BSQType* ttype, BSQTupleIndex idx, BSQInlineCache<size_t>& icache);
+    size_t resolveRecordPropertyOffset(const BSQType* rtype, BSQRecordPropertyID propId, BSQInlineCache<size_t>& icache);
+    size_t resolveEntityFieldOffset(const BSQType* etype, BSQFieldID fldId, BSQInlineCache<size_t>& icache);
+
     void processTupleDirectLoadAndStore(StorageLocationPtr src, const BSQType* srctype, size_t slotoffset, TargetVar dst, const BSQType* dsttype);
-    void processTupleVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQTupleIndex idx, TargetVar dst, const BSQType* dsttype);
+    void processTupleVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQTupleIndex idx, BSQInlineCache<size_t>& icache, TargetVar dst, const BSQType* dsttype);
     void processRecordDirectLoadAndStore(StorageLocationPtr src, const BSQType* srctype, size_t slotoffset, TargetVar dst, const BSQType* dsttype);
-    void processRecordVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQRecordPropertyID propId, TargetVar dst, const BSQType* dsttype);
+    void processRecordVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQRecordPropertyID propId, BSQInlineCache<size_t>& icache, TargetVar dst, const BSQType* dsttype);
     void processEntityDirectLoadAndStore(StorageLocationPtr src, const BSQType* srctype, size_t slotoffset, TargetVar dst, const BSQType* dsttype);
-    void processEntityVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQFieldID fldId, TargetVar dst, const BSQType* dsttype);
+    void processEntityVirtualLoadAndStore(StorageLocationPtr src, const BSQUnionType* srctype, BSQFieldID fldId, BSQInlineCache<size_t>& icache, TargetVar dst, const BSQType* dsttype);
 
     void processGuardVarStore(const BSQGuard& gv, BSQBool f);
 
@@ -556,8 +586,42 @@ private:
     void evalVarLifetimeStartOp(const VarLifetimeStartOp* op);
     void evalVarLifetimeEndOp(const VarLifetimeEndOp* op);
     void evalVarHomeLocationValueUpdate(const VarHomeLocationValueUpdate* op);
+
+    template <OpCodeTag TAG, typename REPRTYPE>
+    BSQBool evalPrimitiveCompareJumpCondOp(const PrimitiveCompareJumpCondOp<TAG>* op);
+
+    template <OpCodeTag TAG, typename REPRTYPE>
+    void evalLoadConstAddOp(const LoadConstBinaryOperatorOp<TAG>* op);
+
+    void evalLoadEntityFieldDirectRegisterAssignOp(const LoadEntityFieldDirectRegisterAssignOp* op);
+
+    void evalInvokeSelfTailCallOp(const InvokeSelfTailCallOp* op);
+    void evalLoadFoldedConstOp(const LoadFoldedConstOp* op);
+
     void evaluateOpCode(const InterpOp* op);
 
+#ifdef BSQ_THREADED_DISPATCH
+    void evaluateOpCodeBlocksThreaded(const void* const** exportlabels);
+#endif
+
+#ifdef BSQ_JIT_AVAILABLE
+    //Stencil handlers called from native code -- ctx is the Evaluator and op the InterpOp the stencil was patched with
+    static void jitStepGeneric(void* ctx, const void* op);
+
+    template <OpCodeTag TAG>
+    static void jitStep(void* ctx, const void* op);
+
+    template <OpCodeTag TAG>
+    static uint8_t jitCond(void* ctx, const void* op);
+
+    static uint8_t* jitFramePtr(void* ctx);
+
+    BSQJitEntryFP jitCompileBody(const BSQInvokeBodyDecl* invk);
+
+    //Counts a call (or self tail call back edge) toward the threshold, compiles the body once it is hot, and runs the native code if there is any
+    bool tryEnterJitCode(const BSQInvokeBodyDecl* invk);
+#endif
+
     void evaluateOpCodeBlocks();
     void evaluateBody(StorageLocationPtr resultsl, const BSQType* restype, Argument resarg);
     
@@ -567,22 +631,69 @@ private:
     void invokePrelude(const BSQInvokeBodyDecl* invk, uint8_t* cstack, uint8_t* maskslots, BSQBool* optmask);
     void invokePostlude();
 
-    void evaluatePrimitiveBody(const BSQInvokePrimitiveDecl* invk, const std::vector<StorageLocationPtr>& params, StorageLocationPtr resultsl, const BSQType* restype);
+    void evaluatePrimitiveBody(const BSQInvokePrimitiveDecl* invk, StorageLocationSpan params, StorageLocationPtr resultsl, const BSQType* restype);
 
 public:
+    void resolveDispatchTable(BSQInvokeBodyDecl* invk);
+
     void invokeGlobalCons(const BSQInvokeBodyDecl* invk, StorageLocationPtr resultsl, const BSQType* restype, Argument resarg);
 
     static size_t initialMainStackSize(const BSQInvokeBodyDecl* invk);
     void invokeMain(const BSQInvokeBodyDecl* invk, uint8_t* istack, StorageLocationPtr resultsl, const BSQType* restype, Argument resarg);
 
-    void linvoke(const BSQInvokeBodyDecl* call, const std::vector<StorageLocationPtr>& args, StorageLocationPtr resultsl);
-    bool iinvoke(const BSQInvokeBodyDecl* call, const std::vector<StorageLocationPtr>& args, BSQBool* optmask);
-    void cinvoke(const BSQInvokeBodyDecl* call, const std::vector<StorageLocationPtr>& args, BSQBool* optmask, StorageLocationPtr resultsl);
+    void linvoke(const BSQInvokeBodyDecl* call, StorageLocationSpan args, StorageLocationPtr resultsl);
+    bool iinvoke(const BSQInvokeBodyDecl* call, StorageLocationSpan args, BSQBool* optmask);
+    void cinvoke(const BSQInvokeBodyDecl* call, StorageLocationSpan args, BSQBool* optmask, StorageLocationPtr resultsl);
+};
+
+//Containers built while their elements are streamed in -- list elements are staged in chunks that are merged as equal sized subtrees (so the result is balanced)
+#define ICPP_INCREMENTAL_LIST_CHUNK 8
+#define ICPP_INCREMENTAL_LIST_LEVELS 48
+
+struct ICPPIncrementalContainer
+{
+    const BSQType* ctype;
+
+    //GCStack frame with the (rooted) partial results followed by the staging space for the element(s) being parsed
+    uint8_t* frame;
+    size_t framebytes;
+    uint8_t* staging;
+    size_t staged;
+
+    //Element counts of the pending list subtrees -- subtree i is in slot i of the frame
+    std::vector<size_t> levels;
+};
+
+//Marshalling plan for an API type -- built once when the APIModule is loaded so parse/extract never go through the name maps
+struct ICPPMarshalPlan
+{
+    const BSQType* btype;
+
+    //Storage offset of each tuple index/record property/entity constructor field (in the order of the IType)
+    std::vector<size_t> offsets;
+
+    //Storage type of each union option (in the order of the IType)
+    std::vector<const BSQType*> opttypes;
+
+    //Number of optional fields in an entity
+    size_t maskcount;
 };
 
 class ICPPParseJSON : public ApiManagerJSON<StorageLocationPtr, Evaluator>
 {
 private:
+    //Indexed by IType::planid
+    static std::vector<ICPPMarshalPlan> g_marshalplans;
+
+    inline static const ICPPMarshalPlan& planFor(const IType* itype)
+    {
+        return ICPPParseJSON::g_marshalplans[itype->planid];
+    }
+
+    //Large string/buffer payloads taken from the input -- the parsed values reference these bytes in place so they are kept until released
+    static std::list<std::string> g_inputstrings;
+    static std::list<std::vector<uint8_t>> g_inputbuffers;
+
     std::vector<std::pair<void*, const BSQType*>> tuplestack;
     std::vector<std::pair<void*, const BSQType*>> recordstack;
     std::vector<std::pair<void*, const BSQType*>> entitystack;
@@ -593,13 +704,23 @@ private:
     std::vector<std::list<StorageLocationPtr>> parsecontainerstack;
     std::vector<std::list<StorageLocationPtr>::iterator> parsecontainerstackiter;
 
+    std::vector<ICPPIncrementalContainer> incrcontainerstack;
+
+    void flushIncrementalListChunk(const BSQListTypeFlavor& lflavor, ICPPIncrementalContainer& cc);
+
 public:
     ICPPParseJSON(): 
-        ApiManagerJSON(), tuplestack(), recordstack(), entitystack(), entitymaskstack(), containerstack(), parsecontainerstack(), parsecontainerstackiter()
+        ApiManagerJSON(), tuplestack(), recordstack(), entitystack(), entitymaskstack(), containerstack(), parsecontainerstack(), parsecontainerstackiter(), incrcontainerstack()
     {;}
 
     virtual ~ICPPParseJSON() {;}
 
+    //Must be called after the assembly is loaded (the plans point into the type table)
+    static void buildMarshalPlans(const APIModule* apimodule);
+
+    //Drop the kept input payloads -- only once no value parsed from them can be reached (after the results of the call are extracted)
+    static void releaseInputPayloads();
+
     virtual bool checkInvokeOk(const std::string& checkinvoke, StorageLocationPtr value, Evaluator& ctx) override final;
 
     virtual bool parseNoneImpl(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
@@ -631,7 +752,7 @@ public:
     virtual void completeParseTuple(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
 
     virtual void prepareParseRecord(const APIModule* apimodule, const IType* itype, Evaluator& ctx) override final;
-    virtual StorageLocationPtr getValueForRecordProperty(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, std::string pname, Evaluator& ctx) override final;
+    virtual StorageLocationPtr getValueForRecordProperty(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t pidx, Evaluator& ctx) override final;
     virtual void completeParseRecord(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
 
     virtual void prepareParseContainer(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t count, Evaluator& ctx) override final;
@@ -639,9 +760,15 @@ public:
     virtual std::pair<StorageLocationPtr, StorageLocationPtr> getValueForContainerElementParse_KV(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t i, Evaluator& ctx) override final;
     virtual void completeParseContainer(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
 
+    virtual bool prepareParseContainerIncremental(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
+    virtual StorageLocationPtr getValueForContainerElementParseIncremental_T(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
+    virtual std::pair<StorageLocationPtr, StorageLocationPtr> getValueForContainerElementParseIncremental_KV(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
+    virtual bool completeContainerElementParseIncremental(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
+    virtual bool completeParseContainerIncremental(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
+
     virtual void prepareParseEntity(const APIModule* apimodule, const IType* itype, Evaluator& ctx) override final;
     virtual void prepareParseEntityMask(const APIModule* apimodule, const IType* itype, Evaluator& ctx) override final;
-    virtual StorageLocationPtr getValueForEntityField(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, std::pair<std::string, std::string> fnamefkey, Evaluator& ctx) override final;
+    virtual StorageLocationPtr getValueForEntityField(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t fidx, Evaluator& ctx) override final;
     virtual void completeParseEntity(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
 
     virtual void setMaskFlag(const APIModule* apimodule, StorageLocationPtr flagloc, size_t i, bool flag, Evaluator& ctx) override final;
@@ -671,8 +798,8 @@ public:
     virtual std::optional<std::pair<float, float>> extractLatLongCoordinateImpl(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
 
     virtual StorageLocationPtr extractValueForTupleIndex(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t i, Evaluator& ctx) override final;
-    virtual StorageLocationPtr extractValueForRecordProperty(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, std::string pname, Evaluator& ctx) override final;
-    virtual StorageLocationPtr extractValueForEntityField(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, std::pair<std::string, std::string> fnamefkey, Evaluator& ctx) override final;
+    virtual StorageLocationPtr extractValueForRecordProperty(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t pidx, Evaluator& ctx) override final;
+    virtual StorageLocationPtr extractValueForEntityField(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, size_t fidx, Evaluator& ctx) override final;
 
     virtual void prepareExtractContainer(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
     virtual std::optional<size_t> extractLengthForContainer(const APIModule* apimodule, const IType* itype, StorageLocationPtr value, Evaluator& ctx) override final;
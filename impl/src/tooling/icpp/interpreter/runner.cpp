@@ -6,47 +6,140 @@
 #include "op_eval.h"
 #include "asm_load.h"
 
+#include <cerrno>
 #include <chrono>
 #include <iostream>
 #include <fstream>
+#include <filesystem>
+#include <functional>
 
-std::optional<json> getIRFromStdIn()
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+//Bodies are deferred (left in the retained source until their first call) unless a debugger needs to see every op at load
+std::optional<json> getIRFromStdIn(bool deferbodies)
 {
-    try
-    {
-        json payload;
-        std::cin >> payload;
+    std::string* contents = new std::string((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
 
-        return std::make_optional(payload);
-    }
-    catch(...)
+    auto res = parseAssemblyPayload(contents->data(), contents->size(), deferbodies);
+    if(!deferbodies || !res.has_value())
     {
-        return std::nullopt;
+        delete contents;
     }
+    return res;
 }
 
-std::optional<json> getIRFromFile(const std::string& file)
+std::optional<json> getIRFromFile(const std::string& file, bool deferbodies)
 {
-    try
+    return loadTextAssembly(file, deferbodies);
+}
+
+const BSQInvokeBodyDecl* resolveInvokeForMainName(const std::string& main)
+{
+    auto iiter = MarshalEnvironment::g_invokeToIdMap.find(main);
+    if(iiter == MarshalEnvironment::g_invokeToIdMap.cend())
     {
-        json payload;
-        std::ifstream infile(file);
-        infile >> payload;
+        return nullptr;
+    }
+
+    return dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[iiter->second]);
+}
+
+//Parses the arguments for a call into the (zeroed) parameter slots of the entry frame -- returns an error message on failure
+typedef std::function<std::optional<std::string>(Evaluator&, const APIModule*, const InvokeSignature*, const BSQInvokeBodyDecl*, uint8_t*)> ArgLoader;
+
+ArgLoader domArgLoader(json args)
+{
+    return [args](Evaluator& runner, const APIModule* api, const InvokeSignature* sig, const BSQInvokeBodyDecl* call, uint8_t* istack) -> std::optional<std::string> {
+        if(args.size() > sig->argtypes.size())
+        {
+            return std::make_optional(std::string("Too many arguments provided to call"));
+        }
+
+        ICPPParseJSON jloader;
+        for(size_t i = 0; i < args.size(); ++i)
+        {
+            auto itype = sig->argtypes[i];
+            StorageLocationPtr pv = Evaluator::evalParameterInfo(call->paraminfo[i], istack);
+            bool ok = itype->tparse(jloader, api, args[i], pv, runner);
+            if(!ok)
+            {
+                return std::make_optional(std::string("Failed in argument parsing"));
+            }
+        }
 
-        return std::make_optional(payload);
+        return std::nullopt;
+    };
+}
+
+//Argument files ending in .cbor or .msgpack are read in that binary encoding (everything else is JSON text)
+json::input_format_t argFormatForFile(const std::string& file)
+{
+    auto ext = std::filesystem::path(file).extension().string();
+    if(ext == ".cbor")
+    {
+        return json::input_format_t::cbor;
     }
-    catch(const std::exception& e)
+    else if(ext == ".msgpack" || ext == ".mpk")
     {
-        return std::nullopt;
+        return json::input_format_t::msgpack;
+    }
+    else
+    {
+        return json::input_format_t::json;
     }
 }
 
-const BSQInvokeBodyDecl* resolveInvokeForMainName(const std::string& main)
+//Parse the argument array straight from the file as it is read -- no DOM is built for the arguments
+ArgLoader streamArgLoader(std::string file)
 {
-    return dynamic_cast<const BSQInvokeBodyDecl*>(BSQInvokeDecl::g_invokes[MarshalEnvironment::g_invokeToIdMap.find(main)->second]);
+    return [file](Evaluator& runner, const APIModule* api, const InvokeSignature* sig, const BSQInvokeBodyDecl* call, uint8_t* istack) -> std::optional<std::string> {
+        FILE* argsin = fopen(file.c_str(), "rb");
+        if(argsin == nullptr)
+        {
+            return std::make_optional("Could not open argument file " + file);
+        }
+
+        std::vector<std::pair<const IType*, StorageLocationPtr>> targets;
+        for(size_t i = 0; i < sig->argtypes.size(); ++i)
+        {
+            targets.push_back(std::make_pair(sig->argtypes[i], Evaluator::evalParameterInfo(call->paraminfo[i], istack)));
+        }
+
+        ICPPParseJSON jloader;
+        APIStreamParser<StorageLocationPtr, Evaluator> sparser(jloader, api, targets, runner);
+
+        bool ok = json::sax_parse(argsin, &sparser, argFormatForFile(file));
+        fclose(argsin);
+
+        if(!ok || !sparser.isComplete())
+        {
+            return std::make_optional(std::string("Failed in argument parsing"));
+        }
+
+        return std::nullopt;
+    };
 }
 
-std::pair<bool, json> run(Evaluator& runner, const APIModule* api, const std::string& main, json args)
+//The failure for a longjmp out of parsing or evaluation -- with the message of the abort that caused it
+std::pair<bool, json> abortFailure(const std::string& phase)
+{
+    std::string msg(Evaluator::g_abortmsg);
+    return std::make_pair(false, msg.empty() ? phase : (phase + " -- " + msg));
+}
+
+//Going over the heap limit aborts the current call (back to the setjmps in run) while one of these is in scope
+struct HeapLimitAbortScope
+{
+    HeapLimitAbortScope() { Allocator::g_heaplimitabortable = true; }
+    ~HeapLimitAbortScope() { Allocator::g_heaplimitabortable = false; }
+};
+
+//If rsink is given the result is written to it as it is extracted (and the returned json is null on success)
+std::pair<bool, json> run(Evaluator& runner, const APIModule* api, const std::string& main, const ArgLoader& argloader, JSONStreamWriter* rsink)
 {
     auto filename = std::string("[MAIN INITIALIZE]");
     auto jsig = api->getSigForFriendlyName(main);
@@ -56,40 +149,31 @@ std::pair<bool, json> run(Evaluator& runner, const APIModule* api, const std::st
         return std::make_pair(false, "Could not load given entrypoint");
     }
 
-    if(args.size() > jsig.value()->argtypes.size())
-    {
-        return std::make_pair(false, "Too many arguments provided to call");
-    }
-
     //TODO: we need to check that all required arguments are provided
 
     //Create a 0 stack frame that we can parse the arguments onto and that will keep them live (for reuse)
     // -- may need to revisit as it creates hidden sharing if/when we support mutation in place
     uint8_t* istack = GCStack::allocFrame(call->stackBytes);
 
+    HeapLimitAbortScope hscope;
+    Evaluator::g_abortmsg[0] = '\0';
     if(setjmp(Evaluator::g_entrybuff) > 0)
     {
-        return std::make_pair(false, "Failed in argument parsing");
+        return abortFailure("Failed in argument parsing");
     }
     else
     {
-        ICPPParseJSON jloader;
-        for(size_t i = 0; i < args.size(); ++i)
+        auto perr = argloader(runner, api, jsig.value(), call, istack);
+        if(perr.has_value())
         {
-            auto itype = jsig.value()->argtypes[i];
-            StorageLocationPtr pv = Evaluator::evalParameterInfo(call->paraminfo[i], istack);
-            bool ok = itype->tparse(jloader, api, args[i], pv, runner);
-            if(!ok)
-            {
-                return std::make_pair(false, "Failed in argument parsing");
-            }
+            return std::make_pair(false, perr.value());
         }
     }
     runner.reset();
 
     if(setjmp(Evaluator::g_entrybuff) > 0)
     {
-        return std::make_pair(false, "Failed in evaluation");
+        return abortFailure("Failed in evaluation");
     }
     else
     {
@@ -134,6 +218,12 @@ std::pair<bool, json> run(Evaluator& runner, const APIModule* api, const std::st
             {
                 return std::make_pair(false, "Failed in result extraction");
             }
+
+            if(rsink != nullptr)
+            {
+                rsink->value(res.value());
+                return std::make_pair(true, json(nullptr));
+            }
         
             return std::make_pair(true, res.value());
         }
@@ -146,6 +236,16 @@ std::pair<bool, json> run(Evaluator& runner, const APIModule* api, const std::st
             ICPPParseJSON jextract;
             auto rtype = jsig.value()->restype;
 
+            if(rsink != nullptr)
+            {
+                if(!streamExtract(jextract, api, rtype, result, runner, *rsink))
+                {
+                    return std::make_pair(false, "Failed in result extraction");
+                }
+
+                return std::make_pair(true, json(nullptr));
+            }
+
             std::optional<json> res = rtype->textract(jextract, api, result, runner); //call->resultType->fpDisplay(call->resultType, result);
             if(res == std::nullopt)
             {
@@ -159,32 +259,607 @@ std::pair<bool, json> run(Evaluator& runner, const APIModule* api, const std::st
     }
 }
 
-void parseArgs(int argc, char** argv, std::string& mode, bool& debugger, std::string& prog, std::string& input)
+void reportLoadStats()
+{
+    fprintf(stderr, "Superinstructions fused: %zu\n", AssemblyLoadInfo::g_fusedOpCount);
+    fprintf(stderr, "Self tail calls: %zu\n", AssemblyLoadInfo::g_tailCallCount);
+    fprintf(stderr, "Ops folded: %zu\n", AssemblyLoadInfo::g_foldedOpCount);
+    fprintf(stderr, "Copies propagated: %zu\n", AssemblyLoadInfo::g_propagatedCopyCount);
+    fprintf(stderr, "Ops removed: %zu\n", AssemblyLoadInfo::g_removedOpCount);
+    fprintf(stderr, "Bodies deferred: %zu\n", AssemblyLoadInfo::g_deferredBodyCount);
+    fprintf(stderr, "Bodies materialized: %zu\n", AssemblyLoadInfo::g_materializedBodyCount);
+#ifdef BSQ_JIT_AVAILABLE
+    fprintf(stderr, "Bodies compiled: %zu\n", Evaluator::g_jitCompiledCount);
+#endif
+    if(!AssemblyLoadInfo::g_snapshotFile.empty())
+    {
+        fprintf(stderr, "Snapshot objects %s: %zu\n", AssemblyLoadInfo::g_snapshotRestored ? "restored" : "written", AssemblyLoadInfo::g_snapshotObjectCount);
+    }
+    fflush(stderr);
+}
+
+//The passes run on each body when it is materialized (on its first call) so the counts are only complete when the process exits
+void configureLoadStats()
+{
+    if(std::getenv("ICPP_LOAD_STATS") != nullptr)
+    {
+        std::atexit(reportLoadStats);
+    }
+}
+
+void reportGCStats()
+{
+    PageMemoryStats pstats = Allocator::GlobalAllocator.getPageStats();
+
+    fprintf(stderr, "GC regions reserved: %zu\n", (size_t)pstats.regions);
+    fprintf(stderr, "GC pages: %zu\n", (size_t)pstats.total_pages);
+    fprintf(stderr, "GC pages free: %zu\n", (size_t)pstats.free_pages);
+    fprintf(stderr, "GC pages released: %zu\n", (size_t)pstats.released_pages);
+    fprintf(stderr, "GC page releases: %zu\n", (size_t)pstats.release_count);
+    fflush(stderr);
+}
+
+//The snapshot lives next to the assembly and is only used if the assembly is unchanged since it was written
+void configureSnapshot(const std::string& prog)
+{
+    std::error_code ec;
+    auto fsize = std::filesystem::file_size(prog, ec);
+    auto ftime = std::filesystem::last_write_time(prog, ec);
+    if(ec)
+    {
+        return;
+    }
+
+    AssemblyLoadInfo::g_snapshotFile = prog + ".bsqsnap";
+    AssemblyLoadInfo::g_snapshotFingerprint = ((uint64_t)ftime.time_since_epoch().count() * 31) ^ (uint64_t)fsize;
+}
+
+void configureJit(const std::string& jitmode)
+{
+    if(jitmode == "off")
+    {
+        return;
+    }
+
+#ifdef BSQ_JIT_AVAILABLE
+    Evaluator::g_jitenabled = true;
+
+    const char* thresholdenv = std::getenv("ICPP_JIT_THRESHOLD");
+    if(thresholdenv != nullptr)
+    {
+        Evaluator::g_jitthreshold = (uint32_t)std::max(1l, std::strtol(thresholdenv, nullptr, 10));
+    }
+#else
+    fprintf(stderr, "Native tier is not available on this platform -- running interpreted\n");
+    fflush(stderr);
+#endif
+}
+
+//Collections trace the heap and sweep the nursery with this many threads -- unset (or 1) keeps the sequential collector
+//Deferred decrements are run on a background thread (instead of in the allocation slow path) if requested
+//The collection trigger is sized from the pause target, heap headroom, and heap limit (defaults unless set)
+void configureCollector()
+{
+    const char* threadsenv = std::getenv("ICPP_GC_THREADS");
+    if(threadsenv != nullptr)
+    {
+        Allocator::GlobalAllocator.setCollectorThreads((size_t)std::max(1l, std::strtol(threadsenv, nullptr, 10)));
+    }
+
+    //heap sizing -- pause target in ms, nursery size as a fraction of the surviving heap, and a hard limit on the heap in MB (0 for none)
+    const char* pauseenv = std::getenv("ICPP_GC_MAX_PAUSE_MS");
+    const char* headroomenv = std::getenv("ICPP_GC_HEAP_HEADROOM");
+    const char* maxheapenv = std::getenv("ICPP_GC_MAX_HEAP_MB");
+    if(pauseenv != nullptr || headroomenv != nullptr || maxheapenv != nullptr)
+    {
+        double maxpausems = (pauseenv != nullptr) ? std::max(0.1, std::strtod(pauseenv, nullptr)) : DEFAULT_GC_MAX_PAUSE_MS;
+        double headroom = (headroomenv != nullptr) ? std::max(0.0, std::strtod(headroomenv, nullptr)) : DEFAULT_GC_HEAP_HEADROOM;
+        size_t maxheapbytes = (maxheapenv != nullptr) ? (size_t)std::max(0l, std::strtol(maxheapenv, nullptr, 10)) * 1048576ul : 0;
+
+        Allocator::GlobalAllocator.configureHeapSizing(maxpausems, headroom, maxheapbytes);
+    }
+
+    //heap regions -- back them with transparent huge pages and/or let the OS reclaim released pages lazily
+    const char* hugeenv = std::getenv("ICPP_GC_HUGE_PAGES");
+    const char* lazyenv = std::getenv("ICPP_GC_LAZY_RELEASE");
+    Allocator::GlobalAllocator.configureRegions(hugeenv != nullptr && std::string(hugeenv) != "0", lazyenv != nullptr && std::string(lazyenv) != "0");
+
+    //where the heap pages are when the process exits (after the decrement worker is stopped)
+    if(std::getenv("ICPP_GC_STATS") != nullptr)
+    {
+        std::atexit(reportGCStats);
+    }
+
+    const char* decenv = std::getenv("ICPP_GC_DEC_THREAD");
+    if(decenv != nullptr && std::string(decenv) != "0")
+    {
+        Allocator::GlobalAllocator.startDecWorker();
+    }
+}
+
+std::pair<bool, json> runDifferential(Evaluator& runner, const APIModule* api, const std::string& main, const ArgLoader& args)
+{
+#ifdef BSQ_JIT_AVAILABLE
+    //the modes are process wide so put them back once both passes are done (serve/batch run many requests with the same settings)
+    bool jitenabled = Evaluator::g_jitenabled;
+    uint32_t jitthreshold = Evaluator::g_jitthreshold;
+
+    //with the native tier disabled the dispatch never looks at the jitcode a body got in an earlier request
+    Evaluator::g_jitenabled = false;
+    auto ires = run(runner, api, main, args, nullptr);
+
+    //compile every body on its first call so the native tier covers as much of the run as possible
+    Evaluator::g_jitenabled = true;
+    Evaluator::g_jitthreshold = 1;
+    auto jres = run(runner, api, main, args, nullptr);
+
+    Evaluator::g_jitenabled = jitenabled;
+    Evaluator::g_jitthreshold = jitthreshold;
+
+    if(ires.first != jres.first || ires.second != jres.second)
+    {
+        fprintf(stderr, "!DIFF! -- interpreter and native tier disagree\n");
+        fprintf(stderr, "interpreter: %s\n", ires.second.dump().c_str());
+        fprintf(stderr, "native: %s\n", jres.second.dump().c_str());
+        fflush(stderr);
+
+        return std::make_pair(false, "Native tier result differs from interpreter");
+    }
+
+    return jres;
+#else
+    return run(runner, api, main, args, nullptr);
+#endif
+}
+
+std::pair<bool, json> runWithJitMode(Evaluator& runner, const APIModule* api, const std::string& main, const ArgLoader& args, const std::string& jitmode, JSONStreamWriter* rsink)
+{
+    if(jitmode == "diff")
+    {
+        //both results are needed as values to compare them
+        auto res = runDifferential(runner, api, main, args);
+        if(res.first && rsink != nullptr)
+        {
+            rsink->value(res.second);
+            return std::make_pair(true, json(nullptr));
+        }
+
+        return res;
+    }
+    else
+    {
+        return run(runner, api, main, args, rsink);
+    }
+}
+
+////
+//Serve mode -- the assembly is loaded once and then each request {main, args} is run against the resident state (types, constants, globals)
+//A request is either one JSON object on a line or a line with a decimal byte count followed by exactly that many bytes of JSON
+//A line "cbor <n>" or "msgpack <n>" is followed by n bytes of the request in that binary encoding
+//Every JSON request gets a single line JSON response and binary requests get a "cbor <n>" line followed by the CBOR response
+//A byte count over the limit (ICPP_SERVE_MAX_REQUEST_MB) gets an error response and ends the stream since the payload after it cannot be skipped
+
+#define DEFAULT_SERVE_MAX_REQUEST_MB 256
+
+size_t g_serveMaxRequestBytes = DEFAULT_SERVE_MAX_REQUEST_MB * 1048576ul;
+
+void configureServe()
+{
+    const char* maxrequestenv = std::getenv("ICPP_SERVE_MAX_REQUEST_MB");
+    if(maxrequestenv != nullptr)
+    {
+        g_serveMaxRequestBytes = (size_t)std::max(1l, std::strtol(maxrequestenv, nullptr, 10)) * 1048576ul;
+    }
+}
+
+void writeServeError(const std::string& msg, bool binary, FILE* out)
+{
+    json resp = {{"status", "error"}, {"msg", msg}};
+    if(binary)
+    {
+        auto rbytes = json::to_cbor(resp);
+        fprintf(out, "cbor %zu\n", rbytes.size());
+        fwrite(rbytes.data(), 1, rbytes.size(), out);
+    }
+    else
+    {
+        fprintf(out, "%s\n", resp.dump().c_str());
+    }
+}
+
+std::optional<std::string> readServeLine(FILE* in)
+{
+    std::string line;
+    int c = fgetc(in);
+    if(c == EOF)
+    {
+        return std::nullopt;
+    }
+
+    while(c != EOF && c != '\n')
+    {
+        line.push_back((char)c);
+        c = fgetc(in);
+    }
+
+    if(!line.empty() && line.back() == '\r')
+    {
+        line.pop_back();
+    }
+
+    return std::make_optional(line);
+}
+
+std::optional<std::pair<json::input_format_t, std::string>> readServeRequest(FILE* in, FILE* out)
+{
+    while(true)
+    {
+        auto line = readServeLine(in);
+        if(!line.has_value())
+        {
+            return std::nullopt;
+        }
+
+        std::string ll = line.value();
+        if(ll.empty())
+        {
+            continue;
+        }
+
+        json::input_format_t format = json::input_format_t::json;
+        if(ll.rfind("cbor ", 0) == 0)
+        {
+            format = json::input_format_t::cbor;
+            ll = ll.substr(5);
+        }
+        else if(ll.rfind("msgpack ", 0) == 0)
+        {
+            format = json::input_format_t::msgpack;
+            ll = ll.substr(8);
+        }
+
+        bool isdigits = !ll.empty() && std::all_of(ll.cbegin(), ll.cend(), [](char ch) { return '0' <= ch && ch <= '9'; });
+        if(!isdigits)
+        {
+            if(format != json::input_format_t::json)
+            {
+                return std::nullopt;
+            }
+
+            return std::make_optional(std::make_pair(format, ll));
+        }
+
+        errno = 0;
+        unsigned long long count = std::strtoull(ll.c_str(), nullptr, 10);
+        if(errno == ERANGE || count > g_serveMaxRequestBytes)
+        {
+            writeServeError("Request of " + ll + " bytes is over the limit of " + std::to_string(g_serveMaxRequestBytes) + " bytes", format != json::input_format_t::json, out);
+            return std::nullopt;
+        }
+
+        std::string payload((size_t)count, '\0');
+        if(fread(payload.data(), 1, payload.size(), in) != payload.size())
+        {
+            return std::nullopt;
+        }
+
+        return std::make_optional(std::make_pair(format, payload));
+    }
+}
+
+//Run one call against the resident state -- each call gets a fresh stack and evaluator state and anything left over from a failed run is discarded
+//If rsink is given a successful value is written there (and left out of the returned status)
+json runResident(Evaluator& runner, const APIModule* api, const std::string& jmain, json jargs, const std::string& jitmode, JSONStreamWriter* rsink)
+{
+    uint8_t* sbase = GCStack::stackp;
+
+    auto start = std::chrono::system_clock::now();
+    auto res = runWithJitMode(runner, api, jmain, domArgLoader(jargs), jitmode, rsink);
+    auto end = std::chrono::system_clock::now();
+
+    GCStack::reset(sbase);
+    runner.reset();
+    ICPPParseJSON::releaseInputPayloads();
+
+    int delta_ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    int64_t delta_us = (int64_t)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    if(res.first && rsink != nullptr)
+    {
+        return {{"status", "success"}, {"time", delta_ms}, {"time_us", delta_us}};
+    }
+    else if(res.first)
+    {
+        return {{"status", "success"}, {"time", delta_ms}, {"time_us", delta_us}, {"value", res.second}};
+    }
+    else
+    {
+        return {{"status", "failure"}, {"time", delta_ms}, {"time_us", delta_us}, {"msg", res.second}};
+    }
+}
+
+//Binary requests get the value written into a CBOR response as it is extracted (raw bytes stay byte strings)
+void writeBinaryServeResponse(Evaluator& runner, const APIModule* api, const json& req, const std::string& jmain, json jargs, const std::string& jitmode, FILE* out)
+{
+    JSONStreamWriter rout(nullptr, -1, JSONStreamFormat::CBOR);
+    rout.beginObject();
+    rout.key("value");
+
+    json resp = runResident(runner, api, jmain, jargs, jitmode, &rout);
+    if(resp["status"] != "success")
+    {
+        rout.discard();
+        rout.beginObject();
+    }
+
+    for(auto iter = resp.cbegin(); iter != resp.cend(); ++iter)
+    {
+        rout.key(iter.key());
+        rout.value(iter.value());
+    }
+
+    if(req.contains("id"))
+    {
+        rout.key("id");
+        rout.value(req["id"]);
+    }
+    rout.endObject();
+
+    fprintf(out, "cbor %zu\n", rout.contents().size());
+    fwrite(rout.contents().data(), 1, rout.contents().size(), out);
+}
+
+void processServeRequest(Evaluator& runner, const APIModule* api, const std::pair<json::input_format_t, std::string>& reqinfo, const std::string& jitmode, FILE* out)
+{
+    json req;
+    if(reqinfo.first == json::input_format_t::cbor)
+    {
+        req = json::from_cbor(reqinfo.second, true, false);
+    }
+    else if(reqinfo.first == json::input_format_t::msgpack)
+    {
+        req = json::from_msgpack(reqinfo.second, true, false);
+    }
+    else
+    {
+        req = json::parse(reqinfo.second, nullptr, false);
+    }
+
+    bool binary = (reqinfo.first != json::input_format_t::json);
+    if(req.is_discarded() || !req.is_object() || (req.contains("args") && !req["args"].is_array()))
+    {
+        writeServeError("Failed to parse request", binary, out);
+        return;
+    }
+
+    std::string jmain = (req.contains("main") && req["main"].is_string()) ? req["main"].get<std::string>() : std::string("__i__Main::main");
+    json jargs = req.contains("args") ? req["args"] : json::array();
+
+    if(binary)
+    {
+        writeBinaryServeResponse(runner, api, req, jmain, jargs, jitmode, out);
+        return;
+    }
+
+    json resp = runResident(runner, api, jmain, jargs, jitmode, nullptr);
+    if(req.contains("id"))
+    {
+        resp["id"] = req["id"];
+    }
+
+    fprintf(out, "%s\n", resp.dump().c_str());
+}
+
+void serveStream(Evaluator& runner, const APIModule* api, FILE* in, FILE* out, const std::string& jitmode)
+{
+    while(true)
+    {
+        auto reqinfo = readServeRequest(in, out);
+        if(!reqinfo.has_value())
+        {
+            return;
+        }
+
+        processServeRequest(runner, api, reqinfo.value(), jitmode, out);
+        fflush(out);
+    }
+}
+
+int serveSocket(Evaluator& runner, const APIModule* api, const std::string& socketpath, const std::string& jitmode)
+{
+#ifdef _WIN32
+    fprintf(stderr, "Unix domain sockets are not supported on this platform -- use --serve over stdin\n");
+    fflush(stderr);
+    return 1;
+#else
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(socketpath.size() >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "Socket path is too long -- %s\n", socketpath.c_str());
+        fflush(stderr);
+        return 1;
+    }
+    strncpy(addr.sun_path, socketpath.c_str(), sizeof(addr.sun_path) - 1);
+
+    int sfd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socketpath.c_str());
+    if(sfd == -1 || bind(sfd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(sfd, 8) != 0)
+    {
+        fprintf(stderr, "Failed to open socket %s\n", socketpath.c_str());
+        fflush(stderr);
+        return 1;
+    }
+
+    //the evaluator is single threaded so connections are served one at a time in arrival order
+    while(true)
+    {
+        int cfd = accept(sfd, nullptr, nullptr);
+        if(cfd == -1)
+        {
+            continue;
+        }
+
+        FILE* in = fdopen(cfd, "r");
+        FILE* out = fdopen(dup(cfd), "w");
+        if(in != nullptr && out != nullptr)
+        {
+            serveStream(runner, api, in, out, jitmode);
+        }
+
+        if(in != nullptr)
+        {
+            fclose(in);
+        }
+        if(out != nullptr)
+        {
+            fclose(out);
+        }
+    }
+#endif
+}
+
+////
+//Batch mode -- one entrypoint is run over a stream of argument sets (one JSON value per line)
+//For a single parameter entrypoint each record is that argument (even if it is an array) and otherwise a record is the full argument list
+//There is one NDJSON result line per record in input order and a failing record only fails its own line
+
+void batchStream(Evaluator& runner, const APIModule* api, const std::string& jmain, FILE* in, FILE* out, const std::string& jitmode)
+{
+    const BSQInvokeBodyDecl* call = resolveInvokeForMainName(jmain);
+    bool unary = (call != nullptr && call->params.size() == 1);
+
+    size_t record = 0;
+    while(true)
+    {
+        auto line = readServeLine(in);
+        if(!line.has_value())
+        {
+            break;
+        }
+
+        if(line.value().empty())
+        {
+            continue;
+        }
+
+        json resp;
+        json jargs = json::parse(line.value(), nullptr, false);
+        if(jargs.is_discarded())
+        {
+            resp = {{"status", "error"}, {"msg", "Failed to parse record"}};
+        }
+        else
+        {
+            resp = runResident(runner, api, jmain, (unary || !jargs.is_array()) ? json::array({jargs}) : jargs, jitmode, nullptr);
+        }
+        resp["record"] = record++;
+
+        //leave the buffering to stdio -- flushing every line dominates small records
+        auto rstr = resp.dump();
+        fwrite(rstr.c_str(), 1, rstr.size(), out);
+        fputc('\n', out);
+    }
+
+    fflush(out);
+}
+
+void parseArgs(int argc, char** argv, std::string& mode, bool& debugger, std::string& jitmode, std::string& prog, std::string& input, std::string& socketpath, std::string& mainname, bool& snapshot, bool& compact, bool& cborout)
 {
     bool isstream = false;
+    bool isserve = false;
+    bool isbatch = false;
     debugger = false;
-    for(int i = 0; i < argc; ++i)
+    jitmode = "off";
+    socketpath = "";
+    mainname = "Main::main";
+    snapshot = false;
+    compact = false;
+    cborout = false;
+
+    std::vector<std::string> positional;
+    for(int i = 1; i < argc; ++i)
     {
         std::string sarg(argv[i]);
 
-        isstream |= (sarg == "--stream");
-        debugger |= (sarg == "--debug");
+        if(sarg == "--stream")
+        {
+            isstream = true;
+        }
+        else if(sarg == "--debug")
+        {
+            debugger = true;
+        }
+        else if(sarg == "--jit")
+        {
+            jitmode = "on";
+        }
+        else if(sarg == "--jit-diff")
+        {
+            jitmode = "diff";
+        }
+        else if(sarg == "--serve")
+        {
+            isserve = true;
+        }
+        else if(sarg == "--batch")
+        {
+            isbatch = true;
+        }
+        else if(sarg == "--socket" && i + 1 < argc)
+        {
+            socketpath = std::string(argv[++i]);
+        }
+        else if(sarg == "--main" && i + 1 < argc)
+        {
+            mainname = std::string(argv[++i]);
+        }
+        else if(sarg == "--snapshot")
+        {
+            snapshot = true;
+        }
+        else if(sarg == "--compact")
+        {
+            compact = true;
+        }
+        else if(sarg == "--cbor")
+        {
+            cborout = true;
+        }
+        else
+        {
+            positional.push_back(sarg);
+        }
     }
 
     if(isstream)
     {
         mode = "stream";
     }
-    else if(argc == 3 || (argc == 4 && debugger))
+    else if(isserve && positional.size() == 1)
+    {
+        mode = "serve";
+        prog = positional[0];
+    }
+    else if(isbatch && (positional.size() == 1 || positional.size() == 2))
+    {
+        mode = "batch";
+        prog = positional[0];
+        input = (positional.size() == 2) ? positional[1] : std::string("Main::main");
+    }
+    else if(positional.size() == 2)
     {
         mode = "run";
-        prog = std::string(debugger ? argv[2] : argv[1]);
-        input = std::string(debugger ? argv[3] : argv[2]);
+        prog = positional[0];
+        input = positional[1];
     }
     else
     {
-        fprintf(stderr, "Usage: icpp [--debug] bytecode.bsqir args[]\n");
-        fprintf(stderr, "Usage: icpp [--debug] --stream\n");
+        fprintf(stderr, "Usage: icpp [--debug] [--jit | --jit-diff] [--snapshot] [--compact | --cbor] [--main entrypoint] bytecode.bsqir args[] | @args.json | @args.cbor | @args.msgpack\n");
+        fprintf(stderr, "Usage: icpp [--debug] [--jit | --jit-diff] [--compact] --stream\n");
+        fprintf(stderr, "Usage: icpp [--jit | --jit-diff] [--snapshot] --serve bytecode.bsqir [--socket path]\n");
+        fprintf(stderr, "Usage: icpp [--jit | --jit-diff] [--snapshot] --batch bytecode.bsqir [entrypoint] < records.ndjson\n");
         fflush(stderr);
         exit(1);
     }
@@ -194,16 +869,29 @@ int main(int argc, char** argv)
 {
     std::string mode;
     bool debugger = false;
+    std::string jitmode;
     std::string prog;
     std::string input;
-    parseArgs(argc, argv, mode, debugger, prog, input);
+    std::string socketpath;
+    std::string mainname;
+    bool snapshot = false;
+    bool compact = false;
+    bool cborout = false;
+    parseArgs(argc, argv, mode, debugger, jitmode, prog, input, socketpath, mainname, snapshot, compact, cborout);
+    configureJit(jitmode);
+    configureCollector();
+
+    if(snapshot && (mode == "run" || mode == "serve" || mode == "batch"))
+    {
+        configureSnapshot(prog);
+    }
 
     const char* outputenv = std::getenv("ICPP_OUTPUT_MODE");
     std::string outmode(outputenv != nullptr ? outputenv : "simple");
 
     if(mode == "stream")
     {
-        auto payload = getIRFromStdIn();
+        auto payload = getIRFromStdIn(!debugger);
         if(!payload.has_value() || !payload.value().contains("code") || !payload.value().contains("args"))
         {
             if(outmode == "simple")
@@ -218,9 +906,9 @@ int main(int argc, char** argv)
             exit(1);
         }
 
-        json jcode = payload.value()["code"];
-        json jmain = payload.value()["main"].get<std::string>();
-        json jargs = payload.value()["args"];
+        json& jcode = payload.value()["code"];
+        std::string jmain = payload.value()["main"].get<std::string>();
+        json jargs = std::move(payload.value()["args"]);
 
         const APIModule* api = APIModule::jparse(jcode["api"]);
 
@@ -230,28 +918,40 @@ int main(int argc, char** argv)
 #endif 
 
         loadAssembly(jcode["bytecode"], runner);
+        payload.reset();
+        ICPPParseJSON::buildMarshalPlans(api);
+        configureLoadStats();
+
+        //the value is written as it is extracted so the envelope puts the time after it
+        JSONStreamWriter rout(stdout, compact ? -1 : 4, JSONStreamFormat::Text);
+        if(outmode != "simple")
+        {
+            rout.raw("{\"status\": \"success\", \"value\": ");
+        }
 
         auto start = std::chrono::system_clock::now();
-        auto res = run(runner, api, jmain, jargs);
+        auto res = runWithJitMode(runner, api, jmain, domArgLoader(jargs), jitmode, &rout);
         auto end = std::chrono::system_clock::now();
 
         int delta_ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-        auto jout = res.second.dump(4);
         if(res.first)
         {
             if(outmode == "simple")
             {
-                printf("%s\n", jout.c_str());
+                rout.raw("\n");
             }
             else
             {
-                printf("{\"status\": \"success\", \"time\": %i, \"value\": %s}\n", delta_ms, jout.c_str());
+                rout.raw(", \"time\": " + std::to_string(delta_ms) + "}\n");
             }
-            fflush(stdout);
+            rout.flush();
             return 0;
         }
         else
         {
+            rout.discard();
+
+            auto jout = res.second.dump(4);
             if(outmode == "simple")
             {
                 printf("%s\n", jout.c_str());
@@ -265,63 +965,160 @@ int main(int argc, char** argv)
             return 1;
         }
     }
+    else if(mode == "serve")
+    {
+        auto cc = getIRFromFile(prog, true);
+        if(!cc.has_value())
+        {
+            fprintf(stderr, "Failed to load file %s\n", prog.c_str());
+            fflush(stderr);
+            exit(1);
+        }
+
+        json& jcode = cc.value()["code"];
+        const APIModule* api = APIModule::jparse(jcode["api"]);
+
+        Evaluator runner;
+        loadAssembly(jcode["bytecode"], runner);
+        cc.reset();
+        ICPPParseJSON::buildMarshalPlans(api);
+        configureLoadStats();
+        configureServe();
+
+        if(!socketpath.empty())
+        {
+            return serveSocket(runner, api, socketpath, jitmode);
+        }
+
+        serveStream(runner, api, stdin, stdout, jitmode);
+        return 0;
+    }
+    else if(mode == "batch")
+    {
+        auto cc = getIRFromFile(prog, true);
+        if(!cc.has_value())
+        {
+            fprintf(stderr, "Failed to load file %s\n", prog.c_str());
+            fflush(stderr);
+            exit(1);
+        }
+
+        json& jcode = cc.value()["code"];
+        const APIModule* api = APIModule::jparse(jcode["api"]);
+
+        Evaluator runner;
+        loadAssembly(jcode["bytecode"], runner);
+        cc.reset();
+        ICPPParseJSON::buildMarshalPlans(api);
+        configureLoadStats();
+
+        batchStream(runner, api, "__i__" + input, stdin, stdout, jitmode);
+        return 0;
+    }
     else
     {
-        auto cc = getIRFromFile(prog);
+        auto cc = getIRFromFile(prog, !debugger);
         if(!cc.has_value())
         {
             if(outmode == "simple")
             {
-                printf("!ERROR! -- Failed to load file %s...\n", argv[1]);
+                printf("!ERROR! -- Failed to load file %s...\n", prog.c_str());
             }
             else
             {
-                printf("{\"status\": \"error:\", \"msg\": \"Failed to load file %s\"}\n", argv[1]);
+                printf("{\"status\": \"error:\", \"msg\": \"Failed to load file %s\"}\n", prog.c_str());
             }
             fflush(stdout);
             exit(1);
         }
 
-        json jcode = cc.value()["code"];
-        std::string jmain("__i__Main::main");
-        auto jargs = json::parse(input);
-        if(jargs.is_object())
+        json& jcode = cc.value()["code"];
+        std::string jmain("__i__" + mainname);
+
+        //@file streams the argument array from the file instead of parsing it into a DOM first
+        ArgLoader argloader;
+        if(!input.empty() && input[0] == '@')
+        {
+            argloader = streamArgLoader(input.substr(1));
+        }
+        else
         {
-            jmain = "__i__" + jargs["main"].get<std::string>();
-            jargs = jargs["args"];
+            auto jargs = json::parse(input);
+            if(jargs.is_object())
+            {
+                jmain = "__i__" + jargs["main"].get<std::string>();
+                jargs = jargs["args"];
+            }
+            argloader = domArgLoader(jargs);
         }
 
         const APIModule* api = APIModule::jparse(jcode["api"]);
 
         Evaluator runner;
-        loadAssembly(jcode["bytecode"], runner);
-
 #ifdef BSQ_DEBUG_BUILD
         runner.debuggerattached = debugger;
 #endif
 
+        loadAssembly(jcode["bytecode"], runner);
+        cc.reset();
+        ICPPParseJSON::buildMarshalPlans(api);
+        configureLoadStats();
+
+        //the value is written as it is extracted so the envelope puts the time after it
+        JSONStreamWriter rout(stdout, compact ? -1 : 4, cborout ? JSONStreamFormat::CBOR : JSONStreamFormat::Text);
+        if(cborout)
+        {
+            rout.beginObject();
+            rout.key("value");
+        }
+        else
+        {
+            rout.raw(outmode == "simple" ? "> " : "{\"status\": \"success\", \"value\": ");
+        }
+
         auto start = std::chrono::system_clock::now();
-        auto res = run(runner, api, jmain, jargs);
+        auto res = runWithJitMode(runner, api, jmain, argloader, jitmode, &rout);
         auto end = std::chrono::system_clock::now();
 
         int delta_ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-        auto jout = res.second.dump(4);
         if(res.first)
         {
-            if(outmode == "simple")
+            if(cborout)
+            {
+                rout.key("status");
+                rout.value("success");
+                rout.key("time");
+                rout.value(delta_ms);
+                rout.endObject();
+            }
+            else if(outmode == "simple")
             {
-                printf("> %s\n", jout.c_str());
-                printf("Elapsed time %i...\n", (int)delta_ms);
+                rout.raw("\nElapsed time " + std::to_string(delta_ms) + "...\n");
             }
             else
             {
-                printf("{\"status\": \"success\", \"time\": %i \"value\": %s}\n", (int)delta_ms, jout.c_str());
+                rout.raw(", \"time\": " + std::to_string(delta_ms) + "}\n");
             }
-            fflush(stdout);
+            rout.flush();
             return 0;
         }
         else
         {
+            rout.discard();
+
+            if(cborout)
+            {
+                rout.beginObject();
+                rout.key("status");
+                rout.value("failure");
+                rout.key("msg");
+                rout.value(res.second);
+                rout.endObject();
+                rout.flush();
+                return 1;
+            }
+
+            auto jout = res.second.dump(4);
             if(outmode == "simple")
             {
                 printf("!ERROR! %s\n", jout.c_str());
@@ -8,6 +8,8 @@
 #include "bsqmap.h"
 
 std::vector<const BSQInvokeDecl*> BSQInvokeDecl::g_invokes;
+bool BSQInvokeBodyDecl::g_lazyload = false;
+const char* BSQInvokeBodyDecl::g_lazysource = nullptr;
 
 RefMask jsonLoadRefMask(json val)
 {
@@ -512,6 +514,17 @@ void BSQInvokeDecl::jsonLoad(json v)
     BSQInvokeDecl::g_invokes[dcl->ikey] = dcl;
 }
 
+void jsonLoadBodyOps(const json& jbody, std::vector<InterpOp*>& body, std::vector<InterpOpSourceEntry>& bodysrcinfo)
+{
+    body.reserve(jbody.size());
+    bodysrcinfo.reserve(jbody.size());
+
+    std::for_each(jbody.cbegin(), jbody.cend(), [&body, &bodysrcinfo](const json& jop) {
+        body.push_back(InterpOp::jparse(jop));
+        bodysrcinfo.push_back(InterpOpSourceEntry{j_sinfo(jop), j_ssrc(jop)});
+    });
+}
+
 BSQInvokeBodyDecl* BSQInvokeBodyDecl::jsonLoad(json v)
 {
     auto ikey = MarshalEnvironment::g_invokeToIdMap.at(v["ikey"].get<std::string>());
@@ -536,13 +549,46 @@ BSQInvokeBodyDecl* BSQInvokeBodyDecl::jsonLoad(json v)
 
     Argument resultArg = { v["resultArg"]["kind"].get<ArgumentTag>(), v["resultArg"]["location"].get<uint32_t>() };
 
+    //a deferred body is {srcoffset, srcbytes} into the retained source instead of the op list
     std::vector<InterpOp*> body;
-    auto jbody = v["body"];
-    std::transform(jbody.cbegin(), jbody.cend(), std::back_inserter(body), [](json jop) {
-        return InterpOp::jparse(jop);
-    });
+    std::vector<InterpOpSourceEntry> bodysrcinfo;
+    bool deferred = v["body"].is_object();
+    if(!deferred)
+    {
+        jsonLoadBodyOps(v["body"], body, bodysrcinfo);
+    }
+
+    auto stackbytes = v["stackBytes"].get<size_t>();
+    RefMask stackmask = v.contains("stackmask") ? jsonLoadRefMask(v["stackmask"]) : nullptr;
+
+    const GCStackFrameMap* stackmap = nullptr;
+    if(stackmask != nullptr && strlen(stackmask) * ICPP_WORD_SIZE == stackbytes)
+    {
+        stackmap = new GCStackFrameMap(stackbytes, stackmask);
+    }
+
+    auto bdecl = new BSQInvokeBodyDecl(j_name(v), ikey, srcfile, j_sinfoStart(v), j_sinfoEnd(v), recursive, params, rtype, paraminfo, resultArg, stackbytes, v["maskSlots"].get<uint32_t>(), stackmap, body, bodysrcinfo, v["argmaskSize"].get<uint32_t>());
+    if(deferred)
+    {
+        bdecl->lazysrc = BSQInvokeBodyDecl::g_lazysource + v["body"]["srcoffset"].get<size_t>();
+        bdecl->lazysrcbytes = v["body"]["srcbytes"].get<size_t>();
+
+        if(!BSQInvokeBodyDecl::g_lazyload)
+        {
+            bdecl->materializeOps();
+        }
+    }
+
+    return bdecl;
+}
+
+void BSQInvokeBodyDecl::materializeOps()
+{
+    json jbody = json::parse(this->lazysrc, this->lazysrc + this->lazysrcbytes);
+    jsonLoadBodyOps(jbody, this->body, this->bodysrcinfo);
 
-    return new BSQInvokeBodyDecl(j_name(v), ikey, srcfile, j_sinfoStart(v), j_sinfoEnd(v), recursive, params, rtype, paraminfo, resultArg, v["stackBytes"].get<size_t>(), v["maskSlots"].get<uint32_t>(), body, v["argmaskSize"].get<uint32_t>());
+    this->lazysrc = nullptr;
+    this->lazysrcbytes = 0;
 }
 
 BSQInvokePrimitiveDecl* BSQInvokePrimitiveDecl::jsonLoad(json v)
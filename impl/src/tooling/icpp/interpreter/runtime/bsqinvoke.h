@@ -54,7 +54,8 @@ public:
 class BSQInvokeBodyDecl : public BSQInvokeDecl 
 {
 public:
-    const std::vector<InterpOp*> body;
+    std::vector<InterpOp*> body; //may be rewritten by the load time passes (the optimizer may also remove ops)
+    std::vector<InterpOpSourceEntry> bodysrcinfo; //kept index aligned with body
     const uint32_t argmaskSize;
 
     const std::vector<ParameterInfo> paraminfo;
@@ -63,8 +64,29 @@ public:
     const size_t stackBytes;
     const uint32_t maskSlots;
 
-    BSQInvokeBodyDecl(std::string name, BSQInvokeID ikey, std::string srcFile, SourceInfo sinfoStart, SourceInfo sinfoEnd, bool recursive, std::vector<BSQFunctionParameter> params, const BSQType* resultType, std::vector<ParameterInfo> paraminfo, Argument resultArg, size_t stackBytes, uint32_t maskSlots, std::vector<InterpOp*> body, uint32_t argmaskSize)
-    : BSQInvokeDecl(name, ikey, srcFile, sinfoStart, sinfoEnd, recursive, params, resultType), body(body), argmaskSize(argmaskSize), paraminfo(paraminfo), resultArg(resultArg), stackBytes(stackBytes), maskSlots(maskSlots)
+    //Precise layout of the frame for the collector -- nullptr if the assembly did not provide one (the frame is then zeroed and scanned conservatively)
+    const GCStackFrameMap* stackmap;
+
+    //Ops of a body that has not been called yet stay as a byte range of the assembly source until materializeOps is run on the first call -- nullptr once loaded
+    const char* lazysrc = nullptr;
+    size_t lazysrcbytes = 0;
+    static bool g_lazyload;
+
+    //The retained assembly text that deferred bodies point into -- see parseAssemblyPayload
+    static const char* g_lazysource;
+
+    //Handler addresses for each op in the body (plus an end of body sentinel) -- resolved once at load by the Evaluator
+    std::vector<const void*> dispatch;
+
+#ifdef BSQ_JIT_AVAILABLE
+    //Native tier state -- the call count is only tracked while the tier is enabled and a rejected body is never retried
+    mutable uint32_t jitcalls = 0;
+    mutable void* jitcode = nullptr;
+    mutable bool jitrejected = false;
+#endif
+
+    BSQInvokeBodyDecl(std::string name, BSQInvokeID ikey, std::string srcFile, SourceInfo sinfoStart, SourceInfo sinfoEnd, bool recursive, std::vector<BSQFunctionParameter> params, const BSQType* resultType, std::vector<ParameterInfo> paraminfo, Argument resultArg, size_t stackBytes, uint32_t maskSlots, const GCStackFrameMap* stackmap, std::vector<InterpOp*> body, std::vector<InterpOpSourceEntry> bodysrcinfo, uint32_t argmaskSize)
+    : BSQInvokeDecl(name, ikey, srcFile, sinfoStart, sinfoEnd, recursive, params, resultType), body(body), bodysrcinfo(bodysrcinfo), argmaskSize(argmaskSize), paraminfo(paraminfo), resultArg(resultArg), stackBytes(stackBytes), maskSlots(maskSlots), stackmap(stackmap), dispatch()
     {;}
 
     virtual ~BSQInvokeBodyDecl()
@@ -79,6 +101,18 @@ public:
         return false;
     }
 
+    inline bool isMaterialized() const
+    {
+        return this->lazysrc == nullptr;
+    }
+
+    void materializeOps();
+
+    inline const SourceInfo& getOpSourceInfo(std::vector<InterpOp*>::const_iterator oppos) const
+    {
+        return this->bodysrcinfo[std::distance(this->body.cbegin(), oppos)].sinfo;
+    }
+
     static BSQInvokeBodyDecl* jsonLoad(json v);
 };
 
@@ -133,5 +167,5 @@ public:
     LambdaEvalThunk(void* ctx): ctx(ctx) {;}
     ~LambdaEvalThunk() {;}
 
-    void invoke(const BSQInvokeBodyDecl* call, const std::vector<StorageLocationPtr>& args, StorageLocationPtr resultsl);
+    void invoke(const BSQInvokeBodyDecl* call, StorageLocationSpan args, StorageLocationPtr resultsl);
 };
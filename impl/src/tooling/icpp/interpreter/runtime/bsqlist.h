@@ -70,7 +70,7 @@ public:
         return ((uint8_t*)repr) + sizeof(uint64_t) + (i * this->entrysize);
     }
 
-    inline static void initializePVData(void* pvinto, const std::vector<StorageLocationPtr>& vals, const BSQType* entrytype)
+    inline static void initializePVData(void* pvinto, StorageLocationSpan vals, const BSQType* entrytype)
     {
         auto intoloc = ((uint8_t*)pvinto) + sizeof(uint64_t);
 
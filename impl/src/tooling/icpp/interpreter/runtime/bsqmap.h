@@ -143,9 +143,10 @@ public:
         this->lcurr = static_cast<BSQMapTreeRepr*>(this->lcurr)->r;
     }
 
+    //the add walk steps onto the empty child where the new leaf goes so the current position may be null here
     inline void pop()
     {
-        assert(this->valid());
+        assert(!this->iterstack.empty());
 
         this->lcurr = this->iterstack.back();
         this->iterstack.pop_back();
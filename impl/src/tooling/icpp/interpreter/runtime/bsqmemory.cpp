@@ -4,6 +4,7 @@
 //-------------------------------------------------------------------------------------------------------
 
 #include "bsqmemory.h"
+#include "../op_eval.h"
 
 size_t BSQType::g_typeTableSize = 0;
 const BSQType** BSQType::g_typetable = nullptr;
@@ -11,6 +12,9 @@ const BSQType** BSQType::g_typetable = nullptr;
 uint8_t GCStack::sdata[BSQ_MAX_STACK] = {0};
 uint8_t* GCStack::stackp = GCStack::sdata;
 
+GCStackMappedFrame GCStack::framemaps[BSQ_MAX_STACK];
+size_t GCStack::framemapcount = 0;
+
 bool GCStack::global_init_complete = false;
 PageInfo* GCStack::global_memory = nullptr;
 BSQType* GCStack::global_type = nullptr;
@@ -18,6 +22,23 @@ BSQType* GCStack::global_type = nullptr;
 PageInfo AllocPages::g_sential_page = {0};
 
 Allocator Allocator::GlobalAllocator;
+thread_local GCWorker* Allocator::g_gcworker = nullptr;
+
+bool Allocator::g_heaplimitabortable = false;
+
+void Allocator::failHeapLimit(size_t livebytes, size_t limitbytes)
+{
+    if(Allocator::g_heaplimitabortable)
+    {
+        snprintf(Evaluator::g_abortmsg, sizeof(Evaluator::g_abortmsg), "Heap limit exceeded -- %zu bytes live with a limit of %zu bytes", livebytes, limitbytes);
+        longjmp(Evaluator::g_entrybuff, 4);
+    }
+
+    //no call to abort (e.g. still loading) so this is fatal
+    fprintf(stderr, "Heap limit exceeded -- %zu bytes live with a limit of %zu bytes\n", livebytes, limitbytes);
+    fflush(stderr);
+    exit(1);
+}
 
 void gcProcessHeapOperator_nopImpl(const BSQType* btype, void** data, void* fromObj)
 {
@@ -7,6 +7,12 @@
 
 #include "../common.h"
 
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -16,13 +22,23 @@
 #include <unistd.h>
 #endif
 
+#ifdef _WIN32
+#define BSQ_WIN_SYSTEM_PAGE_SIZE 4096ul
+#endif
+
 #define DEFAULT_PAGE_COST 2
 #define MAX_PAGE_COST 16
-#define COLLECT_ALL_PAGE_COST ((uint32_t)4294967296)
+#define COLLECT_ALL_PAGE_COST UINT32_MAX
 #define DEFAULT_POST_COLLECT_RUN_DECS_COST 1024
 
 #define DEFAULT_DEC_OPS_COUNT 256
 
+#define DEFAULT_GC_MAX_PAUSE_MS 10.0
+#define DEFAULT_GC_HEAP_HEADROOM 1.0
+
+//weight of the latest collection in the smoothed measurements
+#define GC_SIZING_SMOOTHING 0.5
+
 #define OCCUPANCY_LOW_MID_BREAK 0.30f
 #define OCCUPANCY_MID_HIGH_BREAK 0.85f
 
@@ -51,6 +67,19 @@ public:
     uint64_t live_bytes;
 };
 
+//Where the pages of the heap are -- each region is one mapping so regions is also the number the heap adds to the process
+class PageMemoryStats
+{
+public:
+    uint64_t regions;
+    uint64_t total_pages;
+    uint64_t free_pages;
+    uint64_t released_pages;
+
+    //every page the OS has taken back so far (one reused and released again is counted each time)
+    uint64_t release_count;
+};
+
 ////
 //BSQType abstract base class
 class BSQType
@@ -59,7 +88,11 @@ public:
     static size_t g_typeTableSize;
     static const BSQType** g_typetable;
 
-    PageInfo* allocpage;
+    //Bump allocation range (and next metadata slot) in the nursery block this type is allocating from -- all null if it has none
+    uint8_t* nurserycurr;
+    uint8_t* nurseryend;
+    GC_META_DATA_WORD* nurserymeta;
+
     PageInfo* evacuatepage;
 
     const BSQTypeID tid;
@@ -69,7 +102,10 @@ public:
     const GCFunctorSet gcops;
 
     KeyCmpFP fpkeycmp;
-    const std::map<BSQVirtualInvokeID, BSQInvokeID> vtable; //TODO: This is slow indirection but nice and simple
+    const std::map<BSQVirtualInvokeID, BSQInvokeID> vtable; //source of truth for the virtual dispatch -- flattened into vdispatch at load
+
+    //Dense vtable indexed by BSQVirtualInvokeID (nullptr if this type has no virtual methods)
+    BSQInvokeID* vdispatch;
 
     DisplayFP fpDisplay;
     const std::string name;
@@ -77,12 +113,11 @@ public:
     size_t tableEntrySize;
     size_t tableEntryCount;
 
-    std::set<PageInfo*> filledpages; //pages that have been filled by the allocator and are pending collection
     AllocPages allocatedPages;
 
     //Constructor that everyone delegates to
     BSQType(BSQTypeID tid, BSQTypeLayoutKind tkind, BSQTypeSizeInfo allocinfo, GCFunctorSet gcops, std::map<BSQVirtualInvokeID, BSQInvokeID> vtable, KeyCmpFP fpkeycmp, DisplayFP fpDisplay, std::string name): 
-        allocpage(&AllocPages::g_sential_page), evacuatepage(&AllocPages::g_sential_page), tid(tid), tkind(tkind), filledpages(), allocinfo(allocinfo), gcops(gcops), fpkeycmp(fpkeycmp), vtable(vtable), fpDisplay(fpDisplay), name(name)
+        nurserycurr(nullptr), nurseryend(nullptr), nurserymeta(nullptr), evacuatepage(&AllocPages::g_sential_page), tid(tid), tkind(tkind), allocinfo(allocinfo), gcops(gcops), fpkeycmp(fpkeycmp), vtable(vtable), vdispatch(nullptr), fpDisplay(fpDisplay), name(name)
     {
         static_assert(sizeof(PageInfo) % 8 == 0);
 
@@ -97,6 +132,12 @@ public:
 
     virtual ~BSQType() {;}
 
+    inline BSQInvokeID resolveVirtualInvoke(BSQVirtualInvokeID vid) const
+    {
+        assert(this->vdispatch != nullptr);
+        return this->vdispatch[vid];
+    }
+
     inline bool isLeaf() const
     {
         return this->allocinfo.heapmask == nullptr;
@@ -149,12 +190,60 @@ public:
 //TODO: this should all end up using the actual call stack and walked via ASM (interpreter just stack allocs for data and C compiler frames are in there too)
 //      lets go look at chakra for this
 //
+//Precise layout of a body frame -- one mask entry per word plus the (byte offset, byte count) runs of words that may hold references
+class GCStackFrameMap
+{
+public:
+    const size_t bytes;
+    const RefMask mask;
+    std::vector<std::pair<uint32_t, uint32_t>> refruns;
+
+    GCStackFrameMap(size_t bytes, RefMask mask) : bytes(bytes), mask(mask), refruns()
+    {
+        uint32_t wcount = (uint32_t)(bytes / ICPP_WORD_SIZE);
+        for(uint32_t i = 0; i < wcount; ++i)
+        {
+            if(mask[i] != PTR_FIELD_MASK_NOP)
+            {
+                if(!this->refruns.empty() && (this->refruns.back().first + this->refruns.back().second) == i * ICPP_WORD_SIZE)
+                {
+                    this->refruns.back().second += ICPP_WORD_SIZE;
+                }
+                else
+                {
+                    this->refruns.push_back(std::make_pair(i * ICPP_WORD_SIZE, ICPP_WORD_SIZE));
+                }
+            }
+        }
+    }
+
+    ~GCStackFrameMap() {;}
+
+    inline void zeroRefSlots(uint8_t* frame) const
+    {
+        for(size_t i = 0; i < this->refruns.size(); ++i)
+        {
+            GC_MEM_ZERO(frame + this->refruns[i].first, this->refruns[i].second);
+        }
+    }
+};
+
+struct GCStackMappedFrame
+{
+    uint8_t* frame;
+    const GCStackFrameMap* fmap;
+};
+
 class GCStack
 {
 public:
     static uint8_t* stackp;
     static uint8_t sdata[BSQ_MAX_STACK];
 
+    //Body frames with a precise layout (in stack order) -- stack words outside of these are scanned conservatively
+    static GCStackMappedFrame framemaps[BSQ_MAX_STACK];
+    static size_t framemapcount;
+
     static bool global_init_complete;
     static PageInfo* global_memory;
     static BSQType* global_type;
@@ -164,6 +253,16 @@ public:
     static void reset(uint8_t* argsend)
     {
         stackp = argsend;
+        GCStack::dropStaleFrameMaps();
+    }
+
+    //A longjmp or exception can unwind frames without popping their maps
+    inline static void dropStaleFrameMaps()
+    {
+        while(GCStack::framemapcount != 0 && GCStack::stackp <= GCStack::framemaps[GCStack::framemapcount - 1].frame)
+        {
+            GCStack::framemapcount--;
+        }
     }
 
     inline static uint8_t* allocFrame(size_t bytes)
@@ -184,6 +283,42 @@ public:
         return frame;
     }
 
+    //Only the reference slots are zeroed -- scalar slots are never scanned once the map is pushed
+    inline static uint8_t* allocMappedFrame(size_t bytes, const GCStackFrameMap* fmap)
+    {
+        if(fmap == nullptr)
+        {
+            return GCStack::allocFrame(bytes);
+        }
+
+        assert((GCStack::stackp - GCStack::sdata) < BSQ_MAX_STACK);
+        GCStack::dropStaleFrameMaps();
+
+#ifdef ALLOC_DEBUG_CANARY
+        *((size_t*)GCStack::stackp) = 17;
+        GCStack::stackp += sizeof(size_t);
+#endif
+
+        uint8_t* frame = GCStack::stackp;
+        fmap->zeroRefSlots(frame);
+        GCStack::stackp += bytes;
+
+        GCStack::framemaps[GCStack::framemapcount] = GCStackMappedFrame{frame, fmap};
+        GCStack::framemapcount++;
+
+        return frame;
+    }
+
+    inline static void popMappedFrame(size_t bytes, const GCStackFrameMap* fmap)
+    {
+        if(fmap != nullptr)
+        {
+            GCStack::framemapcount--;
+        }
+
+        GCStack::popFrame(bytes);
+    }
+
     inline static void popFrame(size_t bytes)
     {
         GCStack::stackp -= bytes;
@@ -290,7 +425,9 @@ public:
         void** tmp = (void**)zxalloc(GC_REF_LIST_BLOCK_SIZE_DEFAULT * sizeof(void*));
         this->tailrl[0] = tmp;
         this->tailrl = tmp;
-        this->epos = 1;
+
+        this->tailrl[1] = v;
+        this->epos = 2;
     }
 
     inline void enque(void* v)
@@ -322,7 +459,7 @@ public:
 
         if(this->spos < GC_REF_LIST_BLOCK_SIZE_DEFAULT)
         {
-            return this->tailrl[this->spos++];
+            return this->headrl[this->spos++];
         }
         else
         {
@@ -349,11 +486,8 @@ public:
 
     inline void iterAdvance(GCRefListIterator& iter) const
     {
-        if(iter.cpos < GC_REF_LIST_BLOCK_SIZE_DEFAULT)
-        {
-            iter.cpos++;
-        }
-        else
+        iter.cpos++;
+        if((iter.cpos == GC_REF_LIST_BLOCK_SIZE_DEFAULT) & (iter.crl != this->tailrl))
         {
             this->iterAdvanceSlow(iter);
         }
@@ -368,7 +502,25 @@ public:
     std::set<PageInfo*> page_set;
 
     std::set<PageInfo*> free_pages; //pages that are completely empty
-    std::set<BSQType*> allocated_types; //the set of types that have a alloc page (and maybe filled pages) that are pending processing
+    std::set<PageInfo*> released_pages; //empty pages whose memory has been returned to the OS (still reserved and reused after free_pages)
+
+    //Blocks young objects are bump allocated in -- handed to types in order and nursery_next is the first one not yet in use
+    std::vector<PageInfo*> nursery;
+    size_t nursery_next;
+
+    //Blocks are carved in address order from the current region -- a new region is reserved when it runs out
+    std::vector<uint8_t*> regions;
+    uint8_t* regioncurr;
+    uint8_t* regionend;
+
+    //back regions with transparent huge pages and release pages lazily (the OS reclaims them only under memory pressure)
+    bool hugepages;
+    bool lazyrelease;
+
+    //pages the OS has taken back so far (a page released, reused, and released again counts twice)
+    size_t release_count;
+
+    BlockAllocator() : page_set(), free_pages(), released_pages(), nursery(), nursery_next(0), regions(), regioncurr(nullptr), regionend(nullptr), hugepages(false), lazyrelease(false), release_count(0) {;}
 
     inline bool isAddrAllocated(void* addr, void*& realobj) const
     {
@@ -392,7 +544,8 @@ public:
 #ifdef ALLOC_DEBUG_CANARY
     static void checkCanary(void* addr)
     {
-        if(((uintptr_t)addr & PAGE_ADDR_MASK) != (uintptr_t)addr)
+        //the first object on a page is preceded by the meta data words (not the previous object's canary)
+        if(addr != PAGE_MASK_EXTRACT_ADDR(addr)->data)
         {
             size_t* curr = (size_t*)(((uint8_t*)addr) - ALLOC_DEBUG_CANARY_SIZE);
             while(curr < addr)
@@ -452,6 +605,10 @@ public:
 
     void initializeFreshPageForType(PageInfo* p, BSQType* btype)
     {
+        //a block may have held a different type before so the layout is always recomputed
+        p->slots = (GC_META_DATA_WORD*)((uint8_t*)p + sizeof(PageInfo));
+        p->data = (GC_META_DATA_WORD*)((uint8_t*)p + sizeof(PageInfo) + btype->tableEntryCount * sizeof(GC_META_DATA_WORD));
+
         p->alloc_entry_size = btype->tableEntrySize;
         p->alloc_entry_count = btype->tableEntryCount;
         
@@ -470,46 +627,85 @@ public:
         p->allocinfo = 0x0;
     }
 
-    PageInfo* allocateFreePageMemOp()
+    void reserveRegionMemOp()
     {
 #ifdef _WIN32
-            //https://docs.microsoft.com/en-us/windows/win32/memory/reserving-and-committing-memory
-            auto pp = (PageInfo*)VirtualAlloc(nullptr, BSQ_BLOCK_ALLOCATION_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
-            assert(pp != nullptr);
-
-            return pp;
+        //https://docs.microsoft.com/en-us/windows/win32/memory/reserving-and-committing-memory
+        uint8_t* rgn = (uint8_t*)VirtualAlloc(nullptr, BSQ_REGION_ALLOCATION_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        assert(rgn != nullptr);
 #else
-            void* ppstart = (PageInfo*)mmap(nullptr, 2 * BSQ_BLOCK_ALLOCATION_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-            assert(ppstart != MAP_FAILED);
+        void* rstart = mmap(nullptr, BSQ_REGION_ALLOCATION_SIZE + BSQ_REGION_ALIGNMENT, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        assert(rstart != MAP_FAILED);
 
-            auto pagesize = sysconf(_SC_PAGESIZE);
-            uint8_t* pplcurr = (uint8_t*)ppstart;
-            while((((uintptr_t)pplcurr) & PAGE_ADDR_MASK) != ((uintptr_t)pplcurr))
-            {
-                pplcurr = pplcurr + pagesize;
-            }
-            auto ldist = std::distance((uint8_t*)ppstart, pplcurr);
-            if(ldist != 0)
-            {
-                auto rr = munmap(ppstart, ldist);
-                assert(rr != -1);
-            }
+        //trim the mapping to an aligned region
+        uint8_t* rgn = (uint8_t*)((((uintptr_t)rstart) + BSQ_REGION_ALIGNMENT - 1) & ~(BSQ_REGION_ALIGNMENT - 1));
+        auto ldist = std::distance((uint8_t*)rstart, rgn);
+        if(ldist != 0)
+        {
+            auto rr = munmap(rstart, ldist);
+            assert(rr != -1);
+        }
 
-            uint8_t* pplend = pplcurr + BSQ_BLOCK_ALLOCATION_SIZE;
-            auto rdist = std::distance(pplend, (uint8_t*)ppstart + 2 * BSQ_BLOCK_ALLOCATION_SIZE);
-            if(rdist != 0)
-            {
-                auto rr = munmap(pplend, rdist);
-                assert(rr != -1);
-            }
+        auto rdist = BSQ_REGION_ALIGNMENT - ldist;
+        if(rdist != 0)
+        {
+            auto rr = munmap(rgn + BSQ_REGION_ALLOCATION_SIZE, rdist);
+            assert(rr != -1);
+        }
+
+#ifdef MADV_HUGEPAGE
+        if(this->hugepages)
+        {
+            madvise(rgn, BSQ_REGION_ALLOCATION_SIZE, MADV_HUGEPAGE);
+        }
+#endif
+#endif
+
+        this->regions.push_back(rgn);
+        this->regioncurr = rgn;
+        this->regionend = rgn + BSQ_REGION_ALLOCATION_SIZE;
+    }
+
+    PageInfo* allocateFreePageMemOp()
+    {
+        if(this->regioncurr == this->regionend)
+        {
+            this->reserveRegionMemOp();
+        }
 
-            auto pp = (PageInfo*)pplcurr;
+        PageInfo* pp = (PageInfo*)this->regioncurr;
+        this->regioncurr += BSQ_BLOCK_ALLOCATION_SIZE;
 
-            return pp;
-#endif   
+        return pp;
     }
 
-    PageInfo* allocateFreePage(BSQType* btype)
+    //Give the memory of an (empty and unlinked) page back to the OS -- the address range stays reserved
+    //True if the OS took the page back
+    bool releasePage(PageInfo* pp)
+    {
+#ifdef _WIN32
+        //the header page stays committed since the root scan reads the header of any page in page_set (madvise-d pages just read back as 0)
+        return VirtualFree((uint8_t*)pp + BSQ_WIN_SYSTEM_PAGE_SIZE, BSQ_BLOCK_ALLOCATION_SIZE - BSQ_WIN_SYSTEM_PAGE_SIZE, MEM_DECOMMIT) != 0;
+#else
+#ifdef MADV_FREE
+        return madvise(pp, BSQ_BLOCK_ALLOCATION_SIZE, this->lazyrelease ? MADV_FREE : MADV_DONTNEED) == 0;
+#else
+        return madvise(pp, BSQ_BLOCK_ALLOCATION_SIZE, MADV_DONTNEED) == 0;
+#endif
+#endif
+    }
+
+    void recommitPage(PageInfo* pp)
+    {
+#ifdef _WIN32
+        auto rr = VirtualAlloc((uint8_t*)pp + BSQ_WIN_SYSTEM_PAGE_SIZE, BSQ_BLOCK_ALLOCATION_SIZE - BSQ_WIN_SYSTEM_PAGE_SIZE, MEM_COMMIT, PAGE_READWRITE);
+        assert(rr != nullptr);
+#endif
+    }
+
+    //A block not used by any type -- a free page if there is one, then a released page, then a new block from the current region
+    //If zeroed is set everything after the page header is 0
+    PageInfo* takeEmptyBlock(bool zeroed)
     {
         PageInfo* pp = nullptr;
         if(!this->free_pages.empty())
@@ -518,32 +714,69 @@ public:
 
             pp = *minpageiter;
             this->free_pages.erase(minpageiter);
+
+            if(zeroed)
+            {
+                GC_MEM_ZERO((uint8_t*)pp + sizeof(PageInfo), BSQ_BLOCK_ALLOCATION_SIZE - sizeof(PageInfo));
+            }
+        }
+        else if(!this->released_pages.empty())
+        {
+            auto minpageiter = this->released_pages.begin();
+
+            pp = *minpageiter;
+            this->released_pages.erase(minpageiter);
+
+            this->recommitPage(pp);
+
+            //a lazily released page (or the header page that stays committed on windows) may still hold old contents
+#ifdef _WIN32
+            bool stale = true;
+#else
+            bool stale = this->lazyrelease;
+#endif
+            if(zeroed & stale)
+            {
+                GC_MEM_ZERO((uint8_t*)pp + sizeof(PageInfo), BSQ_BLOCK_ALLOCATION_SIZE - sizeof(PageInfo));
+            }
         }
         else
         {
             pp = this->allocateFreePageMemOp();
-            pp->slots = (GC_META_DATA_WORD*)((uint8_t*)pp + sizeof(PageInfo));
-            pp->data = (GC_META_DATA_WORD*)((uint8_t*)pp + sizeof(PageInfo) + btype->tableEntryCount * sizeof(GC_META_DATA_WORD));
-
             this->page_set.insert(pp);
 
             assert(MIN_ALLOCATED_ADDRESS < ((uintptr_t)pp));
             assert(((uintptr_t)pp) < MAX_ALLOCATED_ADDRESS);
         }
 
+        return pp;
+    }
+
+    PageInfo* allocateFreePage(BSQType* btype)
+    {
+        PageInfo* pp = this->takeEmptyBlock(false);
+
         this->initializeFreshPageForType(pp, btype);
         this->initializePageFreelistFresh(pp);
 
         return pp;
     }
 
-    void releasePage(PageInfo* pp)
+    //Return the memory of free pages above the count we keep around (highest addresses first so allocation stays packed at the low end)
+    void releaseFreePages(size_t keepcount)
     {
-#ifdef _WIN32
-        VirtualFree(pp, 0, MEM_RELEASE);
-#else
-        munmap(pp, BSQ_BLOCK_ALLOCATION_SIZE);
-#endif
+        while(this->free_pages.size() > keepcount)
+        {
+            auto maxpageiter = std::prev(this->free_pages.end());
+            PageInfo* pp = *maxpageiter;
+            this->free_pages.erase(maxpageiter);
+
+            if(this->releasePage(pp))
+            {
+                this->release_count++;
+            }
+            this->released_pages.insert(pp);
+        }
     }
 
     PageInfo* processAndGetNewPageForEvacuation(BSQType* btype)
@@ -557,113 +790,449 @@ public:
             btype->evacuatepage->allocinfo = 0x0;
             btype->allocatedPages.high_utilization.insert(btype->evacuatepage);
             
-            if(!btype->allocatedPages.mid_utilization.empty())
-            {
-                btype->evacuatepage = btype->allocatedPages.mid_utilization.back();
-                btype->allocatedPages.mid_utilization.pop_back();
-            }
-            else if(!btype->allocatedPages.low_utilization.empty())
-            {
-                btype->evacuatepage = *(btype->allocatedPages.low_utilization.begin());
-                btype->allocatedPages.low_utilization.erase(btype->evacuatepage);
-            }
-            else
-            {
-                btype->evacuatepage = this->allocateFreePage(btype);
-            }
+            btype->evacuatepage = this->takePageForEvacuation(btype);
         }
             
         btype->evacuatepage->allocinfo = AllocPageInfo_Ev;
         return btype->evacuatepage;
     }
-    
-    PageInfo* processAndGetNewPageForAllocation(BSQType* btype)
+
+    //A page of the type with free slots to evacuate into -- partially filled pages are used before fresh ones
+    PageInfo* takePageForEvacuation(BSQType* btype)
     {
-        if(btype->allocpage == &AllocPages::g_sential_page)
+        PageInfo* pp = nullptr;
+        if(!btype->allocatedPages.mid_utilization.empty())
+        {
+            pp = btype->allocatedPages.mid_utilization.back();
+            btype->allocatedPages.mid_utilization.pop_back();
+        }
+        else if(!btype->allocatedPages.low_utilization.empty())
         {
-            btype->allocpage = this->allocateFreePage(btype);
+            pp = *(btype->allocatedPages.low_utilization.begin());
+            btype->allocatedPages.low_utilization.erase(pp);
         }
         else
         {
-            btype->allocpage->allocinfo = 0x0;
-            btype->filledpages.insert(btype->allocpage);
+            pp = this->allocateFreePage(btype);
+        }
 
-            if(!btype->allocatedPages.low_utilization.empty())
-            {
-                btype->allocpage = *(btype->allocatedPages.low_utilization.begin());
-                btype->allocatedPages.low_utilization.erase(btype->evacuatepage);
-            }
-            else if(!btype->allocatedPages.mid_utilization.empty())
-            {
-                btype->allocpage = btype->allocatedPages.mid_utilization.front();
-                btype->allocatedPages.mid_utilization.pop_front();
-            }
-            else
-            {
-                btype->allocpage = this->allocateFreePage(btype);
-            }
+        return pp;
+    }
+    
+    //Only called between collections (no nursery blocks in use) -- surplus blocks become free pages and new ones are taken like any other empty block
+    void resizeNursery(size_t count)
+    {
+        assert(this->nursery_next == 0);
+
+        while(this->nursery.size() > count)
+        {
+            this->free_pages.insert(this->nursery.back());
+            this->nursery.pop_back();
+        }
+
+        while(this->nursery.size() < count)
+        {
+            PageInfo* pp = this->takeEmptyBlock(true);
+
+            this->unlinkPageFromType(pp);
+            this->nursery.push_back(pp);
         }
-        btype->allocpage->allocinfo = AllocPageInfo_Alloc;
+    }
+
+    inline bool isNurseryFull() const
+    {
+        return this->nursery_next == this->nursery.size();
+    }
+
+    void takeNurseryBlockForAllocation(BSQType* btype)
+    {
+        PageInfo* pp = this->nursery[this->nursery_next];
+        this->nursery_next++;
+
+        this->initializeFreshPageForType(pp, btype);
+        pp->freelist = nullptr;
+        pp->freelist_count = 0;
+        pp->allocinfo = AllocPageInfo_Alloc;
+
+        btype->nurserycurr = (uint8_t*)pp->data;
+        btype->nurseryend = (uint8_t*)pp->data + (pp->alloc_entry_count * pp->alloc_entry_size);
+        btype->nurserymeta = pp->slots;
+    }
+
+    //Everything in the block was evacuated or is garbage -- clear it so it can be handed out again
+    void resetNurseryBlock(PageInfo* pp)
+    {
+        GC_MEM_ZERO(pp->slots, pp->alloc_entry_count * sizeof(GC_META_DATA_WORD));
+
+#ifdef ALLOC_DEBUG_MEM_INITIALIZE
+        GC_MEM_FILL(pp->data, pp->alloc_entry_count * pp->alloc_entry_size, ALLOC_DEBUG_MEM_INITIALIZE_VALUE);
+#endif
+
+        this->unlinkPageFromType(pp);
+    }
 
-        this->allocated_types.insert(btype);
+    //The block holds pinned objects and is kept as a page of its type -- a fresh block takes its place in the nursery
+    void replaceNurseryBlock(size_t idx)
+    {
+        PageInfo* pp = this->takeEmptyBlock(true);
 
-        return btype->allocpage;
+        this->unlinkPageFromType(pp);
+        this->nursery[idx] = pp;
     }
 };
 
-class Allocator
-{
-public:
-    static Allocator GlobalAllocator;
+#define GC_WORK_DEQUE_INIT_CAPACITY 1024
 
+//Chase-Lev work-stealing deque -- the owner pushes and pops at the bottom without locking and thieves take from the top with a CAS
+//Only the owner grows the buffer -- replaced buffers are kept until reset (between collections) since a thief may still be reading one
+class GCWorkDeque
+{
 private:
-    BlockAllocator blockalloc;
-    GCRefList worklist;
-    void* pendingdecs;
+    struct Buffer
+    {
+        int64_t capacity;
+        std::atomic<void*>* slots;
+    };
 
-    std::set<void*> oldroots;
-    GCRefList roots;
+    std::atomic<int64_t> top;
+    std::atomic<int64_t> bottom;
+    std::atomic<Buffer*> buffer;
+    std::vector<Buffer*> retired;
 
-    std::set<BSQCollectionIterator*> activeiters;
+    static Buffer* allocateBuffer(int64_t capacity)
+    {
+        return new Buffer{capacity, new std::atomic<void*>[capacity]};
+    }
 
-    //"cost" to get a new page -- pay by doing defered decs, processing pages, or (later running some scavanging if needed)
-    //    can adjust to make sure we keep up with alloc/free -- but start out with a cost of 2
-    size_t page_cost;
-    size_t dec_ops_count;
-    size_t post_release_dec_ops_count;
-    size_t current_allocated_bytes;
+    static void freeBuffer(Buffer* bb)
+    {
+        delete[] bb->slots;
+        delete bb;
+    }
 
-#ifdef ENABLE_MEM_STATS
-    size_t gccount;
-    std::list<GeneralMemoryStats> heap_stats;
-#endif
+    Buffer* grow(Buffer* bb, int64_t b, int64_t t)
+    {
+        Buffer* nb = GCWorkDeque::allocateBuffer(bb->capacity * 2);
+        for(int64_t i = t; i < b; ++i)
+        {
+            nb->slots[i & (nb->capacity - 1)].store(bb->slots[i & (bb->capacity - 1)].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        this->retired.push_back(bb);
+        this->buffer.store(nb, std::memory_order_release);
+        return nb;
+    }
 
 public:
-    inline void processIncHeapRC(GC_META_DATA_WORD* addr, GC_META_DATA_WORD meta, void* fromObj)
+    GCWorkDeque() : top(0), bottom(0), buffer(GCWorkDeque::allocateBuffer(GC_WORK_DEQUE_INIT_CAPACITY)), retired() {;}
+
+    ~GCWorkDeque()
     {
-        if(GC_RC_IS_COUNT(meta))
+        this->reset();
+        GCWorkDeque::freeBuffer(this->buffer.load(std::memory_order_relaxed));
+    }
+
+    //Owner only -- and only when no thief can be looking at the deque
+    void reset()
+    {
+        for(size_t i = 0; i < this->retired.size(); ++i)
         {
-            GC_STORE_META_DATA_WORD(addr, GC_INC_RC_COUNT(meta));
+            GCWorkDeque::freeBuffer(this->retired[i]);
         }
-        else
+        this->retired.clear();
+    }
+
+    void push(void* obj)
+    {
+        int64_t b = this->bottom.load(std::memory_order_relaxed);
+        int64_t t = this->top.load(std::memory_order_acquire);
+        Buffer* bb = this->buffer.load(std::memory_order_relaxed);
+
+        if(b - t > bb->capacity - 1)
         {
-            if(GC_IS_ZERO_RC(meta))
-            {
-                GC_STORE_META_DATA_WORD(addr, GC_RC_SET_PARENT(meta, fromObj));
-            }
-            else
-            {
-                GC_STORE_META_DATA_WORD(addr, GC_ALLOCATED_BIT | (GC_RC_KIND_MASK | GC_RC_TWO) | (meta & GC_MARK_BIT));
-            }
+            bb = this->grow(bb, b, t);
         }
+
+        bb->slots[b & (bb->capacity - 1)].store(obj, std::memory_order_relaxed);
+        this->bottom.store(b + 1, std::memory_order_release);
     }
 
-    inline void processDecHeapRC(GC_META_DATA_WORD* addr, GC_META_DATA_WORD meta) 
+    bool pop(void*& obj)
     {
-        if(GC_RC_IS_COUNT(meta))
+        int64_t b = this->bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* bb = this->buffer.load(std::memory_order_relaxed);
+
+        //the store of bottom must be visible before top is read (this is what the seq_cst pair with steal is for)
+        this->bottom.store(b, std::memory_order_seq_cst);
+        int64_t t = this->top.load(std::memory_order_seq_cst);
+
+        if(t > b)
         {
-            auto w = GC_DEC_RC_COUNT(meta);
-            if(GC_IS_ZERO_RC(w))
+            this->bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        obj = bb->slots[b & (bb->capacity - 1)].load(std::memory_order_relaxed);
+        if(t != b)
+        {
+            return true;
+        }
+
+        //last entry -- race any thief for it
+        bool won = this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        this->bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    bool steal(void*& obj)
+    {
+        int64_t t = this->top.load(std::memory_order_seq_cst);
+        int64_t b = this->bottom.load(std::memory_order_seq_cst);
+        if(t >= b)
+        {
+            return false;
+        }
+
+        Buffer* bb = this->buffer.load(std::memory_order_acquire);
+        obj = bb->slots[t & (bb->capacity - 1)].load(std::memory_order_relaxed);
+        return this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+};
+
+//A thread of the parallel collector -- it works from the bottom of its deque while idle workers steal from the top
+class GCWorker
+{
+public:
+    size_t id;
+
+    GCWorkDeque work;
+
+    //the page (of each type) this worker evacuates into -- no other worker allocates from it
+    std::unordered_map<BSQType*, PageInfo*> evacpages;
+    size_t survivedbytes;
+
+    GCWorker(size_t id) : id(id), work(), evacpages(), survivedbytes(0) {;}
+
+    void push(void* obj)
+    {
+        this->work.push(obj);
+    }
+
+    bool pop(void*& obj)
+    {
+        return this->work.pop(obj);
+    }
+
+    bool steal(void*& obj)
+    {
+        return this->work.steal(obj);
+    }
+};
+
+//Sizes the nursery (the collection trigger) and the decrement budgets from what previous collections measured
+class GCSizingPolicy
+{
+public:
+    //target (not a guarantee) for the time a collection spends tracing and evacuating
+    double maxpausems;
+
+    //the nursery may grow to this fraction of the (old) heap that survived earlier collections
+    double headroom;
+
+    //hard limit on the memory the heap holds (old space and nursery) -- 0 for none
+    size_t maxheapbytes;
+
+    //fraction of the nursery that survives a collection, trace time per surviving byte, and time per deferred decrement
+    double survivalrate;
+    double tracensperbyte;
+    double nsperdec;
+
+    GCSizingPolicy() : maxpausems(DEFAULT_GC_MAX_PAUSE_MS), headroom(DEFAULT_GC_HEAP_HEADROOM), maxheapbytes(0), survivalrate(0.0), tracensperbyte(0.0), nsperdec(0.0) {;}
+
+    inline static double smooth(double prev, double curr)
+    {
+        return (prev == 0.0) ? curr : ((1.0 - GC_SIZING_SMOOTHING) * prev + GC_SIZING_SMOOTHING * curr);
+    }
+
+    void recordTrace(size_t nurserybytes, size_t survivedbytes, double tracens)
+    {
+        if(nurserybytes == 0)
+        {
+            return;
+        }
+
+        this->survivalrate = GCSizingPolicy::smooth(this->survivalrate, (double)survivedbytes / (double)nurserybytes);
+        if(survivedbytes != 0)
+        {
+            this->tracensperbyte = GCSizingPolicy::smooth(this->tracensperbyte, tracens / (double)survivedbytes);
+        }
+    }
+
+    void recordDecs(size_t decs, double decns)
+    {
+        if(decs != 0)
+        {
+            this->nsperdec = GCSizingPolicy::smooth(this->nsperdec, decns / (double)decs);
+        }
+    }
+
+    //As large as the headroom allows unless the survivors of a nursery that size would take longer than the pause target to trace (or it would not fit under the limit)
+    size_t computeNurseryBlocks(size_t currblocks, size_t oldbytes) const
+    {
+        //small heaps keep the default threshold -- only the pause target and the limit take it lower
+        double trgtbytes = std::max(this->headroom * (double)oldbytes, (double)BSQ_COLLECT_THRESHOLD);
+        if((this->survivalrate > 0.0) & (this->tracensperbyte > 0.0))
+        {
+            trgtbytes = std::min(trgtbytes, (this->maxpausems * 1000000.0) / (this->survivalrate * this->tracensperbyte));
+        }
+
+        //a small limit can take the nursery under its usual minimum (the caller checks there is room for at least one block)
+        size_t minblocks = BSQ_NURSERY_MIN_BLOCK_COUNT;
+        if(this->maxheapbytes != 0)
+        {
+            trgtbytes = std::min(trgtbytes, (double)this->maxheapbytes - (double)oldbytes);
+            minblocks = std::clamp((this->maxheapbytes - oldbytes) / BSQ_BLOCK_ALLOCATION_SIZE, (size_t)1, minblocks);
+        }
+
+        //grow at most 2x per collection so one unusual cycle does not balloon the heap
+        size_t blocks = (size_t)(std::max(trgtbytes, 0.0) / (double)BSQ_BLOCK_ALLOCATION_SIZE);
+        blocks = std::min(blocks, 2 * currblocks);
+
+        return std::clamp(blocks, minblocks, (size_t)BSQ_NURSERY_MAX_BLOCK_COUNT);
+    }
+
+    //Batches of decrements run right after a collection -- whatever is left of the pause target after the trace
+    size_t computePostCollectDecCredits(double tracens, size_t decopscount) const
+    {
+        if(this->nsperdec == 0.0)
+        {
+            return DEFAULT_POST_COLLECT_RUN_DECS_COST;
+        }
+
+        double budgetns = std::max(this->maxpausems * 1000000.0 - tracens, 0.0);
+        return std::max((size_t)1, (size_t)(budgetns / (this->nsperdec * (double)decopscount)));
+    }
+
+    //Batches of decrements run per nursery block taken -- enough to clear the backlog before the nursery fills again
+    size_t computePageCost(size_t backlog, size_t nurseryblocks, size_t decopscount) const
+    {
+        size_t perblock = nurseryblocks * decopscount;
+        return std::clamp((backlog + perblock - 1) / perblock, (size_t)DEFAULT_PAGE_COST, (size_t)MAX_PAGE_COST);
+    }
+};
+
+class Allocator
+{
+public:
+    static Allocator GlobalAllocator;
+
+    //The worker the current thread is running as in a parallel collection (nullptr otherwise)
+    static thread_local GCWorker* g_gcworker;
+
+    //Set while an entrypoint call is running -- going over the heap limit then aborts that call (like any other runtime abort) instead of the process
+    static bool g_heaplimitabortable;
+    [[noreturn]] static void failHeapLimit(size_t livebytes, size_t limitbytes);
+
+private:
+    BlockAllocator blockalloc;
+    GCRefList worklist;
+    void* pendingdecs;
+    size_t pendingdeccount;
+
+    std::set<void*> oldroots;
+    GCRefList roots;
+
+    std::set<BSQCollectionIterator*> activeiters;
+
+    //objects rebuilt by the loader that are not yet reachable from the globals (e.g. while a snapshot is restored)
+    std::vector<void*> loadroots;
+
+    //"cost" to get a new page -- pay by doing defered decs, processing pages, or (later running some scavanging if needed)
+    //    can adjust to make sure we keep up with alloc/free -- but start out with a cost of 2
+    size_t page_cost;
+    size_t dec_ops_count;
+    size_t post_release_dec_ops_count;
+
+    GCSizingPolicy sizing;
+
+    //bytes evacuated (or pinned) by the current collection
+    size_t gcsurvivedbytes;
+
+    //number of threads that trace the heap and sweep the nursery -- with 1 the collector runs sequentially on the mutator thread
+    size_t collectorthreads;
+    std::vector<GCWorker*> gcworkers;
+
+    //objects pushed on some worker's worklist that have not been fully processed yet -- the trace is done when this is 0
+    std::atomic<size_t> gcpending;
+
+    //workers get evacuation pages from the (shared) block allocator
+    std::mutex gcpagelock;
+
+    //Threads for workers 1..n-1 live as long as the worker set -- they park on gcpoolcv and each parallel phase hands them gcpooltask (worker 0 is the collecting thread)
+    std::vector<std::thread> gcpool;
+    std::mutex gcpoollock;
+    std::condition_variable gcpoolcv;
+    std::condition_variable gcpooldonecv;
+    std::function<void(GCWorker*)> gcpooltask;
+    uint64_t gcpoolepoch;
+    size_t gcpoolbusy;
+    bool gcpoolstop;
+
+    //Optional thread that drains pendingdecs between collections -- it holds declock only to detach a batch (and sets decbatchactive until the batch is freed)
+    //collections hold declock throughout and wait for any detached batch to finish before they touch the heap
+    std::thread decworker;
+    bool decworkerstop;
+    bool decbatchactive;
+    std::mutex declock;
+    std::condition_variable deccv;
+
+#ifdef ENABLE_MEM_STATS
+    size_t gccount;
+    std::list<GeneralMemoryStats> heap_stats;
+#endif
+
+public:
+    inline static GC_META_DATA_WORD incHeapRCWord(GC_META_DATA_WORD meta, void* fromObj)
+    {
+        if(GC_RC_IS_COUNT(meta))
+        {
+            return GC_INC_RC_COUNT(meta);
+        }
+        else
+        {
+            if(GC_IS_ZERO_RC(meta))
+            {
+                return GC_RC_SET_PARENT(meta, fromObj);
+            }
+            else
+            {
+                return GC_ALLOCATED_BIT | (GC_RC_KIND_MASK | GC_RC_TWO) | (meta & GC_MARK_BIT);
+            }
+        }
+    }
+
+    inline void processIncHeapRC(GC_META_DATA_WORD* addr, GC_META_DATA_WORD meta, void* fromObj)
+    {
+        GC_STORE_META_DATA_WORD(addr, Allocator::incHeapRCWord(meta, fromObj));
+    }
+
+    inline static void processIncHeapRCAtomic(GC_META_DATA_WORD* addr, void* fromObj)
+    {
+        std::atomic<GC_META_DATA_WORD>* aw = GC_ATOMIC_META_DATA_WORD(addr);
+
+        GC_META_DATA_WORD w = aw->load(std::memory_order_acquire);
+        while(!aw->compare_exchange_weak(w, Allocator::incHeapRCWord(w, fromObj), std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            ;
+        }
+    }
+
+    inline void processDecHeapRC(GC_META_DATA_WORD* addr, GC_META_DATA_WORD meta) 
+    {
+        if(GC_RC_IS_COUNT(meta))
+        {
+            auto w = GC_DEC_RC_COUNT(meta);
+            if(GC_IS_ZERO_RC(w))
             {
                 GC_STORE_META_DATA_WORD(addr, w & ~GC_RC_KIND_MASK);
             }
@@ -684,6 +1253,7 @@ public:
         GC_STORE_META_DATA_WORD(addr, GC_SET_DEC_LIST(this->pendingdecs));
 
         this->pendingdecs = obj;
+        this->pendingdeccount++;
     }
 
     inline void processDecHeapRC(void* obj)
@@ -722,8 +1292,9 @@ public:
 
                 this->roots.enque(resolvedobj);
 
+                //an old object's children were counted when it became old -- tracing them again would leak them
                 auto ometa = GET_TYPE_META_DATA(resolvedobj);
-                if(!ometa->isLeaf())
+                if(!ometa->isLeaf() & GC_IS_YOUNG(w))
                 {
                     this->worklist.enque(resolvedobj);
                 }
@@ -752,6 +1323,7 @@ public:
     {
         void* nobj = this->allocateEvacuate(ometa);
         GC_MEM_COPY(nobj, obj, ometa->allocinfo.heapsize);
+        this->gcsurvivedbytes += ometa->tableEntrySize;
         
         GC_META_DATA_WORD* naddr = GC_GET_META_DATA_ADDR(nobj);
         GC_STORE_META_DATA_WORD(naddr, GC_RC_SET_PARENT(*naddr, fromObj));
@@ -759,6 +1331,44 @@ public:
         return nobj;
     }
 
+    uint8_t* allocateEvacuateParallel(BSQType* mdata, GCWorker* wk)
+    {
+        PageInfo*& pp = wk->evacpages[mdata];
+        if((pp == nullptr) || (pp->freelist == nullptr))
+        {
+            std::lock_guard<std::mutex> lg(this->gcpagelock);
+            if(pp != nullptr)
+            {
+                pp->allocinfo = 0x0;
+                mdata->allocatedPages.high_utilization.insert(pp);
+            }
+
+            pp = this->blockalloc.takePageForEvacuation(mdata);
+            pp->allocinfo = AllocPageInfo_Ev;
+        }
+
+        uint8_t* alloc = (uint8_t*)pp->freelist;
+        *((GC_META_DATA_WORD*)(*((void**)pp->freelist + 1))) = GC_ALLOCATED_BIT;
+
+        pp->freelist = *((void**)pp->freelist);
+        pp->freelist_count--;
+
+        return alloc;
+    }
+
+    //Another worker forwarded the object first -- the copy goes back on the (worker owned) page it came from
+    void releaseEvacuateParallel(void* nobj)
+    {
+        PageInfo* pp = PAGE_MASK_EXTRACT_ADDR(nobj);
+        GC_META_DATA_WORD* naddr = GC_GET_META_DATA_ADDR_AND_PAGE(nobj, pp);
+        GC_STORE_META_DATA_WORD(naddr, 0x0);
+
+        *((void**)nobj) = pp->freelist;
+        *((void**)nobj + 1) = naddr;
+        pp->freelist = nobj;
+        pp->freelist_count++;
+    }
+
     inline void processHeapEvacuateChildViaUnique(void** slot, void* oobj, void* nobj)
     {
         GC_META_DATA_WORD* addr = GC_GET_META_DATA_ADDR(*slot);
@@ -783,8 +1393,56 @@ public:
         }
     }
 
+    //Workers race to forward young objects -- the one whose CAS installs the forwarding pointer owns the copy and traces it
+    static void gcProcessSlotHeapParallel(void** slot, void* fromObj, GCWorker* wk)
+    {
+        GC_META_DATA_WORD* addr = GC_GET_META_DATA_ADDR(*slot);
+        std::atomic<GC_META_DATA_WORD>* aw = GC_ATOMIC_META_DATA_WORD(addr);
+        GC_META_DATA_WORD w = aw->load(std::memory_order_acquire);
+
+        if(!GC_IS_FWD_PTR(w) & !GC_IS_MARKED(w) & GC_IS_YOUNG(w))
+        {
+            PageInfo* pp = PAGE_MASK_EXTRACT_ADDR(*slot);
+            auto ometa = pp->btype;
+
+            void* nobj = Allocator::GlobalAllocator.allocateEvacuateParallel(ometa, wk);
+            GC_MEM_COPY(nobj, *slot, ometa->allocinfo.heapsize);
+
+            GC_META_DATA_WORD* naddr = GC_GET_META_DATA_ADDR(nobj);
+            GC_STORE_META_DATA_WORD(naddr, GC_RC_SET_PARENT(*naddr, fromObj));
+
+            if(aw->compare_exchange_strong(w, GC_SET_FWD_PTR(nobj), std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                *slot = nobj;
+                wk->survivedbytes += ometa->tableEntrySize;
+                if(!ometa->isLeaf())
+                {
+                    Allocator::GlobalAllocator.enqueParallel(wk, nobj);
+                }
+                return;
+            }
+
+            //w is now the forwarding pointer the winning worker installed
+            Allocator::GlobalAllocator.releaseEvacuateParallel(nobj);
+        }
+
+        if(GC_IS_FWD_PTR(w))
+        {
+            *slot = GC_GET_FWD_PTR(w);
+            addr = GC_GET_META_DATA_ADDR(*slot);
+        }
+
+        Allocator::processIncHeapRCAtomic(addr, fromObj);
+    }
+
     inline static void gcProcessSlotHeap(void** slot, void* fromObj)
     {
+        if(Allocator::g_gcworker != nullptr)
+        {
+            Allocator::gcProcessSlotHeapParallel(slot, fromObj, Allocator::g_gcworker);
+            return;
+        }
+
         GC_META_DATA_WORD* addr = GC_GET_META_DATA_ADDR(*slot);
         GC_META_DATA_WORD w = GC_LOAD_META_DATA_WORD(addr);
         
@@ -926,7 +1584,7 @@ public:
                 case PTR_FIELD_MASK_NOP:
                     break;
                 case PTR_FIELD_MASK_PTR:
-                    Allocator::GlobalAllocator.processDecHeapRC(cslot);
+                    Allocator::GlobalAllocator.processDecHeapRC(*cslot);
                     break;
                 case PTR_FIELD_MASK_STRING:
                     Allocator::gcDecrementString(cslot);
@@ -1086,9 +1744,10 @@ public:
         {            
             this->blockalloc.unlinkPageFromType(pp);
             this->blockalloc.free_pages.insert(pp);
+            return;
         }
         
-        auto utilization = (1.0f - (float)pp->freelist_count) / (float)pp->alloc_entry_count;
+        auto utilization = 1.0f - ((float)pp->freelist_count / (float)pp->alloc_entry_count);
         pp->allocinfo = 0x0;
 
         if(utilization > OCCUPANCY_MID_HIGH_BREAK)
@@ -1164,12 +1823,39 @@ public:
 private:
     ////////
     //GC algorithm
-    void processRoots()
+    void processStackRange(uint8_t* from, uint8_t* to)
     {
-        for(uint8_t* curr = GCStack::sdata; curr < GCStack::stackp; curr += ICPP_WORD_SIZE)
+        for(uint8_t* curr = from; curr < to; curr += ICPP_WORD_SIZE)
         {
             this->gcCopyRoots(*((uintptr_t*)curr));
         }
+    }
+
+    void processStackFramePrecise(uint8_t* frame, const GCStackFrameMap* fmap)
+    {
+        for(size_t i = 0; i < fmap->refruns.size(); ++i)
+        {
+            this->processStackRange(frame + fmap->refruns[i].first, frame + fmap->refruns[i].first + fmap->refruns[i].second);
+        }
+    }
+
+    void processRoots()
+    {
+        //body frames are walked with their stack maps and only the scratch space between them is scanned word by word
+        uint8_t* curr = GCStack::sdata;
+        for(size_t i = 0; i < GCStack::framemapcount; ++i)
+        {
+            const GCStackMappedFrame& mf = GCStack::framemaps[i];
+            if(mf.frame < curr || GCStack::stackp < (mf.frame + mf.fmap->bytes))
+            {
+                continue; //not (or no longer) a live frame -- whatever is there gets the conservative scan
+            }
+
+            this->processStackRange(curr, mf.frame);
+            this->processStackFramePrecise(mf.frame, mf.fmap);
+            curr = mf.frame + mf.fmap->bytes;
+        }
+        this->processStackRange(curr, GCStack::stackp);
 
         for(auto iter = this->activeiters.begin(); iter != this->activeiters.end(); iter++)
         {
@@ -1181,6 +1867,11 @@ private:
             }
         }
 
+        for(size_t i = 0; i < this->loadroots.size(); ++i)
+        {
+            this->gcCopyRoots((uintptr_t)this->loadroots[i]);
+        }
+
         void* groot = GCStack::global_memory->data;
 
         if(GCStack::global_init_complete)
@@ -1212,6 +1903,157 @@ private:
         }
     }
 
+    void enqueParallel(GCWorker* wk, void* obj)
+    {
+        this->gcpending.fetch_add(1, std::memory_order_acq_rel);
+        wk->push(obj);
+    }
+
+    bool stealWork(GCWorker* wk, void*& obj)
+    {
+        for(size_t i = 1; i < this->gcworkers.size(); ++i)
+        {
+            GCWorker* victim = this->gcworkers[(wk->id + i) % this->gcworkers.size()];
+            if(victim->steal(obj))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void runCollectorWorker(GCWorker* wk)
+    {
+        Allocator::g_gcworker = wk;
+
+        void* obj = nullptr;
+        while(true)
+        {
+            if(wk->pop(obj) || this->stealWork(wk, obj))
+            {
+                const BSQType* umeta = PAGE_MASK_EXTRACT_ADDR(obj)->btype;
+                assert(umeta->allocinfo.heapmask != nullptr);
+
+                Allocator::gcProcessSlotsWithMask((void**)obj, obj, umeta->allocinfo.heapmask);
+
+                //only counted as done after its children are enqueued so pending cannot hit 0 while there is still work
+                this->gcpending.fetch_sub(1, std::memory_order_acq_rel);
+            }
+            else if(this->gcpending.load(std::memory_order_acquire) == 0)
+            {
+                break;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        Allocator::g_gcworker = nullptr;
+    }
+
+    void runCollectorPoolThread(GCWorker* wk)
+    {
+        uint64_t seen = 0;
+
+        std::unique_lock<std::mutex> lk(this->gcpoollock);
+        while(true)
+        {
+            this->gcpoolcv.wait(lk, [this, &seen]() { return this->gcpoolstop | (this->gcpoolepoch != seen); });
+            if(this->gcpoolstop)
+            {
+                break;
+            }
+
+            seen = this->gcpoolepoch;
+            lk.unlock();
+
+            //the task is not replaced until every pool thread has reported back
+            this->gcpooltask(wk);
+
+            lk.lock();
+            this->gcpoolbusy--;
+            if(this->gcpoolbusy == 0)
+            {
+                this->gcpooldonecv.notify_one();
+            }
+        }
+    }
+
+    //Run task on every worker (this thread as worker 0) and return once all of them have finished it
+    void runOnCollectorPool(std::function<void(GCWorker*)> task)
+    {
+        {
+            std::lock_guard<std::mutex> lg(this->gcpoollock);
+            this->gcpooltask = task;
+            this->gcpoolbusy = this->gcpool.size();
+            this->gcpoolepoch++;
+        }
+        this->gcpoolcv.notify_all();
+
+        task(this->gcworkers[0]);
+
+        std::unique_lock<std::mutex> lk(this->gcpoollock);
+        this->gcpooldonecv.wait(lk, [this]() { return this->gcpoolbusy == 0; });
+        this->gcpooltask = nullptr;
+    }
+
+    void startCollectorPool()
+    {
+        this->gcpoolstop = false;
+        for(size_t i = 1; i < this->gcworkers.size(); ++i)
+        {
+            this->gcpool.emplace_back(&Allocator::runCollectorPoolThread, this, this->gcworkers[i]);
+        }
+    }
+
+    void stopCollectorPool()
+    {
+        {
+            std::lock_guard<std::mutex> lg(this->gcpoollock);
+            this->gcpoolstop = true;
+        }
+        this->gcpoolcv.notify_all();
+
+        for(size_t i = 0; i < this->gcpool.size(); ++i)
+        {
+            this->gcpool[i].join();
+        }
+        this->gcpool.clear();
+    }
+
+    void processHeapParallel()
+    {
+        //the roots found by the stack scan are dealt out to the workers as their starting work (the pool is parked so the deques are not being used yet)
+        size_t rpos = 0;
+        while(!this->worklist.empty())
+        {
+            this->enqueParallel(this->gcworkers[rpos % this->gcworkers.size()], this->worklist.deque());
+            rpos++;
+        }
+
+        this->runOnCollectorPool([this](GCWorker* wk) {
+            this->runCollectorWorker(wk);
+        });
+
+        //the pages the workers evacuated into go back to their types like any other swept page
+        for(size_t i = 0; i < this->gcworkers.size(); ++i)
+        {
+            this->gcworkers[i]->work.reset();
+
+            for(auto piter = this->gcworkers[i]->evacpages.begin(); piter != this->gcworkers[i]->evacpages.end(); piter++)
+            {
+                piter->second->allocinfo = 0x0;
+                this->postsweep_processing(piter->second);
+            }
+            this->gcworkers[i]->evacpages.clear();
+
+            this->gcsurvivedbytes += this->gcworkers[i]->survivedbytes;
+            this->gcworkers[i]->survivedbytes = 0;
+        }
+    }
+
     void checkMaybeZeroCounts()
     {
         for(auto iter = this->oldroots.cbegin(); iter != this->oldroots.cend(); iter++)
@@ -1223,6 +2065,7 @@ private:
             {
                 GC_STORE_META_DATA_WORD(addr, GC_SET_DEC_LIST(this->pendingdecs));
                 this->pendingdecs = *iter;
+                this->pendingdeccount++;
             }
         }
         this->oldroots.clear();
@@ -1284,6 +2127,11 @@ private:
     {
         for(auto piter = this->blockalloc.page_set.cbegin(); piter != this->blockalloc.page_set.cend(); piter++)
         {
+            if(((*piter)->allocinfo & AllocPageInfo_Alloc) != 0x0)
+            {
+                continue; //nursery blocks are bump allocated and have no freelist
+            }
+
             GC_META_DATA_WORD* metacurr = (*piter)->slots;
 
             uint64_t freecount = 0;
@@ -1320,54 +2168,198 @@ private:
         return GeneralMemoryStats{this->blockalloc.page_set.size(), this->blockalloc.free_pages.size(), live_bytes};
     }
 
+    //Free the head of a dec list and return the rest of the list
+    void* releaseDecObject(void* decobj)
+    {
+#ifdef ALLOC_DEBUG_CANARY
+        BlockAllocator::checkCanary(decobj);
+#endif
+
+        PageInfo* pp = PAGE_MASK_EXTRACT_ADDR(decobj);
+        GC_META_DATA_WORD* addr = GC_GET_META_DATA_ADDR_AND_PAGE(decobj, pp);
+
+        void* next = GC_GET_DEC_LIST(*addr);
+
+        //the object's own fields are released (fpDecObj releases what a slot of the type refers to)
+        if(pp->btype->allocinfo.heapmask != nullptr)
+        {
+            Allocator::gcDecSlotsWithMask((void**)decobj, pp->btype->allocinfo.heapmask);
+        }
+
+        GC_STORE_META_DATA_WORD(addr, 0x0);
+
+        *((void**)decobj) = pp->freelist;
+        *((void**)decobj + 1) = addr;
+        pp->freelist = decobj;
+        pp->freelist_count++;
+        this->postdec_processing(pp);
+
+        return next;
+    }
+
     void processPendingDecs(uint32_t credits)
     {
         for(uint32_t i = 0; i < credits && this->pendingdecs != nullptr; ++i)
         {
-            for(size_t j = 0; j < this->dec_ops_count && this->pendingdecs != nullptr; ++i)
+            for(size_t j = 0; j < this->dec_ops_count && this->pendingdecs != nullptr; ++j)
             {
+                //popped before it is released since children whose counts drop to zero are pushed on the front of the list
                 void* decobj = this->pendingdecs;
+                this->pendingdecs = GC_GET_DEC_LIST(*GC_GET_META_DATA_ADDR(decobj));
+                this->pendingdeccount--;
 
-#ifdef ALLOC_DEBUG_CANARY
-                BlockAllocator::checkCanary(decobj);
-#endif
+                this->releaseDecObject(decobj);
+            }
+        }
+    }
 
-                PageInfo* pp = PAGE_MASK_EXTRACT_ADDR(decobj);
-                GC_META_DATA_WORD* addr = GC_GET_META_DATA_ADDR_AND_PAGE(decobj, pp);
+    //Split off (up to) one batch from the front of pendingdecs -- the returned list is terminated so it can be freed without touching pendingdecs
+    void* detachPendingDecBatch()
+    {
+        void* batch = this->pendingdecs;
 
-                this->pendingdecs = GC_GET_DEC_LIST(*addr);
-                pp->btype->gcops.fpDecObj(pp->btype, (void**)decobj);
+        void* last = nullptr;
+        for(size_t j = 0; j < this->dec_ops_count && this->pendingdecs != nullptr; ++j)
+        {
+            last = this->pendingdecs;
+            this->pendingdecs = GC_GET_DEC_LIST(*GC_GET_META_DATA_ADDR(last));
+            this->pendingdeccount--;
+        }
 
-                GC_STORE_META_DATA_WORD(addr, 0x0);
+        if(last != nullptr)
+        {
+            GC_META_DATA_WORD* addr = GC_GET_META_DATA_ADDR(last);
+            GC_STORE_META_DATA_WORD(addr, GC_SET_DEC_LIST(nullptr));
+        }
 
-                *((void**)decobj) = pp->freelist;
-                *((void**)decobj + 1) = addr;
-                pp->freelist = decobj;
-                pp->freelist_count++;
-                this->postdec_processing(pp);
+        return batch;
+    }
+
+    inline static bool hasPinnedObjects(PageInfo* pp)
+    {
+        for(uint64_t i = 0; i < pp->alloc_entry_count; ++i)
+        {
+            GC_META_DATA_WORD w = pp->slots[i];
+            if(!GC_IS_FWD_PTR(w) & GC_IS_ALLOCATED(w) & GC_IS_LIVE(w))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    //Blocks only touch their own page so ranges of the nursery can be checked and reset by different threads
+    void sweepNurseryRange(size_t from, size_t to, std::vector<uint8_t>& pinned)
+    {
+        for(size_t i = from; i < to; ++i)
+        {
+            PageInfo* pp = this->blockalloc.nursery[i];
+
+            pinned[i] = Allocator::hasPinnedObjects(pp);
+            if(!pinned[i])
+            {
+                this->blockalloc.resetNurseryBlock(pp);
             }
         }
     }
 
-    void processBlocks(BSQType* mdata)
+    //Survivors have all been evacuated except for (root) pinned objects -- blocks with any of these become regular pages of their type and the rest are reset
+    void processNursery()
     {
-        if(mdata->allocpage != &AllocPages::g_sential_page)
+        size_t ncount = this->blockalloc.nursery_next;
+        for(size_t i = 0; i < ncount; ++i)
         {
-            this->processFilledPage(mdata, mdata->allocpage);
+            BSQType* btype = this->blockalloc.nursery[i]->btype;
+
+            btype->nurserycurr = nullptr;
+            btype->nurseryend = nullptr;
+            btype->nurserymeta = nullptr;
         }
 
-        for(auto iter = mdata->filledpages.begin(); iter != mdata->filledpages.end(); ++iter)
+        std::vector<uint8_t> pinned(ncount, 0);
+        if(this->collectorthreads <= 1)
         {
-            this->processFilledPage(mdata, *iter);
+            this->sweepNurseryRange(0, ncount, pinned);
+        }
+        else
+        {
+            size_t rsize = (ncount + this->collectorthreads - 1) / this->collectorthreads;
+
+            this->runOnCollectorPool([this, ncount, rsize, &pinned](GCWorker* wk) {
+                this->sweepNurseryRange(std::min(ncount, wk->id * rsize), std::min(ncount, (wk->id + 1) * rsize), pinned);
+            });
+        }
+
+        //keeping a block moves it into its type's page lists so this part stays on one thread
+        for(size_t i = 0; i < ncount; ++i)
+        {
+            if(pinned[i])
+            {
+                PageInfo* pp = this->blockalloc.nursery[i];
+
+                pp->allocinfo = 0x0;
+                this->processFilledPage(pp->btype, pp);
+                this->gcsurvivedbytes += (pp->alloc_entry_count - pp->freelist_count) * pp->alloc_entry_size;
+
+                //the objects left on the block are old now (like evacuated ones)
+                for(uint64_t j = 0; j < pp->alloc_entry_count; ++j)
+                {
+                    pp->slots[j] &= ~GC_YOUNG_BIT;
+                }
+
+                this->blockalloc.replaceNurseryBlock(i);
+            }
+        }
+
+        this->blockalloc.nursery_next = 0;
+    }
+
+    void runDecWorker()
+    {
+        std::unique_lock<std::mutex> lk(this->declock);
+        while(true)
+        {
+            this->deccv.wait(lk, [this]() { return this->decworkerstop | (this->pendingdecs != nullptr); });
+            if(this->decworkerstop)
+            {
+                break;
+            }
+
+            void* batch = this->detachPendingDecBatch();
+            this->decbatchactive = true;
+            lk.unlock();
+
+            while(batch != nullptr)
+            {
+                batch = this->releaseDecObject(batch);
+            }
+
+            lk.lock();
+            this->decbatchactive = false;
+
+            //a collection may be waiting for this batch to finish
+            this->deccv.notify_all();
         }
-        mdata->filledpages.clear();
     }
 
     void collect()
     {
+        //a running decrement worker is held (between batches) for the whole collection
+        std::unique_lock<std::mutex> lk(this->declock, std::defer_lock);
+        if(this->decworker.joinable())
+        {
+            lk.lock();
+            this->deccv.wait(lk, [this]() { return !this->decbatchactive; });
+        }
+
         MEM_STATS_OP(this->gccount++);
         MEM_STATS_OP(this->heap_stats.push_back(this->compute_mem_stats()));
 
+        auto gcstart = std::chrono::steady_clock::now();
+        size_t nurserybytes = this->blockalloc.nursery_next * BSQ_BLOCK_ALLOCATION_SIZE;
+        this->gcsurvivedbytes = 0;
+
         if(this->blockalloc.free_pages.size() > FREE_PAGE_MIN)
         {
             auto freeratio = (float)this->blockalloc.free_pages.size() / (float)this->blockalloc.page_set.size();
@@ -1376,14 +2368,7 @@ private:
                 auto ratiocount = (size_t)(this->blockalloc.free_pages.size() * FREE_PAGE_RATIO);
                 auto trgtfreecount = (FREE_PAGE_MIN < ratiocount) ? FREE_PAGE_MIN : ratiocount;
 
-                auto riter = this->blockalloc.free_pages.rend();
-                while(this->blockalloc.free_pages.size() > trgtfreecount)
-                {
-                    auto delp = *riter;
-                    riter++;
-
-                    this->blockalloc.free_pages.erase(delp);
-                }
+                this->blockalloc.releaseFreePages(trgtfreecount);
             }
         }
 
@@ -1407,66 +2392,114 @@ private:
 
         //mark and move all live objects out of new space
         this->processRoots();
-        this->processHeap();
+        if(this->collectorthreads <= 1)
+        {
+            this->processHeap();
+        }
+        else
+        {
+            this->processHeapParallel();
+        }
 
         //Look at diff in old and new roots + evac operations as starts for dec operations
         this->checkMaybeZeroCounts();
 
-        //We will take credits proportional to the newly allocated memory -- so in general most work is done in the STW phase
-        uint32_t credits = this->post_release_dec_ops_count;
-        this->processPendingDecs(credits);
+        auto tracedone = std::chrono::steady_clock::now();
+        double tracens = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(tracedone - gcstart).count();
+
+        if(this->decworker.joinable())
+        {
+            //the worker frees these once the collection releases it
+            this->deccv.notify_all();
+        }
+        else
+        {
+            size_t backlog = this->pendingdeccount;
+
+            //the credits are what the pause target has left after the trace -- the rest is paid for as nursery blocks are taken
+            uint32_t credits = (uint32_t)this->post_release_dec_ops_count;
+            this->processPendingDecs(credits);
 
 #ifdef ALLOC_DEBUG_STW_GC
-        this->processPendingDecs(COLLECT_ALL_PAGE_COST);
+            this->processPendingDecs(COLLECT_ALL_PAGE_COST);
 #endif
 
-        for(auto iter = this->blockalloc.allocated_types.begin(); iter != this->blockalloc.allocated_types.end(); ++iter)
+            double decns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tracedone).count();
+            this->sizing.recordDecs(backlog - this->pendingdeccount, decns);
+        }
+
+        this->processNursery();
+
+        this->sizing.recordTrace(nurserybytes, this->gcsurvivedbytes, tracens);
+        if(!this->updateHeapSizing(tracens))
         {
-            this->processBlocks(*iter);
+            //the collection is complete so the heap is consistent -- the worker is let go before unwinding since the longjmp skips lk's destructor
+            if(lk.owns_lock())
+            {
+                lk.unlock();
+            }
+
+            Allocator::failHeapLimit(this->oldHeapBytes(), this->sizing.maxheapbytes);
         }
-        this->blockalloc.allocated_types.clear();
     }
 
-    PageInfo* allocate_slow(BSQType* mdata)
+    size_t oldHeapBytes() const
     {
-        uint32_t credits = this->page_cost;
-        bool docollect = false;
+        return (this->blockalloc.page_set.size() - this->blockalloc.free_pages.size() - this->blockalloc.released_pages.size() - this->blockalloc.nursery.size()) * BSQ_BLOCK_ALLOCATION_SIZE;
+    }
 
-        this->current_allocated_bytes += BSQ_BLOCK_ALLOCATION_SIZE;
-        if(this->current_allocated_bytes > BSQ_COLLECT_THRESHOLD)
+    //False if the live old space leaves no room for a nursery block under the heap limit (after everything that can be freed has been)
+    bool updateHeapSizing(double tracens)
+    {
+        if(this->blockalloc.nursery.empty())
         {
-            credits = COLLECT_ALL_PAGE_COST;
-            docollect = true;
+            return true; //nothing has been allocated yet (e.g. the collection after global initialization)
+        }
 
-            if(this->pendingdecs != nullptr)
-            {
-                this->page_cost = (this->page_cost < MAX_PAGE_COST) ? (2 * this->page_cost) : MAX_PAGE_COST;
-                this->post_release_dec_ops_count = 4 * DEFAULT_POST_COLLECT_RUN_DECS_COST;
-            }
-            else
+        size_t oldbytes = this->oldHeapBytes();
+        if((this->sizing.maxheapbytes != 0) && (this->sizing.maxheapbytes < oldbytes + BSQ_BLOCK_ALLOCATION_SIZE))
+        {
+            //no room left for a nursery block -- everything that can be freed is freed before giving up
+            this->processPendingDecs(COLLECT_ALL_PAGE_COST);
+
+            oldbytes = this->oldHeapBytes();
+            if(this->sizing.maxheapbytes < oldbytes + BSQ_BLOCK_ALLOCATION_SIZE)
             {
-                this->page_cost = (this->page_cost > MAX_PAGE_COST) ? (this->page_cost / 2) : DEFAULT_PAGE_COST;
-                this->post_release_dec_ops_count = DEFAULT_POST_COLLECT_RUN_DECS_COST;
+                return false;
             }
         }
 
-        if(!docollect)
+        size_t nblocks = this->sizing.computeNurseryBlocks(this->blockalloc.nursery.size(), oldbytes);
+        this->blockalloc.resizeNursery(nblocks);
+
+        this->post_release_dec_ops_count = this->sizing.computePostCollectDecCredits(tracens, this->dec_ops_count);
+        this->page_cost = this->sizing.computePageCost(this->pendingdeccount, nblocks, this->dec_ops_count);
+
+        return true;
+    }
+
+    void allocate_slow(BSQType* mdata)
+    {
+        if(this->blockalloc.nursery.empty())
         {
-            this->processPendingDecs(credits);
+            this->blockalloc.resizeNursery(BSQ_NURSERY_BLOCK_COUNT);
         }
 
-        mdata->allocpage = this->blockalloc.processAndGetNewPageForAllocation(mdata);
-
-        if(docollect)
+        if(this->blockalloc.isNurseryFull())
         {
             this->collect();
         }
+        else if(!this->decworker.joinable())
+        {
+            //with a decrement worker releases are paid for there instead
+            this->processPendingDecs((uint32_t)this->page_cost);
+        }
 
-        return mdata->allocpage;
+        this->blockalloc.takeNurseryBlockForAllocation(mdata);
     }
 
 public:
-    Allocator() : blockalloc(), worklist(), pendingdecs(nullptr), oldroots(), roots(), activeiters(), page_cost(DEFAULT_PAGE_COST), dec_ops_count(DEFAULT_DEC_OPS_COUNT), post_release_dec_ops_count(DEFAULT_POST_COLLECT_RUN_DECS_COST)
+    Allocator() : blockalloc(), worklist(), pendingdecs(nullptr), pendingdeccount(0), oldroots(), roots(), activeiters(), loadroots(), page_cost(DEFAULT_PAGE_COST), dec_ops_count(DEFAULT_DEC_OPS_COUNT), post_release_dec_ops_count(DEFAULT_POST_COLLECT_RUN_DECS_COST), sizing(), gcsurvivedbytes(0), collectorthreads(1), gcworkers(), gcpending(0), gcpagelock(), gcpool(), gcpoollock(), gcpoolcv(), gcpooldonecv(), gcpooltask(), gcpoolepoch(0), gcpoolbusy(0), gcpoolstop(false), decworker(), decworkerstop(false), decbatchactive(false), declock(), deccv()
     {
         MEM_STATS_OP(this->gccount = 0);
         MEM_STATS_OP(this->maxheap = 0);
@@ -1474,22 +2507,98 @@ public:
 
     ~Allocator()
     {
-        ;
+        this->stopDecWorker();
+        this->stopCollectorPool();
+
+        for(size_t i = 0; i < this->gcworkers.size(); ++i)
+        {
+            delete this->gcworkers[i];
+        }
+    }
+
+    void startDecWorker()
+    {
+        if(this->decworker.joinable())
+        {
+            return;
+        }
+
+        this->decworkerstop = false;
+        this->decworker = std::thread(&Allocator::runDecWorker, this);
+
+        //must be stopped before the statics it touches (types and their page lists) are destroyed
+        std::atexit([]() { Allocator::GlobalAllocator.stopDecWorker(); });
+    }
+
+    void stopDecWorker()
+    {
+        if(!this->decworker.joinable())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lg(this->declock);
+            this->decworkerstop = true;
+        }
+        this->deccv.notify_all();
+
+        this->decworker.join();
+    }
+
+    void configureRegions(bool hugepages, bool lazyrelease)
+    {
+        this->blockalloc.hugepages = hugepages;
+        this->blockalloc.lazyrelease = lazyrelease;
+    }
+
+    PageMemoryStats getPageStats() const
+    {
+        return PageMemoryStats{this->blockalloc.regions.size(), this->blockalloc.page_set.size(), this->blockalloc.free_pages.size(), this->blockalloc.released_pages.size(), this->blockalloc.release_count};
+    }
+
+    void configureHeapSizing(double maxpausems, double headroom, size_t maxheapbytes)
+    {
+        this->sizing.maxpausems = maxpausems;
+        this->sizing.headroom = headroom;
+        this->sizing.maxheapbytes = maxheapbytes;
+    }
+
+    void setCollectorThreads(size_t count)
+    {
+        this->stopCollectorPool();
+
+        for(size_t i = 0; i < this->gcworkers.size(); ++i)
+        {
+            delete this->gcworkers[i];
+        }
+        this->gcworkers.clear();
+
+        this->collectorthreads = std::max((size_t)1, count);
+        if(this->collectorthreads > 1)
+        {
+            for(size_t i = 0; i < this->collectorthreads; ++i)
+            {
+                this->gcworkers.push_back(new GCWorker(i));
+            }
+
+            this->startCollectorPool();
+        }
     }
 
     inline uint8_t* allocateDynamic(const BSQType* mdata)
     {
-        PageInfo* pp = mdata->allocpage;
-        if(pp->freelist == nullptr)
+        BSQType* btype = const_cast<BSQType*>(mdata);
+        if(btype->nurserycurr == btype->nurseryend)
         {
-            pp = this->allocate_slow(const_cast<BSQType*>(mdata));
+            this->allocate_slow(btype);
         }
         
-        uint8_t* alloc = (uint8_t*)pp->freelist;
-        GC_INIT_YOUNG_ALLOC((GC_META_DATA_WORD*)(*((void**)pp->freelist + 1)));
+        uint8_t* alloc = btype->nurserycurr;
+        GC_INIT_YOUNG_ALLOC(btype->nurserymeta);
 
-        pp->freelist = *((void**)pp->freelist);
-        pp->freelist_count--;
+        btype->nurserycurr += btype->tableEntrySize;
+        btype->nurserymeta++;
 
         return alloc;
     }
@@ -1504,6 +2613,16 @@ public:
         this->activeiters.erase(iter);
     }
 
+    void insertLoadRoot(void* obj)
+    {
+        this->loadroots.push_back(obj);
+    }
+
+    void clearLoadRoots()
+    {
+        this->loadroots.clear();
+    }
+
     void setGlobalsMemory(const BSQType* global_type)
     {
         GCStack::global_memory = this->blockalloc.allocateFreePage(const_cast<BSQType*>(global_type));
@@ -1517,6 +2636,9 @@ public:
         GCStack::global_init_complete = true;
 
         this->collect();
+
+        //children of the globals are counted by the collection above
+        GC_STORE_META_DATA_WORD(GCStack::global_memory->slots, GC_LOAD_META_DATA_WORD(GCStack::global_memory->slots) & ~GC_YOUNG_BIT);
     }
 };
 
@@ -173,7 +173,22 @@ enum class OpCodeTag
     LeBigIntOp,
     LeRationalOp,
     LeFloatOp,
-    LeDecimalOp
+    LeDecimalOp,
+
+    //Superinstructions and optimizer ops -- these are never emitted in the bytecode and are only created by the load time passes
+    LtNatJumpCondOp,
+    LtIntJumpCondOp,
+    LeNatJumpCondOp,
+    LeIntJumpCondOp,
+    EqNatJumpCondOp,
+    EqIntJumpCondOp,
+    NeqNatJumpCondOp,
+    NeqIntJumpCondOp,
+    LoadConstAddNatOp,
+    LoadConstAddIntOp,
+    LoadEntityFieldDirectRegisterAssignOp,
+    InvokeSelfTailCallOp,
+    LoadFoldedConstOp
 };
 
 struct Argument
@@ -202,6 +217,13 @@ struct SourceInfo
 };
 SourceInfo jsonParse_SourceInfo(json j);
 
+//Cold (debugger/error reporting only) source info for an op -- kept in a side table on the invoke indexed by op position
+struct InterpOpSourceEntry
+{
+    SourceInfo sinfo;
+    std::string ssrc;
+};
+
 struct BSQGuard
 {
     int32_t gmaskoffset; 
@@ -226,26 +248,97 @@ const BSQType* jsonParse_BSQType(json j);
 BSQRecordPropertyID jsonParse_BSQRecordPropertyID(json j);
 BSQFieldID jsonParse_BSQFieldID(json j);
 SourceInfo j_sinfo(json j);
+std::string j_ssrc(json j);
 SourceInfo j_sinfoStart(json j);
 SourceInfo j_sinfoEnd(json j);
 
+//Number of (type -> resolved value) entries an op site caches before it is treated as megamorphic
+#define BSQ_INLINE_CACHE_SIZE 4
+
+//Marker for a cached lookup that resolved to "not present" (e.g. a property that the record does not have)
+#define BSQ_INLINE_CACHE_ABSENT SIZE_MAX
+
+template <typename T>
+class BSQInlineCache
+{
+public:
+    BSQTypeID tids[BSQ_INLINE_CACHE_SIZE];
+    T values[BSQ_INLINE_CACHE_SIZE];
+    uint32_t count;
+
+    BSQInlineCache() : count(0) {;}
+
+    inline bool tryLookup(BSQTypeID tid, T& value) const
+    {
+        for(uint32_t i = 0; i < this->count; ++i)
+        {
+            if(this->tids[i] == tid)
+            {
+                value = this->values[i];
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    inline bool isMegamorphic() const
+    {
+        return this->count == BSQ_INLINE_CACHE_SIZE;
+    }
+
+    //Once the cache is full the site is megamorphic and misses always go through the slow path
+    inline void tryInsert(BSQTypeID tid, T value)
+    {
+        if(!this->isMegamorphic())
+        {
+            this->tids[this->count] = tid;
+            this->values[this->count] = value;
+            this->count++;
+        }
+    }
+};
+
+//Cache line sized chunks that all ops are bump allocated out of so the ops for a body are packed contiguously in load order
+#define BSQ_OP_STORAGE_ALIGN 64ul
+#define BSQ_OP_STORAGE_CHUNK_SIZE 65536ul
+
+class InterpOpStorage
+{
+private:
+    static uint8_t* g_cpos;
+    static uint8_t* g_epos;
+
+public:
+    static void* allocate(size_t size);
+};
+
 class InterpOp
 {
 public:
     const OpCodeTag tag;
-    const SourceInfo sinfo;
-    const std::string ssrc;
 
-    InterpOp(SourceInfo sinfo, std::string ssrc, OpCodeTag tag) : tag(tag), sinfo(sinfo), ssrc(ssrc) {;}
+    InterpOp(OpCodeTag tag) : tag(tag) {;}
     virtual ~InterpOp() {;}
 
+    static void* operator new(size_t size)
+    {
+        return InterpOpStorage::allocate(size);
+    }
+
+    static void operator delete(void* op)
+    {
+        //op storage is never released individually
+        ;
+    }
+
     static InterpOp* jparse(json v);
 };
 
 class DeadFlowOp : public InterpOp
 {
 public:
-    DeadFlowOp(SourceInfo sinfo, std::string ssrc) : InterpOp(sinfo, ssrc, OpCodeTag::DeadFlowOp) {;}
+    DeadFlowOp() : InterpOp(OpCodeTag::DeadFlowOp) {;}
     virtual ~DeadFlowOp() {;}
 
     static DeadFlowOp* jparse(json v);
@@ -256,7 +349,7 @@ class AbortOp : public InterpOp
 public:
     const std::string msg;
 
-    AbortOp(SourceInfo sinfo, std::string ssrc, const std::string msg) : InterpOp(sinfo, ssrc, OpCodeTag::AbortOp), msg(msg) {;}
+    AbortOp(const std::string msg) : InterpOp(OpCodeTag::AbortOp), msg(msg) {;}
     virtual ~AbortOp() {;}
 
     static AbortOp* jparse(json v);
@@ -268,7 +361,7 @@ public:
     const Argument arg;
     const std::string msg;
 
-    AssertOp(SourceInfo sinfo, std::string ssrc, Argument arg, const std::string msg) : InterpOp(sinfo, ssrc, OpCodeTag::AssertOp), arg(arg), msg(msg) {;}
+    AssertOp(Argument arg, const std::string msg) : InterpOp(OpCodeTag::AssertOp), arg(arg), msg(msg) {;}
     virtual ~AssertOp() {;}
 
     static AssertOp* jparse(json v);
@@ -280,7 +373,7 @@ public:
     //Arg is invalid and type is nullptr if this is a break
     const Argument arg;
 
-    DebugOp(SourceInfo sinfo, std::string ssrc, Argument arg) : InterpOp(sinfo, ssrc, OpCodeTag::DebugOp), arg(arg) {;}
+    DebugOp(Argument arg) : InterpOp(OpCodeTag::DebugOp), arg(arg) {;}
     virtual ~DebugOp() {;}
 
     static DebugOp* jparse(json v);
@@ -293,7 +386,7 @@ public:
     const TargetVar trgt;
     const BSQType* oftype;
 
-    LoadUnintVariableValueOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype) : InterpOp(sinfo, ssrc, OpCodeTag::LoadUnintVariableValueOp), trgt(trgt), oftype(oftype) {;}
+    LoadUnintVariableValueOp(TargetVar trgt, const BSQType* oftype) : InterpOp(OpCodeTag::LoadUnintVariableValueOp), trgt(trgt), oftype(oftype) {;}
     virtual ~LoadUnintVariableValueOp() {;}
 
     static LoadUnintVariableValueOp* jparse(json v);
@@ -305,7 +398,7 @@ public:
     const TargetVar trgt;
     const BSQUnionType* oftype;
 
-    NoneInitUnionOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQUnionType* oftype) : InterpOp(sinfo, ssrc, OpCodeTag::NoneInitUnionOp), trgt(trgt), oftype(oftype) {;}
+    NoneInitUnionOp(TargetVar trgt, const BSQUnionType* oftype) : InterpOp(OpCodeTag::NoneInitUnionOp), trgt(trgt), oftype(oftype) {;}
     virtual ~NoneInitUnionOp() {;}
 
     static NoneInitUnionOp* jparse(json v);
@@ -318,7 +411,7 @@ public:
     const int32_t gindex;
     const bool flag;
 
-    StoreConstantMaskValueOp(SourceInfo sinfo, std::string ssrc, int32_t gmaskoffset, int32_t gindex, bool flag) : InterpOp(sinfo, ssrc, OpCodeTag::StoreConstantMaskValueOp), gmaskoffset(gmaskoffset), gindex(gindex), flag(flag) {;}
+    StoreConstantMaskValueOp(int32_t gmaskoffset, int32_t gindex, bool flag) : InterpOp(OpCodeTag::StoreConstantMaskValueOp), gmaskoffset(gmaskoffset), gindex(gindex), flag(flag) {;}
     virtual ~StoreConstantMaskValueOp() {;}
 
     static StoreConstantMaskValueOp* jparse(json v);
@@ -332,7 +425,7 @@ public:
     const Argument arg;
     const BSQStatementGuard sguard;
 
-    DirectAssignOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* intotype, Argument arg, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::DirectAssignOp), trgt(trgt), intotype(intotype), arg(arg), sguard(sguard) {;}
+    DirectAssignOp(TargetVar trgt, const BSQType* intotype, Argument arg, BSQStatementGuard sguard) : InterpOp(OpCodeTag::DirectAssignOp), trgt(trgt), intotype(intotype), arg(arg), sguard(sguard) {;}
     virtual ~DirectAssignOp() {;}
 
     static DirectAssignOp* jparse(json v);
@@ -347,7 +440,7 @@ public:
     const BSQType* fromtype;
     const BSQStatementGuard sguard;
 
-    BoxOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQUnionType* intotype, Argument arg, const BSQType* fromtype, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::BoxOp), trgt(trgt), intotype(intotype), arg(arg), fromtype(fromtype), sguard(sguard) {;}
+    BoxOp(TargetVar trgt, const BSQUnionType* intotype, Argument arg, const BSQType* fromtype, BSQStatementGuard sguard) : InterpOp(OpCodeTag::BoxOp), trgt(trgt), intotype(intotype), arg(arg), fromtype(fromtype), sguard(sguard) {;}
     virtual ~BoxOp() {;}
 
     static BoxOp* jparse(json v);
@@ -362,7 +455,7 @@ public:
     const BSQUnionType* fromtype;
     const BSQStatementGuard sguard;
 
-    ExtractOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* intotype, Argument arg, const BSQUnionType* fromtype, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::ExtractOp), trgt(trgt), intotype(intotype), arg(arg), fromtype(fromtype), sguard(sguard) {;}
+    ExtractOp(TargetVar trgt, const BSQType* intotype, Argument arg, const BSQUnionType* fromtype, BSQStatementGuard sguard) : InterpOp(OpCodeTag::ExtractOp), trgt(trgt), intotype(intotype), arg(arg), fromtype(fromtype), sguard(sguard) {;}
     virtual ~ExtractOp() {;}
 
     static ExtractOp* jparse(json v);
@@ -375,7 +468,7 @@ public:
     const Argument arg;
     const BSQType* oftype;
 
-    LoadConstOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, Argument arg, const BSQType* oftype) : InterpOp(sinfo, ssrc, OpCodeTag::LoadConstOp), trgt(trgt), arg(arg), oftype(oftype) {;}
+    LoadConstOp(TargetVar trgt, Argument arg, const BSQType* oftype) : InterpOp(OpCodeTag::LoadConstOp), trgt(trgt), arg(arg), oftype(oftype) {;}
     virtual ~LoadConstOp() {;}
 
     static LoadConstOp* jparse(json v);
@@ -389,7 +482,7 @@ public:
     const BSQUnionType* layouttype;
     const BSQTupleIndex idx;
 
-    TupleHasIndexOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, Argument arg, const BSQUnionType* layouttype, BSQTupleIndex idx) : InterpOp(sinfo, ssrc, OpCodeTag::TupleHasIndexOp), trgt(trgt), arg(arg), layouttype(layouttype), idx(idx) {;}
+    TupleHasIndexOp(TargetVar trgt, Argument arg, const BSQUnionType* layouttype, BSQTupleIndex idx) : InterpOp(OpCodeTag::TupleHasIndexOp), trgt(trgt), arg(arg), layouttype(layouttype), idx(idx) {;}
     virtual ~TupleHasIndexOp() {;}
 
     static TupleHasIndexOp* jparse(json v);
@@ -403,7 +496,7 @@ public:
     const BSQUnionType* layouttype;
     const BSQRecordPropertyID propId;
 
-    RecordHasPropertyOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, Argument arg, const BSQUnionType* layouttype, BSQRecordPropertyID propId) : InterpOp(sinfo, ssrc, OpCodeTag::RecordHasPropertyOp), trgt(trgt), arg(arg), layouttype(layouttype), propId(propId) {;}
+    RecordHasPropertyOp(TargetVar trgt, Argument arg, const BSQUnionType* layouttype, BSQRecordPropertyID propId) : InterpOp(OpCodeTag::RecordHasPropertyOp), trgt(trgt), arg(arg), layouttype(layouttype), propId(propId) {;}
     virtual ~RecordHasPropertyOp() {;}
 
     static RecordHasPropertyOp* jparse(json v);
@@ -419,7 +512,7 @@ public:
     const uint32_t slotoffset;
     const BSQTupleIndex idx;
 
-    LoadTupleIndexDirectOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, uint32_t slotoffset, BSQTupleIndex idx) : InterpOp(sinfo, ssrc, OpCodeTag::LoadTupleIndexDirectOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), slotoffset(slotoffset), idx(idx) {;}
+    LoadTupleIndexDirectOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, uint32_t slotoffset, BSQTupleIndex idx) : InterpOp(OpCodeTag::LoadTupleIndexDirectOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), slotoffset(slotoffset), idx(idx) {;}
     virtual ~LoadTupleIndexDirectOp() {;}
 
     static LoadTupleIndexDirectOp* jparse(json v);
@@ -434,7 +527,9 @@ public:
     const BSQUnionType* layouttype;
     const BSQTupleIndex idx;
 
-    LoadTupleIndexVirtualOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQUnionType* layouttype, BSQTupleIndex idx) : InterpOp(sinfo, ssrc, OpCodeTag::LoadTupleIndexVirtualOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), idx(idx) {;}
+    mutable BSQInlineCache<size_t> icache;
+
+    LoadTupleIndexVirtualOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQUnionType* layouttype, BSQTupleIndex idx) : InterpOp(OpCodeTag::LoadTupleIndexVirtualOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), idx(idx) {;}
     virtual ~LoadTupleIndexVirtualOp() {;}
 
     static LoadTupleIndexVirtualOp* jparse(json v);
@@ -451,7 +546,7 @@ public:
     const BSQTupleIndex idx;
     const BSQGuard guard;
 
-    LoadTupleIndexSetGuardDirectOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, uint32_t slotoffset, BSQTupleIndex idx, BSQGuard guard) : InterpOp(sinfo, ssrc, OpCodeTag::LoadTupleIndexSetGuardDirectOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), slotoffset(slotoffset), idx(idx), guard(guard) {;}
+    LoadTupleIndexSetGuardDirectOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, uint32_t slotoffset, BSQTupleIndex idx, BSQGuard guard) : InterpOp(OpCodeTag::LoadTupleIndexSetGuardDirectOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), slotoffset(slotoffset), idx(idx), guard(guard) {;}
     virtual ~LoadTupleIndexSetGuardDirectOp() {;}
 
     static LoadTupleIndexSetGuardDirectOp* jparse(json v);
@@ -467,7 +562,9 @@ public:
     const BSQTupleIndex idx;
     const BSQGuard guard;
 
-    LoadTupleIndexSetGuardVirtualOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQUnionType* layouttype, BSQTupleIndex idx, BSQGuard guard) : InterpOp(sinfo, ssrc, OpCodeTag::LoadTupleIndexSetGuardVirtualOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), idx(idx), guard(guard) {;}
+    mutable BSQInlineCache<size_t> icache;
+
+    LoadTupleIndexSetGuardVirtualOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQUnionType* layouttype, BSQTupleIndex idx, BSQGuard guard) : InterpOp(OpCodeTag::LoadTupleIndexSetGuardVirtualOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), idx(idx), guard(guard) {;}
     virtual ~LoadTupleIndexSetGuardVirtualOp() {;}
 
     static LoadTupleIndexSetGuardVirtualOp* jparse(json v);
@@ -483,7 +580,7 @@ public:
     const uint32_t slotoffset;
     const BSQRecordPropertyID propId;
 
-    LoadRecordPropertyDirectOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, uint32_t slotoffset, BSQRecordPropertyID propId) : InterpOp(sinfo, ssrc, OpCodeTag::LoadRecordPropertyDirectOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), slotoffset(slotoffset), propId(propId) {;}
+    LoadRecordPropertyDirectOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, uint32_t slotoffset, BSQRecordPropertyID propId) : InterpOp(OpCodeTag::LoadRecordPropertyDirectOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), slotoffset(slotoffset), propId(propId) {;}
     virtual ~LoadRecordPropertyDirectOp() {;}
 
     static LoadRecordPropertyDirectOp* jparse(json v);
@@ -498,7 +595,9 @@ public:
     const BSQUnionType* layouttype;
     const BSQRecordPropertyID propId;
 
-    LoadRecordPropertyVirtualOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQUnionType* layouttype, BSQRecordPropertyID propId) : InterpOp(sinfo, ssrc, OpCodeTag::LoadRecordPropertyVirtualOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), propId(propId) {;}
+    mutable BSQInlineCache<size_t> icache;
+
+    LoadRecordPropertyVirtualOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQUnionType* layouttype, BSQRecordPropertyID propId) : InterpOp(OpCodeTag::LoadRecordPropertyVirtualOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), propId(propId) {;}
     virtual ~LoadRecordPropertyVirtualOp() {;}
 
     static LoadRecordPropertyVirtualOp* jparse(json v);
@@ -515,7 +614,7 @@ public:
     const BSQRecordPropertyID propId;
     const BSQGuard guard;
 
-    LoadRecordPropertySetGuardDirectOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, uint32_t slotoffset, BSQRecordPropertyID propId, BSQGuard guard) : InterpOp(sinfo, ssrc, OpCodeTag::LoadRecordPropertySetGuardDirectOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), slotoffset(slotoffset), propId(propId), guard(guard) {;}
+    LoadRecordPropertySetGuardDirectOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, uint32_t slotoffset, BSQRecordPropertyID propId, BSQGuard guard) : InterpOp(OpCodeTag::LoadRecordPropertySetGuardDirectOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), slotoffset(slotoffset), propId(propId), guard(guard) {;}
     virtual ~LoadRecordPropertySetGuardDirectOp() {;}
 
     static LoadRecordPropertySetGuardDirectOp* jparse(json v);
@@ -531,7 +630,9 @@ public:
     const BSQRecordPropertyID propId;
     const BSQGuard guard;
 
-    LoadRecordPropertySetGuardVirtualOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQUnionType* layouttype, BSQRecordPropertyID propId, BSQGuard guard) : InterpOp(sinfo, ssrc, OpCodeTag::LoadRecordPropertySetGuardVirtualOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), propId(propId), guard(guard) {;}
+    mutable BSQInlineCache<size_t> icache;
+
+    LoadRecordPropertySetGuardVirtualOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQUnionType* layouttype, BSQRecordPropertyID propId, BSQGuard guard) : InterpOp(OpCodeTag::LoadRecordPropertySetGuardVirtualOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), propId(propId), guard(guard) {;}
     virtual ~LoadRecordPropertySetGuardVirtualOp() {;}
 
     static LoadRecordPropertySetGuardVirtualOp* jparse(json v);
@@ -547,7 +648,7 @@ public:
     const uint32_t slotoffset;
     const BSQFieldID fieldId;
 
-    LoadEntityFieldDirectOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, uint32_t slotoffset, BSQFieldID fieldId) : InterpOp(sinfo, ssrc, OpCodeTag::LoadEntityFieldDirectOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), slotoffset(slotoffset), fieldId(fieldId) {;}
+    LoadEntityFieldDirectOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, uint32_t slotoffset, BSQFieldID fieldId) : InterpOp(OpCodeTag::LoadEntityFieldDirectOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), slotoffset(slotoffset), fieldId(fieldId) {;}
     virtual ~LoadEntityFieldDirectOp() {;}
 
     static LoadEntityFieldDirectOp* jparse(json v);
@@ -562,7 +663,9 @@ public:
     const BSQUnionType* layouttype;
     const BSQFieldID fieldId;
 
-    LoadEntityFieldVirtualOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQUnionType* layouttype, BSQFieldID fieldId) : InterpOp(sinfo, ssrc, OpCodeTag::LoadEntityFieldVirtualOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), fieldId(fieldId) {;}
+    mutable BSQInlineCache<size_t> icache;
+
+    LoadEntityFieldVirtualOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQUnionType* layouttype, BSQFieldID fieldId) : InterpOp(OpCodeTag::LoadEntityFieldVirtualOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), fieldId(fieldId) {;}
     virtual ~LoadEntityFieldVirtualOp() {;}
 
     static LoadEntityFieldVirtualOp* jparse(json v);
@@ -578,7 +681,7 @@ public:
     const BSQType* flowtype;
     const std::vector<std::tuple<BSQTupleIndex, uint32_t, const BSQType*>> idxs;
 
-    ProjectTupleOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQEphemeralListType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQTupleIndex, uint32_t, const BSQType*>> idxs) : InterpOp(sinfo, ssrc, OpCodeTag::ProjectTupleOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), idxs(idxs) {;}
+    ProjectTupleOp(TargetVar trgt, const BSQEphemeralListType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQTupleIndex, uint32_t, const BSQType*>> idxs) : InterpOp(OpCodeTag::ProjectTupleOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), idxs(idxs) {;}
     virtual ~ProjectTupleOp() {;}
 
     static ProjectTupleOp* jparse(json v);
@@ -594,7 +697,7 @@ public:
     const BSQType* flowtype;
     const std::vector<std::tuple<BSQRecordPropertyID, uint32_t, const BSQType*>> props;
 
-    ProjectRecordOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQEphemeralListType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQRecordPropertyID, uint32_t, const BSQType*>> props) : InterpOp(sinfo, ssrc, OpCodeTag::ProjectRecordOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), props(props) {;}
+    ProjectRecordOp(TargetVar trgt, const BSQEphemeralListType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQRecordPropertyID, uint32_t, const BSQType*>> props) : InterpOp(OpCodeTag::ProjectRecordOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), props(props) {;}
     virtual ~ProjectRecordOp() {;}
 
     static ProjectRecordOp* jparse(json v);
@@ -610,7 +713,7 @@ public:
     const BSQType* flowtype;
     const std::vector<std::tuple<BSQFieldID, uint32_t, const BSQType*>> fields;
 
-    ProjectEntityOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQEphemeralListType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQFieldID, uint32_t, const BSQType*>> fields) : InterpOp(sinfo, ssrc, OpCodeTag::ProjectEntityOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), fields(fields) {;}
+    ProjectEntityOp(TargetVar trgt, const BSQEphemeralListType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQFieldID, uint32_t, const BSQType*>> fields) : InterpOp(OpCodeTag::ProjectEntityOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), fields(fields) {;}
     virtual ~ProjectEntityOp() {;}
 
     static ProjectEntityOp* jparse(json v);
@@ -626,7 +729,7 @@ public:
     const BSQType* flowtype;
     const std::vector<std::tuple<BSQTupleIndex, uint32_t, const BSQType*, Argument>> updates;
 
-    UpdateTupleOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQTupleIndex, uint32_t, const BSQType*, Argument>> updates) : InterpOp(sinfo, ssrc, OpCodeTag::UpdateTupleOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), updates(updates) {;}
+    UpdateTupleOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQTupleIndex, uint32_t, const BSQType*, Argument>> updates) : InterpOp(OpCodeTag::UpdateTupleOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), updates(updates) {;}
     virtual ~UpdateTupleOp() {;}
 
     static UpdateTupleOp* jparse(json v);
@@ -642,7 +745,7 @@ public:
     const BSQType* flowtype;
     const std::vector<std::tuple<BSQRecordPropertyID, uint32_t, const BSQType*, Argument>> updates;
 
-    UpdateRecordOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQRecordPropertyID, uint32_t, const BSQType*, Argument>> updates) : InterpOp(sinfo, ssrc, OpCodeTag::UpdateRecordOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), updates(updates) {;}
+    UpdateRecordOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQRecordPropertyID, uint32_t, const BSQType*, Argument>> updates) : InterpOp(OpCodeTag::UpdateRecordOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), updates(updates) {;}
     virtual ~UpdateRecordOp() {;}
 
     static UpdateRecordOp* jparse(json v);
@@ -658,7 +761,7 @@ public:
     const BSQType* flowtype;
     const std::vector<std::tuple<BSQFieldID, uint32_t, const BSQType*, Argument>> updates;
 
-    UpdateEntityOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQFieldID, uint32_t, const BSQType*, Argument>> updates) : InterpOp(sinfo, ssrc, OpCodeTag::UpdateEntityOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), updates(updates) {;}
+    UpdateEntityOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQType* layouttype, const BSQType* flowtype, std::vector<std::tuple<BSQFieldID, uint32_t, const BSQType*, Argument>> updates) : InterpOp(OpCodeTag::UpdateEntityOp), trgt(trgt), trgttype(trgttype), arg(arg), layouttype(layouttype), flowtype(flowtype), updates(updates) {;}
     virtual ~UpdateEntityOp() {;}
 
     static UpdateEntityOp* jparse(json v);
@@ -674,7 +777,7 @@ public:
     const uint32_t slotoffset;
     const uint32_t index;
 
-    LoadFromEpehmeralListOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQEphemeralListType* argtype, uint32_t slotoffset, uint32_t index) : InterpOp(sinfo, ssrc, OpCodeTag::LoadFromEpehmeralListOp), trgt(trgt), trgttype(trgttype), arg(arg), argtype(argtype), slotoffset(slotoffset), index(index) {;}
+    LoadFromEpehmeralListOp(TargetVar trgt, const BSQType* trgttype, Argument arg, const BSQEphemeralListType* argtype, uint32_t slotoffset, uint32_t index) : InterpOp(OpCodeTag::LoadFromEpehmeralListOp), trgt(trgt), trgttype(trgttype), arg(arg), argtype(argtype), slotoffset(slotoffset), index(index) {;}
     virtual ~LoadFromEpehmeralListOp() {;}
 
     static LoadFromEpehmeralListOp* jparse(json v);
@@ -690,7 +793,7 @@ public:
     const std::vector<uint32_t> slotoffsets;
     const std::vector<uint32_t> indexs;
 
-    MultiLoadFromEpehmeralListOp(SourceInfo sinfo, std::string ssrc, std::vector<TargetVar> trgts, std::vector<const BSQType*> trgttypes, Argument arg, const BSQEphemeralListType* argtype, std::vector<uint32_t> slotoffsets, std::vector<uint32_t> indexs) : InterpOp(sinfo, ssrc, OpCodeTag::MultiLoadFromEpehmeralListOp), trgts(trgts), trgttypes(trgttypes), arg(arg), argtype(argtype), slotoffsets(slotoffsets), indexs(indexs) {;}
+    MultiLoadFromEpehmeralListOp(std::vector<TargetVar> trgts, std::vector<const BSQType*> trgttypes, Argument arg, const BSQEphemeralListType* argtype, std::vector<uint32_t> slotoffsets, std::vector<uint32_t> indexs) : InterpOp(OpCodeTag::MultiLoadFromEpehmeralListOp), trgts(trgts), trgttypes(trgttypes), arg(arg), argtype(argtype), slotoffsets(slotoffsets), indexs(indexs) {;}
     virtual ~MultiLoadFromEpehmeralListOp() {;}
 
     static MultiLoadFromEpehmeralListOp* jparse(json v);
@@ -706,7 +809,7 @@ public:
     const uint32_t slotoffsetend;
     const uint32_t indexend;
 
-    SliceEphemeralListOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQEphemeralListType* trgttype, Argument arg, const BSQEphemeralListType* argtype, uint32_t slotoffsetend, uint32_t indexend) : InterpOp(sinfo, ssrc, OpCodeTag::SliceEphemeralListOp), trgt(trgt), trgttype(trgttype), arg(arg), argtype(argtype), slotoffsetend(slotoffsetend), indexend(indexend) {;}
+    SliceEphemeralListOp(TargetVar trgt, const BSQEphemeralListType* trgttype, Argument arg, const BSQEphemeralListType* argtype, uint32_t slotoffsetend, uint32_t indexend) : InterpOp(OpCodeTag::SliceEphemeralListOp), trgt(trgt), trgttype(trgttype), arg(arg), argtype(argtype), slotoffsetend(slotoffsetend), indexend(indexend) {;}
     virtual ~SliceEphemeralListOp() {;}
 
     static SliceEphemeralListOp* jparse(json v);
@@ -722,7 +825,7 @@ public:
     const int32_t optmaskoffset;
     const BSQStatementGuard sguard;
 
-    InvokeFixedFunctionOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, BSQInvokeID invokeId, std::vector<Argument> args, BSQStatementGuard sguard, int32_t optmaskoffset) : InterpOp(sinfo, ssrc, OpCodeTag::InvokeFixedFunctionOp), trgt(trgt), trgttype(trgttype), invokeId(invokeId), args(args), optmaskoffset(optmaskoffset), sguard(sguard) {;}
+    InvokeFixedFunctionOp(TargetVar trgt, const BSQType* trgttype, BSQInvokeID invokeId, std::vector<Argument> args, BSQStatementGuard sguard, int32_t optmaskoffset) : InterpOp(OpCodeTag::InvokeFixedFunctionOp), trgt(trgt), trgttype(trgttype), invokeId(invokeId), args(args), optmaskoffset(optmaskoffset), sguard(sguard) {;}
     virtual ~InvokeFixedFunctionOp() {;}
 
     static InvokeFixedFunctionOp* jparse(json v);
@@ -737,8 +840,10 @@ public:
     const BSQUnionType* rcvrlayouttype;
     const int32_t optmaskoffset;
     const std::vector<Argument> args;
+
+    mutable BSQInlineCache<BSQInvokeID> icache;
     
-    InvokeVirtualFunctionOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, BSQVirtualInvokeID invokeId, const BSQUnionType* rcvrlayouttype, std::vector<Argument> args, int32_t optmaskoffset) : InterpOp(sinfo, ssrc, OpCodeTag::InvokeVirtualFunctionOp), trgt(trgt), trgttype(trgttype), invokeId(invokeId), rcvrlayouttype(rcvrlayouttype), optmaskoffset(optmaskoffset), args(args) {;}
+    InvokeVirtualFunctionOp(TargetVar trgt, const BSQType* trgttype, BSQVirtualInvokeID invokeId, const BSQUnionType* rcvrlayouttype, std::vector<Argument> args, int32_t optmaskoffset) : InterpOp(OpCodeTag::InvokeVirtualFunctionOp), trgt(trgt), trgttype(trgttype), invokeId(invokeId), rcvrlayouttype(rcvrlayouttype), optmaskoffset(optmaskoffset), args(args) {;}
     virtual ~InvokeVirtualFunctionOp() {;}
 
     static InvokeVirtualFunctionOp* jparse(json v);
@@ -756,7 +861,7 @@ public:
     //TODO: we probably need to know about the layout and flow type of each arg too
     //
 
-    InvokeVirtualOperatorOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* trgttype, BSQVirtualInvokeID invokeId, std::vector<Argument> args) : InterpOp(sinfo, ssrc, OpCodeTag::InvokeVirtualOperatorOp), trgt(trgt), trgttype(trgttype), invokeId(invokeId), args(args) {;}
+    InvokeVirtualOperatorOp(TargetVar trgt, const BSQType* trgttype, BSQVirtualInvokeID invokeId, std::vector<Argument> args) : InterpOp(OpCodeTag::InvokeVirtualOperatorOp), trgt(trgt), trgttype(trgttype), invokeId(invokeId), args(args) {;}
     virtual ~InvokeVirtualOperatorOp() {;}
 
     static InvokeVirtualOperatorOp* jparse(json v);
@@ -769,7 +874,7 @@ public:
     const BSQType* oftype;
     const std::vector<Argument> args;
     
-    ConstructorTupleOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, std::vector<Argument> args) : InterpOp(sinfo, ssrc, OpCodeTag::ConstructorTupleOp), trgt(trgt), oftype(oftype), args(args) {;}
+    ConstructorTupleOp(TargetVar trgt, const BSQType* oftype, std::vector<Argument> args) : InterpOp(OpCodeTag::ConstructorTupleOp), trgt(trgt), oftype(oftype), args(args) {;}
     virtual ~ConstructorTupleOp() {;}
 
     static ConstructorTupleOp* jparse(json v);
@@ -783,7 +888,7 @@ public:
     const Argument arg;
     const BSQEphemeralListType* argtype;
     
-    ConstructorTupleFromEphemeralListOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument arg, const BSQEphemeralListType* argtype) : InterpOp(sinfo, ssrc, OpCodeTag::ConstructorTupleFromEphemeralListOp), trgt(trgt), oftype(oftype), arg(arg), argtype(argtype) {;}
+    ConstructorTupleFromEphemeralListOp(TargetVar trgt, const BSQType* oftype, Argument arg, const BSQEphemeralListType* argtype) : InterpOp(OpCodeTag::ConstructorTupleFromEphemeralListOp), trgt(trgt), oftype(oftype), arg(arg), argtype(argtype) {;}
     virtual ~ConstructorTupleFromEphemeralListOp() {;}
 
     static ConstructorTupleFromEphemeralListOp* jparse(json v);
@@ -796,7 +901,7 @@ public:
     const BSQType* oftype;
     const std::vector<Argument> args;
     
-    ConstructorRecordOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, std::vector<Argument> args) : InterpOp(sinfo, ssrc, OpCodeTag::ConstructorRecordOp), trgt(trgt), oftype(oftype), args(args) {;}
+    ConstructorRecordOp(TargetVar trgt, const BSQType* oftype, std::vector<Argument> args) : InterpOp(OpCodeTag::ConstructorRecordOp), trgt(trgt), oftype(oftype), args(args) {;}
     virtual ~ConstructorRecordOp() {;}
 
     static ConstructorRecordOp* jparse(json v);
@@ -811,7 +916,7 @@ public:
     const BSQEphemeralListType* argtype;
     const std::vector<uint32_t> proppositions; //if empty then assume properties are in same order as elist
     
-    ConstructorRecordFromEphemeralListOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument arg, const BSQEphemeralListType* argtype, std::vector<BSQRecordPropertyID> proppositions) : InterpOp(sinfo, ssrc, OpCodeTag::ConstructorRecordFromEphemeralListOp), trgt(trgt), oftype(oftype), arg(arg), argtype(argtype), proppositions(proppositions) {;}
+    ConstructorRecordFromEphemeralListOp(TargetVar trgt, const BSQType* oftype, Argument arg, const BSQEphemeralListType* argtype, std::vector<BSQRecordPropertyID> proppositions) : InterpOp(OpCodeTag::ConstructorRecordFromEphemeralListOp), trgt(trgt), oftype(oftype), arg(arg), argtype(argtype), proppositions(proppositions) {;}
     virtual ~ConstructorRecordFromEphemeralListOp() {;}
 
     static ConstructorRecordFromEphemeralListOp* jparse(json v);
@@ -826,7 +931,7 @@ public:
     const BSQEphemeralListType* argtype;
     const std::vector<Argument> ext;
 
-    EphemeralListExtendOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQEphemeralListType* resultType, Argument arg, const BSQEphemeralListType* argtype, std::vector<Argument> ext) : InterpOp(sinfo, ssrc, OpCodeTag::EphemeralListExtendOp), trgt(trgt), resultType(resultType), arg(arg), argtype(argtype), ext(ext) {;}
+    EphemeralListExtendOp(TargetVar trgt, const BSQEphemeralListType* resultType, Argument arg, const BSQEphemeralListType* argtype, std::vector<Argument> ext) : InterpOp(OpCodeTag::EphemeralListExtendOp), trgt(trgt), resultType(resultType), arg(arg), argtype(argtype), ext(ext) {;}
     virtual ~EphemeralListExtendOp() {;}
 
     static EphemeralListExtendOp* jparse(json v);
@@ -839,7 +944,7 @@ public:
     const BSQEphemeralListType* oftype;
     const std::vector<Argument> args;
     
-    ConstructorEphemeralListOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQEphemeralListType* oftype, std::vector<Argument> args) : InterpOp(sinfo, ssrc, OpCodeTag::ConstructorEphemeralListOp), trgt(trgt), oftype(oftype), args(args) {;}
+    ConstructorEphemeralListOp(TargetVar trgt, const BSQEphemeralListType* oftype, std::vector<Argument> args) : InterpOp(OpCodeTag::ConstructorEphemeralListOp), trgt(trgt), oftype(oftype), args(args) {;}
     virtual ~ConstructorEphemeralListOp() {;}
 
     static ConstructorEphemeralListOp* jparse(json v);
@@ -852,7 +957,7 @@ public:
     const BSQType* oftype;
     const std::vector<Argument> args;
     
-    ConstructorEntityDirectOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, std::vector<Argument> args) : InterpOp(sinfo, ssrc, OpCodeTag::ConstructorEntityDirectOp), trgt(trgt), oftype(oftype), args(args) {;}
+    ConstructorEntityDirectOp(TargetVar trgt, const BSQType* oftype, std::vector<Argument> args) : InterpOp(OpCodeTag::ConstructorEntityDirectOp), trgt(trgt), oftype(oftype), args(args) {;}
     virtual ~ConstructorEntityDirectOp() {;}
 
     static ConstructorEntityDirectOp* jparse(json v);
@@ -864,7 +969,7 @@ public:
     const TargetVar trgt;
     const Argument arg;
     
-    PrefixNotOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, Argument arg) : InterpOp(sinfo, ssrc, OpCodeTag::PrefixNotOp), trgt(trgt), arg(arg) {;}
+    PrefixNotOp(TargetVar trgt, Argument arg) : InterpOp(OpCodeTag::PrefixNotOp), trgt(trgt), arg(arg) {;}
     virtual ~PrefixNotOp() {;}
 
     static PrefixNotOp* jparse(json v);
@@ -876,7 +981,7 @@ public:
     const TargetVar trgt;
     const std::vector<Argument> args;
     
-    AllTrueOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, std::vector<Argument> args) : InterpOp(sinfo, ssrc, OpCodeTag::AllTrueOp), trgt(trgt), args(args) {;}
+    AllTrueOp(TargetVar trgt, std::vector<Argument> args) : InterpOp(OpCodeTag::AllTrueOp), trgt(trgt), args(args) {;}
     virtual ~AllTrueOp() {;}
 
     static AllTrueOp* jparse(json v);
@@ -888,7 +993,7 @@ public:
     const TargetVar trgt;
     const std::vector<Argument> args;
     
-    SomeTrueOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, std::vector<Argument> args) : InterpOp(sinfo, ssrc, OpCodeTag::SomeTrueOp), trgt(trgt), args(args) {;}
+    SomeTrueOp(TargetVar trgt, std::vector<Argument> args) : InterpOp(OpCodeTag::SomeTrueOp), trgt(trgt), args(args) {;}
     virtual ~SomeTrueOp() {;}
 
     static SomeTrueOp* jparse(json v);
@@ -903,7 +1008,7 @@ public:
     const Argument argr;
     const BSQStatementGuard sguard;
     
-    BinKeyEqFastOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument argl, Argument argr, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::BinKeyEqFastOp), trgt(trgt), oftype(oftype), argl(argl), argr(argr), sguard(sguard) {;}
+    BinKeyEqFastOp(TargetVar trgt, const BSQType* oftype, Argument argl, Argument argr, BSQStatementGuard sguard) : InterpOp(OpCodeTag::BinKeyEqFastOp), trgt(trgt), oftype(oftype), argl(argl), argr(argr), sguard(sguard) {;}
     virtual ~BinKeyEqFastOp() {;}
 
     static BinKeyEqFastOp* jparse(json v);
@@ -920,7 +1025,7 @@ public:
     const BSQType* argrlayout;
     const BSQStatementGuard sguard;
     
-    BinKeyEqStaticOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument argl, const BSQType* argllayout, Argument argr, const BSQType* argrlayout, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::BinKeyEqStaticOp), trgt(trgt), oftype(oftype), argl(argl), argllayout(argllayout), argr(argr), argrlayout(argrlayout), sguard(sguard) {;}
+    BinKeyEqStaticOp(TargetVar trgt, const BSQType* oftype, Argument argl, const BSQType* argllayout, Argument argr, const BSQType* argrlayout, BSQStatementGuard sguard) : InterpOp(OpCodeTag::BinKeyEqStaticOp), trgt(trgt), oftype(oftype), argl(argl), argllayout(argllayout), argr(argr), argrlayout(argrlayout), sguard(sguard) {;}
     virtual ~BinKeyEqStaticOp() {;}
 
     static BinKeyEqStaticOp* jparse(json v);
@@ -937,7 +1042,7 @@ public:
     const BSQType* argrlayout;
     const BSQStatementGuard sguard;
     
-    BinKeyEqVirtualOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument argl, const BSQType* argllayout, Argument argr, const BSQType* argrlayout, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::BinKeyEqVirtualOp), trgt(trgt), oftype(oftype), argl(argl), argllayout(argllayout), argr(argr), argrlayout(argrlayout), sguard(sguard) {;}
+    BinKeyEqVirtualOp(TargetVar trgt, const BSQType* oftype, Argument argl, const BSQType* argllayout, Argument argr, const BSQType* argrlayout, BSQStatementGuard sguard) : InterpOp(OpCodeTag::BinKeyEqVirtualOp), trgt(trgt), oftype(oftype), argl(argl), argllayout(argllayout), argr(argr), argrlayout(argrlayout), sguard(sguard) {;}
     virtual ~BinKeyEqVirtualOp() {;}
 
     static BinKeyEqVirtualOp* jparse(json v);
@@ -952,7 +1057,7 @@ public:
     const Argument argl;
     const Argument argr;
     
-    BinKeyLessFastOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument argl, Argument argr) : InterpOp(sinfo, ssrc, OpCodeTag::BinKeyLessFastOp), trgt(trgt), oftype(oftype), argl(argl), argr(argr) {;}
+    BinKeyLessFastOp(TargetVar trgt, const BSQType* oftype, Argument argl, Argument argr) : InterpOp(OpCodeTag::BinKeyLessFastOp), trgt(trgt), oftype(oftype), argl(argl), argr(argr) {;}
     virtual ~BinKeyLessFastOp() {;}
 
     static BinKeyLessFastOp* jparse(json v);
@@ -968,7 +1073,7 @@ public:
     const Argument argr;
     const BSQType* argrlayout;
     
-    BinKeyLessStaticOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument argl, const BSQType* argllayout, Argument argr, const BSQType* argrlayout) : InterpOp(sinfo, ssrc, OpCodeTag::BinKeyLessStaticOp), trgt(trgt), oftype(oftype), argl(argl), argllayout(argllayout), argr(argr), argrlayout(argrlayout) {;}
+    BinKeyLessStaticOp(TargetVar trgt, const BSQType* oftype, Argument argl, const BSQType* argllayout, Argument argr, const BSQType* argrlayout) : InterpOp(OpCodeTag::BinKeyLessStaticOp), trgt(trgt), oftype(oftype), argl(argl), argllayout(argllayout), argr(argr), argrlayout(argrlayout) {;}
     virtual ~BinKeyLessStaticOp() {;}
 
     static BinKeyLessStaticOp* jparse(json v);
@@ -984,7 +1089,7 @@ public:
     const Argument argr;
     const BSQType* argrlayout;
     
-    BinKeyLessVirtualOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument argl, const BSQType* argllayout, Argument argr, const BSQType* argrlayout) : InterpOp(sinfo, ssrc, OpCodeTag::BinKeyLessVirtualOp), trgt(trgt), oftype(oftype), argl(argl), argllayout(argllayout), argr(argr), argrlayout(argrlayout) {;}
+    BinKeyLessVirtualOp(TargetVar trgt, const BSQType* oftype, Argument argl, const BSQType* argllayout, Argument argr, const BSQType* argrlayout) : InterpOp(OpCodeTag::BinKeyLessVirtualOp), trgt(trgt), oftype(oftype), argl(argl), argllayout(argllayout), argr(argr), argrlayout(argrlayout) {;}
     virtual ~BinKeyLessVirtualOp() {;}
 
     static BinKeyLessVirtualOp* jparse(json v);
@@ -998,7 +1103,7 @@ public:
     const BSQUnionType* arglayout;
     const BSQStatementGuard sguard;
     
-    TypeIsNoneOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, Argument arg, const BSQUnionType* arglayout, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::TypeIsNoneOp), trgt(trgt), arg(arg), arglayout(arglayout), sguard(sguard) {;}
+    TypeIsNoneOp(TargetVar trgt, Argument arg, const BSQUnionType* arglayout, BSQStatementGuard sguard) : InterpOp(OpCodeTag::TypeIsNoneOp), trgt(trgt), arg(arg), arglayout(arglayout), sguard(sguard) {;}
     virtual ~TypeIsNoneOp() {;}
 
     static TypeIsNoneOp* jparse(json v);
@@ -1012,7 +1117,7 @@ public:
     const BSQUnionType* arglayout;
     const BSQStatementGuard sguard;
     
-    TypeIsSomeOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, Argument arg, const BSQUnionType* arglayout, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::TypeIsSomeOp), trgt(trgt), arg(arg), arglayout(arglayout), sguard(sguard) {;}
+    TypeIsSomeOp(TargetVar trgt, Argument arg, const BSQUnionType* arglayout, BSQStatementGuard sguard) : InterpOp(OpCodeTag::TypeIsSomeOp), trgt(trgt), arg(arg), arglayout(arglayout), sguard(sguard) {;}
     virtual ~TypeIsSomeOp() {;}
 
     static TypeIsSomeOp* jparse(json v);
@@ -1026,7 +1131,7 @@ public:
     const BSQUnionType* arglayout;
     const BSQStatementGuard sguard;
     
-    TypeIsNothingOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, Argument arg, const BSQUnionType* arglayout, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::TypeIsNothingOp), trgt(trgt), arg(arg), arglayout(arglayout), sguard(sguard) {;}
+    TypeIsNothingOp(TargetVar trgt, Argument arg, const BSQUnionType* arglayout, BSQStatementGuard sguard) : InterpOp(OpCodeTag::TypeIsNothingOp), trgt(trgt), arg(arg), arglayout(arglayout), sguard(sguard) {;}
     virtual ~TypeIsNothingOp() {;}
 
     static TypeIsNothingOp* jparse(json v);
@@ -1041,7 +1146,7 @@ public:
     const BSQUnionType* arglayout;
     const BSQStatementGuard sguard;
     
-    TypeTagIsOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument arg, const BSQUnionType* arglayout, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::TypeTagIsOp), trgt(trgt), oftype(oftype), arg(arg), arglayout(arglayout), sguard(sguard) {;}
+    TypeTagIsOp(TargetVar trgt, const BSQType* oftype, Argument arg, const BSQUnionType* arglayout, BSQStatementGuard sguard) : InterpOp(OpCodeTag::TypeTagIsOp), trgt(trgt), oftype(oftype), arg(arg), arglayout(arglayout), sguard(sguard) {;}
     virtual ~TypeTagIsOp() {;}
 
     static TypeTagIsOp* jparse(json v);
@@ -1056,7 +1161,7 @@ public:
     const BSQUnionType* arglayout;
     const BSQStatementGuard sguard;
     
-    TypeTagSubtypeOfOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQUnionType* oftype, Argument arg, const BSQUnionType* arglayout, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::TypeTagSubtypeOfOp), trgt(trgt), oftype(oftype), arg(arg), arglayout(arglayout), sguard(sguard) {;}
+    TypeTagSubtypeOfOp(TargetVar trgt, const BSQUnionType* oftype, Argument arg, const BSQUnionType* arglayout, BSQStatementGuard sguard) : InterpOp(OpCodeTag::TypeTagSubtypeOfOp), trgt(trgt), oftype(oftype), arg(arg), arglayout(arglayout), sguard(sguard) {;}
     virtual ~TypeTagSubtypeOfOp() {;}
 
     static TypeTagSubtypeOfOp* jparse(json v);
@@ -1068,7 +1173,7 @@ public:
     const uint32_t offset;
     const std::string label;
     
-    JumpOp(SourceInfo sinfo, std::string ssrc, uint32_t offset, const std::string label) : InterpOp(sinfo, ssrc, OpCodeTag::JumpOp), offset(offset), label(label) {;}
+    JumpOp(uint32_t offset, const std::string label) : InterpOp(OpCodeTag::JumpOp), offset(offset), label(label) {;}
     virtual ~JumpOp() {;}
 
     static JumpOp* jparse(json v);
@@ -1083,7 +1188,7 @@ public:
     const std::string tlabel;
     const std::string flabel;
     
-    JumpCondOp(SourceInfo sinfo, std::string ssrc, Argument arg, uint32_t toffset, uint32_t foffset, const std::string tlabel, const std::string flabel) : InterpOp(sinfo, ssrc, OpCodeTag::JumpCondOp), arg(arg), toffset(toffset), foffset(foffset), tlabel(tlabel), flabel(flabel) {;}
+    JumpCondOp(Argument arg, uint32_t toffset, uint32_t foffset, const std::string tlabel, const std::string flabel) : InterpOp(OpCodeTag::JumpCondOp), arg(arg), toffset(toffset), foffset(foffset), tlabel(tlabel), flabel(flabel) {;}
     virtual ~JumpCondOp() {;}
 
     static JumpCondOp* jparse(json v);
@@ -1099,7 +1204,7 @@ public:
     const std::string nlabel;
     const std::string slabel;
     
-    JumpNoneOp(SourceInfo sinfo, std::string ssrc, Argument arg, const BSQUnionType* arglayout, uint32_t noffset, uint32_t soffset, const std::string nlabel, const std::string slabel) : InterpOp(sinfo, ssrc, OpCodeTag::JumpNoneOp), arg(arg), arglayout(arglayout), noffset(noffset), soffset(soffset), nlabel(nlabel), slabel(slabel) {;}
+    JumpNoneOp(Argument arg, const BSQUnionType* arglayout, uint32_t noffset, uint32_t soffset, const std::string nlabel, const std::string slabel) : InterpOp(OpCodeTag::JumpNoneOp), arg(arg), arglayout(arglayout), noffset(noffset), soffset(soffset), nlabel(nlabel), slabel(slabel) {;}
     virtual ~JumpNoneOp() {;}
 
     static JumpNoneOp* jparse(json v);
@@ -1113,7 +1218,7 @@ public:
     const BSQType* oftype;
     const BSQStatementGuard sguard;
     
-    RegisterAssignOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, Argument arg, const BSQType* oftype, BSQStatementGuard sguard) : InterpOp(sinfo, ssrc, OpCodeTag::RegisterAssignOp), trgt(trgt), arg(arg), oftype(oftype), sguard(sguard) {;}
+    RegisterAssignOp(TargetVar trgt, Argument arg, const BSQType* oftype, BSQStatementGuard sguard) : InterpOp(OpCodeTag::RegisterAssignOp), trgt(trgt), arg(arg), oftype(oftype), sguard(sguard) {;}
     virtual ~RegisterAssignOp() {;}
 
     static RegisterAssignOp* jparse(json v);
@@ -1126,7 +1231,7 @@ public:
     const Argument arg;
     const BSQType* oftype;
     
-    ReturnAssignOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, Argument arg, const BSQType* oftype) : InterpOp(sinfo, ssrc, OpCodeTag::ReturnAssignOp), trgt(trgt), arg(arg), oftype(oftype) {;}
+    ReturnAssignOp(TargetVar trgt, Argument arg, const BSQType* oftype) : InterpOp(OpCodeTag::ReturnAssignOp), trgt(trgt), arg(arg), oftype(oftype) {;}
     virtual ~ReturnAssignOp() {;}
 
     static ReturnAssignOp* jparse(json v);
@@ -1139,7 +1244,7 @@ public:
     const std::vector<Argument> args;
     const BSQType* oftype;
     
-    ReturnAssignOfConsOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, std::vector<Argument> args, const BSQType* oftype) : InterpOp(sinfo, ssrc, OpCodeTag::ReturnAssignOfConsOp), trgt(trgt), args(args), oftype(oftype) {;}
+    ReturnAssignOfConsOp(TargetVar trgt, std::vector<Argument> args, const BSQType* oftype) : InterpOp(OpCodeTag::ReturnAssignOfConsOp), trgt(trgt), args(args), oftype(oftype) {;}
     virtual ~ReturnAssignOfConsOp() {;}
 
     static ReturnAssignOfConsOp* jparse(json v);
@@ -1152,7 +1257,7 @@ public:
     const BSQType* oftype;
     const std::string name;
     
-    VarLifetimeStartOp(SourceInfo sinfo, std::string ssrc, TargetVar homelocation, const BSQType* oftype, const std::string name) : InterpOp(sinfo, ssrc, OpCodeTag::VarLifetimeStartOp), homelocation(homelocation), oftype(oftype), name(name) {;}
+    VarLifetimeStartOp(TargetVar homelocation, const BSQType* oftype, const std::string name) : InterpOp(OpCodeTag::VarLifetimeStartOp), homelocation(homelocation), oftype(oftype), name(name) {;}
     virtual ~VarLifetimeStartOp() {;}
 
     static VarLifetimeStartOp* jparse(json v);
@@ -1163,7 +1268,7 @@ class VarLifetimeEndOp : public InterpOp
 public:
     const std::string name;
     
-    VarLifetimeEndOp(SourceInfo sinfo, std::string ssrc, const std::string name) : InterpOp(sinfo, ssrc, OpCodeTag::VarLifetimeEndOp), name(name) {;}
+    VarLifetimeEndOp(const std::string name) : InterpOp(OpCodeTag::VarLifetimeEndOp), name(name) {;}
     virtual ~VarLifetimeEndOp() {;}
 
     static VarLifetimeEndOp* jparse(json v);
@@ -1177,7 +1282,7 @@ public:
     const Argument updatevar;
     const BSQType* oftype;
     
-    VarHomeLocationValueUpdate(SourceInfo sinfo, std::string ssrc, TargetVar homelocation, Argument updatevar, const BSQType* oftype) : InterpOp(sinfo, ssrc, OpCodeTag::VarHomeLocationValueUpdate), homelocation(homelocation), updatevar(updatevar), oftype(oftype) {;}
+    VarHomeLocationValueUpdate(TargetVar homelocation, Argument updatevar, const BSQType* oftype) : InterpOp(OpCodeTag::VarHomeLocationValueUpdate), homelocation(homelocation), updatevar(updatevar), oftype(oftype) {;}
     virtual ~VarHomeLocationValueUpdate() {;}
 
     static VarHomeLocationValueUpdate* jparse(json v);
@@ -1191,7 +1296,7 @@ public:
     const BSQType* oftype;
     const Argument arg;
     
-    PrimitiveNegateOperatorOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument arg) : InterpOp(sinfo, ssrc, ttag), trgt(trgt), oftype(oftype), arg(arg) {;}
+    PrimitiveNegateOperatorOp(TargetVar trgt, const BSQType* oftype, Argument arg) : InterpOp(ttag), trgt(trgt), oftype(oftype), arg(arg) {;}
     virtual ~PrimitiveNegateOperatorOp() {;}
 
     static PrimitiveNegateOperatorOp* jparse(json v);
@@ -1206,7 +1311,7 @@ public:
     const Argument larg;
     const Argument rarg;
     
-    PrimitiveBinaryOperatorOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument larg, Argument rarg) : InterpOp(sinfo, ssrc, ttag), trgt(trgt), oftype(oftype), larg(larg), rarg(rarg) {;}
+    PrimitiveBinaryOperatorOp(TargetVar trgt, const BSQType* oftype, Argument larg, Argument rarg) : InterpOp(ttag), trgt(trgt), oftype(oftype), larg(larg), rarg(rarg) {;}
     virtual ~PrimitiveBinaryOperatorOp() {;}
 
     static PrimitiveBinaryOperatorOp* jparse(json v);
@@ -1221,9 +1326,83 @@ public:
     const Argument larg;
     const Argument rarg;
     
-    PrimitiveBinaryCompareOp(SourceInfo sinfo, std::string ssrc, TargetVar trgt, const BSQType* oftype, Argument larg, Argument rarg) : InterpOp(sinfo, ssrc, ttag), trgt(trgt), oftype(oftype), larg(larg), rarg(rarg) {;}
+    PrimitiveBinaryCompareOp(TargetVar trgt, const BSQType* oftype, Argument larg, Argument rarg) : InterpOp(ttag), trgt(trgt), oftype(oftype), larg(larg), rarg(rarg) {;}
     virtual ~PrimitiveBinaryCompareOp() {;}
 
     static PrimitiveBinaryCompareOp* jparse(json v);
 };
 
+////////////////////////////////
+//Superinstructions
+//
+//A fused op replaces the first op of the sequence it was built from and the remaining ops are left in place (so jump offsets and 
+//any jumps that land in the middle of the sequence are unchanged). Executing a fused op covers the full sequence and then 
+//advances past it.
+
+template <OpCodeTag ttag>
+class PrimitiveCompareJumpCondOp : public InterpOp
+{
+public:
+    const TargetVar trgt;
+    const Argument larg;
+    const Argument rarg;
+
+    //offsets are relative to this op (so they include the jump op that was fused)
+    const uint32_t toffset;
+    const uint32_t foffset;
+
+    PrimitiveCompareJumpCondOp(TargetVar trgt, Argument larg, Argument rarg, uint32_t toffset, uint32_t foffset) : InterpOp(ttag), trgt(trgt), larg(larg), rarg(rarg), toffset(toffset), foffset(foffset) {;}
+    virtual ~PrimitiveCompareJumpCondOp() {;}
+};
+
+template <OpCodeTag ttag>
+class LoadConstBinaryOperatorOp : public InterpOp
+{
+public:
+    const TargetVar ctrgt;
+    const Argument carg;
+    const BSQType* ctype;
+
+    //any use of ctrgt in the operator args is replaced with carg
+    const TargetVar trgt;
+    const Argument larg;
+    const Argument rarg;
+
+    LoadConstBinaryOperatorOp(TargetVar ctrgt, Argument carg, const BSQType* ctype, TargetVar trgt, Argument larg, Argument rarg) : InterpOp(ttag), ctrgt(ctrgt), carg(carg), ctype(ctype), trgt(trgt), larg(larg), rarg(rarg) {;}
+    virtual ~LoadConstBinaryOperatorOp() {;}
+};
+
+class LoadEntityFieldDirectRegisterAssignOp : public InterpOp
+{
+public:
+    const LoadEntityFieldDirectOp* lop;
+    const TargetVar atrgt;
+    const BSQType* atype;
+
+    LoadEntityFieldDirectRegisterAssignOp(const LoadEntityFieldDirectOp* lop, TargetVar atrgt, const BSQType* atype) : InterpOp(OpCodeTag::LoadEntityFieldDirectRegisterAssignOp), lop(lop), atrgt(atrgt), atype(atype) {;}
+    virtual ~LoadEntityFieldDirectRegisterAssignOp() {;}
+};
+
+//A self call in tail position (the InvokeFixedFunctionOp that is immediately returned by the following ReturnAssignOp) -- instead 
+//of recursing we overwrite the parameters, reset the frame, and jump back to the start of the body.
+class InvokeSelfTailCallOp : public InterpOp
+{
+public:
+    const InvokeFixedFunctionOp* iop;
+    const size_t argbytes; //scratch space needed to hold the new argument values while the parameters are overwritten
+
+    InvokeSelfTailCallOp(const InvokeFixedFunctionOp* iop, size_t argbytes) : InterpOp(OpCodeTag::InvokeSelfTailCallOp), iop(iop), argbytes(argbytes) {;}
+    virtual ~InvokeSelfTailCallOp() {;}
+};
+
+//Result of an op that the optimizer evaluated at load time -- value holds a Nat, Int, or Bool in its low bytes
+class LoadFoldedConstOp : public InterpOp
+{
+public:
+    const TargetVar trgt;
+    const BSQType* oftype;
+    const uint64_t value;
+
+    LoadFoldedConstOp(TargetVar trgt, const BSQType* oftype, uint64_t value) : InterpOp(OpCodeTag::LoadFoldedConstOp), trgt(trgt), oftype(oftype), value(value) {;}
+    virtual ~LoadFoldedConstOp() {;}
+};
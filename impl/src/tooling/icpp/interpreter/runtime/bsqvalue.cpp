@@ -26,11 +26,13 @@ const BSQType* BSQWellKnownType::g_typeStringKRepr128 = new BSQStringKReprType<1
 const std::pair<size_t, const BSQType*> BSQWellKnownType::g_typeStringKCons[5] = {std::make_pair((size_t)16, BSQWellKnownType::g_typeStringKRepr16), std::make_pair((size_t)32, BSQWellKnownType::g_typeStringKRepr32), std::make_pair((size_t)64, BSQWellKnownType::g_typeStringKRepr64), std::make_pair((size_t)96, BSQWellKnownType::g_typeStringKRepr96), std::make_pair((size_t)128, BSQWellKnownType::g_typeStringKRepr128) };
 
 const BSQType* BSQWellKnownType::g_typeStringTreeRepr = new BSQStringTreeReprType();
+const BSQType* BSQWellKnownType::g_typeStringFlatRepr = new BSQStringFlatReprType();
 
 const BSQType* BSQWellKnownType::g_typeString = CONS_BSQ_STRING_TYPE(BSQ_TYPE_ID_STRING, "String");
 
 const BSQType* BSQWellKnownType::g_typeByteBufferLeaf = CONS_BSQ_BYTE_BUFFER_LEAF_TYPE();
 const BSQType* BSQWellKnownType::g_typeByteBufferNode = CONS_BSQ_BYTE_BUFFER_NODE_TYPE();
+const BSQType* BSQWellKnownType::g_typeByteBufferFlatNode = CONS_BSQ_BYTE_BUFFER_FLAT_NODE_TYPE();
 const BSQType* BSQWellKnownType::g_typeByteBuffer = CONS_BSQ_BYTE_BUFFER_TYPE(BSQ_TYPE_ID_BYTEBUFFER, "BytBuffer");
 const BSQType* BSQWellKnownType::g_typeDateTime = CONS_BSQ_DATE_TIME_TYPE(BSQ_TYPE_ID_DATETIME, "DateTime");
 const BSQType* BSQWellKnownType::g_typeUTCDateTime = CONS_BSQ_UTC_DATE_TIME_TYPE(BSQ_TYPE_ID_UTC_DATETIME, "UTCDateTime");
@@ -496,14 +498,36 @@ void* BSQStringTreeReprType::slice(StorageLocationPtr data, uint64_t nstart, uin
     return res;
 }
 
+void* BSQStringFlatReprType::slice(StorageLocationPtr data, uint64_t nstart, uint64_t nend) const
+{
+    auto frepr = (BSQStringFlatRepr*)SLPTR_LOAD_CONTENTS_AS_GENERIC_HEAPOBJ(data);
+    if((nstart == 0) & (nend == frepr->size))
+    {
+        return frepr;
+    }
+
+    //the bytes are not in the GC heap so a slice is just a new window on them
+    auto fbytes = frepr->bytes;
+    auto res = (BSQStringFlatRepr*)Allocator::GlobalAllocator.allocateDynamic(BSQWellKnownType::g_typeStringFlatRepr);
+    *res = {fbytes + nstart, nend - nstart};
+
+    return res;
+}
+
 void initializeForwardIterRecProcess(int64_t pos, void* data, BSQStringForwardIterator* iter)
 {
     auto stype = GET_TYPE_META_DATA_AS(BSQStringReprType, data);
     if(stype->isKReprNode())
     {
         iter->cbuff = BSQStringKReprTypeAbstract::getUTF8Bytes(data);
-        iter->maxpos = (int16_t)BSQStringKReprTypeAbstract::getUTF8ByteCount(data);
-        iter->cpos = (uint16_t)pos;
+        iter->maxpos = (size_t)BSQStringKReprTypeAbstract::getUTF8ByteCount(data);
+        iter->cpos = (size_t)pos;
+    }
+    else if(stype->isFlatReprNode())
+    {
+        iter->cbuff = static_cast<BSQStringFlatRepr*>(data)->bytes;
+        iter->maxpos = (size_t)static_cast<BSQStringFlatRepr*>(data)->size;
+        iter->cpos = (size_t)pos;
     }
     else
     {
@@ -532,8 +556,8 @@ void BSQStringForwardIterator::initializeIteratorPosition(int64_t curr)
     else if(IS_INLINE_STRING(this->sstr))
     {
         this->cbuff = BSQInlineString::utf8Bytes(this->sstr->u_inlineString);
-        this->maxpos = (int16_t)BSQInlineString::utf8ByteCount(this->sstr->u_inlineString);
-        this->cpos = (int16_t)curr;
+        this->maxpos = (size_t)BSQInlineString::utf8ByteCount(this->sstr->u_inlineString);
+        this->cpos = (size_t)curr;
     }
     else
     {
@@ -558,7 +582,12 @@ void initializeReverseIterRecProcess(int64_t pos, void* data, BSQStringReverseIt
     if(stype->isKReprNode())
     {
         iter->cbuff = BSQStringKReprTypeAbstract::getUTF8Bytes(data);
-        iter->cpos = (int16_t)pos;
+        iter->cpos = pos;
+    }
+    else if(stype->isFlatReprNode())
+    {
+        iter->cbuff = static_cast<BSQStringFlatRepr*>(data)->bytes;
+        iter->cpos = pos;
     }
     else
     {
@@ -586,7 +615,7 @@ void BSQStringReverseIterator::initializeIteratorPosition(int64_t curr)
     else if(IS_INLINE_STRING(this->sstr))
     {
         this->cbuff = BSQInlineString::utf8Bytes(this->sstr->u_inlineString);
-        this->cpos = (int16_t)curr;
+        this->cpos = curr;
     }
     else
     {
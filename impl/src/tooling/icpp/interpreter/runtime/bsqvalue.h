@@ -48,11 +48,13 @@ public:
 
     static const BSQType* g_typeStringTreeRepr;
     static const BSQType* g_typeStringSliceRepr;
+    static const BSQType* g_typeStringFlatRepr;
 
     static const BSQType* g_typeString;
 
     static const BSQType* g_typeByteBufferLeaf;
     static const BSQType* g_typeByteBufferNode;
+    static const BSQType* g_typeByteBufferFlatNode;
     static const BSQType* g_typeByteBuffer;
     static const BSQType* g_typeDateTime;
     static const BSQType* g_typeUTCDateTime;
@@ -461,12 +463,20 @@ class BSQUnionType : public BSQType
 public:
     const std::vector<BSQTypeID> subtypes;
 
+    //Bitset over all type ids with the bits for subtypes set -- built at load
+    uint64_t* subtypebits;
+
      BSQUnionType(BSQTypeID tid, BSQTypeLayoutKind tkind, BSQTypeSizeInfo allocinfo, KeyCmpFP fpkeycmp, std::string name, std::vector<BSQTypeID> subtypes): 
-        BSQType(tid, tkind, allocinfo, {0}, {}, fpkeycmp, unionDisplay_impl, name), subtypes(subtypes)
+        BSQType(tid, tkind, allocinfo, {0}, {}, fpkeycmp, unionDisplay_impl, name), subtypes(subtypes), subtypebits(nullptr)
     {;}
 
     virtual ~BSQUnionType() {;}
 
+    inline bool isSubtype(BSQTypeID stid) const
+    {
+        return (this->subtypebits[stid / 64] >> (stid % 64)) & 0x1ul;
+    }
+
     virtual bool isUnion() const
     {
         return true;
@@ -969,6 +979,7 @@ public:
     virtual ~BSQStringReprType() {;}
 
     virtual bool isKReprNode() const = 0;
+    virtual bool isFlatReprNode() const = 0;
 
     virtual uint64_t utf8ByteCount(void* repr) const = 0;
     virtual void* slice(void* data, uint64_t nstart, uint64_t nend) const = 0;
@@ -984,6 +995,7 @@ public:
     virtual ~BSQStringKReprTypeAbstract() {;}
 
     virtual bool isKReprNode() const override final { return true; }
+    virtual bool isFlatReprNode() const override final { return false; }
 
     static uint64_t getUTF8ByteCount(void* repr)
     {
@@ -1041,6 +1053,7 @@ public:
     virtual ~BSQStringTreeReprType() {;}
 
     virtual bool isKReprNode() const override final { return false; }
+    virtual bool isFlatReprNode() const override final { return false; }
 
     uint64_t utf8ByteCount(void* repr) const override final
     {
@@ -1050,6 +1063,32 @@ public:
     virtual void* slice(void* data, uint64_t nstart, uint64_t nend) const override;
 };
 
+//A leaf over bytes that live outside the GC heap (large input payloads) -- the bytes are read only and must outlive every reference to the leaf
+struct BSQStringFlatRepr
+{
+    const uint8_t* bytes;
+    uint64_t size;
+};
+
+class BSQStringFlatReprType : public BSQStringReprType
+{
+public:
+    BSQStringFlatReprType(): BSQStringReprType(BSQ_TYPE_ID_INTERNAL, sizeof(BSQStringFlatRepr), nullptr, "[Internal::StringFlatRepr]") 
+    {;}
+
+    virtual ~BSQStringFlatReprType() {;}
+
+    virtual bool isKReprNode() const override final { return false; }
+    virtual bool isFlatReprNode() const override final { return true; }
+
+    uint64_t utf8ByteCount(void* repr) const override final
+    {
+        return ((BSQStringFlatRepr*)repr)->size;
+    }
+
+    virtual void* slice(void* data, uint64_t nstart, uint64_t nend) const override;
+};
+
 struct BSQString
 {
     //TODO: should we make the reprs use this instead of void* -- makes a tree node can store much more 
@@ -1069,9 +1108,9 @@ public:
     BSQString* sstr;
     size_t curr;
     size_t strmax;
-    uint8_t* cbuff;
-    uint16_t cpos;
-    uint16_t maxpos;
+    const uint8_t* cbuff;
+    size_t cpos;
+    size_t maxpos;
 
     BSQStringForwardIterator(BSQString* sstr, int64_t curr) : CharCodeIterator(), sstr(sstr), curr(curr), strmax(0), cbuff(nullptr), cpos(0), maxpos(0) 
     {
@@ -1160,8 +1199,8 @@ public:
     BSQString* sstr;
     int64_t curr;
     int64_t strmax;
-    uint8_t* cbuff;
-    int16_t cpos;
+    const uint8_t* cbuff;
+    int64_t cpos;
 
     BSQStringReverseIterator(BSQString* sstr, int64_t curr) : CharCodeIterator(), sstr(sstr), curr(curr), strmax(0), cbuff(nullptr), cpos(0) 
     {
@@ -1318,6 +1357,7 @@ struct BSQByteBufferLeaf
     uint8_t bytes[256];
 };
 
+//A flat node has the same layout but bytes points at a read only block of bytecount bytes outside the GC heap (a large input payload)
 struct BSQByteBufferNode
 {
     BSQByteBufferNode* next;
@@ -1351,6 +1391,7 @@ std::string entityByteBufferDisplay_impl(const BSQType* btype, StorageLocationPt
 
 #define CONS_BSQ_BYTE_BUFFER_LEAF_TYPE() (new BSQRefType(BSQ_TYPE_ID_INTERNAL, sizeof(BSQByteBufferLeaf), nullptr, {}, EMPTY_KEY_CMP, entityByteBufferLeafDisplay_impl, "ByteBufferLeaf"))
 #define CONS_BSQ_BYTE_BUFFER_NODE_TYPE() (new BSQRefType(BSQ_TYPE_ID_INTERNAL, sizeof(BSQByteBufferNode), "22", {}, EMPTY_KEY_CMP, entityByteBufferNodeDisplay_impl, "ByteBufferNode"))
+#define CONS_BSQ_BYTE_BUFFER_FLAT_NODE_TYPE() (new BSQRefType(BSQ_TYPE_ID_INTERNAL, sizeof(BSQByteBufferNode), "21", {}, EMPTY_KEY_CMP, entityByteBufferNodeDisplay_impl, "ByteBufferFlatNode"))
 #define CONS_BSQ_BYTE_BUFFER_TYPE(TID, NAME) (new BSQRefType(TID, sizeof(BSQByteBuffer), "2", {}, EMPTY_KEY_CMP, entityByteBufferDisplay_impl, NAME))
 
 ////
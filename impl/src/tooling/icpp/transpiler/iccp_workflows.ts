@@ -5,7 +5,7 @@
 
 import * as FS from "fs";
 import * as Path from "path";
-import { exec } from "child_process";
+import { exec, spawn, ChildProcess } from "child_process";
 
 import { MIRAssembly, PackageConfig } from "../../../compiler/mir_assembly";
 import { MIREmitter } from "../../../compiler/mir_emitter";
@@ -113,6 +113,54 @@ function runICPPFile(icppjson: {code: object, args: any[], main: string}, debug:
     }
 }
 
+//A warm icpp process (--serve) that keeps an emitted assembly loaded -- requests are answered in order, one response line each
+class ICPPServer {
+    private readonly proc: ChildProcess;
+    private pending: ((result: string | undefined) => void)[] = [];
+    private buffer: string = "";
+
+    constructor(icppfile: string) {
+        this.proc = spawn(exepath, ["--serve", icppfile]);
+
+        (this.proc.stdout as NodeJS.ReadableStream).setEncoding("utf-8");
+        (this.proc.stdout as NodeJS.ReadableStream).on("data", (data: string) => {
+            this.buffer += data;
+
+            let nl = this.buffer.indexOf("\n");
+            while (nl !== -1) {
+                const line = this.buffer.substring(0, nl);
+                this.buffer = this.buffer.substring(nl + 1);
+
+                const cb = this.pending.shift();
+                if (cb !== undefined) {
+                    cb(line.trim());
+                }
+
+                nl = this.buffer.indexOf("\n");
+            }
+        });
+
+        this.proc.on("exit", () => {
+            const waiting = this.pending;
+            this.pending = [];
+            waiting.forEach((cb) => cb(undefined));
+        });
+    }
+
+    run(main: MIRInvokeKey, args: any[], cb: (result: string | undefined) => void) {
+        this.pending.push(cb);
+        (this.proc.stdin as NodeJS.WritableStream).write(JSON.stringify({main: main, args: args}) + "\n");
+    }
+
+    close() {
+        (this.proc.stdin as NodeJS.WritableStream).end();
+    }
+}
+
+function workflowStartICPPServer(icppfile: string): ICPPServer {
+    return new ICPPServer(icppfile);
+}
+
 function workflowEmitICPPFile(into: string, usercode: PackageConfig, emitsrcmap: boolean, buildlevel: BuildLevel, istestbuild: boolean, topts: TranspilerOptions, entrypoint: {filename: string, names: string[], fkeys: MIRResolvedTypeKey[]}): boolean {
     const massembly = generateMASM(usercode, buildlevel, {filename: entrypoint.filename, names: entrypoint.names});
 
@@ -146,5 +194,6 @@ function workflowRunICPPFile(args: any[], usercode: PackageConfig, emitsrcmap: b
 
 export {
     DEFAULT_TOPTS,
-    workflowLoadUserSrc, workflowEmitICPPFile, workflowRunICPPFile
+    ICPPServer,
+    workflowLoadUserSrc, workflowEmitICPPFile, workflowRunICPPFile, workflowStartICPPServer
 };
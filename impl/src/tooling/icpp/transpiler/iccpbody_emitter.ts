@@ -8,7 +8,7 @@ import { ICPPTypeEmitter } from "./icpptype_emitter";
 import { MIRAbort, MIRArgGuard, MIRArgument, MIRAssertCheck, MIRBasicBlock, MIRBinKeyEq, MIRBinKeyLess, MIRConstantArgument, MIRConstantBigInt, MIRConstantBigNat, MIRConstantDataString, MIRConstantDecimal, MIRConstantFalse, MIRConstantFloat, MIRConstantInt, MIRConstantNat, MIRConstantNone, MIRConstantNothing, MIRConstantRational, MIRConstantRegex, MIRConstantString, MIRConstantStringOf, MIRConstantTrue, MIRConstantTypedNumber, MIRConstructorEntityDirect, MIRConstructorEphemeralList, MIRConstructorPrimaryCollectionEmpty, MIRConstructorPrimaryCollectionOneElement, MIRConstructorPrimaryCollectionSingletons, MIRConstructorRecord, MIRConstructorRecordFromEphemeralList, MIRConstructorTuple, MIRConstructorTupleFromEphemeralList, MIRConvertValue, MIRDebug, MIRDeclareGuardFlagLocation, MIREntityProjectToEphemeral, MIREntityUpdate, MIREphemeralListExtend, MIRExtract, MIRFieldKey, MIRGlobalKey, MIRGlobalVariable, MIRGuard, MIRGuardedOptionInject, MIRInject, MIRInvokeFixedFunction, MIRInvokeKey, MIRInvokeVirtualFunction, MIRInvokeVirtualOperator, MIRIsTypeOf, MIRJump, MIRJumpCond, MIRJumpNone, MIRLoadConst, MIRLoadField, MIRLoadFromEpehmeralList, MIRLoadRecordProperty, MIRLoadRecordPropertySetGuard, MIRLoadTupleIndex, MIRLoadTupleIndexSetGuard, MIRLoadUnintVariableValue, MIRLogicAction, MIRMaskGuard, MIRMultiLoadFromEpehmeralList, MIROp, MIROpTag, MIRPhi, MIRPrefixNotOp, MIRRecordHasProperty, MIRRecordProjectToEphemeral, MIRRecordUpdate, MIRRegisterArgument, MIRRegisterAssign, MIRResolvedTypeKey, MIRReturnAssign, MIRReturnAssignOfCons, MIRSetConstantGuardFlag, MIRSliceEpehmeralList, MIRStatmentGuard, MIRStructuredAppendTuple, MIRStructuredJoinRecord, MIRTupleHasIndex, MIRTupleProjectToEphemeral, MIRTupleUpdate, MIRVarLifetimeEnd, MIRVarLifetimeStart } from "../../../compiler/mir_ops";
 import { Argument, ArgumentTag, EMPTY_CONST_POSITION, FALSE_VALUE_POSITION, ICPPGuard, ICPPOp, ICPPOpEmitter, ICPPStatementGuard, NONE_VALUE_POSITION, NOTHING_VALUE_POSITION, OpCodeTag, ParameterInfo, TargetVar, TRUE_VALUE_POSITION } from "./icpp_exp";
 import { SourceInfo } from "../../../ast/parser";
-import { ICPPEntityLayoutInfo, ICPPEphemeralListLayoutInfo, ICPPFunctionParameter, ICPPInvokeBodyDecl, ICPPInvokeDecl, ICPPInvokePrimitiveDecl, ICPPLayoutInfo, ICPPPCode, ICPPRecordLayoutInfo, ICPPTupleLayoutInfo, TranspilerOptions, UNIVERSAL_TOTAL_SIZE } from "./icpp_assembly";
+import { ICPPEntityLayoutInfo, ICPPEphemeralListLayoutInfo, ICPPFunctionParameter, ICPPInvokeBodyDecl, ICPPInvokeDecl, ICPPInvokePrimitiveDecl, ICPPLayoutInfo, ICPPPCode, ICPPRecordLayoutInfo, ICPPTupleLayoutInfo, RefMask, TranspilerOptions, UNIVERSAL_TOTAL_SIZE } from "./icpp_assembly";
 
 import * as assert from "assert";
 import { topologicalOrder } from "../../../compiler/mir_info";
@@ -92,6 +92,10 @@ class ICPPBodyEmitter {
         }
     }
 
+    private generateStackMask(): RefMask {
+        return this.stackLayout.map((entry) => entry.storage.allocinfo.inlinedmask).join("");
+    }
+
     private generateScratchVarInfo(oftype: ICPPLayoutInfo): [TargetVar, Argument] {
         const trgt = { offset: this.stackSize };
 
@@ -214,7 +218,7 @@ class ICPPBodyEmitter {
         ops.push(ICPPOpEmitter.genConstructorEphemeralListOp(sinfo, "[GENERATED PROJECT TUPLE]", rt, geninfo.resulttype.typeID, pargs));
         ops.push(ICPPOpEmitter.genJumpOp(sinfo, "[GENERATED PROJECT TUPLE]", 1, "exit")); //dummy final jump block
         
-        return new ICPPInvokeBodyDecl(name, name, "[GENERATED]", sinfo, sinfo, false, params, paraminfo, geninfo.resulttype.typeID, this.getStackInfoForArgVar("$$return"), this.stackSize, 0, ops, 0);
+        return new ICPPInvokeBodyDecl(name, name, "[GENERATED]", sinfo, sinfo, false, params, paraminfo, geninfo.resulttype.typeID, this.getStackInfoForArgVar("$$return"), this.stackSize, 0, ops, 0, this.generateStackMask());
     }
 
     generateProjectRecordPropertyVirtual(geninfo: { inv: string, argflowtype: MIRType, properties: string[], resulttype: MIRType }, sinfo: SourceInfo, recordtype: MIRType): ICPPInvokeDecl {
@@ -253,7 +257,7 @@ class ICPPBodyEmitter {
         ops.push(ICPPOpEmitter.genConstructorEphemeralListOp(sinfo, "[GENERATED PROJECT RECORD]", rt, geninfo.resulttype.typeID, pargs));
         ops.push(ICPPOpEmitter.genJumpOp(sinfo, "[GENERATED PROJECT RECORD]", 1, "exit")); //dummy final jump block
         
-        return new ICPPInvokeBodyDecl(name, name, "[GENERATED]", sinfo, sinfo, false, params, paraminfo, geninfo.resulttype.typeID, this.getStackInfoForArgVar("$$return"), this.stackSize, 0, ops, 0);
+        return new ICPPInvokeBodyDecl(name, name, "[GENERATED]", sinfo, sinfo, false, params, paraminfo, geninfo.resulttype.typeID, this.getStackInfoForArgVar("$$return"), this.stackSize, 0, ops, 0, this.generateStackMask());
     }
 
     generateProjectEntityFieldVirtual(geninfo: { inv: string, argflowtype: MIRType, fields: MIRFieldDecl[], resulttype: MIRType }, sinfo: SourceInfo, entitytype: MIRType): ICPPInvokeDecl {
@@ -292,7 +296,7 @@ class ICPPBodyEmitter {
         ops.push(ICPPOpEmitter.genConstructorEphemeralListOp(sinfo, "[GENERATED PROJECT ENTITY]", rt, geninfo.resulttype.typeID, pargs));
         ops.push(ICPPOpEmitter.genJumpOp(sinfo, "[GENERATED PROJECT ENTITY]", 1, "exit")); //dummy final jump block
         
-        return new ICPPInvokeBodyDecl(name, name, "[GENERATED]", sinfo, sinfo, false, params, paraminfo, geninfo.resulttype.typeID, this.getStackInfoForArgVar("$$return"), this.stackSize, 0, ops, 0);
+        return new ICPPInvokeBodyDecl(name, name, "[GENERATED]", sinfo, sinfo, false, params, paraminfo, geninfo.resulttype.typeID, this.getStackInfoForArgVar("$$return"), this.stackSize, 0, ops, 0, this.generateStackMask());
     }
 
     generateUpdateEntityFieldDirect(geninfo: { inv: string, arglayouttype: MIRType, argflowtype: MIRType, updates: [MIRFieldKey, MIRResolvedTypeKey][], resulttype: MIRType }, sinfo: SourceInfo): ICPPInvokeDecl {
@@ -338,7 +342,7 @@ class ICPPBodyEmitter {
         ops.push(ICPPOpEmitter.genInvokeFixedFunctionOp(sinfo, "[GENERATED UPDATE ENTITY]", rt, geninfo.resulttype.typeID, edecl.consfunc, pargs, -1, ICPPOpEmitter.genNoStatmentGuard()));
         ops.push(ICPPOpEmitter.genJumpOp(sinfo, "[GENERATED UPDATE ENTITY]", 1, "exit")); //dummy final jump block
         
-        return new ICPPInvokeBodyDecl(geninfo.inv, geninfo.inv, "[GENERATED]", sinfo, sinfo, false, params, paraminfo, geninfo.resulttype.typeID, this.getStackInfoForArgVar("$$return"), this.stackSize, 0, ops, 0);
+        return new ICPPInvokeBodyDecl(geninfo.inv, geninfo.inv, "[GENERATED]", sinfo, sinfo, false, params, paraminfo, geninfo.resulttype.typeID, this.getStackInfoForArgVar("$$return"), this.stackSize, 0, ops, 0, this.generateStackMask());
     }
 
     generateEmptyConstructorList(geninfo: { inv: string, resulttype: MIRType }): ICPPInvokeDecl {
@@ -1911,7 +1915,7 @@ class ICPPBodyEmitter {
             const revblocks = [...inorderblocks].reverse();
             const body = this.generateBlockExps((idecl as MIRInvokeBodyDecl).body.body, inorderblocks, revblocks);
 
-            return new ICPPInvokeBodyDecl(idecl.shortname, idecl.ikey, idecl.srcFile, idecl.sinfoStart, idecl.sinfoEnd, idecl.recursive, params, paraminfo, idecl.resultType, this.getStackInfoForArgVar("$$return"), this.stackSize, this.masksize, body, idecl.masksize);
+            return new ICPPInvokeBodyDecl(idecl.shortname, idecl.ikey, idecl.srcFile, idecl.sinfoStart, idecl.sinfoEnd, idecl.recursive, params, paraminfo, idecl.resultType, this.getStackInfoForArgVar("$$return"), this.stackSize, this.masksize, body, idecl.masksize, this.generateStackMask());
         }
         else {
             assert(idecl instanceof MIRInvokePrimitiveDecl);
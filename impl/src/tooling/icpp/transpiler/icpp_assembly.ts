@@ -318,17 +318,19 @@ class ICPPInvokeBodyDecl extends ICPPInvokeDecl {
     readonly paraminfo: ParameterInfo[];
     readonly resultArg: Argument;
     readonly argmaskSize: number;
+    readonly stackmask: RefMask; //The inlined masks of every stack slot in offset order -- lets the gc walk the frame precisely
 
-    constructor(name: string, ikey: MIRInvokeKey, srcFile: string, sinfoStart: SourceInfo, sinfoEnd: SourceInfo, recursive: boolean, params: ICPPFunctionParameter[], paraminfo: ParameterInfo[], resultType: MIRResolvedTypeKey, resultArg: Argument, stackBytes: number, maskSlots: number, body: ICPPOp[], argmaskSize: number) {
+    constructor(name: string, ikey: MIRInvokeKey, srcFile: string, sinfoStart: SourceInfo, sinfoEnd: SourceInfo, recursive: boolean, params: ICPPFunctionParameter[], paraminfo: ParameterInfo[], resultType: MIRResolvedTypeKey, resultArg: Argument, stackBytes: number, maskSlots: number, body: ICPPOp[], argmaskSize: number, stackmask: RefMask) {
         super(name, ikey, srcFile, sinfoStart, sinfoEnd, recursive, params, resultType, stackBytes, maskSlots);
         this.body = body;
         this.paraminfo = paraminfo;
         this.resultArg = resultArg;
         this.argmaskSize = argmaskSize;
+        this.stackmask = stackmask;
     }
 
     jsonEmit(): object {
-        return {...super.jsonEmit(), isbuiltin: false, paraminfo: this.paraminfo, resultArg: this.resultArg, body: this.body, argmaskSize: this.argmaskSize};
+        return {...super.jsonEmit(), isbuiltin: false, paraminfo: this.paraminfo, resultArg: this.resultArg, body: this.body, argmaskSize: this.argmaskSize, stackmask: this.stackmask};
     }
 }
 